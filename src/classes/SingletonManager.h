@@ -1,6 +1,7 @@
 #pragma once
 
-#include <map>
+#include <memory>
+#include <type_traits>
 
 class SingletonBase
 {
@@ -17,14 +18,8 @@ class SingletonManager
         {
             static_assert(std::is_base_of<SingletonBase, T>::value, "T must inherit from SingletonBase");
 
-            const char* typeName = typeid(T).name();
-            const auto& pos = s_objects.find(typeName);
-            if(pos != s_objects.end())
-            {
-                return dynamic_pointer_cast<T>(pos->second);
-            }
-            std::shared_ptr<T> instance = std::make_shared<T>();
-            s_objects[typeName] = instance;
+            // Initialised exactly once even if worker threads ask while the main thread creates other singletons
+            static const std::shared_ptr<T> instance = std::make_shared<T>();
             return instance;
         }
 
@@ -32,6 +27,4 @@ class SingletonManager
         SingletonManager() {}
 
         ~SingletonManager() {}
-
-        static std::map<const char*, std::shared_ptr<SingletonBase>> s_objects;
 };
@@ -0,0 +1,192 @@
+#include "AssetWatcher.h"
+
+#include <iostream>
+#include <system_error>
+#include <utility>
+
+#ifdef __linux__
+    #include <poll.h>
+    #include <sys/inotify.h>
+    #include <unistd.h>
+#endif
+
+using namespace Engine;
+
+AssetWatcher::AssetWatcher(std::string watchDirectory, std::string runtimeDirectory)
+    : m_watchDirectory(std::move(watchDirectory))
+    , m_runtimeDirectory(std::move(runtimeDirectory))
+    , m_stopping(false)
+{
+    if(!std::filesystem::is_directory(m_watchDirectory))
+    {
+        fprintf(stderr, "AssetWatcher | %s is no directory!\n", m_watchDirectory.string().c_str());
+        return;
+    }
+
+    m_thread = std::thread(&AssetWatcher::watchLoop, this);
+}
+
+AssetWatcher::~AssetWatcher()
+{
+    m_stopping = true;
+    if(m_thread.joinable())
+    {
+        m_thread.join();
+    }
+}
+
+std::vector<std::string> AssetWatcher::consumeChangedFiles()
+{
+    std::vector<std::string> changedFiles;
+    const auto now = std::chrono::steady_clock::now();
+
+    std::lock_guard<std::mutex> lock(m_changeMutex);
+    for(auto it = m_pendingChanges.begin(); it != m_pendingChanges.end();)
+    {
+        if(now - it->second < DEBOUNCE_TIME)
+        {
+            ++it;
+            continue;
+        }
+
+        changedFiles.push_back(it->first);
+        it = m_pendingChanges.erase(it);
+    }
+
+    return changedFiles;
+}
+
+void AssetWatcher::onFileChanged(const std::filesystem::path& file)
+{
+    std::error_code error;
+    const std::filesystem::path runtimeFile = m_runtimeDirectory / std::filesystem::relative(file, m_watchDirectory, error);
+    if(error)
+    {
+        return;
+    }
+
+    if(!std::filesystem::equivalent(m_watchDirectory, m_runtimeDirectory, error))
+    {
+        std::filesystem::create_directories(runtimeFile.parent_path(), error);
+        std::filesystem::copy_file(file, runtimeFile, std::filesystem::copy_options::overwrite_existing, error);
+        if(error)
+        {
+            fprintf(stderr, "AssetWatcher | Couldn't copy %s: %s\n", file.string().c_str(), error.message().c_str());
+            return;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(m_changeMutex);
+    m_pendingChanges[runtimeFile.lexically_normal().generic_string()] = std::chrono::steady_clock::now();
+}
+
+#ifdef __linux__
+void AssetWatcher::watchLoop()
+{
+    const int fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if(fd < 0)
+    {
+        fprintf(stderr, "AssetWatcher | inotify unavailable, falling back to polling\n");
+        pollLoop();
+        return;
+    }
+
+    constexpr uint32_t watchMask = IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE;
+    std::map<int, std::filesystem::path> watchedDirectories;
+    const auto addWatch = [&](const std::filesystem::path& directory)
+    {
+        const int wd = inotify_add_watch(fd, directory.c_str(), watchMask);
+        if(wd >= 0)
+        {
+            watchedDirectories[wd] = directory;
+        }
+    };
+
+    addWatch(m_watchDirectory);
+    for(const auto& entry : std::filesystem::recursive_directory_iterator(m_watchDirectory))
+    {
+        if(entry.is_directory())
+        {
+            addWatch(entry.path());
+        }
+    }
+
+    std::cout << "AssetWatcher | Watching " << m_watchDirectory << std::endl;
+
+    alignas(inotify_event) char buffer[4096];
+    pollfd pollFd { fd, POLLIN, 0 };
+    while(!m_stopping)
+    {
+        // Wake up regularly to notice the shutdown
+        if(poll(&pollFd, 1, 100) <= 0)
+        {
+            continue;
+        }
+
+        ssize_t length;
+        while((length = read(fd, buffer, sizeof(buffer))) > 0)
+        {
+            for(char* ptr = buffer; ptr < buffer + length;)
+            {
+                const auto* event = reinterpret_cast<const inotify_event*>(ptr);
+                ptr += sizeof(inotify_event) + event->len;
+
+                const auto directory = watchedDirectories.find(event->wd);
+                if(directory == watchedDirectories.end() || event->len == 0)
+                {
+                    continue;
+                }
+
+                const std::filesystem::path path = directory->second / event->name;
+                if(event->mask & IN_ISDIR)
+                {
+                    addWatch(path);
+                }
+                else if(event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO))
+                {
+                    onFileChanged(path);
+                }
+            }
+        }
+    }
+
+    close(fd);
+}
+#else
+void AssetWatcher::watchLoop()
+{
+    pollLoop();
+}
+#endif
+
+void AssetWatcher::pollLoop()
+{
+    std::map<std::filesystem::path, std::filesystem::file_time_type> writeTimes;
+    bool initialScan = true;
+
+    while(!m_stopping)
+    {
+        std::error_code error;
+        for(const auto& entry : std::filesystem::recursive_directory_iterator(m_watchDirectory, error))
+        {
+            if(!entry.is_regular_file())
+            {
+                continue;
+            }
+
+            const auto writeTime = entry.last_write_time(error);
+            auto& knownTime = writeTimes[entry.path()];
+            if(knownTime != writeTime)
+            {
+                knownTime = writeTime;
+                if(!initialScan)
+                {
+                    onFileChanged(entry.path());
+                }
+            }
+        }
+        initialScan = false;
+
+        std::this_thread::sleep_for(POLL_INTERVAL);
+    }
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Engine
+{
+    /**
+     * @brief Watches an asset directory recursively on its own thread and collects changed files.
+     *
+     * Uses inotify on Linux and falls back to polling the modification times everywhere else. If the watched
+     * directory differs from the runtime directory (e.g. the source tree vs. the copy next to the binary), every
+     * changed file gets copied over before it is reported, so the runtime always loads the edited version.
+     */
+    class AssetWatcher
+    {
+        public:
+            /**
+             * @param watchDirectory The directory that gets edited.
+             * @param runtimeDirectory The directory the engine loads its assets from, e.g. "resources".
+             */
+            AssetWatcher(std::string watchDirectory, std::string runtimeDirectory);
+            ~AssetWatcher();
+
+            /**
+             * @brief Takes all files that changed and settled since the last call.
+             *
+             * A file counts as settled once it wasn't touched for a short debounce time, so multiple writes of one
+             * save only get reported once.
+             *
+             * @return The changed files as runtime paths, e.g. "resources/shader/standard.frag".
+             */
+            std::vector<std::string> consumeChangedFiles();
+
+        private:
+            void watchLoop();
+            void pollLoop();
+            void onFileChanged(const std::filesystem::path& file);
+
+            std::filesystem::path m_watchDirectory;
+            std::filesystem::path m_runtimeDirectory;
+            std::thread m_thread;
+            std::atomic<bool> m_stopping;
+
+            std::mutex m_changeMutex;
+            std::map<std::string, std::chrono::steady_clock::time_point> m_pendingChanges;
+
+            static constexpr std::chrono::milliseconds DEBOUNCE_TIME { 50 };
+            static constexpr std::chrono::milliseconds POLL_INTERVAL { 250 };
+    };
+} // namespace Engine
@@ -2,12 +2,32 @@
 #include "EngineManager.h"
 
 #include "../../customCode/testScene/TestSceneOrigin.h"
+#include "../../resources/shader/DepthShader.h"
 #include "../../resources/shader/GridShader.h"
+#include "../../resources/shader/ParticleShader.h"
 #include "../nodeComponents/CameraComponent.h"
+#include "../nodeComponents/ColliderComponent.h"
 #include "../nodeComponents/GeometryComponent.h"
+#include "../nodeComponents/ParticleEmitter.h"
+#include "../nodeComponents/SkeletalAnimator.h"
+#include "../nodeComponents/SkinnedMeshComponent.h"
 #include "../nodeComponents/UiDebugWindow.h"
+#include "NodeLifecycleQueue.h"
+#include "SceneIndex.h"
+#include "SceneManager.h"
+#include "ThreadPool.h"
+#include "UserEventManager.h"
+#include "WindowManager.h"
+#include "collision/CollisionWorld.h"
+#include "rendering/DynamicResolution.h"
+#include "rendering/ObjectPicker.h"
+#include "rendering/OcclusionCuller.h"
+#include "rendering/RenderGraph.h"
 #include "rendering/RenderManager.h"
+#include "rendering/backend/RenderBackend.h"
 
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <utility>
 
@@ -27,10 +47,29 @@ namespace Engine
         , m_renderManager(nullptr)
         , m_clearColor { 0.f, 0.f, 0.f, 1.f }
         , m_showGrid(true)
+        , m_depthPrePass(false)
+        , m_showOverdraw(false)
+        , m_occlusionCulling(false)
         , m_gridShader(nullptr)
+        , m_particleShader(nullptr)
+        , m_depthShader(nullptr)
+        , m_skinnedDepthShader(nullptr)
+        , m_dynamicResolution(nullptr)
+        , m_renderGraph(nullptr)
+        , m_occlusionCuller(nullptr)
+        , m_objectPicker(nullptr)
+        , m_sceneIndex(nullptr)
     {
         m_renderManager = std::make_shared<RenderManager>();
         m_gridShader = std::make_shared<GridShader>(m_renderManager);
+        m_particleShader = std::make_shared<ParticleShader>(m_renderManager);
+        m_depthShader = std::make_shared<DepthShader>(m_renderManager, false);
+        m_skinnedDepthShader = std::make_shared<DepthShader>(m_renderManager, true);
+        m_dynamicResolution = std::make_shared<DynamicResolution>(m_renderManager);
+        m_renderGraph = std::make_shared<RenderGraph>();
+        m_occlusionCuller = std::make_shared<OcclusionCuller>(m_depthShader);
+        m_objectPicker = std::make_shared<ObjectPicker>(m_renderManager);
+        m_sceneIndex = std::make_shared<SceneIndex>();
     }
 
     bool EngineManager::engineStart()
@@ -41,28 +80,49 @@ namespace Engine
             return false;
         }
 
-        GLuint VertexArrayID;
-        glGenVertexArrays(1, &VertexArrayID);
-        glBindVertexArray(VertexArrayID);
+        RenderBackend& backend = RenderBackend::get();
+        backend.bindVertexArray(backend.createVertexArray());
 
-        glEnable(GL_DEPTH_TEST);
-        glDepthFunc(GL_LESS);
-        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        backend.enable(GL_DEPTH_TEST);
+        backend.depthFunc(GL_LESS);
+        backend.blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
-        glClearColor(m_clearColor[0], m_clearColor[1], m_clearColor[2], m_clearColor[3]);
+        backend.clearColor(glm::vec4(m_clearColor[0], m_clearColor[1], m_clearColor[2], m_clearColor[3]));
 
         m_lastFrameTimestamp = glfwGetTime();
 
-        m_sceneNode->start();
+        m_sceneNode->startSubtree();
+
+#if defined(DEBUG) && defined(ENGINE_ASSET_SOURCE_DIR)
+        // Edits in the source tree get mirrored into the copied resources and reloaded while running
+        m_renderManager->enableHotReload(ENGINE_ASSET_SOURCE_DIR, "resources");
+#endif
 
         return true;
     }
 
     void EngineManager::engineUpdate()
     {
+        m_renderManager->processHotReload();
+        m_renderManager->processPreloads();
+
+        // A preloaded scene gets switched to before the flush, so the old one leaves within the same frame
+        SingletonManager::get<SceneManager>()->update();
+
+        // Nodes queued since the last frame join or leave the scene before anything gets updated
+        SingletonManager::get<NodeLifecycleQueue>()->flush();
+
+        processPicking();
+
         const auto func = [](BasicNode* node) { node->update(); };
 
         getScene()->callOnAllChildrenRecursiveAndSelf(func);
+
+        updateCollisions();
+
+        animateSkeletons();
+
+        simulateParticles();
     }
 
     void EngineManager::engineLateUpdate()
@@ -70,89 +130,360 @@ namespace Engine
         const auto func = [](BasicNode* node) { node->lateUpdate(); };
 
         getScene()->callOnAllChildrenRecursiveAndSelf(func);
+
+        SingletonManager::get<NodeLifecycleQueue>()->releaseDestroyed();
     }
 
     void EngineManager::engineDraw()
     {
         if(m_camera)
         {
-            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+            const auto& windowManager = SingletonManager::get<WindowManager>();
+            glm::ivec2 framebufferSize;
+            glfwGetFramebufferSize(windowManager->getWindow(), &framebufferSize.x, &framebufferSize.y);
 
-            // TODO: Investigate multithreading
-            // Multithread tri sorting here
+            drawScene(framebufferSize, windowManager->getTextureSamples());
 
-            depthSortNodes();
+            drawUiNodes();
+        }
+        else
+        {
+            fprintf(stderr, "No camera...\n");
+        }
+    }
+
+    void EngineManager::drawScene(const glm::ivec2& framebufferSize, int samples)
+    {
+        // Only the scene is rendered at the dynamic resolution, ImGui stays native
+        const bool scaled = m_dynamicResolution->isEnabled();
+        const glm::ivec2 sceneSize = m_dynamicResolution->beginScene(framebufferSize);
+
+        uploadSkinnedMeshes();
 
-            drawOpaqueNodes();
+        // TODO: Investigate multithreading
+        // Multithread tri sorting here
 
-            // Wait for threads to finish here
+        depthSortNodes();
 
-            drawTranslucentNodes();
+        RenderGraph& graph = *m_renderGraph;
+        graph.beginFrame();
 
-            if(m_showGrid)
+        const RenderGraph::Resource backbuffer = graph.importBackbuffer("Backbuffer", framebufferSize);
+        RenderGraph::Resource sceneColor = backbuffer;
+        RenderGraph::Resource sceneDepth = backbuffer;
+        const auto writeScene = [&sceneColor, &sceneDepth](RenderGraph::PassBuilder& builder)
+        {
+            builder.write(sceneColor);
+            if(sceneDepth != sceneColor)
             {
-                m_gridShader->renderVertices(nullptr, m_camera.get());
+                builder.write(sceneDepth);
             }
+        };
+
+        graph.addPass(
+                "Clear",
+                [&](RenderGraph::PassBuilder& builder)
+                {
+                    if(!scaled)
+                    {
+                        builder.write(backbuffer);
+                        return;
+                    }
+                    sceneColor = builder.create("SceneColor", { sceneSize, GL_RGBA8, samples });
+                    sceneDepth = builder.create("SceneDepth", { sceneSize, GL_DEPTH_COMPONENT24, samples });
+                },
+                [this](const RenderGraph::PassContext&)
+                {
+                    RenderBackend& backend = RenderBackend::get();
+                    if(!m_showOverdraw)
+                    {
+                        backend.clear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+                        return;
+                    }
+
+                    // Every shaded fragment adds up on black
+                    backend.clearColor(glm::vec4(0.f, 0.f, 0.f, 1.f));
+                    backend.clear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+                    backend.clearColor(glm::vec4(m_clearColor[0], m_clearColor[1], m_clearColor[2], m_clearColor[3]));
+                    backend.enable(GL_BLEND);
+                    backend.blendFunc(GL_ONE, GL_ONE);
+                }
+        );
 
-            drawUiNodes();
-            glDisable(GL_BLEND);
+        if(m_depthPrePass)
+        {
+            graph.addPass("DepthPrePass", writeScene, [this](const RenderGraph::PassContext&) { drawDepthPrePass(); });
         }
-        else
+
+        graph.addPass("Opaque", writeScene, [this](const RenderGraph::PassContext&) { drawOpaqueNodes(); });
+
+        graph.addPass("Translucent", writeScene, [this](const RenderGraph::PassContext&) { drawTranslucentNodes(); });
+
+        // Only frames with a pick request draw the ids, nothing reads the targets but the readback
+        if(m_objectPicker->isPickRequested())
         {
-            fprintf(stderr, "No camera...\n");
+            graph.addPass(
+                    "Picking",
+                    [&](RenderGraph::PassBuilder& builder)
+                    {
+                        builder.create("PickingIds", { sceneSize, GL_R32UI, 0 });
+                        builder.create("PickingDepth", { sceneSize, GL_DEPTH_COMPONENT24, 0 });
+                        builder.setSideEffect();
+                    },
+                    // Blending doesn't apply to integer targets, it can stay on
+                    [this, framebufferSize, sceneSize](const RenderGraph::PassContext&)
+                    {
+                        m_objectPicker->drawIds(
+                                m_sceneGeometry.begin(),
+                                m_sceneGeometry.end(),
+                                m_camera.get(),
+                                framebufferSize,
+                                sceneSize
+                        );
+                    }
+            );
+        }
+
+        // Particles & the grid would only cover up the overdraw of the geometry
+        if(!m_sceneParticleEmitters.empty() && !m_showOverdraw)
+        {
+            graph.addPass("Particles", writeScene, [this](const RenderGraph::PassContext&) { drawParticles(); });
+        }
+
+        if(m_showGrid && !m_showOverdraw)
+        {
+            graph.addPass(
+                    "Grid",
+                    writeScene,
+                    [this](const RenderGraph::PassContext&) { m_gridShader->renderVertices(nullptr, m_camera.get()); }
+            );
+        }
+
+        if(scaled)
+        {
+            // Resolve the multisampled scene into a texture the upscale pass can sample
+            RenderGraph::Resource resolved = backbuffer;
+            graph.addPass(
+                    "Resolve",
+                    [&](RenderGraph::PassBuilder& builder)
+                    {
+                        builder.read(sceneColor);
+                        resolved = builder.create("ResolvedScene", { sceneSize, GL_RGBA8, 0 });
+                    },
+                    [sceneColor, sceneSize](const RenderGraph::PassContext& context)
+                    {
+                        context.bindReadFramebuffer(sceneColor);
+                        RenderBackend::get().blitFramebuffer(sceneSize, sceneSize, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+                    }
+            );
+
+            graph.addPass(
+                    "Upscale",
+                    [&](RenderGraph::PassBuilder& builder)
+                    {
+                        builder.read(resolved);
+                        builder.write(backbuffer);
+                    },
+                    [this, resolved](const RenderGraph::PassContext& context)
+                    { m_dynamicResolution->upscale(context.getTexture(resolved), context.getSize(resolved)); }
+            );
         }
+
+        graph.execute();
+
+        RenderBackend& backend = RenderBackend::get();
+        backend.disable(GL_BLEND);
+        if(m_showOverdraw)
+        {
+            backend.blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        }
+        m_dynamicResolution->endScene();
     }
 
+    void EngineManager::processPicking()
+    {
+        const auto& userEventManager = SingletonManager::get<UserEventManager>();
+
+        // Only done once per finished pick, not per frame
+        PickResult result;
+        while(m_objectPicker->pollResult(result))
+        {
+            const auto node = std::dynamic_pointer_cast<GeometryComponent>(m_sceneIndex->findNode(result.nodeId));
+            userEventManager->dispatchPick(node, result.pixel);
+        }
+
+        if(userEventManager->hasPickListeners() && !userEventManager->isCursorOverUi() &&
+           userEventManager->wasMousePressed(GLFW_MOUSE_BUTTON_LEFT))
+        {
+            m_objectPicker->requestPick(userEventManager->getCursorPosition());
+        }
+    }
+
+    // Sorted by: Opaque objects first, sorted by their shaderID, then coarsely front to back. Translucent objects
+    // second, sorted back to front by their distance to the camera.
     void EngineManager::depthSortNodes()
     {
-        const auto& cameraPos = getCamera()->getGlobalPosition();
-        std::sort(
-                m_sceneGeometry.begin(),
-                m_sceneGeometry.end(),
-                [cameraPos](const auto& a, const auto& b)
-                { return EngineManager::nodeSortingAlgorithm(a, b, cameraPos); }
-        );
+        // The global positions walk up the hierarchy, so the keys are computed once per node instead of per comparison
+        const glm::vec3 cameraPos = getCamera()->getGlobalPosition();
+        m_sortKeys.resize(m_sceneGeometry.size());
+        for(size_t i = 0; i < m_sceneGeometry.size(); i++)
+        {
+            const auto& node = m_sceneGeometry[i];
+            NodeSortKey& key = m_sortKeys[i];
+            key.index = i;
+            key.translucent = node->getIsTranslucent();
+
+            const float distance = glm::distance(node->getGlobalPosition(), cameraPos);
+            if(key.translucent)
+            {
+                key.program = 0;
+                key.depth = -distance;
+                continue;
+            }
+
+            // Buckets growing with the distance, nearby nodes keep a stable order instead of flipping every frame
+            key.program = node->getShader()->getShaderIdentifier().second;
+            key.depth = std::floor(std::log2(distance + 1.f) * OPAQUE_DEPTH_BUCKETS_PER_OCTAVE);
+        }
+        std::sort(m_sortKeys.begin(), m_sortKeys.end());
+
+        m_sortedGeometry.resize(m_sceneGeometry.size());
+        for(size_t i = 0; i < m_sortKeys.size(); i++)
+        {
+            m_sortedGeometry[i] = std::move(m_sceneGeometry[m_sortKeys[i].index]);
+        }
+        m_sceneGeometry.swap(m_sortedGeometry);
     }
 
-    // Sorted by: Opaque objects first, sorted by their shaderID. Translucent objects second, sorted by their distance to the camera.
-    bool EngineManager::nodeSortingAlgorithm(
-            const std::shared_ptr<GeometryComponent>& a,
-            const std::shared_ptr<GeometryComponent>& b,
-            const glm::vec3& cameraPosition
-    )
+    bool EngineManager::NodeSortKey::operator<(const NodeSortKey& other) const
     {
-        const auto& aTranslucency = a->getIsTranslucent();
-        if(aTranslucency != b->getIsTranslucent())
+        if(translucent != other.translucent)
         {
-            return !aTranslucency;
+            return !translucent;
         }
-        else if(!aTranslucency)
+        if(program != other.program)
         {
-            return a->getShader()->getShaderIdentifier().second < b->getShader()->getShaderIdentifier().second;
+            return program < other.program;
         }
+        return depth < other.depth;
+    }
+
+    void EngineManager::drawDepthPrePass()
+    {
+        RenderBackend& backend = RenderBackend::get();
+        backend.colorMask(false);
+
+        const auto drawDepth = [this](const std::shared_ptr<GeometryComponent>& node)
+        { getDepthShader(node)->renderVertices(node, m_camera.get()); };
+
+        m_prePassNodes.clear();
+        for(const auto& node : m_sceneGeometry)
+        {
+            if(node->getIsTranslucent())
+            {
+                break;
+            }
+
+            if(!getDepthShader(node))
+            {
+                continue;
+            }
 
-        const auto& distanceA = glm::distance(a->getGlobalPosition(), cameraPosition);
-        const auto& distanceB = glm::distance(b->getGlobalPosition(), cameraPosition);
+            if(m_occlusionCulling)
+            {
+                m_prePassNodes.push_back(node);
+                continue;
+            }
+            drawDepth(node);
+        }
 
-        return distanceA > distanceB;
+        // The culling happens here, the color pass draws the same nodes under the same conditions
+        if(m_occlusionCulling)
+        {
+            m_occlusionCuller->draw(m_prePassNodes.begin(), m_prePassNodes.end(), m_camera.get(), false, drawDepth);
+        }
+        backend.colorMask(true);
     }
 
     void EngineManager::drawOpaqueNodes()
     {
-        for(auto& node : m_sceneGeometry)
+        const auto opaqueEnd = std::find_if(
+                m_sceneGeometry.begin(),
+                m_sceneGeometry.end(),
+                [](const auto& node) { return node->getIsTranslucent(); }
+        );
+        const auto drawShaded = [this](const std::shared_ptr<GeometryComponent>& node) { drawShadedNode(node); };
+
+        if(!m_depthPrePass)
         {
-            if(node->getIsTranslucent())
+            if(m_occlusionCulling)
             {
+                m_occlusionCuller->draw(m_sceneGeometry.begin(), opaqueEnd, m_camera.get(), true, drawShaded);
                 return;
             }
 
-            drawNode(node);
+            std::for_each(m_sceneGeometry.begin(), opaqueEnd, drawShaded);
+            return;
+        }
+
+        // Only the fragments that won the pre-pass get shaded
+        RenderBackend& backend = RenderBackend::get();
+        backend.depthFunc(GL_EQUAL);
+        backend.depthMask(false);
+        if(m_occlusionCulling)
+        {
+            m_occlusionCuller->redraw(drawShaded);
+        }
+        else
+        {
+            for(auto it = m_sceneGeometry.begin(); it != opaqueEnd; ++it)
+            {
+                if(getDepthShader(*it))
+                {
+                    drawShadedNode(*it);
+                }
+            }
+        }
+        backend.depthFunc(GL_LESS);
+        backend.depthMask(true);
+
+        // Geometry the pre-pass skipped gets depth tested as usual
+        for(auto it = m_sceneGeometry.begin(); it != opaqueEnd; ++it)
+        {
+            if(!getDepthShader(*it))
+            {
+                drawShadedNode(*it);
+            }
         }
     }
 
+    void EngineManager::drawShadedNode(const std::shared_ptr<GeometryComponent>& node)
+    {
+        DepthShader* depthShader = m_showOverdraw ? getDepthShader(node) : nullptr;
+        if(depthShader)
+        {
+            depthShader->renderVertices(node, m_camera.get());
+            return;
+        }
+
+        drawNode(node);
+    }
+
+    DepthShader* EngineManager::getDepthShader(const std::shared_ptr<GeometryComponent>& node) const
+    {
+        // Instanced variants place their vertices with per instance matrices, those wouldn't match exactly
+        const auto& shader = node->getShader();
+        if(shader->hasFeature(SHADER_FEATURE_INSTANCED))
+        {
+            return nullptr;
+        }
+
+        return shader->hasFeature(SHADER_FEATURE_SKINNED) ? m_skinnedDepthShader.get() : m_depthShader.get();
+    }
+
     void EngineManager::drawTranslucentNodes()
     {
-        glEnable(GL_BLEND);
+        RenderBackend::get().enable(GL_BLEND);
         for(auto& node : m_sceneGeometry)
         {
             if(!node->getIsTranslucent())
@@ -162,7 +493,94 @@ namespace Engine
 
             node->depthSortTriangles();
 
-            drawNode(node);
+            drawShadedNode(node);
+        }
+    }
+
+    void EngineManager::updateCollisions()
+    {
+        // Every collider only writes its own body, the broadphase then runs once over all of them
+        SingletonManager::get<ThreadPool>()->parallelFor(
+                m_sceneColliders.size(),
+                [this](size_t begin, size_t end)
+                {
+                    for(size_t i = begin; i < end; i++)
+                    {
+                        m_sceneColliders[i]->syncCollisionBody();
+                    }
+                },
+                256
+        );
+
+        SingletonManager::get<CollisionWorld>()->update();
+    }
+
+    void EngineManager::animateSkeletons()
+    {
+        // Animators & skinned meshes are independent of each other, each one is a job of its own
+        const float deltaTime = getDeltaTime();
+        const auto& threadPool = SingletonManager::get<ThreadPool>();
+        threadPool->parallelFor(
+                m_sceneAnimators.size(),
+                [this, deltaTime](size_t begin, size_t end)
+                {
+                    for(size_t i = begin; i < end; i++)
+                    {
+                        m_sceneAnimators[i]->evaluate(deltaTime);
+                    }
+                },
+                1
+        );
+
+        // Meshes skinned on the GPU skip this, the CPU path splits its vertices over the pool as well
+        threadPool->parallelFor(
+                m_sceneSkinnedMeshes.size(),
+                [this](size_t begin, size_t end)
+                {
+                    for(size_t i = begin; i < end; i++)
+                    {
+                        m_sceneSkinnedMeshes[i]->skinVertices();
+                    }
+                },
+                1
+        );
+    }
+
+    void EngineManager::uploadSkinnedMeshes()
+    {
+        for(const auto& skinnedMesh : m_sceneSkinnedMeshes)
+        {
+            skinnedMesh->uploadSkinning();
+        }
+    }
+
+    void EngineManager::simulateParticles()
+    {
+        // Every emitter splits its particles over the ThreadPool itself
+        const float deltaTime = getDeltaTime();
+        for(const auto& emitter : m_sceneParticleEmitters)
+        {
+            emitter->simulate(deltaTime);
+        }
+    }
+
+    void EngineManager::drawParticles()
+    {
+        // Emitters are blended back to front as a whole, the particles within get sorted by the emitter
+        const glm::vec3 cameraPos = getCamera()->getGlobalPosition();
+        std::sort(
+                m_sceneParticleEmitters.begin(),
+                m_sceneParticleEmitters.end(),
+                [cameraPos](const auto& a, const auto& b)
+                {
+                    return glm::distance(a->getGlobalPosition(), cameraPos) >
+                           glm::distance(b->getGlobalPosition(), cameraPos);
+                }
+        );
+
+        for(const auto& emitter : m_sceneParticleEmitters)
+        {
+            m_particleShader->renderParticles(*emitter, m_camera.get());
         }
     }
 
@@ -194,11 +612,35 @@ namespace Engine
 
     void EngineManager::setScene(std::shared_ptr<BasicNode> sceneNode)
     {
+        // The old scene leaves with the next flush & its nodes get released over the following frames
         if(m_sceneNode)
         {
-            m_sceneNode->deleteAllChildren();
+            SingletonManager::get<NodeLifecycleQueue>()->queueDestroy(m_sceneNode);
         }
         m_sceneNode = std::move(sceneNode);
+        if(m_sceneNode)
+        {
+            // A scene built detached, e.g. by a factory of the SceneManager, gets registered in one bulk add.
+            // It is started by whoever set the scene, once it is current.
+            std::vector<std::shared_ptr<BasicNode>> nodes;
+            m_sceneNode->collectDetachedNodes(nodes);
+            addNodesToScene(nodes);
+        }
+
+        // Render settings belong to the scene, the new one starts from the defaults
+        m_depthPrePass = false;
+        setOcclusionCulling(false);
+        m_objectPicker->reset();
+    }
+
+    void EngineManager::setOcclusionCulling(bool occlusionCulling)
+    {
+        // Results of an earlier run would be stale by now
+        if(!occlusionCulling)
+        {
+            m_occlusionCuller->reset();
+        }
+        m_occlusionCulling = occlusionCulling;
     }
 
     void EngineManager::setDeltaTime()
@@ -230,61 +672,114 @@ namespace Engine
         m_clearColor[2] = color[2];
         m_clearColor[3] = color[3];
 
-        glClearColor(m_clearColor[0], m_clearColor[1], m_clearColor[2], m_clearColor[3]);
+        RenderBackend::get().clearColor(glm::vec4(m_clearColor[0], m_clearColor[1], m_clearColor[2], m_clearColor[3]));
     }
 
-    void EngineManager::addGeometryToScene(std::shared_ptr<GeometryComponent>& node)
+    void EngineManager::addNodeToScene(const std::shared_ptr<BasicNode>& node)
     {
-        node->awake();
-        m_sceneGeometry.emplace_back(node);
+        m_sceneIndex->add(node);
+
+        if(auto geometry = std::dynamic_pointer_cast<GeometryComponent>(node))
+        {
+            addGeometryToScene(geometry);
+        }
+        else if(auto emitter = std::dynamic_pointer_cast<ParticleEmitter>(node))
+        {
+            addParticleEmitterToScene(emitter);
+        }
+        else if(auto animator = std::dynamic_pointer_cast<SkeletalAnimator>(node))
+        {
+            addSkeletalAnimatorToScene(animator);
+        }
+        else if(auto debugUi = std::dynamic_pointer_cast<Ui::UiDebugWindow>(node))
+        {
+            addDebugUiToScene(debugUi);
+        }
+
+        // Not part of the chain above, a collider is usually also geometry
+        if(auto collider = std::dynamic_pointer_cast<ColliderComponent>(node))
+        {
+            addColliderToScene(collider);
+        }
     }
 
-    void EngineManager::removeGeometryFromScene(const unsigned int& nodeId)
+    void EngineManager::addNodesToScene(const std::vector<std::shared_ptr<BasicNode>>& nodes)
     {
-        m_sceneGeometry.erase(
-                std::remove_if(
-                        m_sceneGeometry.begin(),
-                        m_sceneGeometry.end(),
-                        [nodeId](const auto& childNode) -> bool { return childNode->getNodeId() == nodeId; }
-                ),
-                m_sceneGeometry.end()
-        );
+        // Bulk adds are mostly geometry, like the tiles of an island. Still grown geometrically, addChild adds
+        // every single node through here as well
+        const size_t geometryCount = m_sceneGeometry.size() + nodes.size();
+        if(geometryCount > m_sceneGeometry.capacity())
+        {
+            m_sceneGeometry.reserve(std::max(geometryCount, m_sceneGeometry.capacity() * 2));
+        }
+        m_sceneIndex->reserve(m_sceneIndex->getCount() + nodes.size());
+        for(const auto& node : nodes)
+        {
+            addNodeToScene(node);
+        }
     }
 
-    void EngineManager::removeGeometryFromScene(Engine::BasicNode* node)
+    void EngineManager::removeNodesFromScene(const std::unordered_set<unsigned int>& nodeIds)
     {
-        removeGeometryFromScene(node->getNodeId());
+        if(nodeIds.empty())
+        {
+            return;
+        }
+
+        m_sceneIndex->remove(nodeIds);
+
+        const auto isRemoved = [&nodeIds](const auto& node) -> bool { return nodeIds.contains(node->getNodeId()); };
+        std::erase_if(m_sceneGeometry, isRemoved);
+        std::erase_if(m_sceneSkinnedMeshes, isRemoved);
+        std::erase_if(m_sceneAnimators, isRemoved);
+        std::erase_if(m_sceneParticleEmitters, isRemoved);
+        std::erase_if(m_sceneDebugUi, isRemoved);
+        std::erase_if(
+                m_sceneColliders,
+                [&nodeIds](const auto& collider) -> bool
+                {
+                    if(!nodeIds.contains(collider->getNodeId()))
+                    {
+                        return false;
+                    }
+                    collider->destroyCollisionBody();
+                    return true;
+                }
+        );
     }
 
-    void EngineManager::removeGeometryFromScene(std::shared_ptr<BasicNode>& node)
+    void EngineManager::addGeometryToScene(std::shared_ptr<GeometryComponent>& node)
     {
-        removeGeometryFromScene(node->getNodeId());
+        node->awake();
+        m_sceneGeometry.emplace_back(node);
+
+        if(auto skinnedMesh = std::dynamic_pointer_cast<SkinnedMeshComponent>(node))
+        {
+            m_sceneSkinnedMeshes.emplace_back(std::move(skinnedMesh));
+        }
     }
 
-    void EngineManager::removeGeometryFromScene(std::shared_ptr<GeometryComponent>& node)
+    void EngineManager::addParticleEmitterToScene(std::shared_ptr<ParticleEmitter>& node)
     {
-        removeGeometryFromScene(node->getNodeId());
+        node->awake();
+        m_sceneParticleEmitters.emplace_back(node);
     }
 
-    void EngineManager::addDebugUiToScene(std::shared_ptr<Ui::UiDebugWindow>& node)
+    void EngineManager::addSkeletalAnimatorToScene(std::shared_ptr<SkeletalAnimator>& node)
     {
-        m_sceneDebugUi.emplace_back(node);
+        node->awake();
+        m_sceneAnimators.emplace_back(node);
     }
 
-    void EngineManager::removeDebugUiFromScene(std::shared_ptr<Ui::UiDebugWindow>& node)
+    void EngineManager::addColliderToScene(std::shared_ptr<ColliderComponent>& node)
     {
-        removeDebugUiFromScene(node->getNodeId());
+        // Colliders are usually geometry as well, awake was already called when that got added
+        node->createCollisionBody();
+        m_sceneColliders.emplace_back(node);
     }
 
-    void EngineManager::removeDebugUiFromScene(const unsigned int& nodeId)
+    void EngineManager::addDebugUiToScene(std::shared_ptr<Ui::UiDebugWindow>& node)
     {
-        m_sceneDebugUi.erase(
-                std::remove_if(
-                        m_sceneDebugUi.begin(),
-                        m_sceneDebugUi.end(),
-                        [nodeId](const auto& childNode) -> bool { return childNode->getNodeId() == nodeId; }
-                ),
-                m_sceneDebugUi.end()
-        );
+        m_sceneDebugUi.emplace_back(node);
     }
 } // namespace Engine
\ No newline at end of file
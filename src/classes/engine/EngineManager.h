@@ -2,17 +2,30 @@
 
 #include "../SingletonManager.h"
 
+#include <glm/vec2.hpp>
 #include <glm/vec3.hpp>
 #include <glm/vec4.hpp>
+#include <unordered_set>
 #include <vector>
 
 namespace Engine
 {
     class BasicNode;
+    class DynamicResolution;
+    class RenderGraph;
     class RenderManager;
     class CameraComponent;
+    class ColliderComponent;
+    class DepthShader;
     class GeometryComponent;
     class GridShader;
+    class ObjectPicker;
+    class OcclusionCuller;
+    class ParticleEmitter;
+    class ParticleShader;
+    class SceneIndex;
+    class SkeletalAnimator;
+    class SkinnedMeshComponent;
 
     namespace Ui
     {
@@ -30,8 +43,20 @@ namespace Engine
             void engineDraw();
             void engineLateUpdate();
 
+            /**
+             * @brief Renders the scene without the debug UI, engineDraw() calls it with the size of the window.
+             * The passes are declared to the RenderGraph, passes that aren't needed this frame don't get added.
+             * Only goes through the RenderBackend, so it runs without a window as well.
+             */
+            void drawScene(const glm::ivec2& framebufferSize, int samples);
+
             void drawNode(const std::shared_ptr<GeometryComponent>& node);
 
+            /**
+             * @brief Replaces the scene root, the old scene gets destroyed through the NodeLifecycleQueue. Use the
+             * SceneManager to build a scene in the background & switch without a hitch. Nodes the scene got through
+             * addChildDetached are registered in one bulk add, the caller starts the scene with startSubtree.
+             */
             void setScene(std::shared_ptr<BasicNode> sceneNode);
 
             std::shared_ptr<BasicNode> getScene() const { return m_sceneNode; };
@@ -42,6 +67,13 @@ namespace Engine
 
             std::shared_ptr<RenderManager> getRenderManager() const { return m_renderManager; };
 
+            std::shared_ptr<DynamicResolution> getDynamicResolution() const { return m_dynamicResolution; };
+
+            /**
+             * @brief The graph the scene passes get added to every frame.
+             */
+            std::shared_ptr<RenderGraph> getRenderGraph() const { return m_renderGraph; };
+
             void setDeltaTime();
             float getDeltaTime() const;
 
@@ -57,39 +89,146 @@ namespace Engine
 
             void setGridVisibility(bool showGrid) { m_showGrid = showGrid; };
 
+            bool isDepthPrePassEnabled() const { return m_depthPrePass; };
+
+            /**
+             * @brief Lays down the depth of all opaque geometry first, so only its visible fragments get shaded.
+             * Pays off for scenes with expensive fragment shaders & lots of overdraw. Every new scene starts
+             * without it, a scene opts in from its start().
+             */
+            void setDepthPrePass(bool depthPrePass) { m_depthPrePass = depthPrePass; };
+
+            bool isOverdrawViewEnabled() const { return m_showOverdraw; };
+
+            /**
+             * @brief Draws all geometry additively in a single color instead, brighter pixels got shaded more often.
+             */
+            void setOverdrawView(bool showOverdraw) { m_showOverdraw = showOverdraw; };
+
+            bool isOcclusionCullingEnabled() const { return m_occlusionCulling; };
+
+            /**
+             * @brief Skips opaque geometry hidden behind other geometry with GPU occlusion queries. Pays off for
+             * scenes with large occluders, hidden nodes still cost a draw call but no fragments.
+             */
+            void setOcclusionCulling(bool occlusionCulling);
+
+            std::shared_ptr<OcclusionCuller> getOcclusionCuller() const { return m_occlusionCuller; };
+
+            /**
+             * @brief Picks nodes under a pixel on the GPU. Clicks into the scene get picked & handed to the pick
+             * listeners of the UserEventManager on their own, requests can be made directly as well.
+             */
+            std::shared_ptr<ObjectPicker> getObjectPicker() const { return m_objectPicker; };
+
+            /**
+             * @brief Finds nodes of the scene by ID & by name without walking the scene graph.
+             */
+            std::shared_ptr<SceneIndex> getSceneIndex() const { return m_sceneIndex; };
+
+            /**
+             * @brief Registers the node with every scene registry matching its components & with the SceneIndex.
+             */
+            void addNodeToScene(const std::shared_ptr<BasicNode>& node);
+
+            /**
+             * @brief Registers many nodes at once, used for queued adds.
+             */
+            void addNodesToScene(const std::vector<std::shared_ptr<BasicNode>>& nodes);
+
+            /**
+             * @brief Removes all given nodes from every scene registry, with a single pass per registry.
+             */
+            void removeNodesFromScene(const std::unordered_set<unsigned int>& nodeIds);
+
             void addGeometryToScene(std::shared_ptr<GeometryComponent>& node);
-            void removeGeometryFromScene(std::shared_ptr<GeometryComponent>& node);
-            void removeGeometryFromScene(std::shared_ptr<BasicNode>& node);
-            void removeGeometryFromScene(BasicNode* node);
-            void removeGeometryFromScene(const unsigned int& nodeId);
+
+            void addParticleEmitterToScene(std::shared_ptr<ParticleEmitter>& node);
+
+            void addSkeletalAnimatorToScene(std::shared_ptr<SkeletalAnimator>& node);
+
+            void addColliderToScene(std::shared_ptr<ColliderComponent>& node);
 
             void addDebugUiToScene(std::shared_ptr<Ui::UiDebugWindow>& node);
-            void removeDebugUiFromScene(std::shared_ptr<Ui::UiDebugWindow>& node);
-            void removeDebugUiFromScene(const unsigned int& nodeId);
 
         private:
+            /**
+             * @brief Hands finished picks to the pick listeners & requests a pick for a click into the scene.
+             */
+            void processPicking();
+
             void depthSortNodes();
 
+            void drawDepthPrePass();
+
             void drawOpaqueNodes();
 
             void drawTranslucentNodes();
 
+            void updateCollisions();
+
+            void animateSkeletons();
+
+            void uploadSkinnedMeshes();
+
+            void simulateParticles();
+
+            void drawParticles();
+
             void drawUiNodes();
 
-            static bool nodeSortingAlgorithm(
-                    const std::shared_ptr<GeometryComponent>& a,
-                    const std::shared_ptr<GeometryComponent>& b,
-                    const glm::vec3& cameraPosition
-            );
+            void drawShadedNode(const std::shared_ptr<GeometryComponent>& node);
+
+            /**
+             * @return The depth shader variant for the nodes shader, nullptr if the node can't be part of the
+             * depth pre-pass.
+             */
+            DepthShader* getDepthShader(const std::shared_ptr<GeometryComponent>& node) const;
+
+            /**
+             * @brief What the scene geometry gets sorted by, computed once per node & frame.
+             */
+            struct NodeSortKey
+            {
+                    bool translucent = false;
+                    unsigned int program = 0;
+                    // The distance bucket for opaque nodes, the negative distance for translucent ones
+                    float depth = 0.f;
+                    size_t index = 0;
+
+                    bool operator<(const NodeSortKey& other) const;
+            };
 
             std::vector<std::shared_ptr<GeometryComponent>> m_sceneGeometry;
+            std::vector<std::shared_ptr<SkinnedMeshComponent>> m_sceneSkinnedMeshes;
+            std::vector<std::shared_ptr<SkeletalAnimator>> m_sceneAnimators;
+            std::vector<std::shared_ptr<ParticleEmitter>> m_sceneParticleEmitters;
+            std::vector<std::shared_ptr<ColliderComponent>> m_sceneColliders;
             std::vector<std::shared_ptr<Ui::UiDebugWindow>> m_sceneDebugUi;
             std::shared_ptr<RenderManager> m_renderManager;
             std::shared_ptr<BasicNode> m_sceneNode;
             std::shared_ptr<CameraComponent> m_camera;
             std::shared_ptr<GridShader> m_gridShader;
+            std::shared_ptr<ParticleShader> m_particleShader;
+            std::shared_ptr<DepthShader> m_depthShader;
+            std::shared_ptr<DepthShader> m_skinnedDepthShader;
+            std::shared_ptr<DynamicResolution> m_dynamicResolution;
+            std::shared_ptr<RenderGraph> m_renderGraph;
+            std::shared_ptr<OcclusionCuller> m_occlusionCuller;
+            std::shared_ptr<ObjectPicker> m_objectPicker;
+            std::shared_ptr<SceneIndex> m_sceneIndex;
+
+            // The opaque nodes the depth pre-pass culls, rebuilt every frame
+            std::vector<std::shared_ptr<GeometryComponent>> m_prePassNodes;
+
+            // Scratch space of depthSortNodes, kept to not allocate every frame
+            std::vector<NodeSortKey> m_sortKeys;
+            std::vector<std::shared_ptr<GeometryComponent>> m_sortedGeometry;
 
             bool m_showGrid;
+            bool m_depthPrePass;
+            bool m_showOverdraw;
+            bool m_occlusionCulling;
             double m_deltaTime;
             double m_currentFrameTimestamp;
             double m_lastFrameTimestamp;
@@ -97,6 +236,9 @@ namespace Engine
             int m_fpsCount;
             int m_frames;
             float m_clearColor[4];
+
+            // Quarter octaves of camera distance, coarse enough to keep the shader buckets together
+            static constexpr float OPAQUE_DEPTH_BUCKETS_PER_OCTAVE = 4.f;
     };
 
 } // namespace Engine
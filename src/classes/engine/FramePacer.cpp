@@ -0,0 +1,181 @@
+#include "FramePacer.h"
+
+#include "WindowManager.h"
+#include "rendering/backend/RenderBackend.h"
+
+#include <algorithm>
+#include <thread>
+
+#include <GLFW/glfw3.h>
+
+using namespace Engine;
+
+namespace
+{
+    void smooth(double& average, double value, double smoothing) { average += (value - average) * smoothing; }
+} // namespace
+
+FramePacer::FramePacer()
+    : m_startTime(Clock::now())
+    , m_lowLatency(false)
+    , m_refreshIntervalMs(1000.0 / DEFAULT_REFRESH_RATE)
+    , m_lastPollMs(0.0)
+    , m_lastGpuDoneMs(-1.0)
+{
+}
+
+FramePacer::~FramePacer()
+{
+    RenderBackend& backend = RenderBackend::get();
+    for(const FrameRecord& frame : m_framesInFlight)
+    {
+        backend.deleteFence(frame.fence);
+        backend.deleteQuery(frame.query);
+    }
+    for(const GLuint query : m_freeQueries)
+    {
+        backend.deleteQuery(query);
+    }
+}
+
+void FramePacer::beginFrame()
+{
+    collectFinishedFrames();
+
+    if(m_lowLatency)
+    {
+        waitForFramesInFlight();
+        sleepUntilDeadline();
+        pollEvents();
+    }
+
+    m_frame = FrameRecord();
+    m_frame.startMs = getElapsedMs();
+    m_frame.pollMs = m_lastPollMs;
+}
+
+void FramePacer::endFrame()
+{
+    RenderBackend& backend = RenderBackend::get();
+    m_frame.swapMs = getElapsedMs();
+
+    if(m_frame.inputMs >= 0.0)
+    {
+        smooth(m_stats.inputToSwapMs, m_frame.swapMs - m_frame.inputMs, SMOOTHING);
+    }
+
+    if(m_freeQueries.empty())
+    {
+        m_freeQueries.push_back(backend.createQuery());
+    }
+    m_frame.query = m_freeQueries.back();
+    m_freeQueries.pop_back();
+
+    backend.queryTimestamp(m_frame.query);
+    m_frame.fence = backend.createFence();
+    m_frame.gpuOffsetMs = getElapsedMs() - double(backend.getTimestamp()) / 1e6;
+
+    m_framesInFlight.push_back(m_frame);
+    m_stats.framesInFlight = m_framesInFlight.size();
+}
+
+void FramePacer::pollEvents()
+{
+    glfwPollEvents();
+    m_lastPollMs = getElapsedMs();
+}
+
+void FramePacer::markInput()
+{
+    if(m_frame.inputMs < 0.0)
+    {
+        m_frame.inputMs = m_lastPollMs;
+    }
+}
+
+void FramePacer::setLowLatency(bool lowLatency)
+{
+    m_lowLatency = lowLatency;
+
+    GLFWmonitor* monitor = glfwGetPrimaryMonitor();
+    const GLFWvidmode* mode = monitor ? glfwGetVideoMode(monitor) : nullptr;
+    m_refreshIntervalMs = 1000.0 / (mode && mode->refreshRate > 0 ? double(mode->refreshRate) : DEFAULT_REFRESH_RATE);
+}
+
+void FramePacer::collectFinishedFrames()
+{
+    RenderBackend& backend = RenderBackend::get();
+    while(!m_framesInFlight.empty())
+    {
+        const FrameRecord& frame = m_framesInFlight.front();
+
+        // The query was issued before the fence, its result is there once the fence is signaled
+        GLuint64 timestampNs = 0;
+        if(!backend.isFenceSignaled(frame.fence) || !backend.getQueryResult(frame.query, timestampNs))
+        {
+            break;
+        }
+
+        const double gpuDoneMs = double(timestampNs) / 1e6 + frame.gpuOffsetMs;
+        smooth(m_stats.pollToGpuMs, gpuDoneMs - frame.pollMs, SMOOTHING);
+        if(frame.inputMs >= 0.0)
+        {
+            smooth(m_stats.inputToGpuMs, gpuDoneMs - frame.inputMs, SMOOTHING);
+            m_stats.inputSamples++;
+        }
+        m_lastGpuDoneMs = std::max(m_lastGpuDoneMs, gpuDoneMs);
+
+        backend.deleteFence(frame.fence);
+        m_freeQueries.push_back(frame.query);
+        m_framesInFlight.erase(m_framesInFlight.begin());
+    }
+
+    m_stats.framesInFlight = m_framesInFlight.size();
+}
+
+void FramePacer::waitForFramesInFlight()
+{
+    RenderBackend& backend = RenderBackend::get();
+    while(m_framesInFlight.size() >= MAX_FRAMES_IN_FLIGHT)
+    {
+        const size_t framesInFlight = m_framesInFlight.size();
+        if(!backend.waitFence(m_framesInFlight.front().fence, FENCE_TIMEOUT_NS))
+        {
+            break;
+        }
+
+        collectFinishedFrames();
+        if(m_framesInFlight.size() == framesInFlight)
+        {
+            break;
+        }
+    }
+}
+
+void FramePacer::sleepUntilDeadline()
+{
+    // Without v-sync there is no refresh to make, starting right away is the lowest latency
+    if(m_lastGpuDoneMs < 0.0 || !SingletonManager::get<WindowManager>()->getVsync())
+    {
+        return;
+    }
+
+    // With a single frame in flight the last one finished around the refresh it was shown with, so the next one
+    // is due a refresh interval later & the frame needs about as long as its predecessors did from their poll
+    const double deadlineMs = m_lastGpuDoneMs + m_refreshIntervalMs;
+    const double wakeMs = deadlineMs - m_stats.pollToGpuMs - DEADLINE_MARGIN_MS;
+    const double sleepMs = std::min(wakeMs - getElapsedMs(), m_refreshIntervalMs);
+    if(sleepMs <= 0.0)
+    {
+        smooth(m_stats.sleepMs, 0.0, SMOOTHING);
+        return;
+    }
+
+    std::this_thread::sleep_for(std::chrono::duration<double, std::milli>(sleepMs));
+    smooth(m_stats.sleepMs, sleepMs, SMOOTHING);
+}
+
+double FramePacer::getElapsedMs() const
+{
+    return std::chrono::duration<double, std::milli>(Clock::now() - m_startTime).count();
+}
@@ -0,0 +1,121 @@
+#pragma once
+
+#include "../SingletonManager.h"
+
+#include <chrono>
+#include <cstddef>
+#include <vector>
+
+#include <GL/glew.h>
+
+namespace Engine
+{
+    /**
+     * @brief Smoothed latencies in milliseconds.
+     */
+    struct LatencyStats
+    {
+            // From the poll delivering an input to the swap of the frame reacting to it
+            double inputToSwapMs = 0.0;
+            // From the poll delivering an input to the GPU finishing the frame reacting to it
+            double inputToGpuMs = 0.0;
+            // From the poll of every frame to the GPU finishing it, what an input right before the poll would see
+            double pollToGpuMs = 0.0;
+            // Slept before a frame in the low latency mode
+            double sleepMs = 0.0;
+            size_t inputSamples = 0;
+            size_t framesInFlight = 0;
+    };
+
+    /**
+     * @brief Measures the latency from input to the finished frame & optionally paces frames for low latency.
+     *
+     * Every frame gets a timestamp query & a fence after its swap, finished frames are collected without waiting.
+     * GPU timestamps are related to the CPU clock when the frame ends. The display still adds up to a refresh
+     * interval & the scan-out on top of what gets measured.
+     *
+     * The low latency mode polls the events right before the frame instead of after the last one, waits for the
+     * previous frame on the GPU instead of letting the driver queue frames ahead & with v-sync sleeps before the
+     * frame, so it starts as late as it can while still making the next refresh.
+     */
+    class FramePacer : public SingletonBase
+    {
+        public:
+            using Clock = std::chrono::steady_clock;
+
+            FramePacer();
+            ~FramePacer();
+
+            /**
+             * @brief Called before anything of the frame. In the low latency mode waits for the previous frame,
+             * sleeps up to the deadline & polls the events.
+             */
+            void beginFrame();
+
+            /**
+             * @brief Called right after the swap.
+             */
+            void endFrame();
+
+            /**
+             * @brief Polls the window events. Only to be called by the main loop when not in the low latency mode,
+             * beginFrame() polls them otherwise.
+             */
+            void pollEvents();
+
+            /**
+             * @brief Marks the frame as reacting to an input, which arrived with the last poll.
+             */
+            void markInput();
+
+            bool isLowLatencyEnabled() const { return m_lowLatency; };
+
+            void setLowLatency(bool lowLatency);
+
+            const LatencyStats& getStats() const { return m_stats; };
+
+        private:
+            struct FrameRecord
+            {
+                    double startMs = 0.0;
+                    double pollMs = 0.0;
+                    // Negative without input
+                    double inputMs = -1.0;
+                    double swapMs = 0.0;
+                    // CPU minus GPU clock when the frame ended
+                    double gpuOffsetMs = 0.0;
+                    GLuint query = 0;
+                    GLsync fence = nullptr;
+            };
+
+            /**
+             * @brief Takes the finished frames off the front of the frames in flight without waiting.
+             */
+            void collectFinishedFrames();
+            void waitForFramesInFlight();
+            void sleepUntilDeadline();
+            double getElapsedMs() const;
+
+            Clock::time_point m_startTime;
+            bool m_lowLatency;
+            double m_refreshIntervalMs;
+            double m_lastPollMs;
+            // When the GPU finished the last collected frame, negative before the first one
+            double m_lastGpuDoneMs;
+
+            FrameRecord m_frame;
+            // Oldest first
+            std::vector<FrameRecord> m_framesInFlight;
+            std::vector<GLuint> m_freeQueries;
+
+            LatencyStats m_stats;
+
+            static constexpr double SMOOTHING = 0.1;
+            static constexpr double DEFAULT_REFRESH_RATE = 60.0;
+            // Sleep & timer slack the deadline leaves room for
+            static constexpr double DEADLINE_MARGIN_MS = 1.5;
+            // The low latency mode lets no frame get queued behind the one on the GPU
+            static constexpr size_t MAX_FRAMES_IN_FLIGHT = 1;
+            static constexpr GLuint64 FENCE_TIMEOUT_NS = 100'000'000;
+    };
+} // namespace Engine
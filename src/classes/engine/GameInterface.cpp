@@ -3,6 +3,8 @@
 
 #include "../nodeComponents/BasicNode.h"
 #include "EngineManager.h"
+#include "FramePacer.h"
+#include "StartupOrchestrator.h"
 #include "UserEventManager.h"
 #include "WindowEventCallbackHelper.h"
 #include "WindowManager.h"
@@ -13,21 +15,33 @@
 
 namespace Engine
 {
-    GameInterface::GameInterface() { SingletonManager::get<WindowManager>()->startWindow(); }
+    GameInterface::GameInterface()
+    {
+        // Assets queued with the StartupOrchestrator before are prepared on the ThreadPool meanwhile
+        SingletonManager::get<StartupOrchestrator>()->createContext();
+    }
 
     int GameInterface::startGame()
     {
+        const std::shared_ptr<StartupOrchestrator>& startup = SingletonManager::get<StartupOrchestrator>();
         const std::shared_ptr<EngineManager>& engineManager = SingletonManager::get<EngineManager>();
+
+        const size_t startPhase = startup->beginPhase("Scene start");
         if(!engineManager->engineStart())
         {
             return 1;
         }
+        startup->endPhase(startPhase);
 
         const std::shared_ptr<UserEventManager>& userEventManager = SingletonManager::get<UserEventManager>();
         const std::shared_ptr<WindowManager>& windowManager = SingletonManager::get<WindowManager>();
+        const std::shared_ptr<FramePacer>& framePacer = SingletonManager::get<FramePacer>();
 
         do
         {
+            // The low latency mode polls the events here, as close to the frame as it gets
+            framePacer->beginFrame();
+
             ImGui_ImplOpenGL3_NewFrame();
             ImGui_ImplGlfw_NewFrame();
             ImGui::NewFrame();
@@ -39,10 +53,15 @@ namespace Engine
             ImGui::Render();
             ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
             glfwSwapBuffers(windowManager->getWindow());
+            framePacer->endFrame();
+            startup->finishFirstFrame();
 
             engineManager->engineLateUpdate();
 
-            glfwPollEvents();
+            if(!framePacer->isLowLatencyEnabled())
+            {
+                framePacer->pollEvents();
+            }
 
             engineManager->setDeltaTime();
         } while(userEventManager->getUserEvent(GLFW_KEY_ESCAPE) != GLFW_PRESS &&
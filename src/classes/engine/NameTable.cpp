@@ -0,0 +1,71 @@
+#include "NameTable.h"
+
+#include <mutex>
+
+using namespace Engine;
+
+NameId NameTable::intern(std::string_view name)
+{
+    if(name.empty())
+    {
+        return EMPTY;
+    }
+
+    Table& table = getTable();
+    {
+        std::shared_lock lock(table.mutex);
+        const auto it = table.ids.find(name);
+        if(it != table.ids.end())
+        {
+            return it->second;
+        }
+    }
+
+    // Another thread may have added it between the locks
+    std::unique_lock lock(table.mutex);
+    const auto it = table.ids.find(name);
+    if(it != table.ids.end())
+    {
+        return it->second;
+    }
+
+    const NameId id = NameId(table.strings.size());
+    table.strings.emplace_back(name);
+    table.ids.emplace(table.strings.back(), id);
+    return id;
+}
+
+NameId NameTable::find(std::string_view name)
+{
+    Table& table = getTable();
+    std::shared_lock lock(table.mutex);
+    const auto it = table.ids.find(name);
+    return it != table.ids.end() ? it->second : EMPTY;
+}
+
+const std::string& NameTable::getString(NameId id)
+{
+    Table& table = getTable();
+    std::shared_lock lock(table.mutex);
+    return id < table.strings.size() ? table.strings[id] : table.strings[EMPTY];
+}
+
+size_t NameTable::getCount()
+{
+    Table& table = getTable();
+    std::shared_lock lock(table.mutex);
+    return table.strings.size();
+}
+
+NameTable::Table& NameTable::getTable()
+{
+    // Never destroyed, nodes still print their names while the singletons holding them go away at exit
+    static Table* table = []()
+    {
+        auto* newTable = new Table();
+        newTable->strings.emplace_back();
+        newTable->ids.emplace(newTable->strings.back(), EMPTY);
+        return newTable;
+    }();
+    return *table;
+}
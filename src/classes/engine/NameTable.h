@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace Engine
+{
+    using NameId = uint32_t;
+
+    /**
+     * @brief Interns strings as 32 bit ids, for names that get compared & looked up far more often than they are set.
+     *
+     * Every distinct string is stored once & never released, so ids stay valid for the whole run & the references
+     * returned by getString never dangle. Id 0 is the empty string. Safe to use from every thread, scenes get built
+     * on the ThreadPool.
+     */
+    class NameTable
+    {
+        public:
+            static constexpr NameId EMPTY = 0;
+
+            /**
+             * @return The id of the name, which gets added to the table if it wasn't interned yet.
+             */
+            static NameId intern(std::string_view name);
+
+            /**
+             * @return The id of the name or EMPTY if it was never interned, without adding it.
+             */
+            static NameId find(std::string_view name);
+
+            static const std::string& getString(NameId id);
+
+            static size_t getCount();
+
+        private:
+            struct Table
+            {
+                    std::shared_mutex mutex;
+                    // A deque never moves its strings, the views used as keys stay valid
+                    std::deque<std::string> strings;
+                    std::unordered_map<std::string_view, NameId> ids;
+            };
+
+            static Table& getTable();
+    };
+} // namespace Engine
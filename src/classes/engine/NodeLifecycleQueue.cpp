@@ -0,0 +1,130 @@
+#include "NodeLifecycleQueue.h"
+
+#include "../nodeComponents/BasicNode.h"
+#include "EngineManager.h"
+
+#include <algorithm>
+#include <unordered_set>
+
+using namespace Engine;
+
+NodeLifecycleQueue::NodeLifecycleQueue() : m_destroyBudget(DEFAULT_DESTROY_BUDGET) {}
+
+void NodeLifecycleQueue::queueAddChild(const std::shared_ptr<BasicNode>& parent, const std::shared_ptr<BasicNode>& node)
+{
+    node->setParent(parent);
+    m_pendingAdds.push_back({ parent, node });
+}
+
+void NodeLifecycleQueue::queueDestroy(const std::shared_ptr<BasicNode>& node) { m_pendingDestroys.push_back(node); }
+
+void NodeLifecycleQueue::flush()
+{
+    // Adds first, a node added & destroyed in the same frame then gets removed like any other
+    applyAdds();
+    applyDestroys();
+}
+
+void NodeLifecycleQueue::applyAdds()
+{
+    if(m_pendingAdds.empty())
+    {
+        return;
+    }
+
+    std::vector<PendingAdd> adds;
+    adds.swap(m_pendingAdds);
+
+    std::vector<std::shared_ptr<BasicNode>> added;
+    std::vector<std::shared_ptr<BasicNode>> roots;
+    added.reserve(adds.size());
+    roots.reserve(adds.size());
+    for(PendingAdd& add : adds)
+    {
+        // The parent may have been destroyed while the add was queued, the node goes with it
+        const std::shared_ptr<BasicNode> parent = add.parent.lock();
+        if(!parent)
+        {
+            continue;
+        }
+
+        // Subtrees built detached join with their root
+        parent->m_childNodes.push_back(add.node);
+        add.node->collectDetachedNodes(added);
+        roots.push_back(std::move(add.node));
+    }
+
+    SingletonManager::get<EngineManager>()->addNodesToScene(added);
+
+    for(const auto& root : roots)
+    {
+        root->startSubtree();
+    }
+}
+
+void NodeLifecycleQueue::applyDestroys()
+{
+    if(m_pendingDestroys.empty())
+    {
+        return;
+    }
+
+    std::vector<std::shared_ptr<BasicNode>> destroys;
+    destroys.swap(m_pendingDestroys);
+
+    std::unordered_set<unsigned int> rootIds;
+    std::unordered_set<unsigned int> subtreeIds;
+    std::vector<std::shared_ptr<BasicNode>> parents;
+    std::vector<std::shared_ptr<BasicNode>> roots;
+    for(auto& node : destroys)
+    {
+        // A node queued twice would be released twice
+        if(!rootIds.insert(node->getNodeId()).second)
+        {
+            continue;
+        }
+
+        if(auto parent = node->getParentNode())
+        {
+            parents.push_back(std::move(parent));
+        }
+        node->setParent(nullptr);
+        node->callOnAllChildrenRecursiveAndSelf([&subtreeIds](BasicNode* child) { subtreeIds.insert(child->getNodeId()); });
+        roots.push_back(std::move(node));
+    }
+
+    // Every parent loses all its destroyed children in one pass, instead of one search per child
+    std::sort(parents.begin(), parents.end());
+    parents.erase(std::unique(parents.begin(), parents.end()), parents.end());
+    for(const auto& parent : parents)
+    {
+        std::erase_if(
+                parent->m_childNodes,
+                [&rootIds](const std::shared_ptr<BasicNode>& child) { return rootIds.contains(child->getNodeId()); }
+        );
+    }
+
+    SingletonManager::get<EngineManager>()->removeNodesFromScene(subtreeIds);
+
+    m_pendingReleases.insert(m_pendingReleases.end(), roots.begin(), roots.end());
+}
+
+void NodeLifecycleQueue::releaseDestroyed()
+{
+    size_t released = 0;
+    while(released < m_destroyBudget && !m_pendingReleases.empty())
+    {
+        std::shared_ptr<BasicNode> node = std::move(m_pendingReleases.back());
+        m_pendingReleases.pop_back();
+
+        // Children are released on their own, otherwise the whole subtree would go with its root at once
+        for(auto& child : node->m_childNodes)
+        {
+            m_pendingReleases.push_back(std::move(child));
+        }
+        node->m_childNodes.clear();
+
+        node.reset();
+        released++;
+    }
+}
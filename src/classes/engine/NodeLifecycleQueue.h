@@ -0,0 +1,78 @@
+#pragma once
+
+#include "../SingletonManager.h"
+
+#include <memory>
+#include <vector>
+
+namespace Engine
+{
+    class BasicNode;
+
+    /**
+     * @brief Buffers adding & destroying nodes, so thousands of them don't each pay for registering with the engine.
+     *
+     * Queued changes get applied together by the EngineManager at the start of the next update: adds first, every
+     * added node gets registered, awoken & started in one pass, then destroyed subtrees get detached & removed from
+     * all scene registries with a single pass per registry. The nodes of destroyed subtrees are released over the
+     * following frames, at most the destroy budget per frame, so destructors & freeing memory don't cause a hitch.
+     */
+    class NodeLifecycleQueue : public SingletonBase
+    {
+        public:
+            NodeLifecycleQueue();
+            ~NodeLifecycleQueue() = default;
+
+            /**
+             * @brief Queues adding a node as child of the parent. The parent is set right away, so the global
+             * transform of the node is valid before it gets added.
+             */
+            void queueAddChild(const std::shared_ptr<BasicNode>& parent, const std::shared_ptr<BasicNode>& node);
+
+            /**
+             * @brief Queues detaching the node from its parent & removing it and its children from the scene.
+             */
+            void queueDestroy(const std::shared_ptr<BasicNode>& node);
+
+            /**
+             * @brief Applies all queued adds & destroys. Nodes queued while applying, e.g. from start(), wait for the
+             * next flush.
+             */
+            void flush();
+
+            /**
+             * @brief Releases up to the destroy budget of the nodes destroyed by previous flushes.
+             */
+            void releaseDestroyed();
+
+            size_t getDestroyBudget() const { return m_destroyBudget; };
+
+            /**
+             * @brief Sets how many destroyed nodes get released per frame.
+             */
+            void setDestroyBudget(size_t budget) { m_destroyBudget = budget > 0 ? budget : 1; };
+
+            size_t getPendingAddCount() const { return m_pendingAdds.size(); };
+
+            size_t getPendingDestroyCount() const { return m_pendingDestroys.size(); };
+
+            size_t getPendingReleaseCount() const { return m_pendingReleases.size(); };
+
+        private:
+            struct PendingAdd
+            {
+                    std::weak_ptr<BasicNode> parent;
+                    std::shared_ptr<BasicNode> node;
+            };
+
+            void applyAdds();
+            void applyDestroys();
+
+            std::vector<PendingAdd> m_pendingAdds;
+            std::vector<std::shared_ptr<BasicNode>> m_pendingDestroys;
+            std::vector<std::shared_ptr<BasicNode>> m_pendingReleases;
+            size_t m_destroyBudget;
+
+            static constexpr size_t DEFAULT_DESTROY_BUDGET = 2048;
+    };
+} // namespace Engine
@@ -0,0 +1,129 @@
+#include "SceneIndex.h"
+
+#include "../nodeComponents/BasicNode.h"
+
+#include <algorithm>
+
+using namespace Engine;
+
+void SceneIndex::add(const std::shared_ptr<BasicNode>& node)
+{
+    const auto [it, added] = m_nodes.try_emplace(node->getNodeId(), Entry { node, node->getNameId() });
+    if(!added)
+    {
+        return;
+    }
+
+    addName(it->second.name, it->first);
+    node->m_indexed = true;
+}
+
+void SceneIndex::remove(const std::unordered_set<unsigned int>& nodeIds)
+{
+    for(const unsigned int nodeId : nodeIds)
+    {
+        const auto it = m_nodes.find(nodeId);
+        if(it == m_nodes.end())
+        {
+            continue;
+        }
+
+        if(const auto node = it->second.node.lock())
+        {
+            node->m_indexed = false;
+        }
+        removeName(it->second.name, nodeId);
+        m_nodes.erase(it);
+    }
+}
+
+void SceneIndex::rename(const BasicNode& node, NameId name)
+{
+    const auto it = m_nodes.find(node.getNodeId());
+    if(it == m_nodes.end() || it->second.name == name)
+    {
+        return;
+    }
+
+    removeName(it->second.name, it->first);
+    it->second.name = name;
+    addName(name, it->first);
+}
+
+void SceneIndex::reserve(size_t count)
+{
+    if(float(count) > float(m_nodes.bucket_count()) * m_nodes.max_load_factor())
+    {
+        m_nodes.reserve(std::max(count, m_nodes.size() * 2));
+    }
+}
+
+std::shared_ptr<BasicNode> SceneIndex::findNode(unsigned int nodeId) const
+{
+    const auto it = m_nodes.find(nodeId);
+    return it != m_nodes.end() ? it->second.node.lock() : nullptr;
+}
+
+std::shared_ptr<BasicNode> SceneIndex::findNodeByName(std::string_view name) const
+{
+    // A name that was never interned can't belong to any node
+    const NameId nameId = NameTable::find(name);
+    const auto it = m_names.find(nameId);
+    if(nameId == NameTable::EMPTY || it == m_names.end())
+    {
+        return nullptr;
+    }
+
+    for(const unsigned int nodeId : it->second)
+    {
+        if(auto node = findNode(nodeId))
+        {
+            return node;
+        }
+    }
+    return nullptr;
+}
+
+std::vector<std::shared_ptr<BasicNode>> SceneIndex::findNodesByName(std::string_view name) const
+{
+    std::vector<std::shared_ptr<BasicNode>> nodes;
+    const NameId nameId = NameTable::find(name);
+    const auto it = m_names.find(nameId);
+    if(nameId == NameTable::EMPTY || it == m_names.end())
+    {
+        return nodes;
+    }
+
+    nodes.reserve(it->second.size());
+    for(const unsigned int nodeId : it->second)
+    {
+        if(auto node = findNode(nodeId))
+        {
+            nodes.push_back(std::move(node));
+        }
+    }
+    return nodes;
+}
+
+void SceneIndex::addName(NameId name, unsigned int nodeId)
+{
+    if(name != NameTable::EMPTY)
+    {
+        m_names[name].insert(nodeId);
+    }
+}
+
+void SceneIndex::removeName(NameId name, unsigned int nodeId)
+{
+    const auto it = m_names.find(name);
+    if(it == m_names.end())
+    {
+        return;
+    }
+
+    it->second.erase(nodeId);
+    if(it->second.empty())
+    {
+        m_names.erase(it);
+    }
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "NameTable.h"
+
+#include <cstddef>
+#include <memory>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace Engine
+{
+    class BasicNode;
+
+    /**
+     * @brief Hash index of the scene from node ID & interned name to node, kept up to date by the EngineManager
+     * whenever nodes get added to or removed from the scene & by BasicNode::setName.
+     *
+     * Lookups are O(1) instead of walking the scene graph. Names don't have to be unique, unnamed nodes are only
+     * indexed by their ID. The nodes are held weakly, a subtree dropped without leaving the scene can't be found.
+     */
+    class SceneIndex
+    {
+        public:
+            SceneIndex() = default;
+            ~SceneIndex() = default;
+
+            void add(const std::shared_ptr<BasicNode>& node);
+
+            void remove(const std::unordered_set<unsigned int>& nodeIds);
+
+            /**
+             * @brief Moves an indexed node to its new name, called by BasicNode::setName.
+             */
+            void rename(const BasicNode& node, NameId name);
+
+            /**
+             * @brief Makes room for count nodes in total, growing geometrically to keep single adds amortised.
+             */
+            void reserve(size_t count);
+
+            std::shared_ptr<BasicNode> findNode(unsigned int nodeId) const;
+
+            /**
+             * @return Any of the nodes with the name, nullptr if there is none.
+             */
+            std::shared_ptr<BasicNode> findNodeByName(std::string_view name) const;
+
+            std::vector<std::shared_ptr<BasicNode>> findNodesByName(std::string_view name) const;
+
+            size_t getCount() const { return m_nodes.size(); };
+
+        private:
+            struct Entry
+            {
+                    std::weak_ptr<BasicNode> node;
+                    NameId name = NameTable::EMPTY;
+            };
+
+            void addName(NameId name, unsigned int nodeId);
+            void removeName(NameId name, unsigned int nodeId);
+
+            std::unordered_map<unsigned int, Entry> m_nodes;
+            std::unordered_map<NameId, std::unordered_set<unsigned int>> m_names;
+    };
+} // namespace Engine
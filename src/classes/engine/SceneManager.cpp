@@ -0,0 +1,78 @@
+#include "SceneManager.h"
+
+#include "../nodeComponents/BasicNode.h"
+#include "EngineManager.h"
+#include "ThreadPool.h"
+#include "rendering/RenderManager.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <utility>
+
+using namespace Engine;
+
+SceneManager::SceneManager() : m_pendingAssetCount(0) {}
+
+void SceneManager::loadScene(SceneFactory factory, const SceneAssets& assets)
+{
+    // A replaced load still finishes on the pool, its scene is dropped & its assets stay cached
+    const auto& renderManager = SingletonManager::get<EngineManager>()->getRenderManager();
+    for(const std::string& object : assets.objects)
+    {
+        renderManager->preloadObject(object);
+    }
+    for(const std::string& texture : assets.textures)
+    {
+        renderManager->preloadTexture(texture);
+    }
+    for(const SceneShader& shader : assets.shaders)
+    {
+        renderManager->preloadShader(shader.shaderPath, shader.shaderName, shader.features);
+    }
+
+    m_pendingAssetCount = renderManager->getPendingPreloadCount();
+    m_pendingScene = SingletonManager::get<ThreadPool>()->enqueue(std::move(factory));
+}
+
+void SceneManager::update()
+{
+    if(!m_pendingScene.valid() || m_pendingScene.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+    {
+        return;
+    }
+
+    // Also waits for preloads queued by others, start() of the scene may rely on them just the same
+    const auto& engineManager = SingletonManager::get<EngineManager>();
+    if(engineManager->getRenderManager()->getPendingPreloadCount() > 0)
+    {
+        return;
+    }
+
+    std::shared_ptr<BasicNode> scene = m_pendingScene.get();
+    m_pendingAssetCount = 0;
+    if(!scene)
+    {
+        std::cout << "Scene factory returned no scene, keeping the current one" << std::endl;
+        return;
+    }
+
+    engineManager->setScene(scene);
+    scene->startSubtree();
+}
+
+float SceneManager::getLoadProgress() const
+{
+    if(!m_pendingScene.valid())
+    {
+        return 1.f;
+    }
+
+    const size_t pendingAssets = SingletonManager::get<EngineManager>()->getRenderManager()->getPendingPreloadCount();
+    const bool sceneBuilt = m_pendingScene.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+
+    // The scene itself counts as one more step, next to every asset
+    const size_t total = m_pendingAssetCount + 1;
+    const size_t finished = total - std::min(pendingAssets, m_pendingAssetCount) - (sceneBuilt ? 0 : 1);
+    return float(finished) / float(total);
+}
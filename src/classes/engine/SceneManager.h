@@ -0,0 +1,78 @@
+#pragma once
+
+#include "../SingletonManager.h"
+
+#include <functional>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Engine
+{
+    class BasicNode;
+
+    /**
+     * @brief A shader variant a scene registers, see RenderManager::registerShader.
+     */
+    struct SceneShader
+    {
+            std::string shaderPath;
+            std::string shaderName;
+            unsigned int features = 0;
+    };
+
+    /**
+     * @brief The assets a scene registers in start(), loaded before the scene gets switched to.
+     */
+    struct SceneAssets
+    {
+            std::vector<std::string> objects;
+            std::vector<std::string> textures;
+            std::vector<SceneShader> shaders;
+    };
+
+    /**
+     * @brief Builds the next scene in the background & switches to it once it is ready.
+     *
+     * The factory runs on the ThreadPool, it constructs the scene root & may do CPU heavy generation & build whole
+     * subtrees with addChildDetached, which get registered in bulk once the scene is set. It must neither touch GL nor
+     * add children through addChild, both only happen on the main thread. Meanwhile the
+     * listed assets are read & cooked on the pool and uploaded by the RenderManager within its preload budget per
+     * frame. Once everything finished the scene is set & started in one update, start() then only hits the caches of
+     * the RenderManager. The previous scene gets torn down by the NodeLifecycleQueue over the following frames.
+     */
+    class SceneManager : public SingletonBase
+    {
+        public:
+            using SceneFactory = std::function<std::shared_ptr<BasicNode>()>;
+
+            SceneManager();
+            ~SceneManager() = default;
+
+            /**
+             * @brief Starts building a scene, replacing a load that is still in progress.
+             *
+             * @param factory Creates the scene root on a worker thread
+             * @param assets Everything the scene registers in its start(), to be preloaded
+             */
+            void loadScene(SceneFactory factory, const SceneAssets& assets = SceneAssets());
+
+            /**
+             * @brief Switches to the loaded scene once it & its assets are ready. Called by the EngineManager at the
+             * start of every update, after the preloads of the frame got uploaded.
+             */
+            void update();
+
+            bool isLoading() const { return m_pendingScene.valid(); };
+
+            /**
+             * @return float between 0 and 1, how much of the current load has finished. 1 if nothing is loading.
+             */
+            float getLoadProgress() const;
+
+        private:
+            std::future<std::shared_ptr<BasicNode>> m_pendingScene;
+            size_t m_pendingAssetCount;
+    };
+} // namespace Engine
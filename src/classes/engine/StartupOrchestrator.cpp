@@ -0,0 +1,144 @@
+#include "StartupOrchestrator.h"
+
+#include "EngineManager.h"
+#include "SceneManager.h"
+#include "ThreadPool.h"
+#include "WindowManager.h"
+#include "rendering/RenderManager.h"
+#include "vfs/VirtualFileSystem.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+
+using namespace Engine;
+
+StartupOrchestrator::StartupOrchestrator()
+    : m_startTime(Clock::now())
+    , m_preparePhase(SIZE_MAX)
+    , m_assetCount(0)
+    , m_assetsReadyWithContext(0)
+    , m_firstFrameMs(0.0)
+    , m_finished(false)
+{
+#ifndef DEBUG
+    // Assets come from the packed archive if it was built with the packResources target, loose files otherwise
+    SingletonManager::get<VirtualFileSystem>()->mountArchive("resources.pak");
+#endif
+
+    // The workers are started before anything gets queued, so they are up while the context gets created
+    SingletonManager::get<ThreadPool>();
+}
+
+void StartupOrchestrator::prepareAssets(const SceneAssets& assets)
+{
+    if(m_preparePhase == SIZE_MAX)
+    {
+        m_preparePhase = beginPhase("Asset preparation (workers)");
+    }
+
+    for(const std::string& object : assets.objects)
+    {
+        m_preloads.addObject(object);
+    }
+    for(const std::string& texture : assets.textures)
+    {
+        m_preloads.addTexture(texture);
+    }
+    for(const SceneShader& shader : assets.shaders)
+    {
+        m_preloads.addShader(shader.shaderPath, shader.shaderName, shader.features);
+    }
+    m_assetCount = m_preloads.getCount();
+}
+
+bool StartupOrchestrator::createContext()
+{
+    const size_t phase = beginPhase("Window & context creation");
+    const bool created = SingletonManager::get<WindowManager>()->startWindow();
+    endPhase(phase);
+
+    m_assetsReadyWithContext = m_preloads.getPreparedCount();
+    return created;
+}
+
+void StartupOrchestrator::uploadAssets()
+{
+    // Creating the engine compiles its own shaders & needs the context as well
+    const size_t enginePhase = beginPhase("Engine setup");
+    const auto& renderManager = SingletonManager::get<EngineManager>()->getRenderManager();
+    endPhase(enginePhase);
+
+    if(m_preloads.getCount() == 0)
+    {
+        return;
+    }
+
+    const size_t waitPhase = beginPhase("Waiting for asset preparation");
+    m_preloads.wait();
+    endPhase(waitPhase);
+
+    // The preparation ended with its last job, which may have been long before anyone waited for it
+    m_timeline[m_preparePhase].endMs = getElapsedMs(m_preloads.getLastPreparedTime());
+
+    const size_t uploadPhase = beginPhase("Uploads & shader compiles");
+    renderManager->adoptPreloads(std::move(m_preloads));
+    renderManager->finishPreloads();
+    endPhase(uploadPhase);
+}
+
+size_t StartupOrchestrator::beginPhase(const std::string& name)
+{
+    const double now = getElapsedMs(Clock::now());
+    m_timeline.push_back({ name, now, now });
+    return m_timeline.size() - 1;
+}
+
+void StartupOrchestrator::endPhase(size_t phase) { m_timeline[phase].endMs = getElapsedMs(Clock::now()); }
+
+void StartupOrchestrator::finishFirstFrame()
+{
+    if(m_finished)
+    {
+        return;
+    }
+
+    m_finished = true;
+    m_firstFrameMs = getElapsedMs(Clock::now());
+    std::cout << getReport();
+}
+
+std::string StartupOrchestrator::getReport() const
+{
+    std::string report = "Start-up timeline:\n";
+    char line[160];
+    for(const StartupPhase& phase : m_timeline)
+    {
+        snprintf(line, sizeof(line), "  %8.1f - %8.1f ms  %s\n", phase.startMs, phase.endMs, phase.name.c_str());
+        report += line;
+    }
+
+    if(m_assetCount > 0)
+    {
+        snprintf(
+                line,
+                sizeof(line),
+                "  %zu of %zu assets were prepared once the context was ready\n",
+                m_assetsReadyWithContext,
+                m_assetCount
+        );
+        report += line;
+    }
+
+    if(m_finished)
+    {
+        snprintf(line, sizeof(line), "  First frame after %.1f ms\n", m_firstFrameMs);
+        report += line;
+    }
+    return report;
+}
+
+double StartupOrchestrator::getElapsedMs(Clock::time_point time) const
+{
+    return std::max(0.0, std::chrono::duration<double, std::milli>(time - m_startTime).count());
+}
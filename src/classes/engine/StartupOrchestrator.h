@@ -0,0 +1,90 @@
+#pragma once
+
+#include "../SingletonManager.h"
+#include "rendering/AssetPreloads.h"
+
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace Engine
+{
+    struct SceneAssets;
+
+    /**
+     * @brief A phase of the start-up, in milliseconds since the StartupOrchestrator was created.
+     */
+    struct StartupPhase
+    {
+            std::string name;
+            double startMs = 0.0;
+            double endMs = 0.0;
+    };
+
+    /**
+     * @brief Overlaps creating the window & context with reading & decoding the assets of the first scene.
+     *
+     * The assets get prepared on the ThreadPool right away, while the main thread creates the context. Once it is
+     * ready, everything prepared gets uploaded in one go through the RenderManager, so start() of the first scene
+     * only hits its caches. Time to first frame comes down to roughly the longer of context creation & asset
+     * preparation instead of their sum. Every phase gets recorded & the timeline is printed with the first frame.
+     */
+    class StartupOrchestrator : public SingletonBase
+    {
+        public:
+            using Clock = std::chrono::steady_clock;
+
+            StartupOrchestrator();
+            ~StartupOrchestrator() = default;
+
+            /**
+             * @brief Starts reading & decoding the assets on the ThreadPool. Needs no context.
+             */
+            void prepareAssets(const SceneAssets& assets);
+
+            /**
+             * @brief Creates the window, the GL context & ImGui on the calling thread, which has to be the main thread.
+             */
+            bool createContext();
+
+            /**
+             * @brief Waits for the prepared assets & uploads all of them through the RenderManager. Needs the context.
+             */
+            void uploadAssets();
+
+            /**
+             * @return The index of the phase, to be passed to endPhase.
+             */
+            size_t beginPhase(const std::string& name);
+
+            void endPhase(size_t phase);
+
+            /**
+             * @brief Ends the start-up once the first frame got presented & prints the timeline. Only the first call
+             * does anything.
+             */
+            void finishFirstFrame();
+
+            bool isFinished() const { return m_finished; };
+
+            const std::vector<StartupPhase>& getTimeline() const { return m_timeline; };
+
+            /**
+             * @return The timeline as text, one line per phase.
+             */
+            std::string getReport() const;
+
+        private:
+            double getElapsedMs(Clock::time_point time) const;
+
+            Clock::time_point m_startTime;
+            std::vector<StartupPhase> m_timeline;
+            AssetPreloads m_preloads;
+            size_t m_preparePhase;
+            size_t m_assetCount;
+            size_t m_assetsReadyWithContext;
+            double m_firstFrameMs;
+            bool m_finished;
+    };
+} // namespace Engine
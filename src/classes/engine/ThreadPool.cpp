@@ -0,0 +1,120 @@
+#include "ThreadPool.h"
+
+#include <algorithm>
+
+namespace Engine
+{
+    ThreadPool::ThreadPool() : m_stopping(false)
+    {
+        const unsigned int hardwareThreads = std::thread::hardware_concurrency();
+        const unsigned int workerCount = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+
+        m_workers.reserve(workerCount);
+        for(unsigned int i = 0; i < workerCount; ++i)
+        {
+            m_workers.emplace_back([this]() { workerLoop(); });
+        }
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_queueMutex);
+            m_stopping = true;
+        }
+        m_condition.notify_all();
+
+        for(auto& worker : m_workers)
+        {
+            worker.join();
+        }
+    }
+
+    void ThreadPool::workerLoop()
+    {
+        while(true)
+        {
+            std::function<void()> task;
+            {
+                std::unique_lock<std::mutex> lock(m_queueMutex);
+                m_condition.wait(lock, [this]() { return m_stopping || !m_tasks.empty(); });
+
+                if(m_stopping && m_tasks.empty())
+                {
+                    return;
+                }
+
+                task = std::move(m_tasks.front());
+                m_tasks.pop();
+            }
+            task();
+        }
+    }
+
+    void ThreadPool::parallelFor(size_t count, const std::function<void(size_t, size_t)>& func, size_t minChunkSize)
+    {
+        if(count == 0)
+        {
+            return;
+        }
+
+        const size_t threadCount = m_workers.size() + 1;
+        const size_t chunkSize = std::max(minChunkSize, (count + threadCount * 4 - 1) / (threadCount * 4));
+        const size_t chunkCount = (count + chunkSize - 1) / chunkSize;
+
+        if(chunkCount == 1)
+        {
+            func(0, count);
+            return;
+        }
+
+        // Chunks are claimed through an atomic counter. A helper task that starts after all chunks were claimed
+        // returns right away, so the caller only ever waits for chunks that are actively being processed.
+        struct SharedState
+        {
+                std::atomic<size_t> nextChunk { 0 };
+                std::atomic<size_t> remainingChunks { 0 };
+                std::mutex doneMutex;
+                std::condition_variable doneCondition;
+        };
+
+        auto state = std::make_shared<SharedState>();
+        state->remainingChunks = chunkCount;
+
+        const auto processChunks = [state, chunkSize, chunkCount, count, &func]()
+        {
+            while(true)
+            {
+                const size_t chunk = state->nextChunk.fetch_add(1);
+                if(chunk >= chunkCount)
+                {
+                    return;
+                }
+
+                const size_t begin = chunk * chunkSize;
+                func(begin, std::min(begin + chunkSize, count));
+
+                if(state->remainingChunks.fetch_sub(1) == 1)
+                {
+                    std::lock_guard<std::mutex> lock(state->doneMutex);
+                    state->doneCondition.notify_all();
+                }
+            }
+        };
+
+        const size_t helperCount = std::min(m_workers.size(), chunkCount - 1);
+        {
+            std::lock_guard<std::mutex> lock(m_queueMutex);
+            for(size_t i = 0; i < helperCount; ++i)
+            {
+                m_tasks.emplace(processChunks);
+            }
+        }
+        m_condition.notify_all();
+
+        processChunks();
+
+        std::unique_lock<std::mutex> lock(state->doneMutex);
+        state->doneCondition.wait(lock, [&state]() { return state->remainingChunks == 0; });
+    }
+} // namespace Engine
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "../SingletonManager.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+namespace Engine
+{
+    /**
+     * @brief A fixed size pool of worker threads shared by all engine systems.
+     *
+     * Work can either be enqueued as single tasks or split into ranges with parallelFor. The calling thread of
+     * parallelFor takes part in the work itself, which makes it safe to nest parallelFor calls inside pool tasks.
+     */
+    class ThreadPool : public SingletonBase
+    {
+        public:
+            ThreadPool();
+            ~ThreadPool();
+
+            /**
+             * @brief Enqueues a task to be run on one of the worker threads.
+             *
+             * @param func The task to run.
+             * @return A future holding the result of the task.
+             */
+            template<typename F>
+            auto enqueue(F&& func) -> std::future<std::invoke_result_t<F>>
+            {
+                using ReturnType = std::invoke_result_t<F>;
+
+                auto task = std::make_shared<std::packaged_task<ReturnType()>>(std::forward<F>(func));
+                std::future<ReturnType> result = task->get_future();
+                {
+                    std::lock_guard<std::mutex> lock(m_queueMutex);
+                    m_tasks.emplace([task]() { (*task)(); });
+                }
+                m_condition.notify_one();
+
+                return result;
+            }
+
+            /**
+             * @brief Splits the range [0, count) into chunks and processes them on the pool and the calling thread.
+             *
+             * Blocks until every chunk has been processed.
+             *
+             * @param count The amount of elements to process.
+             * @param func The function to call for every chunk, receiving the chunks begin and end index.
+             * @param minChunkSize The minimum amount of elements per chunk.
+             */
+            void parallelFor(size_t count, const std::function<void(size_t, size_t)>& func, size_t minChunkSize = 64);
+
+            /**
+             * @brief Gets the amount of worker threads, not including the calling thread.
+             *
+             * @return The amount of worker threads.
+             */
+            size_t getWorkerCount() const { return m_workers.size(); };
+
+        private:
+            void workerLoop();
+
+            std::vector<std::thread> m_workers;
+            std::queue<std::function<void()>> m_tasks;
+            std::mutex m_queueMutex;
+            std::condition_variable m_condition;
+            bool m_stopping;
+    };
+} // namespace Engine
@@ -1,11 +1,59 @@
 
 #include "UserEventManager.h"
 
+#include "FramePacer.h"
+
 #include <iostream>
 #include <vector>
 
+#include <imgui.h>
+
 namespace Engine
 {
+    namespace
+    {
+        // Pressed inputs turn into repeats while held & into releases for a single update before they get dropped
+        // Returns whether any input got pressed or released
+        template<typename PollFunc>
+        bool updateStates(std::map<int, int>& states, int first, int last, const PollFunc& poll)
+        {
+            bool changed = false;
+            std::vector<int> inputsToRemove;
+            for(auto& state : states)
+            {
+                if(state.second == GLFW_RELEASE)
+                {
+                    inputsToRemove.push_back(state.first);
+                }
+                else if(poll(state.first) == GLFW_RELEASE)
+                {
+                    state.second = GLFW_RELEASE;
+                    changed = true;
+                }
+                else if(state.second == GLFW_PRESS && poll(state.first) == GLFW_PRESS)
+                {
+                    state.second = GLFW_REPEAT;
+                }
+            }
+
+            for(const auto& input : inputsToRemove)
+            {
+                states.erase(input);
+            }
+
+            for(int input = first; input <= last; ++input)
+            {
+                if(states.find(input) == states.end() && poll(input) != GLFW_RELEASE)
+                {
+                    states[input] = poll(input);
+                    changed = true;
+                }
+            }
+
+            return changed;
+        }
+    } // namespace
+
     UserEventManager::GLFW_ACTION UserEventManager::getUserEvent(GLFW_KEY key)
     {
         if(m_userEvents.find(key) == m_userEvents.end())
@@ -18,35 +66,42 @@ namespace Engine
 
     void UserEventManager::updateEvents(GLFWwindow* window)
     {
-        std::vector<GLFW_KEY> keysToRemove;
-        for(auto& userEvent : m_userEvents)
-        {
-            if(userEvent.second == GLFW_RELEASE)
-            {
-                keysToRemove.push_back(userEvent.first);
-            }
-            else if(glfwGetKey(window, userEvent.first) == GLFW_RELEASE)
-            {
-                m_userEvents[userEvent.first] = GLFW_RELEASE;
-            }
-            else if(userEvent.second == GLFW_PRESS && glfwGetKey(window, userEvent.first) == GLFW_PRESS)
-            {
-                m_userEvents[userEvent.first] = GLFW_REPEAT;
-            }
-        }
+        const bool keysChanged = updateStates(
+                m_userEvents,
+                GLFW_KEY_SPACE,
+                GLFW_KEY_LAST,
+                [window](int key) { return glfwGetKey(window, key); }
+        );
+        m_previousMouseEvents = m_mouseEvents;
+        const bool buttonsChanged = updateStates(
+                m_mouseEvents,
+                GLFW_MOUSE_BUTTON_1,
+                GLFW_MOUSE_BUTTON_LAST,
+                [window](int button) { return glfwGetMouseButton(window, button); }
+        );
 
-        for(const auto& key : keysToRemove)
+        // The frame reacting to it measures how long the input took to reach the screen
+        if(keysChanged || buttonsChanged)
         {
-            m_userEvents.erase(key);
+            SingletonManager::get<FramePacer>()->markInput();
         }
 
-        for(int key = GLFW_KEY_SPACE; key <= GLFW_KEY_LAST; ++key)
+        // The cursor comes in screen coordinates, those differ from pixels on high DPI displays
+        double cursorX = 0.0;
+        double cursorY = 0.0;
+        glm::ivec2 windowSize;
+        glm::ivec2 framebufferSize;
+        glfwGetCursorPos(window, &cursorX, &cursorY);
+        glfwGetWindowSize(window, &windowSize.x, &windowSize.y);
+        glfwGetFramebufferSize(window, &framebufferSize.x, &framebufferSize.y);
+        if(windowSize.x > 0 && windowSize.y > 0)
         {
-            if(m_userEvents.find(key) == m_userEvents.end() && glfwGetKey(window, key) != GLFW_RELEASE)
-            {
-                m_userEvents[key] = glfwGetKey(window, key);
-            }
+            m_cursorPosition = glm::ivec2(
+                    int(cursorX * framebufferSize.x / windowSize.x),
+                    int(cursorY * framebufferSize.y / windowSize.y)
+            );
         }
+        m_cursorOverUi = ImGui::GetCurrentContext() && ImGui::GetIO().WantCaptureMouse;
 
         checkListeners();
 
@@ -72,6 +127,30 @@ namespace Engine
         }
     }
 
+    UserEventManager::GLFW_ACTION UserEventManager::getMouseEvent(int button)
+    {
+        const auto it = m_mouseEvents.find(button);
+        return it == m_mouseEvents.end() ? -1 : it->second;
+    }
+
+    bool UserEventManager::wasMousePressed(int button) const
+    {
+        const auto isHeld = [button](const std::map<int, GLFW_ACTION>& states)
+        {
+            const auto it = states.find(button);
+            return it != states.end() && it->second != GLFW_RELEASE;
+        };
+        return isHeld(m_mouseEvents) && !isHeld(m_previousMouseEvents);
+    }
+
+    void UserEventManager::dispatchPick(const std::shared_ptr<GeometryComponent>& node, glm::ivec2 pixel)
+    {
+        for(const auto& listener : m_pickListeners)
+        {
+            listener(node, pixel);
+        }
+    }
+
     glm::vec2 UserEventManager::getWasdInput()
     {
         glm::vec2 input = glm::vec2(0.f, 0.f);
@@ -2,7 +2,10 @@
 
 #include "../SingletonManager.h"
 
+#include <functional>
 #include <map>
+#include <memory>
+#include <vector>
 
 #include <GL/glew.h>
 #include <GLFW/glfw3.h>
@@ -10,10 +13,13 @@
 
 namespace Engine
 {
+    class GeometryComponent;
+
     class UserEventManager : public SingletonBase
     {
         public:
             using Callback = std::function<void()>;
+            using PickListener = std::function<void(const std::shared_ptr<GeometryComponent>& node, glm::ivec2 pixel)>;
 
             UserEventManager() = default;
             ~UserEventManager() = default;
@@ -32,7 +38,11 @@ namespace Engine
                 m_listeners.emplace_back(action, listener);
             };
 
-            void clearListener() { m_listeners.clear(); };
+            void clearListener()
+            {
+                m_listeners.clear();
+                m_pickListeners.clear();
+            };
 
             const std::map<GLFW_KEY, GLFW_ACTION>& getUserEvents() const { return m_userEvents; };
 
@@ -40,8 +50,43 @@ namespace Engine
 
             glm::vec2 getWasdInput();
 
+            /**
+             * @return The state of a GLFW_MOUSE_BUTTON like getUserEvent(), -1 if it isn't held.
+             */
+            GLFW_ACTION getMouseEvent(int button);
+
+            /**
+             * @brief True only in the update where the button went from released to held, once per click.
+             */
+            bool wasMousePressed(int button) const;
+
+            /**
+             * @brief The cursor in framebuffer pixels from the top left.
+             */
+            glm::ivec2 getCursorPosition() const { return m_cursorPosition; };
+
+            /**
+             * @brief Whether the cursor is over a debug window, clicks there aren't meant for the scene.
+             */
+            bool isCursorOverUi() const { return m_cursorOverUi; };
+
+            /**
+             * @brief Gets called with the node under the cursor whenever the scene gets clicked, nullptr if there
+             * was none. The nodes are picked on the GPU, the answer arrives a frame or two after the click.
+             */
+            void addPickListener(const PickListener& listener) { m_pickListeners.push_back(listener); };
+
+            bool hasPickListeners() const { return !m_pickListeners.empty(); };
+
+            void dispatchPick(const std::shared_ptr<GeometryComponent>& node, glm::ivec2 pixel);
+
         private:
             std::map<GLFW_KEY, GLFW_ACTION> m_userEvents;
+            std::map<int, GLFW_ACTION> m_mouseEvents;
+            std::map<int, GLFW_ACTION> m_previousMouseEvents;
             std::vector<std::pair<std::pair<GLFW_KEY, GLFW_ACTION>, Callback>> m_listeners;
+            std::vector<PickListener> m_pickListeners;
+            glm::ivec2 m_cursorPosition = glm::ivec2(0);
+            bool m_cursorOverUi = false;
     };
 } // namespace Engine
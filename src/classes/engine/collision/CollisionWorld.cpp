@@ -0,0 +1,395 @@
+#include "CollisionWorld.h"
+
+#include "../ThreadPool.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ENGINE_COLLISION_SSE2 1
+#endif
+
+using namespace Engine;
+
+namespace
+{
+    void appendPair(std::vector<CollisionPair>& pairs, CollisionBodyId a, CollisionBodyId b)
+    {
+        pairs.push_back(a < b ? CollisionPair { a, b } : CollisionPair { b, a });
+    }
+} // namespace
+
+CollisionWorld::CollisionWorld() : m_axis(0), m_needsFullSort(true), m_maxExtent(0.f), m_lastSwapCount(0) {}
+
+CollisionBodyId CollisionWorld::addBody(
+        const glm::vec3& localMin,
+        const glm::vec3& localMax,
+        uint32_t layer /* = 1 */,
+        uint32_t mask /* = UINT32_MAX */,
+        unsigned int userId /* = 0 */
+)
+{
+    CollisionBodyId body;
+    if(!m_freeBodies.empty())
+    {
+        body = m_freeBodies.back();
+        m_freeBodies.pop_back();
+    }
+    else
+    {
+        body = CollisionBodyId(m_bodies.size());
+        m_bodies.emplace_back();
+    }
+
+    m_bodies[body] = { localMin, localMax, localMin, localMax, layer, mask, userId, true };
+    // Sorted in by the next update, wherever its key ends up
+    m_sorted.push_back({ 0.f, body });
+
+    return body;
+}
+
+void CollisionWorld::removeBody(CollisionBodyId body)
+{
+    if(!isActive(body))
+    {
+        return;
+    }
+
+    m_bodies[body].active = false;
+    m_removedBodies.push_back(body);
+}
+
+void CollisionWorld::setLocalBounds(CollisionBodyId body, const glm::vec3& localMin, const glm::vec3& localMax)
+{
+    m_bodies[body].localMin = localMin;
+    m_bodies[body].localMax = localMax;
+}
+
+void CollisionWorld::setTransform(CollisionBodyId body, const glm::mat4& transform)
+{
+    Body& data = m_bodies[body];
+    const glm::vec3 localCenter = (data.localMax + data.localMin) * 0.5f;
+    const glm::vec3 localExtent = (data.localMax - data.localMin) * 0.5f;
+
+    // Transforming the center & summing the absolute axes gives the tightest box around the transformed box
+    const glm::vec3 center = glm::vec3(transform * glm::vec4(localCenter, 1.f));
+    const glm::vec3 extent = glm::abs(glm::vec3(transform[0])) * localExtent.x +
+                             glm::abs(glm::vec3(transform[1])) * localExtent.y +
+                             glm::abs(glm::vec3(transform[2])) * localExtent.z;
+
+    data.worldMin = center - extent;
+    data.worldMax = center + extent;
+}
+
+void CollisionWorld::setLayer(CollisionBodyId body, uint32_t layer, uint32_t mask)
+{
+    m_bodies[body].layer = layer;
+    m_bodies[body].mask = mask;
+}
+
+void CollisionWorld::update()
+{
+    if(!m_removedBodies.empty())
+    {
+        std::erase_if(m_sorted, [this](const SortEntry& entry) { return !m_bodies[entry.body].active; });
+        m_freeBodies.insert(m_freeBodies.end(), m_removedBodies.begin(), m_removedBodies.end());
+        m_removedBodies.clear();
+    }
+
+    refreshSortKeys();
+    sortBodies();
+    buildSweepBoxes();
+
+    const size_t boxCount = m_boxes.count;
+    const size_t chunkCount = (boxCount + SWEEP_CHUNK_SIZE - 1) / SWEEP_CHUNK_SIZE;
+    m_chunkPairs.resize(std::max(chunkCount, m_chunkPairs.size()));
+
+    SingletonManager::get<ThreadPool>()->parallelFor(
+            chunkCount,
+            [this, boxCount](size_t begin, size_t end)
+            {
+                for(size_t chunk = begin; chunk < end; chunk++)
+                {
+                    m_chunkPairs[chunk].clear();
+                    sweep(chunk * SWEEP_CHUNK_SIZE, std::min(boxCount, (chunk + 1) * SWEEP_CHUNK_SIZE), m_chunkPairs[chunk]);
+                }
+            },
+            1
+    );
+
+    m_pairs.clear();
+    for(size_t chunk = 0; chunk < chunkCount; chunk++)
+    {
+        m_pairs.insert(m_pairs.end(), m_chunkPairs[chunk].begin(), m_chunkPairs[chunk].end());
+    }
+}
+
+void CollisionWorld::refreshSortKeys()
+{
+    // Sums of the box centers, their spread picks the sort axis of the next update
+    glm::dvec3 sum(0.0);
+    glm::dvec3 sumSquared(0.0);
+    float maxExtent = 0.f;
+
+    for(SortEntry& entry : m_sorted)
+    {
+        const Body& body = m_bodies[entry.body];
+        entry.key = body.worldMin[m_axis];
+        maxExtent = std::max(maxExtent, body.worldMax[m_axis] - body.worldMin[m_axis]);
+
+        const glm::dvec3 center = glm::dvec3(body.worldMin + body.worldMax) * 0.5;
+        sum += center;
+        sumSquared += center * center;
+    }
+    m_maxExtent = maxExtent;
+
+    if(m_sorted.empty())
+    {
+        return;
+    }
+
+    const glm::dvec3 mean = sum / double(m_sorted.size());
+    const glm::dvec3 variance = sumSquared / double(m_sorted.size()) - mean * mean;
+
+    int widestAxis = 0;
+    for(int axis = 1; axis < 3; axis++)
+    {
+        widestAxis = variance[axis] > variance[widestAxis] ? axis : widestAxis;
+    }
+
+    // Switching axis costs a full sort, it only pays off if the other axis separates the bodies a lot better
+    if(widestAxis != m_axis && variance[widestAxis] > variance[m_axis] * AXIS_SWITCH_RATIO)
+    {
+        m_axis = widestAxis;
+        m_needsFullSort = true;
+        m_maxExtent = 0.f;
+        for(SortEntry& entry : m_sorted)
+        {
+            const Body& body = m_bodies[entry.body];
+            entry.key = body.worldMin[m_axis];
+            m_maxExtent = std::max(m_maxExtent, body.worldMax[m_axis] - body.worldMin[m_axis]);
+        }
+    }
+}
+
+void CollisionWorld::sortBodies()
+{
+    const auto byKey = [](const SortEntry& a, const SortEntry& b) { return a.key < b.key; };
+
+    if(!m_needsFullSort)
+    {
+        // Bodies move little between updates, so most entries are already in place or close to it
+        const size_t maxSwaps = m_sorted.size() * MAX_SWAPS_PER_BODY;
+        size_t swaps = 0;
+        for(size_t i = 1; i < m_sorted.size() && !m_needsFullSort; i++)
+        {
+            const SortEntry entry = m_sorted[i];
+            size_t j = i;
+            while(j > 0 && m_sorted[j - 1].key > entry.key)
+            {
+                m_sorted[j] = m_sorted[j - 1];
+                j--;
+            }
+            m_sorted[j] = entry;
+
+            swaps += i - j;
+            m_needsFullSort = swaps > maxSwaps;
+        }
+        m_lastSwapCount = int64_t(swaps);
+    }
+
+    if(m_needsFullSort)
+    {
+        std::sort(m_sorted.begin(), m_sorted.end(), byKey);
+        m_lastSwapCount = -1;
+        m_needsFullSort = false;
+    }
+}
+
+void CollisionWorld::buildSweepBoxes()
+{
+    const size_t count = m_sorted.size();
+    const size_t paddedCount = count + SWEEP_PADDING;
+    for(std::vector<float>* values : { &m_boxes.min, &m_boxes.max, &m_boxes.minB, &m_boxes.maxB, &m_boxes.minC, &m_boxes.maxC })
+    {
+        values->resize(paddedCount);
+    }
+    m_boxes.layer.resize(paddedCount);
+    m_boxes.mask.resize(paddedCount);
+    m_boxes.body.resize(count);
+    m_boxes.count = count;
+
+    for(size_t i = count; i < paddedCount; i++)
+    {
+        m_boxes.min[i] = std::numeric_limits<float>::infinity();
+        m_boxes.layer[i] = 0;
+    }
+
+    const int axisB = (m_axis + 1) % 3;
+    const int axisC = (m_axis + 2) % 3;
+    SingletonManager::get<ThreadPool>()->parallelFor(
+            count,
+            [this, axisB, axisC](size_t begin, size_t end)
+            {
+                for(size_t i = begin; i < end; i++)
+                {
+                    const CollisionBodyId id = m_sorted[i].body;
+                    const Body& body = m_bodies[id];
+                    m_boxes.min[i] = body.worldMin[m_axis];
+                    m_boxes.max[i] = body.worldMax[m_axis];
+                    m_boxes.minB[i] = body.worldMin[axisB];
+                    m_boxes.maxB[i] = body.worldMax[axisB];
+                    m_boxes.minC[i] = body.worldMin[axisC];
+                    m_boxes.maxC[i] = body.worldMax[axisC];
+                    m_boxes.layer[i] = body.layer;
+                    m_boxes.mask[i] = body.mask;
+                    m_boxes.body[i] = id;
+                }
+            },
+            SWEEP_CHUNK_SIZE
+    );
+}
+
+void CollisionWorld::sweep(size_t begin, size_t end, std::vector<CollisionPair>& pairs) const
+{
+    // Raw pointers, appending pairs would otherwise force reloading every array after each hit
+    const float* boxMin = m_boxes.min.data();
+    const float* boxMax = m_boxes.max.data();
+    const float* boxMinB = m_boxes.minB.data();
+    const float* boxMaxB = m_boxes.maxB.data();
+    const float* boxMinC = m_boxes.minC.data();
+    const float* boxMaxC = m_boxes.maxC.data();
+    const uint32_t* boxLayer = m_boxes.layer.data();
+    const uint32_t* boxMask = m_boxes.mask.data();
+    const CollisionBodyId* boxBody = m_boxes.body.data();
+
+    for(size_t i = begin; i < end; i++)
+    {
+        // Boxes are sorted by their minimum, the first one starting past the end of box i ends the search
+#if defined(ENGINE_COLLISION_SSE2)
+        const __m128 max = _mm_set1_ps(boxMax[i]);
+        const __m128 minB = _mm_set1_ps(boxMinB[i]);
+        const __m128 maxB = _mm_set1_ps(boxMaxB[i]);
+        const __m128 minC = _mm_set1_ps(boxMinC[i]);
+        const __m128 maxC = _mm_set1_ps(boxMaxC[i]);
+        const __m128i layer = _mm_set1_epi32(int(boxLayer[i]));
+        const __m128i mask = _mm_set1_epi32(int(boxMask[i]));
+        const __m128i zero = _mm_setzero_si128();
+
+        // The padding starts at infinity, so a block reaching past the last box never counts
+        for(size_t j = i + 1;; j += 4)
+        {
+            const int inRange = _mm_movemask_ps(_mm_cmple_ps(_mm_loadu_ps(boxMin + j), max));
+            if(inRange == 0)
+            {
+                break;
+            }
+
+            __m128 overlap = _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(boxMinB + j), maxB), _mm_cmple_ps(minB, _mm_loadu_ps(boxMaxB + j)));
+            overlap = _mm_and_ps(overlap, _mm_cmple_ps(_mm_loadu_ps(boxMinC + j), maxC));
+            overlap = _mm_and_ps(overlap, _mm_cmple_ps(minC, _mm_loadu_ps(boxMaxC + j)));
+
+            const __m128i otherLayer = _mm_loadu_si128((const __m128i*)(boxLayer + j));
+            const __m128i otherMask = _mm_loadu_si128((const __m128i*)(boxMask + j));
+            const __m128i filtered = _mm_or_si128(
+                    _mm_cmpeq_epi32(_mm_and_si128(layer, otherMask), zero),
+                    _mm_cmpeq_epi32(_mm_and_si128(otherLayer, mask), zero)
+            );
+
+            const int hits = inRange & _mm_movemask_ps(overlap) & ~_mm_movemask_ps(_mm_castsi128_ps(filtered));
+            for(int lane = 0; hits != 0 && lane < 4; lane++)
+            {
+                if(hits & (1 << lane))
+                {
+                    appendPair(pairs, boxBody[i], boxBody[j + lane]);
+                }
+            }
+
+            if(inRange != 0xF)
+            {
+                break;
+            }
+        }
+#else
+        for(size_t j = i + 1; boxMin[j] <= boxMax[i]; j++)
+        {
+            if((boxLayer[i] & boxMask[j]) != 0 && (boxLayer[j] & boxMask[i]) != 0 && boxMinB[j] <= boxMaxB[i] &&
+               boxMinB[i] <= boxMaxB[j] && boxMinC[j] <= boxMaxC[i] && boxMinC[i] <= boxMaxC[j])
+            {
+                appendPair(pairs, boxBody[i], boxBody[j]);
+            }
+        }
+#endif
+    }
+}
+
+void CollisionWorld::getOverlaps(CollisionBodyId body, std::vector<CollisionBodyId>& overlaps) const
+{
+    for(const CollisionPair& pair : m_pairs)
+    {
+        if(pair.a == body || pair.b == body)
+        {
+            const CollisionBodyId other = pair.a == body ? pair.b : pair.a;
+            if(m_bodies[other].active)
+            {
+                overlaps.push_back(other);
+            }
+        }
+    }
+}
+
+template<typename F>
+void CollisionWorld::forEachCandidate(const glm::vec3& min, const glm::vec3& max, uint32_t mask, const F& func) const
+{
+    const int axisB = (m_axis + 1) % 3;
+    const int axisC = (m_axis + 2) % 3;
+
+    // No box is longer than the largest extent, so none starting before this can reach the query
+    const auto boxesEnd = m_boxes.min.begin() + ptrdiff_t(m_boxes.count);
+    const size_t first = size_t(std::lower_bound(m_boxes.min.begin(), boxesEnd, min[m_axis] - m_maxExtent) - m_boxes.min.begin());
+
+    for(size_t i = first; i < m_boxes.count && m_boxes.min[i] <= max[m_axis]; i++)
+    {
+        if(m_boxes.max[i] < min[m_axis] || (m_boxes.layer[i] & mask) == 0 || !m_bodies[m_boxes.body[i]].active ||
+           m_boxes.minB[i] > max[axisB] || m_boxes.maxB[i] < min[axisB] || m_boxes.minC[i] > max[axisC] ||
+           m_boxes.maxC[i] < min[axisC])
+        {
+            continue;
+        }
+
+        glm::vec3 boxMin;
+        glm::vec3 boxMax;
+        boxMin[m_axis] = m_boxes.min[i];
+        boxMax[m_axis] = m_boxes.max[i];
+        boxMin[axisB] = m_boxes.minB[i];
+        boxMax[axisB] = m_boxes.maxB[i];
+        boxMin[axisC] = m_boxes.minC[i];
+        boxMax[axisC] = m_boxes.maxC[i];
+        func(m_boxes.body[i], boxMin, boxMax);
+    }
+}
+
+void CollisionWorld::queryAabb(const glm::vec3& min, const glm::vec3& max, uint32_t mask, std::vector<CollisionBodyId>& results) const
+{
+    forEachCandidate(min, max, mask, [&results](CollisionBodyId body, const glm::vec3&, const glm::vec3&) { results.push_back(body); });
+}
+
+void CollisionWorld::querySphere(const glm::vec3& center, float radius, uint32_t mask, std::vector<CollisionBodyId>& results) const
+{
+    const float radiusSquared = radius * radius;
+    forEachCandidate(
+            center - glm::vec3(radius),
+            center + glm::vec3(radius),
+            mask,
+            [&results, &center, radiusSquared](CollisionBodyId body, const glm::vec3& boxMin, const glm::vec3& boxMax)
+            {
+                const glm::vec3 offset = glm::clamp(center, boxMin, boxMax) - center;
+                if(glm::dot(offset, offset) <= radiusSquared)
+                {
+                    results.push_back(body);
+                }
+            }
+    );
+}
@@ -0,0 +1,182 @@
+#pragma once
+
+#include "../../SingletonManager.h"
+
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+namespace Engine
+{
+    using CollisionBodyId = uint32_t;
+
+    static constexpr CollisionBodyId INVALID_COLLISION_BODY = UINT32_MAX;
+
+    /**
+     * @brief Two bodies whose world bounds overlap, the lower id always comes first.
+     */
+    struct CollisionPair
+    {
+            CollisionBodyId a;
+            CollisionBodyId b;
+    };
+
+    /**
+     * @brief Broadphase keeping world space AABBs of bodies and finding the overlapping ones with sweep and prune.
+     *
+     * Bodies stay sorted by the lower bound of their box along the axis with the largest spread, between frames they
+     * barely move so an insertion sort brings the order up to date in close to linear time. The sweep over the sorted
+     * boxes is split over the ThreadPool. Two bodies are only reported if the layer of each is in the mask of the other.
+     *
+     * Bodies may be moved from several threads at once, adding & removing them as well as update() have to happen on a
+     * single thread. Pairs & queries reflect the state of the last update().
+     */
+    class CollisionWorld : public SingletonBase
+    {
+        public:
+            CollisionWorld();
+            ~CollisionWorld() = default;
+
+            /**
+             * @brief Adds a body, its world bounds equal the local ones until it gets a transform.
+             *
+             * @param localMin The minimum corner of the box in the space of the body.
+             * @param localMax The maximum corner of the box in the space of the body.
+             * @param layer The layer bits the body is on.
+             * @param mask The layer bits the body collides with.
+             * @param userId Free to use by the owner, colliders store their node id.
+             * @return The id of the new body.
+             */
+            CollisionBodyId addBody(
+                    const glm::vec3& localMin,
+                    const glm::vec3& localMax,
+                    uint32_t layer = 1,
+                    uint32_t mask = UINT32_MAX,
+                    unsigned int userId = 0
+            );
+
+            /**
+             * @brief Removes a body. Its id only gets handed out again after the next update, so ids in the current
+             * pairs stay unambiguous.
+             */
+            void removeBody(CollisionBodyId body);
+
+            /**
+             * @brief Changes the box of the body, the world bounds follow with the next setTransform.
+             */
+            void setLocalBounds(CollisionBodyId body, const glm::vec3& localMin, const glm::vec3& localMax);
+
+            /**
+             * @brief Moves the body, its world AABB encloses the transformed local box.
+             */
+            void setTransform(CollisionBodyId body, const glm::mat4& transform);
+
+            void setLayer(CollisionBodyId body, uint32_t layer, uint32_t mask);
+
+            uint32_t getLayer(CollisionBodyId body) const { return m_bodies[body].layer; };
+
+            uint32_t getMask(CollisionBodyId body) const { return m_bodies[body].mask; };
+
+            unsigned int getUserId(CollisionBodyId body) const { return m_bodies[body].userId; };
+
+            glm::vec3 getWorldMin(CollisionBodyId body) const { return m_bodies[body].worldMin; };
+
+            glm::vec3 getWorldMax(CollisionBodyId body) const { return m_bodies[body].worldMax; };
+
+            bool isActive(CollisionBodyId body) const { return body < m_bodies.size() && m_bodies[body].active; };
+
+            size_t getBodyCount() const { return m_bodies.size() - m_freeBodies.size() - m_removedBodies.size(); };
+
+            /**
+             * @brief Brings the sort order up to date & collects all overlapping pairs.
+             */
+            void update();
+
+            const std::vector<CollisionPair>& getOverlappingPairs() const { return m_pairs; };
+
+            /**
+             * @brief Appends the bodies overlapping the given body in the last update.
+             */
+            void getOverlaps(CollisionBodyId body, std::vector<CollisionBodyId>& overlaps) const;
+
+            /**
+             * @brief Appends the bodies whose box overlaps the given box & whose layer is in the mask.
+             */
+            void queryAabb(const glm::vec3& min, const glm::vec3& max, uint32_t mask, std::vector<CollisionBodyId>& results) const;
+
+            /**
+             * @brief Appends the bodies whose box overlaps the given sphere & whose layer is in the mask.
+             */
+            void querySphere(const glm::vec3& center, float radius, uint32_t mask, std::vector<CollisionBodyId>& results) const;
+
+            /**
+             * @brief Gets the amount of swaps the insertion sort needed in the last update, a full sort counts as -1.
+             */
+            int64_t getLastSwapCount() const { return m_lastSwapCount; };
+
+        private:
+            struct Body
+            {
+                    glm::vec3 localMin;
+                    glm::vec3 localMax;
+                    glm::vec3 worldMin;
+                    glm::vec3 worldMax;
+                    uint32_t layer;
+                    uint32_t mask;
+                    unsigned int userId;
+                    bool active;
+            };
+
+            struct SortEntry
+            {
+                    float key;
+                    CollisionBodyId body;
+            };
+
+            // The bodies as seen by the sweep, in sort order & split into arrays so SSE tests 4 candidates at once. B & C
+            // are the two axes besides the sort axis, the arrays are padded with boxes starting at infinity
+            struct SweepBoxes
+            {
+                    std::vector<float> min;
+                    std::vector<float> max;
+                    std::vector<float> minB;
+                    std::vector<float> maxB;
+                    std::vector<float> minC;
+                    std::vector<float> maxC;
+                    std::vector<uint32_t> layer;
+                    std::vector<uint32_t> mask;
+                    std::vector<CollisionBodyId> body;
+                    size_t count = 0;
+            };
+
+            void refreshSortKeys();
+            void sortBodies();
+            void buildSweepBoxes();
+            void sweep(size_t begin, size_t end, std::vector<CollisionPair>& pairs) const;
+
+            template<typename F>
+            void forEachCandidate(const glm::vec3& min, const glm::vec3& max, uint32_t mask, const F& func) const;
+
+            std::vector<Body> m_bodies;
+            std::vector<CollisionBodyId> m_freeBodies;
+            std::vector<CollisionBodyId> m_removedBodies; // Freed by the next update
+
+            std::vector<SortEntry> m_sorted;
+            SweepBoxes m_boxes;
+            int m_axis;
+            bool m_needsFullSort;
+            float m_maxExtent; // Largest box along the sweep axis, bounds how far back a query has to look
+            int64_t m_lastSwapCount;
+
+            std::vector<std::vector<CollisionPair>> m_chunkPairs;
+            std::vector<CollisionPair> m_pairs;
+
+            static constexpr size_t SWEEP_CHUNK_SIZE = 2048;
+            static constexpr size_t SWEEP_PADDING = 4;
+            // Past this many swaps per body the order is too far off & a full sort is cheaper
+            static constexpr size_t MAX_SWAPS_PER_BODY = 32;
+            // The spread of another axis has to be this much larger before the sort axis changes
+            static constexpr float AXIS_SWITCH_RATIO = 1.5f;
+    };
+} // namespace Engine
@@ -0,0 +1,124 @@
+#include "AssetPreloads.h"
+
+#include "../ThreadPool.h"
+#include "RenderManager.h"
+#include "ShaderLoader.h"
+
+#include <algorithm>
+
+using namespace Engine;
+
+AssetPreloads::AssetPreloads() : m_lastPrepared(std::make_shared<std::atomic<std::chrono::steady_clock::rep>>(0)) {}
+
+template<typename F>
+auto AssetPreloads::prepare(F&& job) -> std::future<std::invoke_result_t<F>>
+{
+    return SingletonManager::get<ThreadPool>()->enqueue(
+            [job = std::forward<F>(job), lastPrepared = m_lastPrepared]()
+            {
+                auto result = job();
+
+                const auto now = std::chrono::steady_clock::now().time_since_epoch().count();
+                auto previous = lastPrepared->load();
+                while(previous < now && !lastPrepared->compare_exchange_weak(previous, now))
+                {
+                }
+                return result;
+            }
+    );
+}
+
+void AssetPreloads::addObject(const std::string& filePath)
+{
+    if(contains(filePath))
+    {
+        return;
+    }
+
+    m_objects.push_back({ filePath, prepare([filePath]() { return RenderManager::loadCookedObject(filePath); }) });
+}
+
+void AssetPreloads::addTexture(const std::string& filePath)
+{
+    if(contains(filePath))
+    {
+        return;
+    }
+
+    m_textures.push_back({ filePath, prepare([filePath]() { return RenderManager::loadTextureImage(filePath); }) });
+}
+
+void AssetPreloads::addShader(const std::string& shaderPath, const std::string& shaderName, unsigned int features)
+{
+    m_shaders.push_back({ shaderPath,
+                          shaderName,
+                          features,
+                          prepare(
+                                  [shaderPath, features]()
+                                  {
+                                      ShaderSources sources;
+                                      sources.valid = ReadShaderSources(
+                                              (shaderPath + ".vert").c_str(),
+                                              (shaderPath + ".frag").c_str(),
+                                              features,
+                                              sources.vertexCode,
+                                              sources.fragmentCode,
+                                              &sources.declaredFeatures
+                                      );
+                                      return sources;
+                                  }
+                          ) });
+}
+
+size_t AssetPreloads::getPreparedCount() const
+{
+    size_t prepared = 0;
+    for(const ObjectPreload& preload : m_objects)
+    {
+        prepared += isReady(preload.mesh) ? 1 : 0;
+    }
+    for(const TexturePreload& preload : m_textures)
+    {
+        prepared += isReady(preload.image) ? 1 : 0;
+    }
+    for(const ShaderPreload& preload : m_shaders)
+    {
+        prepared += isReady(preload.sources) ? 1 : 0;
+    }
+    return prepared;
+}
+
+bool AssetPreloads::contains(const std::string& filePath) const
+{
+    return std::any_of(
+                   m_objects.begin(),
+                   m_objects.end(),
+                   [&filePath](const ObjectPreload& preload) { return preload.filePath == filePath; }
+           ) ||
+           std::any_of(
+                   m_textures.begin(),
+                   m_textures.end(),
+                   [&filePath](const TexturePreload& preload) { return preload.filePath == filePath; }
+           );
+}
+
+void AssetPreloads::wait() const
+{
+    for(const ObjectPreload& preload : m_objects)
+    {
+        preload.mesh.wait();
+    }
+    for(const TexturePreload& preload : m_textures)
+    {
+        preload.image.wait();
+    }
+    for(const ShaderPreload& preload : m_shaders)
+    {
+        preload.sources.wait();
+    }
+}
+
+std::chrono::steady_clock::time_point AssetPreloads::getLastPreparedTime() const
+{
+    return std::chrono::steady_clock::time_point(std::chrono::steady_clock::duration(m_lastPrepared->load()));
+}
@@ -0,0 +1,118 @@
+#pragma once
+
+#include "../../helper/CookedModel.h"
+#include "../../helper/TextureImage.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace Engine
+{
+    /**
+     * @brief Both sources of a shader variant, read & preprocessed off the main thread.
+     */
+    struct ShaderSources
+    {
+            bool valid = false;
+            std::string vertexCode;
+            std::string fragmentCode;
+            unsigned int declaredFeatures = 0;
+    };
+
+    /**
+     * @brief Assets being read & decoded on the ThreadPool, waiting to be uploaded by a RenderManager.
+     *
+     * Nothing here touches GL, so assets can be prepared before the context exists & handed over with
+     * RenderManager::adoptPreloads() once it does.
+     */
+    class AssetPreloads
+    {
+        public:
+            AssetPreloads();
+            ~AssetPreloads() = default;
+
+            AssetPreloads(AssetPreloads&&) = default;
+            AssetPreloads& operator=(AssetPreloads&&) = default;
+
+            /**
+             * @brief Reads & cooks an object, requests for a path already being prepared are dropped.
+             */
+            void addObject(const std::string& filePath);
+
+            /**
+             * @brief Reads a BMP or DDS texture, requests for a path already being prepared are dropped.
+             */
+            void addTexture(const std::string& filePath);
+
+            /**
+             * @brief Reads & preprocesses the sources of a shader variant, compiling is left to the RenderManager.
+             */
+            void addShader(const std::string& shaderPath, const std::string& shaderName, unsigned int features = 0);
+
+            size_t getCount() const { return m_objects.size() + m_textures.size() + m_shaders.size(); };
+
+            /**
+             * @return How many of the preloads finished their work on the ThreadPool.
+             */
+            size_t getPreparedCount() const;
+
+            bool contains(const std::string& filePath) const;
+
+            /**
+             * @brief Blocks until every preload finished its work on the ThreadPool.
+             */
+            void wait() const;
+
+            /**
+             * @return When the last preload so far finished its work on the ThreadPool, the epoch if none did yet.
+             */
+            std::chrono::steady_clock::time_point getLastPreparedTime() const;
+
+        private:
+            friend class RenderManager;
+
+            struct ObjectPreload
+            {
+                    std::string filePath;
+                    std::future<CookedMesh> mesh;
+            };
+
+            struct TexturePreload
+            {
+                    std::string filePath;
+                    std::future<TextureImage> image;
+            };
+
+            struct ShaderPreload
+            {
+                    std::string shaderPath;
+                    std::string shaderName;
+                    unsigned int features;
+                    std::future<ShaderSources> sources;
+            };
+
+            /**
+             * @brief Runs the job on the ThreadPool, noting when it finished.
+             */
+            template<typename F>
+            auto prepare(F&& job) -> std::future<std::invoke_result_t<F>>;
+
+            template<typename T>
+            static bool isReady(const std::future<T>& future)
+            {
+                return future.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+            };
+
+            std::vector<ObjectPreload> m_objects;
+            std::vector<TexturePreload> m_textures;
+            std::vector<ShaderPreload> m_shaders;
+
+            // Shared with the running jobs, in ticks of the steady clock
+            std::shared_ptr<std::atomic<std::chrono::steady_clock::rep>> m_lastPrepared;
+    };
+} // namespace Engine
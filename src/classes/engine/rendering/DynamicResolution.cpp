@@ -0,0 +1,133 @@
+#include "DynamicResolution.h"
+
+#include "../../../resources/shader/UpscaleShader.h"
+#include "backend/RenderBackend.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace Engine;
+
+DynamicResolution::DynamicResolution(const std::shared_ptr<RenderManager>& renderManager)
+    : m_upscaleShader(std::make_shared<UpscaleShader>(renderManager))
+    , m_enabled(false)
+    , m_targetFrameTime(12.f)
+    , m_minScale(0.5f)
+    , m_scale(MAX_SCALE)
+    , m_smoothedScale(MAX_SCALE)
+    , m_gpuFrameTime(0.f)
+    , m_timerQueries {}
+    , m_queryPending {}
+    , m_currentQuery(0)
+    , m_queryActive(false)
+{
+    for(GLuint& query : m_timerQueries)
+    {
+        query = RenderBackend::get().createQuery();
+    }
+}
+
+DynamicResolution::~DynamicResolution()
+{
+    for(GLuint query : m_timerQueries)
+    {
+        RenderBackend::get().deleteQuery(query);
+    }
+}
+
+void DynamicResolution::setEnabled(bool enabled)
+{
+    m_enabled = enabled;
+    m_scale = MAX_SCALE;
+    m_smoothedScale = MAX_SCALE;
+}
+
+float DynamicResolution::getSharpness() const { return m_upscaleShader->getSharpness(); }
+
+void DynamicResolution::setSharpness(float sharpness) { m_upscaleShader->setSharpness(sharpness); }
+
+glm::ivec2 DynamicResolution::beginScene(const glm::ivec2& nativeSize)
+{
+    readTimerQueries();
+
+    // A slot whose result hasn't arrived yet gets skipped instead of waiting for it
+    m_queryActive = !m_queryPending[m_currentQuery];
+    if(m_queryActive)
+    {
+        RenderBackend::get().beginQuery(GL_TIME_ELAPSED, m_timerQueries[m_currentQuery]);
+    }
+
+    if(!m_enabled)
+    {
+        return nativeSize;
+    }
+    return glm::max(glm::ivec2(glm::vec2(nativeSize) * m_scale + 0.5f), glm::ivec2(1));
+}
+
+void DynamicResolution::endScene()
+{
+    if(!m_queryActive)
+    {
+        return;
+    }
+
+    RenderBackend::get().endQuery(GL_TIME_ELAPSED);
+    m_queryPending[m_currentQuery] = true;
+    m_currentQuery = (m_currentQuery + 1) % QUERY_COUNT;
+    m_queryActive = false;
+}
+
+void DynamicResolution::upscale(GLuint sceneTexture, const glm::ivec2& sceneSize)
+{
+    // The upscale runs at native resolution, it mustn't feed back into the scale
+    endScene();
+
+    // The fullscreen pass must neither be depth tested nor drawn as wireframe
+    RenderBackend& backend = RenderBackend::get();
+    const GLenum polygonMode = backend.getPolygonMode();
+    backend.polygonMode(GL_FILL);
+    backend.disable(GL_DEPTH_TEST);
+    backend.disable(GL_BLEND);
+
+    m_upscaleShader->setSourceTexture(sceneTexture, sceneSize);
+    m_upscaleShader->renderVertices(nullptr, nullptr);
+
+    backend.enable(GL_DEPTH_TEST);
+    backend.polygonMode(polygonMode);
+}
+
+void DynamicResolution::readTimerQueries()
+{
+    for(int i = 0; i < QUERY_COUNT; ++i)
+    {
+        if(!m_queryPending[i])
+        {
+            continue;
+        }
+
+        GLuint64 elapsedNs = 0;
+        if(!RenderBackend::get().getQueryResult(m_timerQueries[i], elapsedNs))
+        {
+            continue;
+        }
+        m_queryPending[i] = false;
+
+        m_gpuFrameTime = float(double(elapsedNs) / 1000000.0);
+        updateScale();
+    }
+}
+
+void DynamicResolution::updateScale()
+{
+    if(!m_enabled || m_gpuFrameTime <= 0.f)
+    {
+        return;
+    }
+
+    // Fill cost grows with the pixel count, so the scale per axis follows the square root of the time ratio
+    const float budget = m_targetFrameTime * BUDGET_HEADROOM;
+    const float desiredScale = std::clamp(m_scale * std::sqrt(budget / m_gpuFrameTime), m_minScale, MAX_SCALE);
+
+    m_smoothedScale += (desiredScale - m_smoothedScale) * SCALE_SMOOTHING;
+    m_scale = std::clamp(std::round(m_smoothedScale / SCALE_STEP) * SCALE_STEP, m_minScale, MAX_SCALE);
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <array>
+#include <memory>
+
+#include <GL/glew.h>
+#include <glm/vec2.hpp>
+
+namespace Engine
+{
+    class RenderManager;
+    class UpscaleShader;
+
+    /**
+     * @brief Picks the resolution of the scene targets, following the GPU time of the scene.
+     *
+     * The scene passes are timed with GL_TIME_ELAPSED queries, read back a few frames later to never stall. Since the
+     * fill cost grows with the square of the scale, the controller picks the scale that would just fit the budget,
+     * smooths it and snaps it to fixed steps, so the render graph doesn't reallocate its targets every frame.
+     * The result is upscaled to the window with a sharpening filter, everything drawn afterwards (ImGui) stays native.
+     */
+    class DynamicResolution
+    {
+        public:
+            explicit DynamicResolution(const std::shared_ptr<RenderManager>& renderManager);
+            ~DynamicResolution();
+
+            /**
+             * @brief Starts timing the scene passes.
+             *
+             * @param nativeSize The size of the window framebuffer.
+             * @return The size the scene should be rendered at, nativeSize while disabled.
+             */
+            glm::ivec2 beginScene(const glm::ivec2& nativeSize);
+
+            /**
+             * @brief Stops the timing, does nothing if it already stopped.
+             */
+            void endScene();
+
+            /**
+             * @brief Stops the timing & draws the resolved scene texture over the bound framebuffer, sharpening it.
+             */
+            void upscale(GLuint sceneTexture, const glm::ivec2& sceneSize);
+
+            bool isEnabled() const { return m_enabled; };
+
+            void setEnabled(bool enabled);
+
+            /**
+             * @brief The GPU time budget of the scene pass in milliseconds.
+             */
+            float getTargetFrameTime() const { return m_targetFrameTime; };
+
+            void setTargetFrameTime(float milliseconds) { m_targetFrameTime = milliseconds; };
+
+            float getMinScale() const { return m_minScale; };
+
+            void setMinScale(float scale) { m_minScale = scale; };
+
+            float getSharpness() const;
+
+            void setSharpness(float sharpness);
+
+            /**
+             * @brief The current render scale per axis, 1 being native resolution.
+             */
+            float getScale() const { return m_enabled ? m_scale : 1.f; };
+
+            /**
+             * @brief The last measured GPU time of the scene pass in milliseconds.
+             */
+            float getGpuFrameTime() const { return m_gpuFrameTime; };
+
+        private:
+            void readTimerQueries();
+            void updateScale();
+
+            std::shared_ptr<UpscaleShader> m_upscaleShader;
+
+            bool m_enabled;
+            float m_targetFrameTime;
+            float m_minScale;
+            float m_scale;
+            float m_smoothedScale;
+            float m_gpuFrameTime;
+
+            static constexpr int QUERY_COUNT = 4;
+            std::array<GLuint, QUERY_COUNT> m_timerQueries;
+            std::array<bool, QUERY_COUNT> m_queryPending;
+            int m_currentQuery;
+            bool m_queryActive;
+
+            static constexpr float MAX_SCALE = 1.f;
+            static constexpr float SCALE_STEP = 0.05f;
+            static constexpr float SCALE_SMOOTHING = 0.1f;
+            static constexpr float BUDGET_HEADROOM = 0.9f;
+    };
+} // namespace Engine
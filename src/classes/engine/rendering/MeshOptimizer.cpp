@@ -0,0 +1,369 @@
+#include "MeshOptimizer.h"
+
+#include <algorithm>
+#include <numeric>
+
+using namespace Engine;
+
+namespace
+{
+    /**
+     * @brief Exact FIFO cache simulation. A miss stamps the vertex, it stays cached for the next cacheSize misses.
+     */
+    class FifoCache
+    {
+        public:
+            FifoCache(size_t vertexCount, unsigned int cacheSize)
+                : m_cacheSize(cacheSize)
+                , m_timestamp(cacheSize + 1)
+                , m_cacheTime(vertexCount, 0)
+            {
+            }
+
+            /**
+             * @return True if the vertex had to be transformed.
+             */
+            bool access(unsigned short vertex)
+            {
+                if(m_timestamp - m_cacheTime[vertex] <= m_cacheSize)
+                {
+                    return false;
+                }
+                m_cacheTime[vertex] = m_timestamp++;
+                return true;
+            }
+
+            unsigned int accessTriangle(const triData& triangle)
+            {
+                return access(std::get<0>(triangle)) + access(std::get<1>(triangle)) + access(std::get<2>(triangle));
+            }
+
+            void clear() { m_timestamp += m_cacheSize + 1; }
+
+        private:
+            unsigned int m_cacheSize;
+            unsigned int m_timestamp;
+            std::vector<unsigned int> m_cacheTime;
+    };
+} // namespace
+
+MeshOptimizationResult MeshOptimizer::optimize(CookedMesh& mesh)
+{
+    MeshOptimizationResult result;
+    result.before = analyzeVertexCache(mesh.triIndexData, mesh.vertexData.size());
+
+    std::vector<size_t> clusterStarts;
+    optimizeVertexCache(mesh.triIndexData, mesh.vertexData.size(), clusterStarts);
+    optimizeOverdraw(mesh.triIndexData, mesh.vertexData, std::move(clusterStarts));
+    optimizeVertexFetch(mesh);
+
+    result.after = analyzeVertexCache(mesh.triIndexData, mesh.vertexData.size());
+    return result;
+}
+
+void MeshOptimizer::optimizeVertexCache(
+        std::vector<triData>& triangles,
+        size_t vertexCount,
+        std::vector<size_t>& clusterStarts
+)
+{
+    clusterStarts.clear();
+    if(triangles.empty())
+    {
+        return;
+    }
+
+    // Triangles adjacent to every vertex, packed into one array
+    std::vector<unsigned int> liveTriangles(vertexCount, 0);
+    for(const triData& triangle : triangles)
+    {
+        liveTriangles[std::get<0>(triangle)]++;
+        liveTriangles[std::get<1>(triangle)]++;
+        liveTriangles[std::get<2>(triangle)]++;
+    }
+
+    std::vector<unsigned int> adjacencyOffsets(vertexCount + 1, 0);
+    std::partial_sum(liveTriangles.begin(), liveTriangles.end(), adjacencyOffsets.begin() + 1);
+
+    std::vector<unsigned int> adjacency(triangles.size() * 3);
+    std::vector<unsigned int> adjacencyCursor(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+    for(size_t i = 0; i < triangles.size(); i++)
+    {
+        adjacency[adjacencyCursor[std::get<0>(triangles[i])]++] = unsigned(i);
+        adjacency[adjacencyCursor[std::get<1>(triangles[i])]++] = unsigned(i);
+        adjacency[adjacencyCursor[std::get<2>(triangles[i])]++] = unsigned(i);
+    }
+
+    std::vector<unsigned int> cacheTime(vertexCount, 0);
+    std::vector<bool> emitted(triangles.size(), false);
+    std::vector<unsigned short> deadEnd;
+    std::vector<unsigned short> candidates;
+    std::vector<triData> output;
+    deadEnd.reserve(triangles.size() * 3);
+    output.reserve(triangles.size());
+
+    unsigned int timestamp = CACHE_SIZE + 1;
+    size_t cursor = 0;
+    int fanningVertex = 0;
+    bool restarted = true;
+
+    while(fanningVertex >= 0)
+    {
+        if(restarted && (clusterStarts.empty() || clusterStarts.back() != output.size()))
+        {
+            clusterStarts.push_back(output.size());
+        }
+
+        // Emit every remaining triangle around the fanning vertex
+        candidates.clear();
+        for(unsigned int i = adjacencyOffsets[fanningVertex]; i < adjacencyOffsets[fanningVertex + 1]; i++)
+        {
+            const unsigned int triangleIndex = adjacency[i];
+            if(emitted[triangleIndex])
+            {
+                continue;
+            }
+
+            const triData& triangle = triangles[triangleIndex];
+            for(unsigned short vertex : { std::get<0>(triangle), std::get<1>(triangle), std::get<2>(triangle) })
+            {
+                deadEnd.push_back(vertex);
+                candidates.push_back(vertex);
+                liveTriangles[vertex]--;
+                if(timestamp - cacheTime[vertex] > CACHE_SIZE)
+                {
+                    cacheTime[vertex] = timestamp++;
+                }
+            }
+
+            output.push_back(triangle);
+            emitted[triangleIndex] = true;
+        }
+
+        // Continue at the candidate that stays in the cache the longest while it still has triangles left, its
+        // triangles have to fit before it gets evicted
+        int nextVertex = -1;
+        int bestPriority = -1;
+        for(unsigned short vertex : candidates)
+        {
+            if(liveTriangles[vertex] == 0)
+            {
+                continue;
+            }
+
+            int priority = 0;
+            if(timestamp - cacheTime[vertex] + 2 * liveTriangles[vertex] <= CACHE_SIZE)
+            {
+                priority = int(timestamp - cacheTime[vertex]);
+            }
+            if(priority > bestPriority)
+            {
+                bestPriority = priority;
+                nextVertex = vertex;
+            }
+        }
+
+        // Dead end, fall back to recently used vertices, then to the next vertex in index order
+        restarted = nextVertex < 0;
+        while(nextVertex < 0 && !deadEnd.empty())
+        {
+            const unsigned short vertex = deadEnd.back();
+            deadEnd.pop_back();
+            if(liveTriangles[vertex] > 0)
+            {
+                nextVertex = vertex;
+            }
+        }
+        while(nextVertex < 0 && cursor < vertexCount)
+        {
+            if(liveTriangles[cursor] > 0)
+            {
+                nextVertex = int(cursor);
+            }
+            cursor++;
+        }
+
+        fanningVertex = nextVertex;
+    }
+
+    triangles = std::move(output);
+}
+
+void MeshOptimizer::optimizeOverdraw(
+        std::vector<triData>& triangles,
+        const std::vector<glm::vec3>& positions,
+        std::vector<size_t> clusterStarts,
+        float threshold /* = OVERDRAW_THRESHOLD */
+)
+{
+    if(triangles.empty() || clusterStarts.empty())
+    {
+        return;
+    }
+    clusterStarts.push_back(triangles.size());
+
+    // Split the clusters wherever a fresh cache start costs little compared to the whole mesh
+    const float meshAcmr = analyzeVertexCache(triangles, positions.size()).getAcmr();
+    FifoCache cache(positions.size(), CACHE_SIZE);
+    std::vector<size_t> splitStarts;
+    for(size_t cluster = 0; cluster + 1 < clusterStarts.size(); cluster++)
+    {
+        size_t start = clusterStarts[cluster];
+        unsigned int misses = 0;
+        cache.clear();
+        splitStarts.push_back(start);
+
+        for(size_t i = start; i < clusterStarts[cluster + 1]; i++)
+        {
+            misses += cache.accessTriangle(triangles[i]);
+            if(i + 1 < clusterStarts[cluster + 1] && float(misses) <= threshold * meshAcmr * float(i + 1 - start))
+            {
+                start = i + 1;
+                misses = 0;
+                cache.clear();
+                splitStarts.push_back(start);
+            }
+        }
+    }
+    splitStarts.push_back(triangles.size());
+
+    const auto getCentroid = [&positions](const triData& triangle)
+    {
+        return (positions[std::get<0>(triangle)] + positions[std::get<1>(triangle)] + positions[std::get<2>(triangle)]) /
+               3.f;
+    };
+    const auto getAreaNormal = [&positions](const triData& triangle)
+    {
+        const glm::vec3& a = positions[std::get<0>(triangle)];
+        return glm::cross(positions[std::get<1>(triangle)] - a, positions[std::get<2>(triangle)] - a);
+    };
+
+    glm::vec3 meshCentroid = glm::vec3(0.f);
+    float meshArea = 0.f;
+    for(const triData& triangle : triangles)
+    {
+        const float area = glm::length(getAreaNormal(triangle));
+        meshCentroid += getCentroid(triangle) * area;
+        meshArea += area;
+    }
+    meshCentroid = meshArea > 0.f ? meshCentroid / meshArea : glm::vec3(0.f);
+
+    // Clusters facing away from the center are likely in front of the rest, drawing them first lets the depth test
+    // reject more of what follows
+    struct ClusterOrder
+    {
+            size_t start;
+            size_t end;
+            float sortKey;
+    };
+    std::vector<ClusterOrder> clusters;
+    for(size_t cluster = 0; cluster + 1 < splitStarts.size(); cluster++)
+    {
+        glm::vec3 centroid = glm::vec3(0.f);
+        glm::vec3 normal = glm::vec3(0.f);
+        float area = 0.f;
+        for(size_t i = splitStarts[cluster]; i < splitStarts[cluster + 1]; i++)
+        {
+            const glm::vec3 areaNormal = getAreaNormal(triangles[i]);
+            const float triangleArea = glm::length(areaNormal);
+            centroid += getCentroid(triangles[i]) * triangleArea;
+            normal += areaNormal;
+            area += triangleArea;
+        }
+
+        const float normalLength = glm::length(normal);
+        float sortKey = 0.f;
+        if(area > 0.f && normalLength > 0.f)
+        {
+            sortKey = glm::dot(centroid / area - meshCentroid, normal / normalLength);
+        }
+        clusters.push_back({ splitStarts[cluster], splitStarts[cluster + 1], sortKey });
+    }
+
+    std::stable_sort(
+            clusters.begin(),
+            clusters.end(),
+            [](const ClusterOrder& a, const ClusterOrder& b) { return a.sortKey > b.sortKey; }
+    );
+
+    std::vector<triData> sorted;
+    sorted.reserve(triangles.size());
+    for(const ClusterOrder& cluster : clusters)
+    {
+        sorted.insert(sorted.end(), triangles.begin() + cluster.start, triangles.begin() + cluster.end);
+    }
+    triangles = std::move(sorted);
+}
+
+void MeshOptimizer::optimizeVertexFetch(CookedMesh& mesh)
+{
+    constexpr unsigned short UNUSED = 0xFFFF;
+    std::vector<unsigned short> remap(mesh.vertexData.size(), UNUSED);
+    unsigned short nextIndex = 0;
+
+    for(triData& triangle : mesh.triIndexData)
+    {
+        unsigned short* indices[3] = { &std::get<0>(triangle), &std::get<1>(triangle), &std::get<2>(triangle) };
+        for(unsigned short* index : indices)
+        {
+            if(remap[*index] == UNUSED)
+            {
+                remap[*index] = nextIndex++;
+            }
+            *index = remap[*index];
+        }
+    }
+
+    // Vertices no triangle references get dropped on the way
+    const auto reorder = [&remap, nextIndex](auto& data)
+    {
+        if(data.size() != remap.size())
+        {
+            return;
+        }
+
+        std::remove_reference_t<decltype(data)> reordered(nextIndex);
+        for(size_t i = 0; i < remap.size(); i++)
+        {
+            if(remap[i] != UNUSED)
+            {
+                reordered[remap[i]] = data[i];
+            }
+        }
+        data = std::move(reordered);
+    };
+
+    reorder(mesh.vertexNormals);
+    reorder(mesh.uvData);
+    reorder(mesh.vertexTangents);
+    reorder(mesh.boneIndices);
+    reorder(mesh.boneWeights);
+    reorder(mesh.vertexData);
+}
+
+MeshCacheStatistics MeshOptimizer::analyzeVertexCache(
+        const std::vector<triData>& triangles,
+        size_t vertexCount,
+        unsigned int cacheSize /* = CACHE_SIZE */
+)
+{
+    MeshCacheStatistics statistics;
+    statistics.triangleCount = unsigned(triangles.size());
+
+    FifoCache cache(vertexCount, cacheSize);
+    std::vector<bool> referenced(vertexCount, false);
+    for(const triData& triangle : triangles)
+    {
+        statistics.transformedVertices += cache.accessTriangle(triangle);
+        for(unsigned short vertex : { std::get<0>(triangle), std::get<1>(triangle), std::get<2>(triangle) })
+        {
+            if(!referenced[vertex])
+            {
+                referenced[vertex] = true;
+                statistics.vertexCount++;
+            }
+        }
+    }
+
+    return statistics;
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#include "../../helper/CookedModel.h"
+
+#include <vector>
+
+namespace Engine
+{
+    /**
+     * @brief Post-transform cache statistics of an index order, simulated with a FIFO cache.
+     */
+    struct MeshCacheStatistics
+    {
+            unsigned int triangleCount = 0;
+            unsigned int vertexCount = 0;
+            unsigned int transformedVertices = 0;
+
+            /**
+             * @brief Average cache miss ratio, vertex shader invocations per triangle. 0.5 is the ideal for large
+             * grid like meshes, 3 means no reuse at all.
+             */
+            float getAcmr() const { return triangleCount ? float(transformedVertices) / float(triangleCount) : 0.f; };
+
+            /**
+             * @brief Average transform to vertex ratio, vertex shader invocations per unique vertex. 1 is the ideal.
+             */
+            float getAtvr() const { return vertexCount ? float(transformedVertices) / float(vertexCount) : 0.f; };
+
+            MeshCacheStatistics& operator+=(const MeshCacheStatistics& other)
+            {
+                triangleCount += other.triangleCount;
+                vertexCount += other.vertexCount;
+                transformedVertices += other.transformedVertices;
+                return *this;
+            }
+    };
+
+    struct MeshOptimizationResult
+    {
+            MeshCacheStatistics before;
+            MeshCacheStatistics after;
+    };
+
+    /**
+     * @brief Reorders triangles & vertices of a cooked mesh, so a draw transforms & fetches fewer vertices.
+     *
+     * Runs in three steps: Tipsify reorders the triangles for the post-transform cache, the resulting clusters get
+     * sorted so outward facing parts of the mesh are drawn first (less overdraw), and finally the vertices get
+     * renumbered in the order the triangles use them (linear vertex fetches). Only index & vertex order change, the
+     * rendered result stays the same.
+     */
+    class MeshOptimizer
+    {
+        public:
+            /**
+             * @brief Runs all optimization steps on a mesh.
+             *
+             * @param mesh The mesh to reorder in place.
+             * @return The cache statistics before & after the optimization.
+             */
+            static MeshOptimizationResult optimize(CookedMesh& mesh);
+
+            /**
+             * @brief Reorders the triangles for the post-transform cache (Sander, Nehab & Barczak - Tipsify).
+             *
+             * @param triangles The triangles to reorder.
+             * @param vertexCount The amount of vertices the triangles index.
+             * @param clusterStarts Receives the first triangle of every cluster, a new cluster begins wherever the
+             * algorithm had to restart at a vertex outside of the cache.
+             */
+            static void optimizeVertexCache(
+                    std::vector<triData>& triangles,
+                    size_t vertexCount,
+                    std::vector<size_t>& clusterStarts
+            );
+
+            /**
+             * @brief Sorts the clusters of a cache optimized mesh front to back in the direction they face.
+             *
+             * Clusters get split further where the cache order allows it, as long as the cluster keeps an ACMR below
+             * threshold times the ACMR of the whole mesh.
+             */
+            static void optimizeOverdraw(
+                    std::vector<triData>& triangles,
+                    const std::vector<glm::vec3>& positions,
+                    std::vector<size_t> clusterStarts,
+                    float threshold = OVERDRAW_THRESHOLD
+            );
+
+            /**
+             * @brief Renumbers the vertices in the order the triangles first use them. Unreferenced vertices are
+             * dropped.
+             */
+            static void optimizeVertexFetch(CookedMesh& mesh);
+
+            static MeshCacheStatistics analyzeVertexCache(
+                    const std::vector<triData>& triangles,
+                    size_t vertexCount,
+                    unsigned int cacheSize = CACHE_SIZE
+            );
+
+            static constexpr unsigned int CACHE_SIZE = 16;
+            static constexpr float OVERDRAW_THRESHOLD = 1.05f;
+    };
+} // namespace Engine
@@ -0,0 +1,581 @@
+#include "ModelImporter.h"
+
+#include "../ThreadPool.h"
+#include "MeshOptimizer.h"
+
+#include <assimp/Importer.hpp>
+#include <assimp/config.h>
+#include <assimp/postprocess.h>
+#include <assimp/scene.h>
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <chrono>
+#include <iostream>
+#include <unordered_map>
+
+using namespace Engine;
+
+namespace
+{
+    glm::mat4 toMat4(const aiMatrix4x4& matrix)
+    {
+        // assimp matrices are row major
+        return glm::mat4(
+                glm::vec4(matrix.a1, matrix.b1, matrix.c1, matrix.d1),
+                glm::vec4(matrix.a2, matrix.b2, matrix.c2, matrix.d2),
+                glm::vec4(matrix.a3, matrix.b3, matrix.c3, matrix.d3),
+                glm::vec4(matrix.a4, matrix.b4, matrix.c4, matrix.d4)
+        );
+    }
+
+    glm::vec4 toQuaternion(const aiQuaternion& rotation)
+    {
+        return glm::vec4(rotation.x, rotation.y, rotation.z, rotation.w);
+    }
+
+    void addJoints(const aiNode* node, int parent, Skeleton& skeleton, std::unordered_map<const aiNode*, int>& jointIndices)
+    {
+        aiVector3D scale, position;
+        aiQuaternion rotation;
+        node->mTransformation.Decompose(scale, rotation, position);
+
+        const int index = int(skeleton.joints.size());
+        SkeletonJoint& joint = skeleton.joints.emplace_back();
+        joint.name = node->mName.C_Str();
+        joint.parent = parent;
+        joint.translation = glm::vec4(position.x, position.y, position.z, 0.f);
+        joint.rotation = toQuaternion(rotation);
+        joint.scale = glm::vec4(scale.x, scale.y, scale.z, 0.f);
+        jointIndices[node] = index;
+
+        // Depth first, so parents always come before their children
+        for(unsigned int i = 0; i < node->mNumChildren; i++)
+        {
+            addJoints(node->mChildren[i], index, skeleton, jointIndices);
+        }
+    }
+} // namespace
+
+bool ModelImporter::loadModel(const std::string& filePath, CookedModel& model, bool skinned /* = false */)
+{
+    const CookedSourceStamp stamp = getCookedSourceStamp(filePath);
+    const std::string cookedPath = getCookedPath(filePath, skinned);
+
+    if(readCookedModel(cookedPath, model, stamp))
+    {
+        return true;
+    }
+
+    if(!importModel(filePath, model, skinned))
+    {
+        return false;
+    }
+
+    // A failed write only costs the next load another import
+    writeCookedModel(cookedPath, model, stamp);
+    return true;
+}
+
+bool ModelImporter::importModel(const std::string& filePath, CookedModel& model, bool skinned /* = false */)
+{
+    const auto startTime = std::chrono::steady_clock::now();
+
+    Assimp::Importer importer;
+    // Indices are 16 bit, so meshes get split before they could address more vertices
+    importer.SetPropertyInteger(AI_CONFIG_PP_SLM_VERTEX_LIMIT, MAX_MESH_VERTICES);
+    importer.SetPropertyInteger(AI_CONFIG_PP_SBP_REMOVE, aiPrimitiveType_POINT | aiPrimitiveType_LINE);
+    importer.SetPropertyInteger(AI_CONFIG_PP_LBW_MAX_WEIGHTS, MAX_BONE_INFLUENCES);
+
+    // Only the steps needing the whole scene run inside assimp, the per mesh work is done on the ThreadPool below.
+    // Skinned models keep their hierarchy, it becomes the skeleton instead of getting baked into the vertices
+    const unsigned int hierarchySteps = skinned ? aiProcess_LimitBoneWeights : aiProcess_PreTransformVertices;
+    const aiScene* scene = importer.ReadFile(
+            filePath.c_str(),
+            aiProcess_Triangulate | aiProcess_JoinIdenticalVertices | aiProcess_SortByPType |
+                    aiProcess_SplitLargeMeshes | aiProcess_FindDegenerates | hierarchySteps
+    );
+    if(scene == nullptr || (scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE))
+    {
+        std::cout << "Couldn't import model [" << filePath << "]: " << importer.GetErrorString() << std::endl;
+        return false;
+    }
+
+    model.materials.clear();
+    for(unsigned int i = 0; i < scene->mNumMaterials; i++)
+    {
+        model.materials.push_back(convertMaterial(scene, i));
+    }
+
+    model.skeleton = Skeleton();
+    std::vector<std::vector<int>> meshBones;
+    if(skinned)
+    {
+        meshBones = convertSkeleton(scene, model.skeleton);
+    }
+
+    model.meshes.clear();
+    model.meshes.resize(scene->mNumMeshes);
+    std::vector<MeshOptimizationResult> optimizationResults(scene->mNumMeshes);
+    SingletonManager::get<ThreadPool>()->parallelFor(
+            scene->mNumMeshes,
+            [scene, &model, &optimizationResults, &meshBones](size_t begin, size_t end)
+            {
+                for(size_t i = begin; i < end; i++)
+                {
+                    CookedMesh& mesh = model.meshes[i];
+                    mesh = convertMesh(scene, unsigned(i));
+                    if(!mesh.valid)
+                    {
+                        continue;
+                    }
+
+                    if(!meshBones.empty())
+                    {
+                        convertSkin(scene->mMeshes[i], meshBones[i], mesh);
+                    }
+
+                    if(mesh.vertexNormals.empty())
+                    {
+                        generateNormals(mesh);
+                    }
+                    optimizationResults[i] = MeshOptimizer::optimize(mesh);
+                    generateTangents(mesh);
+                }
+            },
+            1
+    );
+
+    std::erase_if(model.meshes, [](const CookedMesh& mesh) { return !mesh.valid; });
+
+    MeshOptimizationResult total;
+    for(const MeshOptimizationResult& result : optimizationResults)
+    {
+        total.before += result.before;
+        total.after += result.after;
+    }
+
+    const auto duration = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime);
+    std::cout << "Imported model [" << filePath << "] with " << model.meshes.size() << " meshes, "
+              << model.skeleton.bones.size() << " bones & " << model.skeleton.clips.size() << " animations in "
+              << duration.count() << "ms (ACMR " << total.before.getAcmr() << " -> " << total.after.getAcmr()
+              << ", ATVR " << total.before.getAtvr() << " -> " << total.after.getAtvr() << ")" << std::endl;
+
+    return !model.meshes.empty();
+}
+
+bool ModelImporter::isImportedFormat(const std::string& filePath)
+{
+    const size_t dotIndex = filePath.find_last_of('.');
+    if(dotIndex == std::string::npos)
+    {
+        return false;
+    }
+
+    std::string fileExtension = filePath.substr(dotIndex + 1);
+    std::transform(fileExtension.begin(), fileExtension.end(), fileExtension.begin(), ::tolower);
+    return fileExtension != "obj";
+}
+
+CookedMesh ModelImporter::mergeMeshes(const CookedModel& model)
+{
+    CookedMesh merged;
+    if(model.meshes.empty())
+    {
+        return merged;
+    }
+
+    size_t vertexCount = 0;
+    bool hasUvs = true, hasNormals = true, hasTangents = true, hasBones = true;
+    for(const CookedMesh& mesh : model.meshes)
+    {
+        vertexCount += mesh.vertexData.size();
+        hasUvs = hasUvs && mesh.uvData.size() == mesh.vertexData.size();
+        hasNormals = hasNormals && mesh.vertexNormals.size() == mesh.vertexData.size();
+        hasTangents = hasTangents && mesh.vertexTangents.size() == mesh.vertexData.size();
+        hasBones = hasBones && mesh.boneIndices.size() == mesh.vertexData.size();
+    }
+
+    if(vertexCount > MAX_MESH_VERTICES)
+    {
+        return merged;
+    }
+
+    merged.name = model.meshes.front().name;
+    merged.materialIndex = model.meshes.front().materialIndex;
+
+    // Attributes only some of the meshes have get dropped, the buffers have to line up with the vertices
+    for(const CookedMesh& mesh : model.meshes)
+    {
+        const auto offset = (unsigned short)(merged.vertexData.size());
+        merged.vertexData.insert(merged.vertexData.end(), mesh.vertexData.begin(), mesh.vertexData.end());
+        if(hasUvs)
+        {
+            merged.uvData.insert(merged.uvData.end(), mesh.uvData.begin(), mesh.uvData.end());
+        }
+        if(hasNormals)
+        {
+            merged.vertexNormals.insert(merged.vertexNormals.end(), mesh.vertexNormals.begin(), mesh.vertexNormals.end());
+        }
+        if(hasTangents)
+        {
+            merged.vertexTangents.insert(
+                    merged.vertexTangents.end(),
+                    mesh.vertexTangents.begin(),
+                    mesh.vertexTangents.end()
+            );
+        }
+        if(hasBones)
+        {
+            merged.boneIndices.insert(merged.boneIndices.end(), mesh.boneIndices.begin(), mesh.boneIndices.end());
+            merged.boneWeights.insert(merged.boneWeights.end(), mesh.boneWeights.begin(), mesh.boneWeights.end());
+        }
+
+        for(const triData& tri : mesh.triIndexData)
+        {
+            merged.triIndexData.emplace_back(
+                    std::get<0>(tri) + offset,
+                    std::get<1>(tri) + offset,
+                    std::get<2>(tri) + offset
+            );
+        }
+    }
+
+    merged.valid = true;
+    return merged;
+}
+
+CookedMaterial ModelImporter::convertMaterial(const aiScene* scene, unsigned int materialIndex)
+{
+    const aiMaterial* sourceMaterial = scene->mMaterials[materialIndex];
+
+    CookedMaterial material;
+    material.name = sourceMaterial->GetName().C_Str();
+
+    // glTF stores a base color, most other formats a diffuse color
+    aiColor4D color;
+    if(sourceMaterial->Get(AI_MATKEY_BASE_COLOR, color) == aiReturn_SUCCESS ||
+       sourceMaterial->Get(AI_MATKEY_COLOR_DIFFUSE, color) == aiReturn_SUCCESS)
+    {
+        material.diffuseColor = glm::vec4(color.r, color.g, color.b, color.a);
+    }
+
+    aiString texturePath;
+    if(sourceMaterial->GetTexture(aiTextureType_BASE_COLOR, 0, &texturePath) == aiReturn_SUCCESS ||
+       sourceMaterial->GetTexture(aiTextureType_DIFFUSE, 0, &texturePath) == aiReturn_SUCCESS)
+    {
+        // Embedded textures are referenced as "*<index>" & aren't supported
+        if(texturePath.length > 0 && texturePath.C_Str()[0] != '*')
+        {
+            material.diffuseTexture = texturePath.C_Str();
+        }
+    }
+
+    return material;
+}
+
+CookedMesh ModelImporter::convertMesh(const aiScene* scene, unsigned int meshIndex)
+{
+    const aiMesh* sourceMesh = scene->mMeshes[meshIndex];
+
+    CookedMesh mesh;
+    mesh.name = sourceMesh->mName.C_Str();
+    mesh.materialIndex = sourceMesh->mMaterialIndex;
+
+    if(sourceMesh->mNumVertices > MAX_MESH_VERTICES || !(sourceMesh->mPrimitiveTypes & aiPrimitiveType_TRIANGLE))
+    {
+        return mesh;
+    }
+
+    mesh.vertexData.resize(sourceMesh->mNumVertices);
+    for(unsigned int i = 0; i < sourceMesh->mNumVertices; i++)
+    {
+        const aiVector3D& vertex = sourceMesh->mVertices[i];
+        mesh.vertexData[i] = glm::vec3(vertex.x, vertex.y, vertex.z);
+    }
+
+    if(sourceMesh->HasNormals())
+    {
+        mesh.vertexNormals.resize(sourceMesh->mNumVertices);
+        for(unsigned int i = 0; i < sourceMesh->mNumVertices; i++)
+        {
+            const aiVector3D& normal = sourceMesh->mNormals[i];
+            mesh.vertexNormals[i] = glm::vec3(normal.x, normal.y, normal.z);
+        }
+    }
+
+    if(sourceMesh->HasTextureCoords(0))
+    {
+        mesh.uvData.resize(sourceMesh->mNumVertices);
+        for(unsigned int i = 0; i < sourceMesh->mNumVertices; i++)
+        {
+            const aiVector3D& uv = sourceMesh->mTextureCoords[0][i];
+            mesh.uvData[i] = glm::vec2(uv.x, uv.y);
+        }
+    }
+
+    mesh.triIndexData.reserve(sourceMesh->mNumFaces);
+    for(unsigned int i = 0; i < sourceMesh->mNumFaces; i++)
+    {
+        const aiFace& face = sourceMesh->mFaces[i];
+        if(face.mNumIndices != 3)
+        {
+            continue;
+        }
+        mesh.triIndexData.emplace_back(face.mIndices[0], face.mIndices[1], face.mIndices[2]);
+    }
+
+    mesh.valid = !mesh.triIndexData.empty();
+    return mesh;
+}
+
+std::vector<std::vector<int>> ModelImporter::convertSkeleton(const aiScene* scene, Skeleton& skeleton)
+{
+    std::unordered_map<const aiNode*, int> jointIndices;
+    addJoints(scene->mRootNode, -1, skeleton, jointIndices);
+
+    std::unordered_map<std::string, int> jointsByName;
+    for(size_t i = 0; i < skeleton.joints.size(); i++)
+    {
+        jointsByName.emplace(skeleton.joints[i].name, int(i));
+    }
+
+    // Vertices of a mesh without bones only follow the node the mesh is attached to
+    std::vector<int> meshJoints(scene->mNumMeshes, 0);
+    for(const auto& [node, joint] : jointIndices)
+    {
+        for(unsigned int i = 0; i < node->mNumMeshes; i++)
+        {
+            if(meshJoints[node->mMeshes[i]] == 0)
+            {
+                meshJoints[node->mMeshes[i]] = joint;
+            }
+        }
+    }
+
+    // Meshes sharing a joint share its bone, the palette only holds every joint once
+    std::unordered_map<int, int> bonesByJoint;
+    const auto addBone = [&skeleton, &bonesByJoint](int joint, const glm::mat4& inverseBindMatrix)
+    {
+        const auto [bone, inserted] = bonesByJoint.emplace(joint, int(skeleton.bones.size()));
+        if(inserted)
+        {
+            skeleton.bones.push_back({ joint, inverseBindMatrix });
+        }
+        return bone->second;
+    };
+
+    std::vector<std::vector<int>> meshBones(scene->mNumMeshes);
+    for(unsigned int meshIndex = 0; meshIndex < scene->mNumMeshes; meshIndex++)
+    {
+        const aiMesh* sourceMesh = scene->mMeshes[meshIndex];
+        if(!sourceMesh->HasBones())
+        {
+            meshBones[meshIndex].push_back(addBone(meshJoints[meshIndex], glm::mat4(1.f)));
+            continue;
+        }
+
+        for(unsigned int i = 0; i < sourceMesh->mNumBones; i++)
+        {
+            const aiBone* bone = sourceMesh->mBones[i];
+            const auto joint = jointsByName.find(bone->mName.C_Str());
+            if(joint == jointsByName.end())
+            {
+                std::cout << "Bone " << bone->mName.C_Str() << " has no node, its vertices stay in place" << std::endl;
+                meshBones[meshIndex].push_back(addBone(0, glm::mat4(1.f)));
+                continue;
+            }
+            meshBones[meshIndex].push_back(addBone(joint->second, toMat4(bone->mOffsetMatrix)));
+        }
+    }
+
+    for(unsigned int animationIndex = 0; animationIndex < scene->mNumAnimations; animationIndex++)
+    {
+        const aiAnimation* animation = scene->mAnimations[animationIndex];
+        const double ticksPerSecond = animation->mTicksPerSecond > 0.0 ? animation->mTicksPerSecond : 25.0;
+        const auto toSeconds = [ticksPerSecond](double ticks) { return float(ticks / ticksPerSecond); };
+
+        AnimationClip& clip = skeleton.clips.emplace_back();
+        clip.name = animation->mName.C_Str();
+        clip.duration = toSeconds(animation->mDuration);
+
+        for(unsigned int channelIndex = 0; channelIndex < animation->mNumChannels; channelIndex++)
+        {
+            const aiNodeAnim* sourceChannel = animation->mChannels[channelIndex];
+            const auto joint = jointsByName.find(sourceChannel->mNodeName.C_Str());
+            if(joint == jointsByName.end())
+            {
+                continue;
+            }
+
+            AnimationChannel& channel = clip.channels.emplace_back();
+            channel.joint = joint->second;
+            for(unsigned int i = 0; i < sourceChannel->mNumPositionKeys; i++)
+            {
+                const aiVectorKey& key = sourceChannel->mPositionKeys[i];
+                channel.translationTimes.push_back(toSeconds(key.mTime));
+                channel.translations.emplace_back(key.mValue.x, key.mValue.y, key.mValue.z, 0.f);
+            }
+            for(unsigned int i = 0; i < sourceChannel->mNumRotationKeys; i++)
+            {
+                const aiQuatKey& key = sourceChannel->mRotationKeys[i];
+                channel.rotationTimes.push_back(toSeconds(key.mTime));
+                channel.rotations.push_back(toQuaternion(key.mValue));
+            }
+            for(unsigned int i = 0; i < sourceChannel->mNumScalingKeys; i++)
+            {
+                const aiVectorKey& key = sourceChannel->mScalingKeys[i];
+                channel.scaleTimes.push_back(toSeconds(key.mTime));
+                channel.scales.emplace_back(key.mValue.x, key.mValue.y, key.mValue.z, 0.f);
+            }
+        }
+    }
+
+    return meshBones;
+}
+
+void ModelImporter::convertSkin(const aiMesh* sourceMesh, const std::vector<int>& meshBones, CookedMesh& mesh)
+{
+    mesh.boneIndices.assign(mesh.vertexData.size(), glm::uvec4(0));
+    mesh.boneWeights.assign(mesh.vertexData.size(), glm::vec4(0.f));
+
+    if(!sourceMesh->HasBones())
+    {
+        std::fill(mesh.boneIndices.begin(), mesh.boneIndices.end(), glm::uvec4(meshBones.front(), 0, 0, 0));
+        std::fill(mesh.boneWeights.begin(), mesh.boneWeights.end(), glm::vec4(1.f, 0.f, 0.f, 0.f));
+        return;
+    }
+
+    // Keeps the strongest influences in descending order, replacing the weakest one when full
+    for(unsigned int boneIndex = 0; boneIndex < sourceMesh->mNumBones; boneIndex++)
+    {
+        const aiBone* bone = sourceMesh->mBones[boneIndex];
+        for(unsigned int i = 0; i < bone->mNumWeights; i++)
+        {
+            const aiVertexWeight& influence = bone->mWeights[i];
+            if(influence.mVertexId >= mesh.vertexData.size())
+            {
+                continue;
+            }
+
+            glm::uvec4& indices = mesh.boneIndices[influence.mVertexId];
+            glm::vec4& weights = mesh.boneWeights[influence.mVertexId];
+            int slot = MAX_BONE_INFLUENCES - 1;
+            if(influence.mWeight <= weights[slot])
+            {
+                continue;
+            }
+            for(; slot > 0 && weights[slot - 1] < influence.mWeight; slot--)
+            {
+                weights[slot] = weights[slot - 1];
+                indices[slot] = indices[slot - 1];
+            }
+            weights[slot] = influence.mWeight;
+            indices[slot] = unsigned(meshBones[boneIndex]);
+        }
+    }
+
+    for(size_t i = 0; i < mesh.boneWeights.size(); i++)
+    {
+        glm::vec4& weights = mesh.boneWeights[i];
+        const float total = weights.x + weights.y + weights.z + weights.w;
+        if(total > 0.f)
+        {
+            weights /= total;
+        }
+        else
+        {
+            // Unweighted vertices follow the first bone of the mesh
+            mesh.boneIndices[i] = glm::uvec4(meshBones.front(), 0, 0, 0);
+            weights = glm::vec4(1.f, 0.f, 0.f, 0.f);
+        }
+    }
+}
+
+void ModelImporter::generateNormals(CookedMesh& mesh)
+{
+    mesh.vertexNormals.assign(mesh.vertexData.size(), glm::vec3(0.f));
+
+    // The unnormalized cross product weighs every face by its area
+    for(const triData& tri : mesh.triIndexData)
+    {
+        const glm::vec3& a = mesh.vertexData[std::get<0>(tri)];
+        const glm::vec3& b = mesh.vertexData[std::get<1>(tri)];
+        const glm::vec3& c = mesh.vertexData[std::get<2>(tri)];
+        const glm::vec3 faceNormal = glm::cross(b - a, c - a);
+
+        mesh.vertexNormals[std::get<0>(tri)] += faceNormal;
+        mesh.vertexNormals[std::get<1>(tri)] += faceNormal;
+        mesh.vertexNormals[std::get<2>(tri)] += faceNormal;
+    }
+
+    for(glm::vec3& normal : mesh.vertexNormals)
+    {
+        const float length = glm::length(normal);
+        normal = length > 0.f ? normal / length : glm::vec3(0.f, 1.f, 0.f);
+    }
+}
+
+void ModelImporter::generateTangents(CookedMesh& mesh)
+{
+    mesh.vertexTangents.clear();
+    if(mesh.uvData.size() != mesh.vertexData.size() || mesh.vertexNormals.size() != mesh.vertexData.size())
+    {
+        return;
+    }
+
+    std::vector<glm::vec3> tangents(mesh.vertexData.size(), glm::vec3(0.f));
+    std::vector<glm::vec3> bitangents(mesh.vertexData.size(), glm::vec3(0.f));
+
+    for(const triData& tri : mesh.triIndexData)
+    {
+        const unsigned short indices[3] = { std::get<0>(tri), std::get<1>(tri), std::get<2>(tri) };
+
+        const glm::vec3 edgeA = mesh.vertexData[indices[1]] - mesh.vertexData[indices[0]];
+        const glm::vec3 edgeB = mesh.vertexData[indices[2]] - mesh.vertexData[indices[0]];
+        const glm::vec2 uvEdgeA = mesh.uvData[indices[1]] - mesh.uvData[indices[0]];
+        const glm::vec2 uvEdgeB = mesh.uvData[indices[2]] - mesh.uvData[indices[0]];
+
+        const float determinant = uvEdgeA.x * uvEdgeB.y - uvEdgeB.x * uvEdgeA.y;
+        if(std::abs(determinant) < 1e-12f)
+        {
+            continue;
+        }
+
+        const float inverse = 1.f / determinant;
+        const glm::vec3 tangent = (edgeA * uvEdgeB.y - edgeB * uvEdgeA.y) * inverse;
+        const glm::vec3 bitangent = (edgeB * uvEdgeA.x - edgeA * uvEdgeB.x) * inverse;
+
+        for(unsigned short index : indices)
+        {
+            tangents[index] += tangent;
+            bitangents[index] += bitangent;
+        }
+    }
+
+    mesh.vertexTangents.resize(mesh.vertexData.size());
+    for(size_t i = 0; i < mesh.vertexData.size(); i++)
+    {
+        const glm::vec3& normal = mesh.vertexNormals[i];
+
+        // Gram-Schmidt, so the tangent frame stays orthogonal after averaging
+        glm::vec3 tangent = tangents[i] - normal * glm::dot(normal, tangents[i]);
+        const float length = glm::length(tangent);
+        if(length > 0.f)
+        {
+            tangent /= length;
+        }
+        else
+        {
+            // Any vector perpendicular to the normal will do for vertices without a usable uv layout
+            tangent = glm::normalize(glm::cross(
+                    normal,
+                    std::abs(normal.y) < 0.99f ? glm::vec3(0.f, 1.f, 0.f) : glm::vec3(1.f, 0.f, 0.f)
+            ));
+        }
+
+        const float handedness = glm::dot(glm::cross(normal, tangent), bitangents[i]) < 0.f ? -1.f : 1.f;
+        mesh.vertexTangents[i] = glm::vec4(tangent, handedness);
+    }
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "../../helper/CookedModel.h"
+
+#include <string>
+
+struct aiMesh;
+struct aiNode;
+struct aiScene;
+
+namespace Engine
+{
+    /**
+     * @brief Imports glTF, FBX & every other format assimp understands into the engines cooked model format.
+     *
+     * assimp only runs the steps that need the whole scene (triangulation, splitting into meshes the 16 bit indices
+     * can address, flattening the node hierarchy). Normals, tangents and the vertex order get computed per mesh on the
+     * ThreadPool. The result is written next to the source file, every later load reads the cooked file instead.
+     */
+    class ModelImporter
+    {
+        public:
+            /**
+             * @brief Loads the cooked model of a source file, importing & cooking it first if the cache is missing or
+             * outdated.
+             *
+             * @param filePath The path to the source model.
+             * @param model The model to fill.
+             * @param skinned Keeps the node hierarchy as skeleton with its animations & binds every vertex to its
+             * bones, instead of baking the hierarchy into the vertices. Cooked separately from the static variant.
+             * @return True if the model was loaded successfully, false otherwise.
+             */
+            static bool loadModel(const std::string& filePath, CookedModel& model, bool skinned = false);
+
+            /**
+             * @brief Imports a source file with assimp, ignoring & not touching the cooked cache.
+             */
+            static bool importModel(const std::string& filePath, CookedModel& model, bool skinned = false);
+
+            static std::string getCookedPath(const std::string& filePath, bool skinned = false)
+            {
+                return filePath + (skinned ? ".skinned.cmdl" : ".cmdl");
+            };
+
+            /**
+             * @return Whether the file extension is one the importer should handle instead of the OBJ loader.
+             */
+            static bool isImportedFormat(const std::string& filePath);
+
+            /**
+             * @brief Merges all meshes of a model into one, for callers wanting a single object.
+             *
+             * @return The merged mesh, invalid if the model has more vertices than 16 bit indices can address.
+             */
+            static CookedMesh mergeMeshes(const CookedModel& model);
+
+            /**
+             * @brief Computes area weighted smooth normals, used when the source has none.
+             */
+            static void generateNormals(CookedMesh& mesh);
+
+            /**
+             * @brief Computes per vertex tangents from the uv layout, orthogonalized against the normals.
+             */
+            static void generateTangents(CookedMesh& mesh);
+
+        private:
+            static CookedMaterial convertMaterial(const aiScene* scene, unsigned int materialIndex);
+            static CookedMesh convertMesh(const aiScene* scene, unsigned int meshIndex);
+
+            /**
+             * @brief Converts the node hierarchy, the bones of all meshes & the animations.
+             *
+             * @return Per mesh the skin bone index of each of its aiBones. Meshes without bones get the joint of the
+             * node they are attached to as their only bone.
+             */
+            static std::vector<std::vector<int>> convertSkeleton(const aiScene* scene, Skeleton& skeleton);
+
+            /**
+             * @brief Fills the bone indices & weights of a mesh, keeping the 4 strongest influences per vertex.
+             */
+            static void convertSkin(const aiMesh* sourceMesh, const std::vector<int>& meshBones, CookedMesh& mesh);
+
+            static constexpr unsigned int MAX_BONE_INFLUENCES = 4;
+
+            static constexpr unsigned int MAX_MESH_VERTICES = 0xFFFF;
+    };
+} // namespace Engine
@@ -0,0 +1,138 @@
+#include "ObjectPicker.h"
+
+#include "../../../resources/shader/PickingShader.h"
+#include "../../nodeComponents/GeometryComponent.h"
+#include "backend/RenderBackend.h"
+
+#include <cstring>
+
+using namespace Engine;
+
+ObjectPicker::ObjectPicker(const std::shared_ptr<RenderManager>& renderManager)
+    : m_shader(std::make_shared<PickingShader>(renderManager, false))
+    , m_skinnedShader(std::make_shared<PickingShader>(renderManager, true))
+    , m_pickRequested(false)
+    , m_requestedPixel(0)
+{
+}
+
+ObjectPicker::~ObjectPicker()
+{
+    reset();
+
+    RenderBackend& backend = RenderBackend::get();
+    for(const GLuint buffer : m_freeBuffers)
+    {
+        backend.deleteBuffer(buffer);
+    }
+}
+
+void ObjectPicker::requestPick(const glm::ivec2& pixel)
+{
+    m_pickRequested = true;
+    m_requestedPixel = pixel;
+}
+
+void ObjectPicker::drawIds(
+        Nodes::const_iterator begin,
+        Nodes::const_iterator end,
+        CameraComponent* camera,
+        const glm::ivec2& framebufferSize,
+        const glm::ivec2& targetSize
+)
+{
+    m_pickRequested = false;
+
+    // GL counts rows from the bottom
+    glm::ivec2 pixel = m_requestedPixel * targetSize / glm::max(framebufferSize, glm::ivec2(1));
+    pixel.y = targetSize.y - 1 - pixel.y;
+    pixel = glm::clamp(pixel, glm::ivec2(0), targetSize - 1);
+
+    RenderBackend& backend = RenderBackend::get();
+    backend.enable(GL_SCISSOR_TEST);
+    backend.scissor(pixel, glm::ivec2(1));
+    backend.clearColorBuffer(0, glm::uvec4(0));
+    backend.clear(GL_DEPTH_BUFFER_BIT);
+
+    for(auto it = begin; it != end; ++it)
+    {
+        const auto& shader = (*it)->getShader();
+        if(shader->hasFeature(SHADER_FEATURE_INSTANCED))
+        {
+            continue;
+        }
+
+        PickingShader& pickingShader = shader->hasFeature(SHADER_FEATURE_SKINNED) ? *m_skinnedShader : *m_shader;
+        pickingShader.renderNode(*it, camera);
+    }
+
+    Readback readback;
+    readback.buffer = acquireBuffer();
+    readback.pixel = m_requestedPixel;
+
+    backend.bindBuffer(GL_PIXEL_PACK_BUFFER, readback.buffer);
+    backend.readPixels(pixel, glm::ivec2(1), GL_RED_INTEGER, GL_UNSIGNED_INT, 0);
+    backend.bindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    readback.fence = backend.createFence();
+    m_readbacks.push_back(readback);
+
+    backend.disable(GL_SCISSOR_TEST);
+}
+
+bool ObjectPicker::pollResult(PickResult& result)
+{
+    RenderBackend& backend = RenderBackend::get();
+    if(m_readbacks.empty() || !backend.isFenceSignaled(m_readbacks.front().fence))
+    {
+        return false;
+    }
+
+    const Readback readback = m_readbacks.front();
+    m_readbacks.erase(m_readbacks.begin());
+    backend.deleteFence(readback.fence);
+
+    // The copy is done, mapping doesn't wait
+    result.pixel = readback.pixel;
+    backend.bindBuffer(GL_PIXEL_PACK_BUFFER, readback.buffer);
+    const void* data = backend.mapBufferRange(GL_PIXEL_PACK_BUFFER, 0, sizeof(GLuint), GL_MAP_READ_BIT);
+    result.nodeId = 0;
+    if(data)
+    {
+        memcpy(&result.nodeId, data, sizeof(GLuint));
+    }
+    backend.unmapBuffer(GL_PIXEL_PACK_BUFFER);
+    backend.bindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    m_freeBuffers.push_back(readback.buffer);
+    return true;
+}
+
+void ObjectPicker::reset()
+{
+    RenderBackend& backend = RenderBackend::get();
+    for(const Readback& readback : m_readbacks)
+    {
+        backend.deleteFence(readback.fence);
+        m_freeBuffers.push_back(readback.buffer);
+    }
+
+    m_readbacks.clear();
+    m_pickRequested = false;
+}
+
+GLuint ObjectPicker::acquireBuffer()
+{
+    if(!m_freeBuffers.empty())
+    {
+        const GLuint buffer = m_freeBuffers.back();
+        m_freeBuffers.pop_back();
+        return buffer;
+    }
+
+    RenderBackend& backend = RenderBackend::get();
+    const GLuint buffer = backend.createBuffer();
+    backend.bindBuffer(GL_PIXEL_PACK_BUFFER, buffer);
+    backend.bufferData(GL_PIXEL_PACK_BUFFER, sizeof(GLuint), nullptr, GL_STREAM_READ);
+    backend.bindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    return buffer;
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include <GL/glew.h>
+#include <glm/vec2.hpp>
+
+namespace Engine
+{
+    class CameraComponent;
+    class GeometryComponent;
+    class PickingShader;
+    class RenderManager;
+
+    struct PickResult
+    {
+            // 0 if no node covered the pixel
+            unsigned int nodeId = 0;
+            glm::ivec2 pixel = glm::ivec2(0);
+    };
+
+    /**
+     * @brief Finds the node under a pixel by drawing node ids into an integer target & reading the pixel back.
+     *
+     * Nothing gets drawn unless a pick was requested, the picking pass of that frame only touches the requested
+     * pixel through the scissor test. The pixel is read into a pixel pack buffer behind a fence & only mapped
+     * once the fence is signaled, usually a frame later, so neither the CPU nor the GPU ever wait on each other.
+     * Instanced nodes can't be picked, their instances are placed by per instance matrices.
+     */
+    class ObjectPicker
+    {
+        public:
+            using Nodes = std::vector<std::shared_ptr<GeometryComponent>>;
+
+            explicit ObjectPicker(const std::shared_ptr<RenderManager>& renderManager);
+            ~ObjectPicker();
+
+            ObjectPicker(const ObjectPicker&) = delete;
+            ObjectPicker& operator=(const ObjectPicker&) = delete;
+
+            /**
+             * @brief Picks the node at the pixel with the next drawn frame, only the last request before it counts.
+             *
+             * @param pixel In framebuffer pixels from the top left, like the cursor position.
+             */
+            void requestPick(const glm::ivec2& pixel);
+
+            bool isPickRequested() const { return m_pickRequested; };
+
+            /**
+             * @brief Draws the ids of the nodes into the bound target & starts reading back the requested pixel.
+             * Called by the picking pass, expects an unsigned integer color & a depth target bound.
+             *
+             * @param framebufferSize The size the requested pixel refers to.
+             * @param targetSize The size of the bound targets, differs with dynamic resolution.
+             */
+            void drawIds(
+                    Nodes::const_iterator begin,
+                    Nodes::const_iterator end,
+                    CameraComponent* camera,
+                    const glm::ivec2& framebufferSize,
+                    const glm::ivec2& targetSize
+            );
+
+            /**
+             * @return true & the oldest finished pick, false without waiting if none finished yet.
+             */
+            bool pollResult(PickResult& result);
+
+            /**
+             * @brief Drops the request & all picks in flight, for a new scene.
+             */
+            void reset();
+
+            size_t getPicksInFlight() const { return m_readbacks.size(); };
+
+        private:
+            struct Readback
+            {
+                    GLuint buffer = 0;
+                    GLsync fence = nullptr;
+                    glm::ivec2 pixel = glm::ivec2(0);
+            };
+
+            GLuint acquireBuffer();
+
+            std::shared_ptr<PickingShader> m_shader;
+            std::shared_ptr<PickingShader> m_skinnedShader;
+
+            bool m_pickRequested;
+            glm::ivec2 m_requestedPixel;
+
+            // Oldest first, fences signal in the order they were issued
+            std::vector<Readback> m_readbacks;
+            std::vector<GLuint> m_freeBuffers;
+    };
+} // namespace Engine
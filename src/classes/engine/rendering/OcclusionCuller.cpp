@@ -0,0 +1,370 @@
+#include "OcclusionCuller.h"
+
+#include "../../../resources/shader/DepthShader.h"
+#include "../../nodeComponents/CameraComponent.h"
+#include "../../nodeComponents/GeometryComponent.h"
+#include "backend/RenderBackend.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace Engine;
+
+namespace
+{
+    // Transforming the center & summing the absolute axes gives the tightest box around the transformed box
+    void transformBounds(
+            const glm::vec3& localMin,
+            const glm::vec3& localMax,
+            const glm::mat4& transform,
+            glm::vec3& worldMin,
+            glm::vec3& worldMax
+    )
+    {
+        const glm::vec3 localCenter = (localMax + localMin) * 0.5f;
+        const glm::vec3 localExtent = (localMax - localMin) * 0.5f;
+
+        const glm::vec3 center = glm::vec3(transform * glm::vec4(localCenter, 1.f));
+        const glm::vec3 extent = glm::abs(glm::vec3(transform[0])) * localExtent.x +
+                                 glm::abs(glm::vec3(transform[1])) * localExtent.y +
+                                 glm::abs(glm::vec3(transform[2])) * localExtent.z;
+
+        worldMin = center - extent;
+        worldMax = center + extent;
+    }
+} // namespace
+
+OcclusionCuller::OcclusionCuller(std::shared_ptr<DepthShader> boxShader)
+    : m_boxShader(std::move(boxShader))
+    , m_cellSize(DEFAULT_CELL_SIZE)
+    , m_frame(0)
+{
+}
+
+OcclusionCuller::~OcclusionCuller() { reset(); }
+
+void OcclusionCuller::draw(
+        Nodes::const_iterator begin,
+        Nodes::const_iterator end,
+        CameraComponent* camera,
+        bool colorWrites,
+        const DrawFunc& drawFunc
+)
+{
+    m_frame++;
+    m_stats = OcclusionCullingStats();
+    m_visibleEntries.clear();
+    m_conditionalEntries.clear();
+
+    pollQueries();
+
+    const glm::vec3 eye = camera->getGlobalPosition();
+    const float margin = camera->getZNear() * NEAR_PLANE_MARGIN;
+
+    buildGroups(begin, end);
+    classifyGroups(eye, margin);
+    classifyNodes(eye, margin);
+
+    // The visible nodes lay down the depth the boxes of the hidden ones get tested against
+    executeEntries(m_visibleEntries, drawFunc, true);
+    issueBoxQueries(camera, colorWrites);
+    executeEntries(m_conditionalEntries, drawFunc, false);
+
+    releaseUnusedQueries();
+}
+
+void OcclusionCuller::redraw(const DrawFunc& drawFunc) const
+{
+    executeEntries(m_visibleEntries, drawFunc, false);
+    executeEntries(m_conditionalEntries, drawFunc, false);
+}
+
+void OcclusionCuller::reset()
+{
+    RenderBackend& backend = RenderBackend::get();
+    for(auto* states : { &m_nodeStates, &m_groupStates })
+    {
+        for(const auto& [key, state] : *states)
+        {
+            if(state.query != 0)
+            {
+                backend.deleteQuery(state.query);
+            }
+        }
+        states->clear();
+    }
+
+    m_nodes.clear();
+    m_groups.clear();
+    m_visibleEntries.clear();
+    m_conditionalEntries.clear();
+}
+
+void OcclusionCuller::setCellSize(float cellSize)
+{
+    // The groups of the old cells get released with the next frame
+    m_cellSize = std::max(cellSize, 0.01f);
+}
+
+void OcclusionCuller::pollQueries()
+{
+    RenderBackend& backend = RenderBackend::get();
+    GLuint64 samples = 0;
+
+    for(auto& [key, state] : m_nodeStates)
+    {
+        if(state.pending && backend.getQueryResult(state.query, samples))
+        {
+            state.pending = false;
+            state.visible = samples != 0;
+        }
+    }
+
+    for(auto& [key, state] : m_groupStates)
+    {
+        if(state.pending && backend.getQueryResult(state.query, samples))
+        {
+            state.pending = false;
+            state.revealed = samples != 0 && !state.visible;
+            state.visible = samples != 0;
+        }
+    }
+}
+
+void OcclusionCuller::releaseUnusedQueries()
+{
+    RenderBackend& backend = RenderBackend::get();
+    for(auto* states : { &m_nodeStates, &m_groupStates })
+    {
+        for(auto it = states->begin(); it != states->end();)
+        {
+            if(it->second.lastUsedFrame == m_frame)
+            {
+                ++it;
+                continue;
+            }
+
+            if(it->second.query != 0)
+            {
+                backend.deleteQuery(it->second.query);
+            }
+            it = states->erase(it);
+        }
+    }
+}
+
+void OcclusionCuller::buildGroups(Nodes::const_iterator begin, Nodes::const_iterator end)
+{
+    m_nodes.clear();
+    m_groups.clear();
+
+    for(auto it = begin; it != end; ++it)
+    {
+        const auto& objectData = (*it)->getObjectData();
+        if(!objectData || !objectData->m_hasBounds)
+        {
+            m_visibleEntries.push_back({ &*it, 0, 0 });
+            m_stats.visibleNodes++;
+            continue;
+        }
+
+        CulledNode node = { &*it, glm::vec3(0.f), glm::vec3(0.f), 0, nullptr };
+        const glm::mat4 transform = (*it)->getGlobalModelMatrix();
+        transformBounds(objectData->m_boundsMin, objectData->m_boundsMax, transform, node.min, node.max);
+        node.cell = getCellKey((node.min + node.max) * 0.5f);
+        node.state = &getState(m_nodeStates, (*it)->getNodeId());
+
+        auto [group, created] = m_groups.try_emplace(node.cell);
+        group->second.min = created ? node.min : glm::min(group->second.min, node.min);
+        group->second.max = created ? node.max : glm::max(group->second.max, node.max);
+        group->second.members.push_back(m_nodes.size());
+
+        m_nodes.push_back(node);
+    }
+}
+
+void OcclusionCuller::classifyGroups(const glm::vec3& eye, float margin)
+{
+    m_hiddenGroups.clear();
+
+    for(auto& [key, group] : m_groups)
+    {
+        QueryState& state = getState(m_groupStates, key);
+        group.state = &state;
+
+        // The box of the group showed up, its nodes get tested one by one again
+        if(state.revealed)
+        {
+            state.revealed = false;
+            for(const size_t member : group.members)
+            {
+                m_nodes[member].state->visible = true;
+            }
+        }
+
+        // A single query for the whole group once all of its nodes were found hidden
+        const bool allHidden = std::none_of(
+                group.members.begin(),
+                group.members.end(),
+                [this](size_t member) { return m_nodes[member].state->visible; }
+        );
+        if(state.visible && group.members.size() > 1 && allHidden)
+        {
+            state.visible = false;
+        }
+
+        if(!state.visible && contains(group.min, group.max, eye, margin))
+        {
+            state.visible = true;
+        }
+
+        if(!state.visible)
+        {
+            m_hiddenGroups.push_back(&group);
+            m_stats.occludedGroups++;
+        }
+    }
+}
+
+void OcclusionCuller::classifyNodes(const glm::vec3& eye, float margin)
+{
+    m_deferredNodes.clear();
+
+    // Going through the nodes in their given order keeps the sorting of the caller
+    for(size_t i = 0; i < m_nodes.size(); i++)
+    {
+        CulledNode& node = m_nodes[i];
+        QueryState& groupState = *m_groups.at(node.cell).state;
+        if(!groupState.visible)
+        {
+            m_conditionalEntries.push_back({ node.node, 0, getQuery(groupState) });
+            m_stats.occludedNodes++;
+            continue;
+        }
+
+        QueryState& state = *node.state;
+        if(!state.visible && contains(node.min, node.max, eye, margin))
+        {
+            state.visible = true;
+        }
+
+        if(state.visible)
+        {
+            // Queries still in flight keep their node visible until they finish
+            const GLuint query = state.pending ? 0 : getQuery(state);
+            state.pending = true;
+            m_stats.queries += query != 0 ? 1 : 0;
+            m_visibleEntries.push_back({ node.node, query, 0 });
+            m_stats.visibleNodes++;
+            continue;
+        }
+
+        m_deferredNodes.push_back(i);
+        m_conditionalEntries.push_back({ node.node, 0, getQuery(state) });
+        m_stats.occludedNodes++;
+    }
+}
+
+void OcclusionCuller::issueBoxQueries(CameraComponent* camera, bool colorWrites)
+{
+    RenderBackend& backend = RenderBackend::get();
+    backend.colorMask(false);
+    backend.depthMask(false);
+
+    const auto queryBox = [this, &backend, camera](QueryState& state, const glm::vec3& min, const glm::vec3& max)
+    {
+        // A box still in flight gets drawn conditionally on its last query
+        if(state.pending)
+        {
+            return;
+        }
+
+        backend.beginQuery(GL_ANY_SAMPLES_PASSED, getQuery(state));
+        m_boxShader->renderBox(min, max, camera);
+        backend.endQuery(GL_ANY_SAMPLES_PASSED);
+        state.pending = true;
+        m_stats.queries++;
+    };
+
+    for(const size_t i : m_deferredNodes)
+    {
+        queryBox(*m_nodes[i].state, m_nodes[i].min, m_nodes[i].max);
+    }
+
+    for(const Group* group : m_hiddenGroups)
+    {
+        queryBox(*group->state, group->min, group->max);
+    }
+
+    backend.depthMask(true);
+    backend.colorMask(colorWrites);
+}
+
+OcclusionCuller::QueryState& OcclusionCuller::getState(std::unordered_map<uint64_t, QueryState>& states, uint64_t key)
+{
+    QueryState& state = states[key];
+    state.lastUsedFrame = m_frame;
+    return state;
+}
+
+uint64_t OcclusionCuller::getCellKey(const glm::vec3& position) const
+{
+    // 21 bits per axis, cells further out than a million cells wrap around
+    const auto pack = [this](float coordinate)
+    { return uint64_t(int64_t(std::floor(coordinate / m_cellSize))) & 0x1fffff; };
+
+    return pack(position.x) << 42 | pack(position.y) << 21 | pack(position.z);
+}
+
+GLuint OcclusionCuller::getQuery(QueryState& state)
+{
+    if(state.query == 0)
+    {
+        state.query = RenderBackend::get().createQuery();
+    }
+    return state.query;
+}
+
+bool OcclusionCuller::contains(const glm::vec3& min, const glm::vec3& max, const glm::vec3& point, float margin)
+{
+    return point.x >= min.x - margin && point.y >= min.y - margin && point.z >= min.z - margin &&
+           point.x <= max.x + margin && point.y <= max.y + margin && point.z <= max.z + margin;
+}
+
+void OcclusionCuller::executeEntries(const std::vector<DrawEntry>& entries, const DrawFunc& drawFunc, bool queries)
+{
+    RenderBackend& backend = RenderBackend::get();
+    GLuint condition = 0;
+
+    for(const DrawEntry& entry : entries)
+    {
+        // Neighbouring nodes of a hidden group share the same condition
+        if(entry.condition != condition)
+        {
+            if(condition != 0)
+            {
+                backend.endConditionalRender();
+            }
+            if(entry.condition != 0)
+            {
+                backend.beginConditionalRender(entry.condition, GL_QUERY_NO_WAIT);
+            }
+            condition = entry.condition;
+        }
+
+        if(queries && entry.query != 0)
+        {
+            backend.beginQuery(GL_ANY_SAMPLES_PASSED, entry.query);
+            drawFunc(*entry.node);
+            backend.endQuery(GL_ANY_SAMPLES_PASSED);
+            continue;
+        }
+
+        drawFunc(*entry.node);
+    }
+
+    if(condition != 0)
+    {
+        backend.endConditionalRender();
+    }
+}
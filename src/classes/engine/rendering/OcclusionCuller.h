@@ -0,0 +1,158 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include <GL/glew.h>
+#include <glm/vec3.hpp>
+
+namespace Engine
+{
+    class CameraComponent;
+    class DepthShader;
+    class GeometryComponent;
+
+    struct OcclusionCullingStats
+    {
+            size_t visibleNodes = 0;
+            size_t occludedNodes = 0;
+            size_t occludedGroups = 0;
+            size_t queries = 0;
+    };
+
+    /**
+     * @brief Hardware occlusion culling: nodes found hidden get drawn under a conditional render, so the GPU
+     * skips them as long as their bounding box stays hidden.
+     *
+     * Results are only read once available, a node is drawn according to what the last finished query said about it
+     * (temporal coherence), the pipeline never waits for them. Visible nodes get queried with their own draw, hidden
+     * ones with their bounding box after the visible ones laid down their depth. Nodes are grouped by the cell of a
+     * uniform grid they are in, a group whose nodes are all hidden gets a single query for its box & its nodes only
+     * get queried one by one again once that box shows up. Nodes without bounds are always drawn.
+     */
+    class OcclusionCuller
+    {
+        public:
+            using Nodes = std::vector<std::shared_ptr<GeometryComponent>>;
+            using DrawFunc = std::function<void(const std::shared_ptr<GeometryComponent>&)>;
+
+            explicit OcclusionCuller(std::shared_ptr<DepthShader> boxShader);
+            ~OcclusionCuller();
+
+            OcclusionCuller(const OcclusionCuller&) = delete;
+            OcclusionCuller& operator=(const OcclusionCuller&) = delete;
+
+            /**
+             * @brief Draws the opaque nodes, issuing the queries of this frame in between. Expects the depth test to
+             * be enabled & depth writes on.
+             *
+             * @param colorWrites Whether color writes are on, the box queries turn them off & restore them.
+             */
+            void draw(
+                    Nodes::const_iterator begin,
+                    Nodes::const_iterator end,
+                    CameraComponent* camera,
+                    bool colorWrites,
+                    const DrawFunc& drawFunc
+            );
+
+            /**
+             * @brief Draws the nodes of the last draw() again with the same conditions, without any queries. For
+             * the color pass after a depth pre-pass did the culling.
+             */
+            void redraw(const DrawFunc& drawFunc) const;
+
+            /**
+             * @brief Deletes all queries & forgets every result, for a new scene.
+             */
+            void reset();
+
+            float getCellSize() const { return m_cellSize; };
+
+            /**
+             * @brief The edge length of the grid cells nodes get grouped by, in world units.
+             */
+            void setCellSize(float cellSize);
+
+            const OcclusionCullingStats& getStats() const { return m_stats; };
+
+        private:
+            struct QueryState
+            {
+                    GLuint query = 0;
+                    bool pending = false;
+                    bool visible = true;
+                    // Groups only, the box of the group showed up after it was hidden
+                    bool revealed = false;
+                    uint64_t lastUsedFrame = 0;
+            };
+
+            struct CulledNode
+            {
+                    const std::shared_ptr<GeometryComponent>* node;
+                    glm::vec3 min;
+                    glm::vec3 max;
+                    uint64_t cell;
+                    QueryState* state;
+            };
+
+            struct Group
+            {
+                    glm::vec3 min;
+                    glm::vec3 max;
+                    std::vector<size_t> members;
+                    QueryState* state = nullptr;
+            };
+
+            // Points into the nodes of the last draw(), only valid for the frame
+            struct DrawEntry
+            {
+                    const std::shared_ptr<GeometryComponent>* node;
+                    // Query wrapped around the draw, 0 for none
+                    GLuint query;
+                    // Query the draw is conditional on, 0 for none
+                    GLuint condition;
+            };
+
+            void pollQueries();
+            void releaseUnusedQueries();
+            void buildGroups(Nodes::const_iterator begin, Nodes::const_iterator end);
+            void classifyGroups(const glm::vec3& eye, float margin);
+            void classifyNodes(const glm::vec3& eye, float margin);
+            void issueBoxQueries(CameraComponent* camera, bool colorWrites);
+            QueryState& getState(std::unordered_map<uint64_t, QueryState>& states, uint64_t key);
+
+            uint64_t getCellKey(const glm::vec3& position) const;
+
+            static GLuint getQuery(QueryState& state);
+            static bool contains(const glm::vec3& min, const glm::vec3& max, const glm::vec3& point, float margin);
+            static void executeEntries(const std::vector<DrawEntry>& entries, const DrawFunc& drawFunc, bool queries);
+
+            std::shared_ptr<DepthShader> m_boxShader;
+            float m_cellSize;
+            uint64_t m_frame;
+
+            std::unordered_map<uint64_t, QueryState> m_nodeStates;
+            std::unordered_map<uint64_t, QueryState> m_groupStates;
+
+            // Rebuilt every frame, kept to reuse their memory
+            std::vector<CulledNode> m_nodes;
+            std::unordered_map<uint64_t, Group> m_groups;
+            std::vector<size_t> m_deferredNodes;
+            std::vector<const Group*> m_hiddenGroups;
+
+            // Unconditional draws first, everything drawn after the box queries second
+            std::vector<DrawEntry> m_visibleEntries;
+            std::vector<DrawEntry> m_conditionalEntries;
+
+            OcclusionCullingStats m_stats;
+
+            static constexpr float DEFAULT_CELL_SIZE = 16.f;
+            // Boxes closer to the camera than this many near plane distances could be clipped by the near plane
+            static constexpr float NEAR_PLANE_MARGIN = 2.f;
+    };
+} // namespace Engine
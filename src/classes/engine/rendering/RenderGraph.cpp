@@ -0,0 +1,504 @@
+#include "RenderGraph.h"
+
+#include "backend/RenderBackend.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <utility>
+
+using namespace Engine;
+
+namespace
+{
+    bool isIntegerFormat(GLenum format)
+    {
+        switch(format)
+        {
+            case GL_R32UI:
+            case GL_RG32UI:
+            case GL_RGBA32UI:
+            case GL_R32I:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    // The client format & type glTexImage2D expects for an internal format, nothing gets uploaded anyway
+    std::pair<GLenum, GLenum> getTextureUploadFormat(GLenum format)
+    {
+        switch(format)
+        {
+            case GL_DEPTH_COMPONENT16:
+            case GL_DEPTH_COMPONENT24:
+            case GL_DEPTH_COMPONENT32F:
+                return { GL_DEPTH_COMPONENT, GL_FLOAT };
+            case GL_DEPTH24_STENCIL8:
+                return { GL_DEPTH_STENCIL, GL_UNSIGNED_INT_24_8 };
+            case GL_R32UI:
+                return { GL_RED_INTEGER, GL_UNSIGNED_INT };
+            case GL_RG32UI:
+                return { GL_RG_INTEGER, GL_UNSIGNED_INT };
+            case GL_RGBA32UI:
+                return { GL_RGBA_INTEGER, GL_UNSIGNED_INT };
+            case GL_R32I:
+                return { GL_RED_INTEGER, GL_INT };
+            case GL_R8:
+                return { GL_RED, GL_UNSIGNED_BYTE };
+            case GL_R16F:
+            case GL_R32F:
+                return { GL_RED, GL_FLOAT };
+            case GL_RG16F:
+            case GL_RG32F:
+                return { GL_RG, GL_FLOAT };
+            case GL_RGBA16F:
+            case GL_RGBA32F:
+                return { GL_RGBA, GL_FLOAT };
+            default:
+                return { GL_RGBA, GL_UNSIGNED_BYTE };
+        }
+    }
+} // namespace
+
+RenderGraph::Resource RenderGraph::PassBuilder::create(const std::string& name, const RenderTargetDesc& desc)
+{
+    ResourceNode resource;
+    resource.name = name;
+    resource.desc = desc;
+    m_graph.m_resources.push_back(resource);
+
+    const Resource handle = m_graph.m_resources.size() - 1;
+    m_graph.m_passes[m_pass].writes.push_back(handle);
+    return handle;
+}
+
+RenderGraph::Resource RenderGraph::PassBuilder::read(Resource resource)
+{
+    m_graph.m_passes[m_pass].reads.push_back(resource);
+    return resource;
+}
+
+RenderGraph::Resource RenderGraph::PassBuilder::write(Resource resource)
+{
+    m_graph.m_passes[m_pass].writes.push_back(resource);
+    return resource;
+}
+
+void RenderGraph::PassBuilder::setSideEffect() { m_graph.m_passes[m_pass].sideEffect = true; }
+
+GLuint RenderGraph::PassContext::getTexture(Resource resource) const
+{
+    const ResourceNode& node = m_graph.m_resources[resource];
+    if(node.imported || node.desc.samples > 0)
+    {
+        fprintf(stderr, "Render target %s has no texture to sample!\n", node.name.c_str());
+        return 0;
+    }
+
+    return m_graph.m_targets[node.physical].object;
+}
+
+const glm::ivec2& RenderGraph::PassContext::getSize(Resource resource) const
+{
+    return m_graph.m_resources[resource].desc.size;
+}
+
+void RenderGraph::PassContext::bindReadFramebuffer(Resource resource) const
+{
+    const GLuint framebuffer = m_graph.m_resources[resource].imported ? 0 : m_graph.getFramebuffer({ resource });
+    RenderBackend::get().bindFramebuffer(GL_READ_FRAMEBUFFER, framebuffer);
+}
+
+RenderGraph::~RenderGraph() { releaseTargets(); }
+
+void RenderGraph::beginFrame()
+{
+    m_passes.clear();
+    m_resources.clear();
+}
+
+RenderGraph::Resource RenderGraph::importBackbuffer(const std::string& name, const glm::ivec2& size)
+{
+    ResourceNode resource;
+    resource.name = name;
+    resource.desc.size = size;
+    resource.imported = true;
+    m_resources.push_back(resource);
+    return m_resources.size() - 1;
+}
+
+void RenderGraph::addPass(const std::string& name, const SetupFunc& setup, ExecuteFunc execute)
+{
+    PassNode pass;
+    pass.name = name;
+    pass.execute = std::move(execute);
+    m_passes.push_back(std::move(pass));
+
+    PassBuilder builder(*this, m_passes.size() - 1);
+    setup(builder);
+}
+
+void RenderGraph::execute()
+{
+    m_stats = RenderGraphStats();
+    m_stats.passes = m_passes.size();
+
+    cullPasses();
+    assignTargets();
+
+    const PassContext context(*this);
+    for(const PassNode& pass : m_passes)
+    {
+        if(pass.culled)
+        {
+            continue;
+        }
+
+        if(!pass.writes.empty())
+        {
+            bindPassFramebuffer(pass);
+        }
+        pass.execute(context);
+    }
+
+    releaseUnusedTargets();
+}
+
+void RenderGraph::cullPasses()
+{
+    // Walking backwards, a pass is needed if a needed pass after it uses one of its writes. Writes keep the
+    // previous contents, so the earlier writers of a needed target are needed as well.
+    std::vector<bool> neededResources(m_resources.size(), false);
+    for(size_t i = m_passes.size(); i-- > 0;)
+    {
+        PassNode& pass = m_passes[i];
+        pass.culled = !pass.sideEffect;
+        for(Resource resource : pass.writes)
+        {
+            if(m_resources[resource].imported || neededResources[resource])
+            {
+                pass.culled = false;
+                break;
+            }
+        }
+
+        if(pass.culled)
+        {
+            m_stats.culledPasses++;
+            continue;
+        }
+
+        for(Resource resource : pass.reads)
+        {
+            neededResources[resource] = true;
+        }
+        for(Resource resource : pass.writes)
+        {
+            neededResources[resource] = true;
+        }
+    }
+}
+
+void RenderGraph::assignTargets()
+{
+    for(size_t i = 0; i < m_passes.size(); i++)
+    {
+        if(m_passes[i].culled)
+        {
+            continue;
+        }
+
+        const auto use = [this, i](Resource resource)
+        {
+            ResourceNode& node = m_resources[resource];
+            node.firstUse = std::min(node.firstUse, i);
+            node.lastUse = std::max(node.lastUse, i);
+        };
+        std::for_each(m_passes[i].reads.begin(), m_passes[i].reads.end(), use);
+        std::for_each(m_passes[i].writes.begin(), m_passes[i].writes.end(), use);
+    }
+
+    for(PhysicalTarget& target : m_targets)
+    {
+        target.usedThisFrame = false;
+    }
+
+    // Resources in the order their lifetimes start, each takes the first matching target that is free by then
+    std::vector<Resource> order;
+    for(Resource resource = 0; resource < m_resources.size(); resource++)
+    {
+        const ResourceNode& node = m_resources[resource];
+        if(!node.imported && node.firstUse != SIZE_MAX)
+        {
+            order.push_back(resource);
+        }
+    }
+    std::stable_sort(
+            order.begin(),
+            order.end(),
+            [this](Resource a, Resource b) { return m_resources[a].firstUse < m_resources[b].firstUse; }
+    );
+
+    for(Resource resource : order)
+    {
+        ResourceNode& node = m_resources[resource];
+        node.physical = acquireTarget(node);
+
+        m_stats.transientTargets++;
+        m_stats.transientBytes += getTargetBytes(node.desc);
+    }
+
+    for(const PhysicalTarget& target : m_targets)
+    {
+        if(target.usedThisFrame)
+        {
+            m_stats.physicalTargets++;
+            m_stats.physicalBytes += getTargetBytes(target.desc);
+        }
+    }
+}
+
+size_t RenderGraph::acquireTarget(const ResourceNode& resource)
+{
+    for(size_t i = 0; i < m_targets.size(); i++)
+    {
+        PhysicalTarget& target = m_targets[i];
+        if(target.desc == resource.desc && (!target.usedThisFrame || target.freeAfter < resource.firstUse))
+        {
+            target.usedThisFrame = true;
+            target.freeAfter = resource.lastUse;
+            return i;
+        }
+    }
+
+    PhysicalTarget target;
+    target.desc = resource.desc;
+    target.usedThisFrame = true;
+    target.freeAfter = resource.lastUse;
+
+    RenderBackend& backend = RenderBackend::get();
+    const RenderTargetDesc& desc = resource.desc;
+    if(desc.samples > 0)
+    {
+        target.object = backend.createRenderbuffer();
+        backend.renderbufferStorage(target.object, desc.samples, desc.format, desc.size.x, desc.size.y);
+    }
+    else
+    {
+        const auto [uploadFormat, uploadType] = getTextureUploadFormat(desc.format);
+        const GLint filter = isDepthFormat(desc.format) || isIntegerFormat(desc.format) ? GL_NEAREST : GL_LINEAR;
+
+        target.object = backend.createTexture();
+        backend.bindTexture(GL_TEXTURE_2D, target.object);
+        backend.texImage2D(
+                GL_TEXTURE_2D,
+                0,
+                GLint(desc.format),
+                desc.size.x,
+                desc.size.y,
+                uploadFormat,
+                uploadType,
+                nullptr
+        );
+        backend.texParameter(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, filter);
+        backend.texParameter(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, filter);
+        backend.texParameter(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        backend.texParameter(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    }
+
+    m_targets.push_back(target);
+    return m_targets.size() - 1;
+}
+
+void RenderGraph::releaseUnusedTargets()
+{
+    // A target not needed this frame, e.g. after a resize, most likely won't be needed again
+    for(const PhysicalTarget& target : m_targets)
+    {
+        if(!target.usedThisFrame)
+        {
+            deleteTarget(target);
+        }
+    }
+    std::erase_if(m_targets, [](const PhysicalTarget& target) { return !target.usedThisFrame; });
+}
+
+void RenderGraph::releaseTargets()
+{
+    for(const PhysicalTarget& target : m_targets)
+    {
+        deleteTarget(target);
+    }
+    m_targets.clear();
+}
+
+void RenderGraph::deleteTarget(const PhysicalTarget& target)
+{
+    RenderBackend& backend = RenderBackend::get();
+
+    const uint64_t key = getFramebufferKey(target);
+    for(auto it = m_framebuffers.begin(); it != m_framebuffers.end();)
+    {
+        if(std::find(it->first.begin(), it->first.end(), key) != it->first.end())
+        {
+            backend.deleteFramebuffer(it->second);
+            it = m_framebuffers.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+
+    if(target.desc.samples > 0)
+    {
+        backend.deleteRenderbuffer(target.object);
+    }
+    else
+    {
+        backend.deleteTexture(target.object);
+    }
+}
+
+void RenderGraph::bindPassFramebuffer(const PassNode& pass)
+{
+    RenderBackend& backend = RenderBackend::get();
+
+    const auto imported = std::find_if(
+            pass.writes.begin(),
+            pass.writes.end(),
+            [this](Resource resource) { return m_resources[resource].imported; }
+    );
+    if(imported != pass.writes.end())
+    {
+        if(pass.writes.size() > 1)
+        {
+            fprintf(stderr, "Pass %s mixes the backbuffer with other targets!\n", pass.name.c_str());
+        }
+
+        backend.bindFramebuffer(GL_FRAMEBUFFER, 0);
+        backend.viewport(glm::ivec2(0), m_resources[*imported].desc.size);
+        return;
+    }
+
+    backend.bindFramebuffer(GL_FRAMEBUFFER, getFramebuffer(pass.writes));
+    backend.viewport(glm::ivec2(0), m_resources[pass.writes.front()].desc.size);
+}
+
+GLuint RenderGraph::getFramebuffer(const std::vector<Resource>& attachments)
+{
+    std::vector<uint64_t> key;
+    key.reserve(attachments.size());
+    for(Resource resource : attachments)
+    {
+        key.push_back(getFramebufferKey(m_targets[m_resources[resource].physical]));
+    }
+    std::sort(key.begin(), key.end());
+    key.erase(std::unique(key.begin(), key.end()), key.end());
+
+    if(const auto it = m_framebuffers.find(key); it != m_framebuffers.end())
+    {
+        return it->second;
+    }
+
+    RenderBackend& backend = RenderBackend::get();
+    const GLuint framebuffer = backend.createFramebuffer();
+    backend.bindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+
+    int colorAttachments = 0;
+    for(Resource resource : attachments)
+    {
+        const PhysicalTarget& target = m_targets[m_resources[resource].physical];
+
+        GLenum attachment = GL_COLOR_ATTACHMENT0;
+        if(target.desc.format == GL_DEPTH24_STENCIL8)
+        {
+            attachment = GL_DEPTH_STENCIL_ATTACHMENT;
+        }
+        else if(isDepthFormat(target.desc.format))
+        {
+            attachment = GL_DEPTH_ATTACHMENT;
+        }
+        else if(colorAttachments++ > 0)
+        {
+            // Would need glDrawBuffers, none of the passes writes more than one color target so far
+            fprintf(stderr, "Only one color target per pass, %s skipped!\n", m_resources[resource].name.c_str());
+            continue;
+        }
+
+        if(target.desc.samples > 0)
+        {
+            backend.framebufferRenderbuffer(GL_FRAMEBUFFER, attachment, target.object);
+        }
+        else
+        {
+            backend.framebufferTexture2D(GL_FRAMEBUFFER, attachment, GL_TEXTURE_2D, target.object);
+        }
+    }
+
+    if(!backend.isFramebufferComplete(GL_FRAMEBUFFER))
+    {
+        fprintf(stderr, "Render graph framebuffer incomplete!\n");
+    }
+
+    m_framebuffers.emplace(std::move(key), framebuffer);
+    return framebuffer;
+}
+
+bool RenderGraph::wasPassExecuted(const std::string& name) const
+{
+    return std::any_of(
+            m_passes.begin(),
+            m_passes.end(),
+            [&name](const PassNode& pass) { return pass.name == name && !pass.culled; }
+    );
+}
+
+uint64_t RenderGraph::getFramebufferKey(const PhysicalTarget& target)
+{
+    // Textures & renderbuffers have separate names
+    return (uint64_t(target.object) << 1) | (target.desc.samples > 0 ? 1 : 0);
+}
+
+bool RenderGraph::isDepthFormat(GLenum format)
+{
+    switch(format)
+    {
+        case GL_DEPTH_COMPONENT16:
+        case GL_DEPTH_COMPONENT24:
+        case GL_DEPTH_COMPONENT32F:
+        case GL_DEPTH24_STENCIL8:
+            return true;
+        default:
+            return false;
+    }
+}
+
+size_t RenderGraph::getTargetBytes(const RenderTargetDesc& desc)
+{
+    size_t bytesPerPixel;
+    switch(desc.format)
+    {
+        case GL_R8:
+            bytesPerPixel = 1;
+            break;
+        case GL_DEPTH_COMPONENT16:
+        case GL_R16F:
+            bytesPerPixel = 2;
+            break;
+        case GL_RGBA16F:
+        case GL_RG32F:
+        case GL_RG32UI:
+            bytesPerPixel = 8;
+            break;
+        case GL_RGBA32F:
+        case GL_RGBA32UI:
+            bytesPerPixel = 16;
+            break;
+        default:
+            bytesPerPixel = 4;
+            break;
+    }
+
+    return size_t(desc.size.x) * size_t(desc.size.y) * bytesPerPixel * size_t(std::max(desc.samples, 1));
+}
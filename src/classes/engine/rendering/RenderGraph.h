@@ -0,0 +1,203 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <GL/glew.h>
+#include <glm/vec2.hpp>
+
+namespace Engine
+{
+    /**
+     * @brief Describes a render target. Targets with the same description can share the same GL object.
+     *
+     * samples > 0 creates a multisampled renderbuffer, otherwise a texture that later passes can sample.
+     */
+    struct RenderTargetDesc
+    {
+            glm::ivec2 size = glm::ivec2(0);
+            GLenum format = GL_RGBA8;
+            int samples = 0;
+
+            bool operator==(const RenderTargetDesc& other) const
+            {
+                return size == other.size && format == other.format && samples == other.samples;
+            };
+    };
+
+    struct RenderGraphStats
+    {
+            size_t passes = 0;
+            size_t culledPasses = 0;
+            size_t transientTargets = 0;
+            size_t physicalTargets = 0;
+            size_t transientBytes = 0;
+            size_t physicalBytes = 0;
+    };
+
+    /**
+     * @brief A frame graph: passes declare the render targets they create, read & write, the graph then only
+     * runs the passes contributing to its outputs & backs the transient targets with as few GL objects as possible.
+     *
+     * Passes get added every frame & execute in the order they were added. A pass can only use targets created by
+     * itself or an earlier pass, so that order always satisfies their dependencies. Passes whose writes nobody reads
+     * get culled, optional passes simply aren't added. Transient targets only live from the first to the last pass
+     * using them, targets with the same description & non overlapping lifetimes alias the same GL object. The GL
+     * objects & framebuffers are kept between frames & released once a frame doesn't need them anymore.
+     */
+    class RenderGraph
+    {
+        public:
+            using Resource = size_t;
+
+            class PassBuilder
+            {
+                public:
+                    /**
+                     * @brief Creates a transient target, its contents are undefined until this pass writes them.
+                     */
+                    Resource create(const std::string& name, const RenderTargetDesc& desc);
+
+                    /**
+                     * @brief Samples or blits from the target, the pass depends on everything written to it before.
+                     */
+                    Resource read(Resource resource);
+
+                    /**
+                     * @brief Renders into the target, keeping what earlier passes wrote. The written targets get
+                     * bound as the framebuffer of the pass, depth formats as its depth attachment.
+                     */
+                    Resource write(Resource resource);
+
+                    /**
+                     * @brief The pass never gets culled, for passes with effects outside the graph.
+                     */
+                    void setSideEffect();
+
+                private:
+                    friend class RenderGraph;
+                    PassBuilder(RenderGraph& graph, size_t pass) : m_graph(graph), m_pass(pass) {};
+
+                    RenderGraph& m_graph;
+                    size_t m_pass;
+            };
+
+            class PassContext
+            {
+                public:
+                    /**
+                     * @brief The texture backing a target, only valid for targets without samples.
+                     */
+                    GLuint getTexture(Resource resource) const;
+
+                    const glm::ivec2& getSize(Resource resource) const;
+
+                    /**
+                     * @brief Binds a framebuffer with only the target attached as GL_READ_FRAMEBUFFER, for blits.
+                     */
+                    void bindReadFramebuffer(Resource resource) const;
+
+                private:
+                    friend class RenderGraph;
+                    explicit PassContext(RenderGraph& graph) : m_graph(graph) {};
+
+                    RenderGraph& m_graph;
+            };
+
+            using SetupFunc = std::function<void(PassBuilder&)>;
+            using ExecuteFunc = std::function<void(const PassContext&)>;
+
+            RenderGraph() = default;
+            ~RenderGraph();
+
+            RenderGraph(const RenderGraph&) = delete;
+            RenderGraph& operator=(const RenderGraph&) = delete;
+
+            /**
+             * @brief Drops the passes & resources of the last frame, the GL objects stay for reuse.
+             */
+            void beginFrame();
+
+            /**
+             * @brief Registers the window framebuffer. Passes writing to it are outputs of the graph.
+             */
+            Resource importBackbuffer(const std::string& name, const glm::ivec2& size);
+
+            /**
+             * @brief Adds a pass, setup gets called right away to declare its resources.
+             */
+            void addPass(const std::string& name, const SetupFunc& setup, ExecuteFunc execute);
+
+            /**
+             * @brief Culls unused passes, assigns the GL objects & runs the remaining passes.
+             */
+            void execute();
+
+            /**
+             * @brief Deletes all GL objects the graph holds.
+             */
+            void releaseTargets();
+
+            const RenderGraphStats& getStats() const { return m_stats; };
+
+            /**
+             * @return true if the pass of the last executed frame wasn't culled.
+             */
+            bool wasPassExecuted(const std::string& name) const;
+
+        private:
+            struct ResourceNode
+            {
+                    std::string name;
+                    RenderTargetDesc desc;
+                    bool imported = false;
+                    size_t firstUse = SIZE_MAX;
+                    size_t lastUse = 0;
+                    size_t physical = SIZE_MAX;
+            };
+
+            struct PassNode
+            {
+                    std::string name;
+                    ExecuteFunc execute;
+                    std::vector<Resource> reads;
+                    std::vector<Resource> writes;
+                    bool sideEffect = false;
+                    bool culled = false;
+            };
+
+            struct PhysicalTarget
+            {
+                    RenderTargetDesc desc;
+                    GLuint object = 0;
+                    bool usedThisFrame = false;
+                    size_t freeAfter = 0;
+            };
+
+            void cullPasses();
+            void assignTargets();
+            size_t acquireTarget(const ResourceNode& resource);
+            void releaseUnusedTargets();
+            void bindPassFramebuffer(const PassNode& pass);
+            GLuint getFramebuffer(const std::vector<Resource>& attachments);
+            void deleteTarget(const PhysicalTarget& target);
+
+            static uint64_t getFramebufferKey(const PhysicalTarget& target);
+
+            static bool isDepthFormat(GLenum format);
+            static size_t getTargetBytes(const RenderTargetDesc& desc);
+
+            std::vector<PassNode> m_passes;
+            std::vector<ResourceNode> m_resources;
+            std::vector<PhysicalTarget> m_targets;
+
+            // Framebuffers by the targets attached to them, deleted together with any of those
+            std::map<std::vector<uint64_t>, GLuint> m_framebuffers;
+
+            RenderGraphStats m_stats;
+    };
+} // namespace Engine
@@ -2,10 +2,19 @@
 #include "RenderManager.h"
 
 #include "../../helper/FileLoading.h"
+#include "../../helper/GlbLoading.h"
 #include "../../helper/VertexIndexingHelper.h"
+#include "../AssetWatcher.h"
+#include "../ThreadPool.h"
+#include "MeshOptimizer.h"
+#include "ModelImporter.h"
+#include "ShaderFeatures.h"
 #include "ShaderLoader.h"
 
+#include <algorithm>
+#include <chrono>
 #include <iostream>
+#include <iterator>
 #include <string>
 #include <utility>
 
@@ -19,11 +28,16 @@ namespace Engine
         , m_ambientLightUbo(nullptr)
         , m_diffuseLightUbo(nullptr)
         , m_showWireframe(false)
+        , m_shaderGeneration(0)
+        , m_assetWatcher(nullptr)
+        , m_preloadBudgetMs(DEFAULT_PRELOAD_BUDGET_MS)
     {
         m_ambientLightUbo = std::make_shared<Lighting::AmbientLightUbo>();
         m_diffuseLightUbo = std::make_shared<Lighting::DiffuseLightUbo>();
     }
 
+    RenderManager::~RenderManager() = default;
+
     std::shared_ptr<ObjectData> RenderManager::registerObject(const char* filePath)
     {
         for(auto& object : m_objectList)
@@ -34,38 +48,315 @@ namespace Engine
             }
         }
 
-        std::vector<glm::vec3> vertexData, vertexNormals;
-        std::vector<glm::vec2> uvData;
+        // A single primitive GLB goes straight from the file into GL buffers
+        std::vector<GlbPrimitive> primitives;
+        if(loadGlbPrimitives(filePath, primitives, 1))
+        {
+            std::shared_ptr<ObjectData> newObject = createEmptyObject(filePath);
+            uploadGlbPrimitive(*newObject, primitives.front());
+            m_objectList[filePath] = newObject;
+            return newObject;
+        }
 
-        if(!loadFileOBJ(filePath, vertexData, uvData, vertexNormals))
+        CookedMesh mesh = loadCookedObject(filePath);
+        if(!mesh.valid)
         {
             return nullptr;
         }
 
-        std::vector<triData> triIndexData;
+        std::shared_ptr<ObjectData> newObject = createEmptyObject(filePath);
+        uploadMesh(*newObject, mesh);
+
+        m_objectList[filePath] = newObject;
+
+        return newObject;
+    }
+
+    std::vector<ModelPart> RenderManager::registerModel(const char* filePath)
+    {
+        const auto model = m_modelList.find(filePath);
+        if(model != m_modelList.end())
+        {
+            return model->second;
+        }
+
+        const std::string filePathString = std::string(filePath);
+        const size_t slashIndex = filePathString.find_last_of("/\\");
+        const std::string directory = slashIndex == std::string::npos ? "" : filePathString.substr(0, slashIndex + 1);
+
+        std::vector<ModelPart> parts;
+        const auto addPart = [this, &parts, &filePathString, &directory](const CookedMaterial* material)
+        {
+            const std::string partPath = filePathString + "#" + std::to_string(parts.size());
+
+            ModelPart part;
+            part.objectData = createEmptyObject(partPath);
+            if(material)
+            {
+                part.material = *material;
+                if(!part.material.diffuseTexture.empty())
+                {
+                    part.texture = registerTexture((directory + part.material.diffuseTexture).c_str());
+                }
+            }
+
+            m_objectList[partPath] = part.objectData;
+            parts.push_back(std::move(part));
+            return parts.back().objectData;
+        };
+
+        std::vector<GlbPrimitive> primitives;
+        if(loadGlbPrimitives(filePath, primitives))
+        {
+            for(GlbPrimitive& primitive : primitives)
+            {
+                uploadGlbPrimitive(*addPart(&primitive.material), primitive);
+            }
+        }
+        else
+        {
+            CookedModel cookedModel = loadCookedModel(filePath);
+            for(CookedMesh& mesh : cookedModel.meshes)
+            {
+                const bool hasMaterial = mesh.materialIndex < cookedModel.materials.size();
+                uploadMesh(*addPart(hasMaterial ? &cookedModel.materials[mesh.materialIndex] : nullptr), mesh);
+            }
+        }
+
+        if(!parts.empty())
+        {
+            m_modelList[filePath] = parts;
+        }
+
+        return parts;
+    }
+
+    SkinnedModel RenderManager::registerSkinnedModel(const char* filePath)
+    {
+        const auto model = m_skinnedModelList.find(filePath);
+        if(model != m_skinnedModelList.end())
+        {
+            return model->second;
+        }
+
+        CookedModel cookedModel;
+        if(!ModelImporter::loadModel(filePath, cookedModel, true))
+        {
+            return {};
+        }
+
+        const std::string filePathString = std::string(filePath);
+        const size_t slashIndex = filePathString.find_last_of("/\\");
+        const std::string directory = slashIndex == std::string::npos ? "" : filePathString.substr(0, slashIndex + 1);
+
+        SkinnedModel skinnedModel;
+        for(CookedMesh& mesh : cookedModel.meshes)
+        {
+            // Kept apart from the static parts of the same file, those get hot reloaded into other objects
+            const std::string partPath = filePathString + "#skinned" + std::to_string(skinnedModel.parts.size());
+
+            ModelPart part;
+            part.objectData = createEmptyObject(partPath);
+            if(mesh.materialIndex < cookedModel.materials.size())
+            {
+                part.material = cookedModel.materials[mesh.materialIndex];
+                if(!part.material.diffuseTexture.empty())
+                {
+                    part.texture = registerTexture((directory + part.material.diffuseTexture).c_str());
+                }
+            }
+            uploadMesh(*part.objectData, mesh);
+
+            m_objectList[partPath] = part.objectData;
+            skinnedModel.parts.push_back(std::move(part));
+        }
+
+        skinnedModel.skeleton = std::make_shared<const Skeleton>(std::move(cookedModel.skeleton));
+        m_skinnedModelList[filePath] = skinnedModel;
 
-        indexVBO(vertexData, uvData, vertexNormals, triIndexData);
+        return skinnedModel;
+    }
 
-        GLuint vertexBuffer = !vertexData.empty() ? createBuffer(vertexData) : -1;
-        GLuint uvBuffer = !uvData.empty() ? createBuffer(uvData) : -1;
-        GLuint normalBuffer = !vertexNormals.empty() ? createBuffer(vertexNormals) : -1;
-        GLuint indexBuffer = !triIndexData.empty() ? createBuffer(triIndexData) : -1;
+    CookedModel RenderManager::loadCookedModel(const std::string& filePath)
+    {
+        CookedModel model;
+        if(ModelImporter::isImportedFormat(filePath))
+        {
+            if(!ModelImporter::loadModel(filePath, model))
+            {
+                model.meshes.clear();
+            }
+            return model;
+        }
 
-        std::shared_ptr<ObjectData> newObject = std::make_shared<ObjectData>(
+        CookedMesh mesh;
+        if(!loadFileOBJ(filePath.c_str(), mesh.vertexData, mesh.uvData, mesh.vertexNormals))
+        {
+            return model;
+        }
+
+        indexVBO(mesh.vertexData, mesh.uvData, mesh.vertexNormals, mesh.triIndexData);
+        mesh.valid = true;
+
+        const MeshOptimizationResult result = MeshOptimizer::optimize(mesh);
+        std::cout << "Optimized object [" << filePath << "] ACMR " << result.before.getAcmr() << " -> "
+                  << result.after.getAcmr() << ", ATVR " << result.before.getAtvr() << " -> "
+                  << result.after.getAtvr() << std::endl;
+
+        model.meshes.push_back(std::move(mesh));
+
+        return model;
+    }
+
+    CookedMesh RenderManager::loadCookedObject(const std::string& filePath)
+    {
+        CookedModel model = loadCookedModel(filePath);
+        if(model.meshes.empty())
+        {
+            return CookedMesh();
+        }
+
+        CookedMesh mesh = ModelImporter::mergeMeshes(model);
+        if(!mesh.valid)
+        {
+            std::cout << "Model " << filePath << " is too large for a single object, only its first mesh is used"
+                      << std::endl;
+            mesh = std::move(model.meshes.front());
+            mesh.valid = true;
+        }
+
+        return mesh;
+    }
+
+    TextureImage RenderManager::loadTextureImage(const std::string& filePath)
+    {
+        TextureImage image;
+        const std::string fileExtension = filePath.substr(filePath.find_last_of('.') + 1);
+        if(fileExtension == "bmp" || fileExtension == "BMP")
+        {
+            readFileBMP(filePath.c_str(), image);
+        }
+        else if(fileExtension == "dds" || fileExtension == "DDS")
+        {
+            readFileDDS(filePath.c_str(), image);
+        }
+        else
+        {
+            std::cout << "Texture extension of " << filePath << " not valid" << std::endl;
+        }
+
+        return image;
+    }
+
+    std::shared_ptr<ObjectData> RenderManager::createEmptyObject(const std::string& filePath)
+    {
+        return std::make_shared<ObjectData>(
                 filePath,
-                vertexBuffer,
-                uvBuffer,
-                normalBuffer,
-                indexBuffer,
-                vertexData,
-                uvData,
-                vertexNormals,
-                triIndexData
+                -1,
+                -1,
+                -1,
+                -1,
+                std::vector<glm::vec3>(),
+                std::vector<glm::vec2>(),
+                std::vector<glm::vec3>(),
+                std::vector<triData>()
         );
+    }
 
-        m_objectList[filePath] = newObject;
+    bool RenderManager::loadGlbPrimitives(
+            const std::string& filePath,
+            std::vector<GlbPrimitive>& primitives,
+            size_t maxPrimitives /* = -1 */
+    )
+    {
+        if(!filePath.ends_with(".glb") && !filePath.ends_with(".GLB"))
+        {
+            return false;
+        }
 
-        return newObject;
+        GlbFile glbFile;
+        if(!glbFile.open(filePath.c_str()) || glbFile.getPrimitiveCount() > maxPrimitives)
+        {
+            return false;
+        }
+
+        return glbFile.loadPrimitives(primitives) == GLB_LOADED;
+    }
+
+    void RenderManager::uploadGlbPrimitive(ObjectData& objectData, GlbPrimitive& primitive)
+    {
+        GLuint oldBuffers[7] = { objectData.m_vertexBuffer,
+                                 objectData.m_uvBuffer,
+                                 objectData.m_normalBuffer,
+                                 objectData.m_tangentBuffer,
+                                 objectData.m_indexBuffer,
+                                 objectData.m_boneIndexBuffer,
+                                 objectData.m_boneWeightBuffer };
+
+        objectData.m_vertexBuffer = primitive.vertexBuffer;
+        objectData.m_uvBuffer = primitive.uvBuffer;
+        objectData.m_normalBuffer = primitive.normalBuffer;
+        objectData.m_tangentBuffer = -1;
+        objectData.m_indexBuffer = primitive.indexBuffer;
+        objectData.m_boneIndexBuffer = -1;
+        objectData.m_boneWeightBuffer = -1;
+        objectData.m_gpuIndexCount = primitive.indexCount;
+        objectData.m_generation++;
+        objectData.m_boundsMin = primitive.boundsMin;
+        objectData.m_boundsMax = primitive.boundsMax;
+        objectData.m_hasBounds = primitive.hasBounds;
+        objectData.m_vertexData.clear();
+        objectData.m_vertexUvs.clear();
+        objectData.m_vertexNormals.clear();
+        objectData.m_vertexTangents.clear();
+        objectData.m_vertexIndices.clear();
+        objectData.m_boneIndices.clear();
+        objectData.m_boneWeights.clear();
+
+        for(GLuint buffer : oldBuffers)
+        {
+            if(buffer != -1)
+            {
+                RenderBackend::get().deleteBuffer(buffer);
+            }
+        }
+    }
+
+    void RenderManager::uploadMesh(ObjectData& objectData, CookedMesh& mesh)
+    {
+        GLuint oldBuffers[7] = { objectData.m_vertexBuffer,
+                                 objectData.m_uvBuffer,
+                                 objectData.m_normalBuffer,
+                                 objectData.m_tangentBuffer,
+                                 objectData.m_indexBuffer,
+                                 objectData.m_boneIndexBuffer,
+                                 objectData.m_boneWeightBuffer };
+
+        objectData.m_vertexBuffer = !mesh.vertexData.empty() ? createBuffer(mesh.vertexData) : -1;
+        objectData.m_uvBuffer = !mesh.uvData.empty() ? createBuffer(mesh.uvData) : -1;
+        objectData.m_normalBuffer = !mesh.vertexNormals.empty() ? createBuffer(mesh.vertexNormals) : -1;
+        objectData.m_tangentBuffer = !mesh.vertexTangents.empty() ? createBuffer(mesh.vertexTangents) : -1;
+        objectData.m_indexBuffer = !mesh.triIndexData.empty() ? createBuffer(mesh.triIndexData) : -1;
+        objectData.m_boneIndexBuffer = !mesh.boneIndices.empty() ? createBuffer(mesh.boneIndices) : -1;
+        objectData.m_boneWeightBuffer = !mesh.boneWeights.empty() ? createBuffer(mesh.boneWeights) : -1;
+        objectData.m_vertexData = std::move(mesh.vertexData);
+        objectData.m_vertexUvs = std::move(mesh.uvData);
+        objectData.m_vertexNormals = std::move(mesh.vertexNormals);
+        objectData.m_vertexTangents = std::move(mesh.vertexTangents);
+        objectData.m_vertexIndices = std::move(mesh.triIndexData);
+        objectData.m_boneIndices = std::move(mesh.boneIndices);
+        objectData.m_boneWeights = std::move(mesh.boneWeights);
+        objectData.m_gpuIndexCount = 0;
+        objectData.computeBounds();
+        objectData.m_generation++;
+
+        for(GLuint buffer : oldBuffers)
+        {
+            if(buffer != -1)
+            {
+                RenderBackend::get().deleteBuffer(buffer);
+            }
+        }
     }
 
     void RenderManager::deregisterObject(std::shared_ptr<ObjectData>& obj)
@@ -77,8 +368,7 @@ namespace Engine
                     const bool shouldRemove = elem.second == obj;
                     if(shouldRemove)
                     {
-                        GLuint buffer[1] = { obj->m_vertexBuffer };
-                        glDeleteBuffers(1, buffer);
+                        RenderBackend::get().deleteBuffer(obj->m_vertexBuffer);
                     }
                     return shouldRemove;
                 }
@@ -89,10 +379,11 @@ namespace Engine
     {
         for(auto& obj : m_objectList)
         {
-            GLuint buffer[1] = { obj.second->m_vertexBuffer };
-            glDeleteBuffers(1, buffer);
+            RenderBackend::get().deleteBuffer(obj.second->m_vertexBuffer);
         }
         m_objectList.clear();
+        m_modelList.clear();
+        m_skinnedModelList.clear();
     }
 
     GLuint RenderManager::registerTexture(const char* filePath)
@@ -144,8 +435,7 @@ namespace Engine
                     const bool shouldRemove = elem.second == tex;
                     if(shouldRemove)
                     {
-                        GLuint buffer[1] = { tex };
-                        glDeleteBuffers(1, buffer);
+                        RenderBackend::get().deleteTexture(tex);
                     }
                     return shouldRemove;
                 }
@@ -156,29 +446,89 @@ namespace Engine
     {
         for(auto& obj : m_textureList)
         {
-            GLuint buffer[1] = { obj.second };
-            glDeleteBuffers(1, buffer);
+            RenderBackend::get().deleteTexture(obj.second);
         }
         m_objectList.clear();
     }
 
-    std::pair<std::string, GLuint> RenderManager::registerShader(const std::string& shaderPath, std::string shaderName)
+    std::pair<std::string, GLuint> RenderManager::registerShader(
+            const std::string& shaderPath,
+            std::string shaderName,
+            unsigned int features /* = 0 */
+    )
     {
-        if(m_shaderList.contains(shaderName))
+        return registerShaderVariant(shaderPath, std::move(shaderName), features, nullptr);
+    }
+
+    std::pair<std::string, GLuint> RenderManager::registerShaderVariant(
+            const std::string& shaderPath,
+            std::string shaderName,
+            unsigned int features,
+            const ShaderSources* preloadedSources
+    )
+    {
+        // Once the source is known, variants only differing in undeclared features resolve to the same name
+        const auto declared = m_declaredShaderFeatures.find(shaderPath);
+        if(declared != m_declaredShaderFeatures.end())
+        {
+            features &= declared->second;
+        }
+
+        if(m_shaderList.contains(shaderName + GetShaderFeatureSuffix(features)))
         {
-            auto shader = m_shaderList.find(shaderName);
+            auto shader = m_shaderList.find(shaderName + GetShaderFeatureSuffix(features));
             return *shader;
         }
 
+        unsigned int declaredFeatures = 0;
         std::pair<std::string, GLuint> newShader;
-        newShader.first = std::move(shaderName);
-        newShader.second = LoadShaders((shaderPath + ".vert").c_str(), (shaderPath + ".frag").c_str());
+        if(preloadedSources && preloadedSources->valid)
+        {
+            // Read on the ThreadPool already, only compiling is left
+            declaredFeatures = preloadedSources->declaredFeatures;
+            newShader.second = CreateShaderProgram(preloadedSources->vertexCode, preloadedSources->fragmentCode);
+            FinishShaderProgram(
+                    newShader.second,
+                    (shaderPath + ".vert" + GetShaderFeatureSuffix(features & declaredFeatures)).c_str()
+            );
+        }
+        else
+        {
+            newShader.second = LoadShaders(
+                    (shaderPath + ".vert").c_str(),
+                    (shaderPath + ".frag").c_str(),
+                    features,
+                    &declaredFeatures
+            );
+        }
+        newShader.first = std::move(shaderName) + GetShaderFeatureSuffix(features & declaredFeatures);
+
+        m_declaredShaderFeatures[shaderPath] = declaredFeatures;
+        m_shaderVariants[newShader.first] = { shaderPath, features & declaredFeatures };
+
+        if(m_shaderList.contains(newShader.first))
+        {
+            RenderBackend::get().deleteProgram(newShader.second);
+            return *m_shaderList.find(newShader.first);
+        }
 
         m_shaderList.emplace(newShader);
 
         return newShader;
     }
 
+    GLuint RenderManager::getShaderProgram(const std::string& variantName) const
+    {
+        const auto shader = m_shaderList.find(variantName);
+        return shader == m_shaderList.end() ? 0 : shader->second;
+    }
+
+    unsigned int RenderManager::getDeclaredShaderFeatures(const std::string& shaderPath) const
+    {
+        const auto declared = m_declaredShaderFeatures.find(shaderPath);
+        return declared == m_declaredShaderFeatures.end() ? 0 : declared->second;
+    }
+
     void RenderManager::deregisterShader(std::string shaderName /* = "" */, GLuint shaderId /* = -1 */)
     {
         if(shaderName.empty() && shaderId == -1)
@@ -186,11 +536,19 @@ namespace Engine
             fprintf(stderr, "Deregistering shader failed. No shader specified");
         }
 
-        std::erase_if(
-                m_shaderList,
-                [&shaderName, &shaderId](const auto& elem)
-                { return elem.first == shaderName || elem.second == shaderId; }
-        );
+        // The cache owns the programs, Shaders using them don't delete them
+        for(auto shader = m_shaderList.begin(); shader != m_shaderList.end();)
+        {
+            if(shader->first == shaderName || shader->second == shaderId)
+            {
+                RenderBackend::get().deleteProgram(shader->second);
+                shader = m_shaderList.erase(shader);
+            }
+            else
+            {
+                ++shader;
+            }
+        }
     }
 
     void RenderManager::setWireframeMode(bool toggle)
@@ -200,7 +558,374 @@ namespace Engine
             return;
         }
 
-        glPolygonMode(GL_FRONT_AND_BACK, toggle ? GL_LINE : GL_FILL);
+        RenderBackend::get().polygonMode(toggle ? GL_LINE : GL_FILL);
         m_showWireframe = toggle;
     }
-} // namespace Engine
\ No newline at end of file
+
+    void RenderManager::enableHotReload(const std::string& sourceDirectory, const std::string& runtimeDirectory)
+    {
+        m_assetWatcher = std::make_unique<AssetWatcher>(sourceDirectory, runtimeDirectory);
+    }
+
+    void RenderManager::processHotReload()
+    {
+        if(!m_assetWatcher)
+        {
+            return;
+        }
+
+        for(const std::string& filePath : m_assetWatcher->consumeChangedFiles())
+        {
+            reloadAsset(filePath);
+        }
+
+        applyShaderReloads();
+        applyMeshReloads();
+    }
+
+    void RenderManager::preloadObject(const std::string& filePath)
+    {
+        if(!m_objectList.contains(filePath))
+        {
+            m_preloads.addObject(filePath);
+        }
+    }
+
+    void RenderManager::preloadTexture(const std::string& filePath)
+    {
+        if(!m_textureList.contains(filePath))
+        {
+            m_preloads.addTexture(filePath);
+        }
+    }
+
+    void RenderManager::preloadShader(const std::string& shaderPath, const std::string& shaderName, unsigned int features)
+    {
+        m_preloads.addShader(shaderPath, shaderName, features);
+    }
+
+    void RenderManager::adoptPreloads(AssetPreloads&& preloads)
+    {
+        for(AssetPreloads::ObjectPreload& preload : preloads.m_objects)
+        {
+            if(!m_preloads.contains(preload.filePath))
+            {
+                m_preloads.m_objects.push_back(std::move(preload));
+            }
+        }
+        for(AssetPreloads::TexturePreload& preload : preloads.m_textures)
+        {
+            if(!m_preloads.contains(preload.filePath))
+            {
+                m_preloads.m_textures.push_back(std::move(preload));
+            }
+        }
+        std::move(preloads.m_shaders.begin(), preloads.m_shaders.end(), std::back_inserter(m_preloads.m_shaders));
+        preloads = AssetPreloads();
+    }
+
+    void RenderManager::processPreloads() { uploadPreloads(true); }
+
+    void RenderManager::finishPreloads()
+    {
+        m_preloads.wait();
+        uploadPreloads(false);
+    }
+
+    void RenderManager::uploadPreloads(bool budgeted)
+    {
+        if(getPendingPreloadCount() == 0)
+        {
+            return;
+        }
+
+        using Clock = std::chrono::steady_clock;
+        const auto deadline = Clock::now() + std::chrono::duration<double, std::milli>(m_preloadBudgetMs);
+        bool uploaded = false;
+        // The first upload of a call always happens, every later one only while the budget lasts
+        const auto hasBudget = [budgeted, &uploaded, &deadline]()
+        { return !budgeted || !uploaded || Clock::now() < deadline; };
+
+        std::erase_if(
+                m_preloads.m_objects,
+                [this, &uploaded, &hasBudget](AssetPreloads::ObjectPreload& preload)
+                {
+                    if(!hasBudget() || !AssetPreloads::isReady(preload.mesh))
+                    {
+                        return false;
+                    }
+
+                    CookedMesh mesh = preload.mesh.get();
+                    // Registered synchronously in the meantime, the preload is no longer needed
+                    if(mesh.valid && !m_objectList.contains(preload.filePath))
+                    {
+                        std::shared_ptr<ObjectData> newObject = createEmptyObject(preload.filePath);
+                        uploadMesh(*newObject, mesh);
+                        m_objectList[preload.filePath] = newObject;
+                    }
+                    uploaded = true;
+                    return true;
+                }
+        );
+
+        std::erase_if(
+                m_preloads.m_textures,
+                [this, &uploaded, &hasBudget](AssetPreloads::TexturePreload& preload)
+                {
+                    if(!hasBudget() || !AssetPreloads::isReady(preload.image))
+                    {
+                        return false;
+                    }
+
+                    const TextureImage image = preload.image.get();
+                    if(image.valid && !m_textureList.contains(preload.filePath))
+                    {
+                        m_textureList[preload.filePath] = uploadTextureImage(image);
+                    }
+                    uploaded = true;
+                    return true;
+                }
+        );
+
+        // Compiling is the most expensive part, one variant at a time keeps the frame within budget
+        std::erase_if(
+                m_preloads.m_shaders,
+                [this, &uploaded, &hasBudget](AssetPreloads::ShaderPreload& preload)
+                {
+                    if(!hasBudget() || !AssetPreloads::isReady(preload.sources))
+                    {
+                        return false;
+                    }
+
+                    const ShaderSources sources = preload.sources.get();
+                    registerShaderVariant(preload.shaderPath, preload.shaderName, preload.features, &sources);
+                    uploaded = true;
+                    return true;
+                }
+        );
+    }
+
+    void RenderManager::reloadAsset(const std::string& filePath)
+    {
+        const size_t dotIndex = filePath.find_last_of('.');
+        if(dotIndex == std::string::npos)
+        {
+            return;
+        }
+        const std::string basePath = filePath.substr(0, dotIndex);
+        const std::string fileExtension = filePath.substr(dotIndex + 1);
+
+        if(fileExtension == "vert" || fileExtension == "frag")
+        {
+            for(const auto& [variantName, variant] : m_shaderVariants)
+            {
+                if(variant.shaderPath != basePath)
+                {
+                    continue;
+                }
+
+                // Drop a reload of the same variant that is still in flight, the newer sources win
+                std::erase_if(
+                        m_shaderReloads,
+                        [&variantName](const ShaderReload& reload)
+                        {
+                            if(reload.variantName != variantName)
+                            {
+                                return false;
+                            }
+                            if(reload.programId != 0)
+                            {
+                                RenderBackend::get().deleteProgram(reload.programId);
+                            }
+                            return true;
+                        }
+                );
+
+                const std::string shaderPath = variant.shaderPath;
+                const unsigned int features = variant.features;
+                m_shaderReloads.push_back({ variantName,
+                                            SingletonManager::get<ThreadPool>()->enqueue(
+                                                    [shaderPath, features]()
+                                                    {
+                                                        ShaderSources sources;
+                                                        sources.valid = ReadShaderSources(
+                                                                (shaderPath + ".vert").c_str(),
+                                                                (shaderPath + ".frag").c_str(),
+                                                                features,
+                                                                sources.vertexCode,
+                                                                sources.fragmentCode
+                                                        );
+                                                        return sources;
+                                                    }
+                                            ) });
+            }
+        }
+        else if((m_objectList.contains(filePath) || m_modelList.contains(filePath)) && !reloadGlb(filePath))
+        {
+            // The changed source invalidates the cooked cache, so imported models get cooked again
+            m_meshReloads.push_back({ filePath,
+                                      SingletonManager::get<ThreadPool>()->enqueue([filePath]()
+                                                                                   { return loadCookedModel(filePath); }) });
+        }
+        else if(m_textureList.contains(filePath))
+        {
+            reloadTexture(filePath, m_textureList[filePath]);
+        }
+    }
+
+    void RenderManager::applyShaderReloads()
+    {
+        std::erase_if(
+                m_shaderReloads,
+                [this](ShaderReload& reload)
+                {
+                    // Sources are still read on the ThreadPool
+                    if(reload.programId == 0)
+                    {
+                        if(reload.sources.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+                        {
+                            return false;
+                        }
+
+                        const ShaderSources sources = reload.sources.get();
+                        if(!sources.valid)
+                        {
+                            return true;
+                        }
+                        reload.programId = CreateShaderProgram(sources.vertexCode, sources.fragmentCode);
+                    }
+
+                    // The driver may still compile in the background
+                    if(!IsShaderProgramReady(reload.programId))
+                    {
+                        return false;
+                    }
+
+                    if(!FinishShaderProgram(reload.programId, reload.variantName.c_str()))
+                    {
+                        fprintf(stderr, "Reloading shader %s failed, keeping the previous program\n", reload.variantName.c_str());
+                        RenderBackend::get().deleteProgram(reload.programId);
+                        return true;
+                    }
+
+                    const auto shader = m_shaderList.find(reload.variantName);
+                    if(shader == m_shaderList.end())
+                    {
+                        RenderBackend::get().deleteProgram(reload.programId);
+                        return true;
+                    }
+
+                    RenderBackend::get().deleteProgram(shader->second);
+                    shader->second = reload.programId;
+                    m_shaderGeneration++;
+
+                    std::cout << "Reloaded shader " << reload.variantName << std::endl;
+                    return true;
+                }
+        );
+    }
+
+    void RenderManager::applyMeshReloads()
+    {
+        std::erase_if(
+                m_meshReloads,
+                [this](MeshReload& reload)
+                {
+                    if(reload.model.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+                    {
+                        return false;
+                    }
+
+                    CookedModel model = reload.model.get();
+                    if(model.meshes.empty())
+                    {
+                        return true;
+                    }
+
+                    // Swap the data of the existing objects, so every node using them picks up the new meshes
+                    const auto object = m_objectList.find(reload.filePath);
+                    if(object != m_objectList.end())
+                    {
+                        CookedMesh mesh = ModelImporter::mergeMeshes(model);
+                        if(!mesh.valid)
+                        {
+                            mesh = model.meshes.front();
+                        }
+                        uploadMesh(*object->second, mesh);
+                    }
+
+                    const auto parts = m_modelList.find(reload.filePath);
+                    if(parts != m_modelList.end())
+                    {
+                        if(parts->second.size() != model.meshes.size())
+                        {
+                            std::cout << "Mesh count of " << reload.filePath << " changed, only matching meshes get reloaded"
+                                      << std::endl;
+                        }
+
+                        for(size_t i = 0; i < std::min(parts->second.size(), model.meshes.size()); i++)
+                        {
+                            uploadMesh(*parts->second[i].objectData, model.meshes[i]);
+                        }
+                    }
+
+                    std::cout << "Reloaded object " << reload.filePath << std::endl;
+                    return true;
+                }
+        );
+    }
+
+    bool RenderManager::reloadGlb(const std::string& filePath)
+    {
+        // The fast path uploads directly & has to stay on the GL thread, it is quick enough to not need the pool
+        std::vector<GlbPrimitive> primitives;
+        if(!loadGlbPrimitives(filePath, primitives))
+        {
+            return false;
+        }
+
+        const auto object = m_objectList.find(filePath);
+        const auto parts = m_modelList.find(filePath);
+        if((object != m_objectList.end() && primitives.size() != 1) ||
+           (parts != m_modelList.end() && parts->second.size() != primitives.size()))
+        {
+            // The layout changed, the importer path knows how to merge & match meshes
+            for(GlbPrimitive& primitive : primitives)
+            {
+                GlbFile::deletePrimitive(primitive);
+            }
+            return false;
+        }
+
+        if(object != m_objectList.end())
+        {
+            uploadGlbPrimitive(*object->second, primitives.front());
+        }
+        else
+        {
+            for(size_t i = 0; i < primitives.size(); i++)
+            {
+                uploadGlbPrimitive(*parts->second[i].objectData, primitives[i]);
+            }
+        }
+
+        std::cout << "Reloaded object " << filePath << std::endl;
+        return true;
+    }
+
+    void RenderManager::reloadTexture(const std::string& filePath, GLuint textureId)
+    {
+        // Uploading into the same texture keeps every node referencing it valid
+        const std::string fileExtension = filePath.substr(filePath.find_last_of('.') + 1);
+        if(fileExtension == "bmp" || fileExtension == "BMP")
+        {
+            loadFileBMP(filePath.c_str(), textureId);
+        }
+        else if(fileExtension == "dds" || fileExtension == "DDS")
+        {
+            loadFileDDS(filePath.c_str(), textureId);
+        }
+
+        std::cout << "Reloaded texture " << filePath << std::endl;
+    }
+} // namespace Engine
@@ -1,10 +1,16 @@
 #pragma once
 
+#include "../../helper/CookedModel.h"
 #include "../../helper/ObjectData.h"
+#include "../../helper/TextureImage.h"
+#include "AssetPreloads.h"
+#include "backend/RenderBackend.h"
 #include "lighting/AmbientLightUbo.h"
 #include "lighting/DiffuseLightUbo.h"
 
+#include <future>
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -12,18 +18,61 @@
 
 namespace Engine
 {
+    class AssetWatcher;
     class GeometryComponent;
     class Shader;
+    struct GlbPrimitive;
 
     inline const glm::vec3 WORLD_UP = glm::vec3(0.f, 1.f, 0.f);
 
+    /**
+     * @brief One mesh of an imported model together with the material it is drawn with.
+     */
+    struct ModelPart
+    {
+            std::shared_ptr<ObjectData> objectData;
+            CookedMaterial material;
+            GLuint texture = -1;
+    };
+
+    /**
+     * @brief The meshes of a skinned model & the skeleton their bone indices refer to.
+     */
+    struct SkinnedModel
+    {
+            std::shared_ptr<const Skeleton> skeleton;
+            std::vector<ModelPart> parts;
+    };
+
     class RenderManager
     {
         public:
             RenderManager();
-            ~RenderManager() = default;
+            ~RenderManager();
 
+            /**
+             * @brief Loads an OBJ file, or any format the ModelImporter handles. The meshes of an imported model get
+             * merged into one object, use registerModel to keep them apart.
+             */
             std::shared_ptr<ObjectData> registerObject(const char* filePath);
+
+            /**
+             * @brief Loads every mesh & material of a model through the ModelImporter and its cooked cache.
+             *
+             * @param filePath The path to the model, material textures are resolved relative to it
+             * @return std::vector<ModelPart> one part per mesh, empty if the import failed
+             */
+            std::vector<ModelPart> registerModel(const char* filePath);
+
+            /**
+             * @brief Loads a model keeping its node hierarchy as skeleton, together with its animations.
+             *
+             * Skinned models are cooked separately from the static variant & aren't hot reloaded.
+             *
+             * @return SkinnedModel without parts if the import failed
+             */
+            SkinnedModel registerSkinnedModel(const char* filePath);
+
             void deregisterObject(std::shared_ptr<ObjectData>& obj);
             void clearObjects();
 
@@ -36,14 +85,96 @@ namespace Engine
              *
              * @param shaderPath full file path, without extension
              * @param shaderName The name the shader should be given
-             * @return std::pair<std::string, GLuint> the loaded shaders name & ID
+             * @param features ShaderFeature bitmask of the variant. Features the source doesn't declare are ignored,
+             * so requests differing only in those share one program.
+             * @return std::pair<std::string, GLuint> the loaded shaders variant name & ID
+             */
+            std::pair<std::string, GLuint> registerShader(
+                    const std::string& shaderPath,
+                    std::string shaderName,
+                    unsigned int features = 0
+            );
+
+            /**
+             * @return unsigned int the ShaderFeature bitmask declared by an already registered shader source
              */
-            std::pair<std::string, GLuint> registerShader(const std::string& shaderPath, std::string shaderName);
+            unsigned int getDeclaredShaderFeatures(const std::string& shaderPath) const;
 
             void deregisterShader(std::string shaderName = std::string(), GLuint shaderId = -1);
 
             std::map<std::string, GLuint> getShader() const { return m_shaderList; }
 
+            /**
+             * @return GLuint the current program of a shader variant, 0 if it isn't registered
+             */
+            GLuint getShaderProgram(const std::string& variantName) const;
+
+            /**
+             * @brief Gets incremented whenever a hot reload swapped a shader program.
+             */
+            unsigned int getShaderGeneration() const { return m_shaderGeneration; };
+
+            /**
+             * @brief Starts watching the asset directory. Changed shaders, meshes and textures get reloaded in place.
+             *
+             * @param sourceDirectory The directory being edited, changes get mirrored into the runtime directory
+             * @param runtimeDirectory The directory all assets are registered from
+             */
+            void enableHotReload(const std::string& sourceDirectory, const std::string& runtimeDirectory = "resources");
+
+            /**
+             * @brief Picks up changed assets and applies finished reloads. Has to be called once per frame from the
+             * thread owning the GL context.
+             *
+             * Shader sources and meshes are read & cooked on the ThreadPool. A shader program that fails to link
+             * gets dropped and the previous one stays in use.
+             */
+            void processHotReload();
+
+            /**
+             * @brief Reads & cooks an object on the ThreadPool. Once processPreloads uploaded it, registerObject of the
+             * same path only hits the cache.
+             */
+            void preloadObject(const std::string& filePath);
+
+            /**
+             * @brief Reads a BMP or DDS texture on the ThreadPool, to be uploaded by processPreloads.
+             */
+            void preloadTexture(const std::string& filePath);
+
+            /**
+             * @brief Queues compiling a shader variant in processPreloads, takes the same parameters as registerShader.
+             */
+            void preloadShader(const std::string& shaderPath, const std::string& shaderName, unsigned int features = 0);
+
+            /**
+             * @brief Uploads finished preloads until the preload budget of the frame is used up. Has to be called once
+             * per frame from the thread owning the GL context.
+             *
+             * At least one preload gets uploaded per call, so a single large asset can't stall the queue forever.
+             */
+            void processPreloads();
+
+            /**
+             * @brief Takes over preloads prepared before the RenderManager existed, e.g. while the context got created.
+             * They get uploaded by processPreloads() like every other preload.
+             */
+            void adoptPreloads(AssetPreloads&& preloads);
+
+            /**
+             * @brief Waits for all preloads & uploads them regardless of the budget. For loading screens & start-up.
+             */
+            void finishPreloads();
+
+            size_t getPendingPreloadCount() const { return m_preloads.getCount(); };
+
+            double getPreloadBudget() const { return m_preloadBudgetMs; };
+
+            /**
+             * @brief Sets how many milliseconds per frame processPreloads may spend on uploads & shader compiles.
+             */
+            void setPreloadBudget(double milliseconds) { m_preloadBudgetMs = milliseconds; };
+
             std::map<std::string, std::shared_ptr<ObjectData>> getObjects() { return m_objectList; };
 
             std::shared_ptr<Lighting::AmbientLightUbo>& getAmbientLightUbo() { return m_ambientLightUbo; };
@@ -59,25 +190,95 @@ namespace Engine
             {
                 int dataSize = data.size() * sizeof(T);
 
-                // Identify the vertex buffer
-                GLuint vbo;
+                RenderBackend& backend = RenderBackend::get();
+
                 // Generate a buffer with our identifier
-                glGenBuffers(1, &vbo);
-                glBindBuffer(GL_ARRAY_BUFFER, vbo);
+                GLuint vbo = backend.createBuffer();
+                backend.bindBuffer(GL_ARRAY_BUFFER, vbo);
 
                 // Give vertices to OpenGL
-                glBufferData(GL_ARRAY_BUFFER, dataSize, &data[0], GL_STATIC_DRAW);
+                backend.bufferData(GL_ARRAY_BUFFER, dataSize, &data[0], GL_STATIC_DRAW);
 
                 return vbo;
             };
 
         private:
+            struct ShaderVariant
+            {
+                    std::string shaderPath;
+                    unsigned int features;
+            };
+
+            struct ShaderReload
+            {
+                    std::string variantName;
+                    std::future<ShaderSources> sources;
+                    GLuint programId = 0;
+            };
+
+            struct MeshReload
+            {
+                    std::string filePath;
+                    std::future<CookedModel> model;
+            };
+
+            friend class AssetPreloads;
+
+            /**
+             * @param preloadedSources Sources read ahead of time, the files get read if they are missing
+             */
+            std::pair<std::string, GLuint> registerShaderVariant(
+                    const std::string& shaderPath,
+                    std::string shaderName,
+                    unsigned int features,
+                    const ShaderSources* preloadedSources
+            );
+            void uploadPreloads(bool budgeted);
+
+            static CookedModel loadCookedModel(const std::string& filePath);
+            static CookedMesh loadCookedObject(const std::string& filePath);
+            static TextureImage loadTextureImage(const std::string& filePath);
+            static void uploadMesh(ObjectData& objectData, CookedMesh& mesh);
+            static void uploadGlbPrimitive(ObjectData& objectData, GlbPrimitive& primitive);
+            static std::shared_ptr<ObjectData> createEmptyObject(const std::string& filePath);
+
+            /**
+             * @brief Loads a GLB file through the zero copy fast path.
+             *
+             * @param maxPrimitives Files with more primitives aren't loaded & leave the decision to the caller
+             * @return false if the file needs the ModelImporter instead
+             */
+            static bool loadGlbPrimitives(
+                    const std::string& filePath,
+                    std::vector<GlbPrimitive>& primitives,
+                    size_t maxPrimitives = -1
+            );
+            bool reloadGlb(const std::string& filePath);
+
+            void reloadAsset(const std::string& filePath);
+            void applyShaderReloads();
+            void applyMeshReloads();
+            void reloadTexture(const std::string& filePath, GLuint textureId);
+
             std::shared_ptr<Lighting::AmbientLightUbo> m_ambientLightUbo;
             std::shared_ptr<Lighting::DiffuseLightUbo> m_diffuseLightUbo;
             std::map<std::string, GLuint> m_shaderList;
+            std::map<std::string, unsigned int> m_declaredShaderFeatures;
+            std::map<std::string, ShaderVariant> m_shaderVariants;
+            unsigned int m_shaderGeneration;
+
+            std::unique_ptr<AssetWatcher> m_assetWatcher;
+            std::vector<ShaderReload> m_shaderReloads;
+            std::vector<MeshReload> m_meshReloads;
+            AssetPreloads m_preloads;
+            double m_preloadBudgetMs;
             std::map<std::string, std::shared_ptr<ObjectData>> m_objectList;
+            std::map<std::string, std::vector<ModelPart>> m_modelList;
+            std::map<std::string, SkinnedModel> m_skinnedModelList;
             std::map<std::string, GLuint> m_textureList;
             bool m_showWireframe;
+
+            static constexpr double DEFAULT_PRELOAD_BUDGET_MS = 2.0;
     };
 
 } // namespace Engine
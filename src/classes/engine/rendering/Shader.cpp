@@ -1,116 +1,285 @@
 
 #include "Shader.h"
 
+#include "../../nodeComponents/SkinnedMeshComponent.h"
+#include "backend/RenderBackend.h"
+
+#include <array>
+
 using namespace Engine;
 
-Shader::Shader() : m_passVisual(PASS_NONE) {}
+Shader::Shader()
+    : m_features(SHADER_FEATURE_NONE)
+    , m_renderFunction(getRenderFunction(SHADER_FEATURE_NONE))
+    , m_mvpUniform(-1)
+    , m_tintUniform(-1)
+    , m_textureSamplerUniform(-1)
+    , m_bonePaletteUniform(-1)
+    , m_instanceBuffer(-1)
+    , m_shaderGeneration(0)
+{
+}
 
 Shader::~Shader()
 {
-    // TODO: check if this is the correct way to handle expired programms
-    GLint numShaders;
-    glGetProgramiv(m_shaderIdentifier.second, GL_ATTACHED_SHADERS, &numShaders);
-
-    // Create an array to store the shader object IDs
-    auto* shaderIds = new GLuint[numShaders];
-
-    // Get the attached shader primitives
-    glGetAttachedShaders(m_shaderIdentifier.second, numShaders, nullptr, shaderIds);
-
-    // Detach and delete the shader primitives if needed
-    for(int i = 0; i < numShaders; ++i)
+    // The program is shared with every other Shader of the same variant, the RenderManager's cache owns it
+    if(m_instanceBuffer != -1)
     {
-        GLuint shaderId = shaderIds[i];
-        glDetachShader(m_shaderIdentifier.second, shaderId);
-        glDeleteShader(shaderId);
+        RenderBackend::get().deleteBuffer(m_instanceBuffer);
     }
-
-    // Finally, delete the program
-    glDeleteProgram(m_shaderIdentifier.second);
-    delete[](shaderIds);
 }
 
 void Shader::registerShader(
         const std::shared_ptr<RenderManager>& renderManager,
         const std::string& shaderPath,
-        const std::string& shaderName
+        const std::string& shaderName,
+        unsigned int features /* = SHADER_FEATURE_NONE */
 )
 {
-    m_shaderIdentifier = renderManager->registerShader(shaderPath, shaderName);
+    m_shaderIdentifier = renderManager->registerShader(shaderPath, shaderName, features);
+    m_features = features & renderManager->getDeclaredShaderFeatures(shaderPath);
+    m_renderFunction = getRenderFunction(m_features);
+    m_renderManager = renderManager;
+    m_shaderGeneration = renderManager->getShaderGeneration();
+
+    cacheUniformLocations();
+}
+
+void Shader::refreshProgram()
+{
+    const auto renderManager = m_renderManager.lock();
+    if(!renderManager || renderManager->getShaderGeneration() == m_shaderGeneration)
+    {
+        return;
+    }
+    m_shaderGeneration = renderManager->getShaderGeneration();
+
+    const GLuint programId = renderManager->getShaderProgram(m_shaderIdentifier.first);
+    if(programId == 0 || programId == m_shaderIdentifier.second)
+    {
+        return;
+    }
+
+    // A new program has none of the old uniform locations & block bindings
+    m_shaderIdentifier.second = programId;
+    cacheUniformLocations();
+    for(const auto& ubo : m_boundUbos)
+    {
+        bindUboBlock(ubo);
+    }
+}
+
+void Shader::cacheUniformLocations()
+{
+    // Uniform locations don't change after linking, so they are only looked up once per program
+    m_mvpUniform = getActiveUniform(hasFeature(SHADER_FEATURE_INSTANCED) ? "VP" : "MVP");
+    m_tintUniform = getActiveUniform("tintColor");
+    m_textureSamplerUniform = hasFeature(SHADER_FEATURE_TEXTURED) ? getActiveUniform("textureSampler") : -1;
+    m_bonePaletteUniform = hasFeature(SHADER_FEATURE_SKINNED) ? getActiveUniform("bonePalette") : -1;
 }
 
 void Shader::renderVertices(std::nullptr_t object, Engine::CameraComponent* camera)
 {
+    refreshProgram();
     loadCustomRenderData(camera);
 }
 
 void Shader::renderVertices(const std::shared_ptr<GeometryComponent>& object, Engine::CameraComponent* camera)
 {
+    refreshProgram();
+    m_renderFunction(*this, object, camera, nullptr);
+}
+
+void Shader::renderInstances(
+        const std::shared_ptr<GeometryComponent>& object,
+        CameraComponent* camera,
+        const std::vector<glm::mat4>& modelMatrices
+)
+{
+    if(!hasFeature(SHADER_FEATURE_INSTANCED))
+    {
+        fprintf(stderr, "Shader %s has no instanced variant!\n", m_shaderIdentifier.first.c_str());
+        return;
+    }
+
+    if(modelMatrices.empty())
+    {
+        return;
+    }
+
+    refreshProgram();
+    m_renderFunction(*this, object, camera, &modelMatrices);
+}
+
+template<unsigned int Features>
+void Shader::renderSpecialised(
+        Shader& shader,
+        const std::shared_ptr<GeometryComponent>& object,
+        CameraComponent* camera,
+        const std::vector<glm::mat4>* modelMatrices
+)
+{
+    constexpr bool textured = (Features & SHADER_FEATURE_TEXTURED) != 0;
+    constexpr bool vertexColor = (Features & SHADER_FEATURE_VERTEX_COLOR) != 0;
+    constexpr bool lit = (Features & SHADER_FEATURE_LIT) != 0;
+    constexpr bool instanced = (Features & SHADER_FEATURE_INSTANCED) != 0;
+    constexpr bool skinned = (Features & SHADER_FEATURE_SKINNED) != 0;
+
     const auto& objectData = object->getObjectData();
-    glm::mat4 mvp = camera->getProjectionMatrix() * camera->getViewMatrix() * object->getGlobalModelMatrix();
+    RenderBackend& backend = RenderBackend::get();
 
-    glUseProgram(getShaderIdentifier().second);
+    backend.useProgram(shader.m_shaderIdentifier.second);
 
-    // Load MVP matrix into uniform
-    glUniformMatrix4fv(getActiveUniform("MVP"), 1, GL_FALSE, &mvp[0][0]);
+    // Load MVP matrix into uniform, instanced variants get their model matrices per instance
+    if constexpr(instanced)
+    {
+        backend.setUniform(shader.m_mvpUniform, camera->getProjectionMatrix() * camera->getViewMatrix());
+    }
+    else
+    {
+        glm::mat4 mvp = camera->getProjectionMatrix() * camera->getViewMatrix() * object->getGlobalModelMatrix();
+        backend.setUniform(shader.m_mvpUniform, mvp);
+    }
 
     // Load tint value into uniform
-    const glm::vec4 tint = object->getTint();
-    glUniform4f(getActiveUniform("tintColor"), tint.x, tint.y, tint.z, tint.w);
+    backend.setUniform(shader.m_tintUniform, object->getTint());
 
     if(objectData->m_vertexBuffer != -1)
     {
         bindVertexData(GLOBAL_ATTRIB_INDEX_VERTEXPOSITION, GL_ARRAY_BUFFER, objectData->m_vertexBuffer, 3, GL_FLOAT, false, 0);
-        m_usedAttribArrays.push_back(GLOBAL_ATTRIB_INDEX_VERTEXPOSITION);
     }
 
-    if(objectData->m_normalBuffer != -1)
+    if constexpr(lit)
     {
-        bindVertexData(GLOBAL_ATTRIB_INDEX_VERTEXNORMAL, GL_ARRAY_BUFFER, objectData->m_normalBuffer, 3, GL_FLOAT, false, 0);
-        m_usedAttribArrays.push_back(GLOBAL_ATTRIB_INDEX_VERTEXNORMAL);
+        if(objectData->m_normalBuffer != -1)
+        {
+            bindVertexData(GLOBAL_ATTRIB_INDEX_VERTEXNORMAL, GL_ARRAY_BUFFER, objectData->m_normalBuffer, 3, GL_FLOAT, false, 0);
+        }
+    }
+
+    if constexpr(textured)
+    {
+        if(object->getTextureBuffer() != -1)
+        {
+            bindTexture(GLOBAL_ATTRIB_INDEX_VERTEXUV, objectData->m_uvBuffer, object->getTextureBuffer(), shader.m_textureSamplerUniform);
+        }
     }
 
-    if(object->getTextureBuffer() != -1)
+    if constexpr(vertexColor)
     {
-        if(m_passVisual == PASS_COLOR)
+        // The texture buffer holds either a texture or vertex colors, textured variants fall back to white
+        if(!textured && object->getTextureBuffer() != -1)
         {
             bindVertexData(GLOBAL_ATTRIB_INDEX_VERTEXCOLOR, GL_ARRAY_BUFFER, object->getTextureBuffer(), 4, GL_FLOAT, false, 0);
-            m_usedAttribArrays.push_back(GLOBAL_ATTRIB_INDEX_VERTEXCOLOR);
         }
-        else if(m_passVisual == PASS_TEXTURE)
+        else
         {
-            bindTexture(
-                    GLOBAL_ATTRIB_INDEX_VERTEXCOLOR,
-                    objectData->m_uvBuffer,
-                    object->getTextureBuffer(),
-                    getActiveUniform("textureSampler")
-            );
-            m_usedAttribArrays.push_back(GLOBAL_ATTRIB_INDEX_VERTEXCOLOR);
+            backend.setVertexAttribute(GLOBAL_ATTRIB_INDEX_VERTEXCOLOR, glm::vec4(1.f));
         }
     }
 
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, object->getIndexBuffer());
+    if constexpr(skinned)
+    {
+        // Geometry without bones gets zero weights, which the shader treats as unskinned
+        const auto* skinnedMesh = dynamic_cast<const SkinnedMeshComponent*>(object.get());
+        if(skinnedMesh && objectData->isSkinned() && skinnedMesh->getPaletteTexture() != 0)
+        {
+            backend.enableVertexAttribute(GLOBAL_ATTRIB_INDEX_BONEINDICES);
+            backend.bindBuffer(GL_ARRAY_BUFFER, objectData->m_boneIndexBuffer);
+            backend.vertexAttributeIntegerPointer(GLOBAL_ATTRIB_INDEX_BONEINDICES, 4, GL_UNSIGNED_INT, 0, 0);
+            bindVertexData(GLOBAL_ATTRIB_INDEX_BONEWEIGHTS, GL_ARRAY_BUFFER, objectData->m_boneWeightBuffer, 4, GL_FLOAT, false, 0);
+
+            backend.activeTexture(GLOBAL_TEXTURE_UNIT_BONEPALETTE);
+            backend.bindTexture(GL_TEXTURE_BUFFER, skinnedMesh->getPaletteTexture());
+            backend.setUniform(shader.m_bonePaletteUniform, int(GLOBAL_TEXTURE_UNIT_BONEPALETTE));
+            backend.activeTexture(0);
+        }
+        else
+        {
+            backend.setVertexAttribute(GLOBAL_ATTRIB_INDEX_BONEINDICES, glm::uvec4(0));
+            backend.setVertexAttribute(GLOBAL_ATTRIB_INDEX_BONEWEIGHTS, glm::vec4(0.f));
+        }
+    }
+
+    backend.bindBuffer(GL_ELEMENT_ARRAY_BUFFER, object->getIndexBuffer());
 
     // Drawing the object
-    glDrawElements(
-            GL_TRIANGLES,                 // mode
-            objectData->getVertexCount(), // count
-            GL_UNSIGNED_SHORT,            // type
-            nullptr                       // element array buffer offset
-    );
+    if constexpr(instanced)
+    {
+        const glm::mat4 modelMatrix = object->getGlobalModelMatrix();
+        const glm::mat4* matrixData = modelMatrices ? modelMatrices->data() : &modelMatrix;
+        const auto instanceCount = modelMatrices ? (GLsizei)modelMatrices->size() : 1;
 
-    loadCustomRenderData(object, camera);
+        if(shader.m_instanceBuffer == -1)
+        {
+            shader.m_instanceBuffer = backend.createBuffer();
+        }
+        backend.bindBuffer(GL_ARRAY_BUFFER, shader.m_instanceBuffer);
+        backend.bufferData(GL_ARRAY_BUFFER, instanceCount * sizeof(glm::mat4), matrixData, GL_STREAM_DRAW);
 
-    for(const GLuint arrayIndex : m_usedAttribArrays)
+        for(GLuint column = 0; column < 4; ++column)
+        {
+            const GLuint attribId = GLOBAL_ATTRIB_INDEX_INSTANCEMATRIX + column;
+            backend.enableVertexAttribute(attribId);
+            backend.vertexAttributePointer(attribId, 4, GL_FLOAT, false, sizeof(glm::mat4), sizeof(glm::vec4) * column);
+            backend.vertexAttributeDivisor(attribId, 1);
+        }
+
+        backend.drawElementsInstanced(GL_TRIANGLES, objectData->getVertexCount(), GL_UNSIGNED_SHORT, 0, instanceCount);
+
+        for(GLuint column = 0; column < 4; ++column)
+        {
+            backend.vertexAttributeDivisor(GLOBAL_ATTRIB_INDEX_INSTANCEMATRIX + column, 0);
+            backend.disableVertexAttribute(GLOBAL_ATTRIB_INDEX_INSTANCEMATRIX + column);
+        }
+    }
+    else
+    {
+        backend.drawElements(
+                GL_TRIANGLES,                 // mode
+                objectData->getVertexCount(), // count
+                GL_UNSIGNED_SHORT,            // type
+                0                             // element array buffer offset
+        );
+    }
+
+    shader.loadCustomRenderData(object, camera);
+
+    // Disabling arrays that never got enabled is a no-op, so no bookkeeping is needed
+    backend.disableVertexAttribute(GLOBAL_ATTRIB_INDEX_VERTEXPOSITION);
+    if constexpr(lit)
+    {
+        backend.disableVertexAttribute(GLOBAL_ATTRIB_INDEX_VERTEXNORMAL);
+    }
+    if constexpr(textured)
+    {
+        backend.disableVertexAttribute(GLOBAL_ATTRIB_INDEX_VERTEXUV);
+    }
+    if constexpr(vertexColor)
+    {
+        backend.disableVertexAttribute(GLOBAL_ATTRIB_INDEX_VERTEXCOLOR);
+    }
+    if constexpr(skinned)
     {
-        glDisableVertexAttribArray(arrayIndex);
+        backend.disableVertexAttribute(GLOBAL_ATTRIB_INDEX_BONEINDICES);
+        backend.disableVertexAttribute(GLOBAL_ATTRIB_INDEX_BONEWEIGHTS);
     }
-    m_usedAttribArrays.clear();
+}
+
+Shader::RenderFunction Shader::getRenderFunction(unsigned int features)
+{
+    // One specialised render function per feature permutation, generated at compile time
+    static constexpr auto RENDER_FUNCTIONS = []<unsigned int... Masks>(std::integer_sequence<unsigned int, Masks...>)
+    { return std::array<RenderFunction, sizeof...(Masks)> { &Shader::renderSpecialised<Masks>... }; }(
+            std::make_integer_sequence<unsigned int, SHADER_FEATURE_PERMUTATIONS>()
+    );
+
+    return RENDER_FUNCTIONS[features & (SHADER_FEATURE_PERMUTATIONS - 1)];
 }
 
 GLint Shader::getActiveUniform(const std::string& uniform) const
 {
-    const GLint index = glGetUniformLocation(m_shaderIdentifier.second, uniform.c_str());
+    const GLint index = RenderBackend::get().getUniformLocation(m_shaderIdentifier.second, uniform.c_str());
 
     if(index == GL_INVALID_VALUE)
     {
@@ -128,7 +297,8 @@ GLint Shader::getActiveUniform(const std::string& uniform) const
 
 void Shader::bindUbo(const std::shared_ptr<UboBlock>& ubo)
 {
-    unsigned int index = glGetUniformBlockIndex(m_shaderIdentifier.second, ubo->getBindingPoint().first);
+    const auto bindingPoint = ubo->getBindingPoint();
+    unsigned int index = RenderBackend::get().getUniformBlockIndex(m_shaderIdentifier.second, bindingPoint.first);
 
     if(index == GL_INVALID_INDEX)
     {
@@ -136,11 +306,21 @@ void Shader::bindUbo(const std::shared_ptr<UboBlock>& ubo)
         return;
     }
 
-    glUniformBlockBinding(m_shaderIdentifier.second, index, ubo->getBindingPoint().second);
+    bindUboBlock(ubo);
 
     m_boundUbos.push_back(ubo);
 }
 
+void Shader::bindUboBlock(const std::shared_ptr<UboBlock>& ubo) const
+{
+    RenderBackend& backend = RenderBackend::get();
+    unsigned int index = backend.getUniformBlockIndex(m_shaderIdentifier.second, ubo->getBindingPoint().first);
+    if(index != GL_INVALID_INDEX)
+    {
+        backend.uniformBlockBinding(m_shaderIdentifier.second, index, ubo->getBindingPoint().second);
+    }
+}
+
 void Shader::removeBoundUbo(const std::shared_ptr<UboBlock>& ubo)
 {
     m_boundUbos.erase(std::remove(m_boundUbos.begin(), m_boundUbos.end(), ubo), m_boundUbos.end());
@@ -148,9 +328,10 @@ void Shader::removeBoundUbo(const std::shared_ptr<UboBlock>& ubo)
 
 void Shader::bindTexture(GLuint attribId, GLuint bufferId, GLuint textureBufferId, GLint textureSamplerUniformId)
 {
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, textureBufferId);
-    glUniform1i(textureSamplerUniformId, 0);
+    RenderBackend& backend = RenderBackend::get();
+    backend.activeTexture(0);
+    backend.bindTexture(GL_TEXTURE_2D, textureBufferId);
+    backend.setUniform(textureSamplerUniformId, 0);
 
     bindVertexData(attribId, GL_ARRAY_BUFFER, bufferId, 2, GL_FLOAT, false, 0);
 }
@@ -165,7 +346,8 @@ void Shader::bindVertexData(
         int stride
 )
 {
-    glEnableVertexAttribArray(attribId);
-    glBindBuffer(targetType, bufferId);
-    glVertexAttribPointer(attribId, size, dataType, normalized, stride, (void*)nullptr);
+    RenderBackend& backend = RenderBackend::get();
+    backend.enableVertexAttribute(attribId);
+    backend.bindBuffer(targetType, bufferId);
+    backend.vertexAttributePointer(attribId, size, dataType, normalized, stride, 0);
 }
\ No newline at end of file
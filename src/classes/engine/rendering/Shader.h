@@ -3,6 +3,7 @@
 #include "../../nodeComponents/CameraComponent.h"
 #include "../../nodeComponents/GeometryComponent.h"
 #include "RenderManager.h"
+#include "ShaderFeatures.h"
 #include "UboBlock.h"
 #include <utility>
 
@@ -11,6 +12,11 @@ namespace Engine
     inline const GLuint GLOBAL_ATTRIB_INDEX_VERTEXPOSITION = 0;
     inline const GLuint GLOBAL_ATTRIB_INDEX_VERTEXCOLOR = 1;
     inline const GLuint GLOBAL_ATTRIB_INDEX_VERTEXNORMAL = 2;
+    inline const GLuint GLOBAL_ATTRIB_INDEX_VERTEXUV = 3;
+    inline const GLuint GLOBAL_ATTRIB_INDEX_INSTANCEMATRIX = 4; // Occupies 4 - 7, one per matrix column
+    inline const GLuint GLOBAL_ATTRIB_INDEX_BONEINDICES = 8;
+    inline const GLuint GLOBAL_ATTRIB_INDEX_BONEWEIGHTS = 9;
+    inline const GLuint GLOBAL_TEXTURE_UNIT_BONEPALETTE = 1;
 
     class Shader
     {
@@ -18,21 +24,33 @@ namespace Engine
             Shader();
             ~Shader();
 
-            enum passVisual
-            {
-                PASS_NONE = 0,
-                PASS_TEXTURE = 1,
-                PASS_COLOR = 2
-            };
-
+            /**
+             * @brief Loads the variant of a shader source with the given features.
+             *
+             * The render function matching the features is selected once here, so drawing doesn't branch on them.
+             *
+             * @param features ShaderFeature bitmask. Features not declared by the source are dropped.
+             */
             void registerShader(
                     const std::shared_ptr<RenderManager>& renderManager,
                     const std::string& shaderPath,
-                    const std::string& shaderName
+                    const std::string& shaderName,
+                    unsigned int features = SHADER_FEATURE_NONE
             );
 
             virtual void renderVertices(std::nullptr_t object, CameraComponent* camera);
             virtual void renderVertices(const std::shared_ptr<GeometryComponent>& object, CameraComponent* camera);
+
+            /**
+             * @brief Draws the objects mesh once per model matrix in a single draw call.
+             *
+             * Requires a shader variant with SHADER_FEATURE_INSTANCED. The objects own transform is ignored.
+             */
+            void renderInstances(
+                    const std::shared_ptr<GeometryComponent>& object,
+                    CameraComponent* camera,
+                    const std::vector<glm::mat4>& modelMatrices
+            );
             virtual void loadCustomRenderData(CameraComponent* camera) {};
             virtual void loadCustomRenderData(const std::shared_ptr<GeometryComponent>& object, CameraComponent* camera) {
             };
@@ -59,13 +77,47 @@ namespace Engine
                     int stride
             );
 
-            passVisual getVisualPassStyle() const { return m_passVisual; }
+            unsigned int getFeatures() const { return m_features; }
+
+            bool hasFeature(ShaderFeature feature) const { return (m_features & feature) != 0; }
 
-            void setVisualPassStyle(passVisual passType) { m_passVisual = passType; }
+        protected:
+            /**
+             * @brief Picks up a program swapped by a hot reload. Has to be called before using the program.
+             */
+            void refreshProgram();
 
         private:
-            std::vector<GLuint> m_usedAttribArrays;
-            passVisual m_passVisual;
+            using RenderFunction = void (*)(
+                    Shader& shader,
+                    const std::shared_ptr<GeometryComponent>& object,
+                    CameraComponent* camera,
+                    const std::vector<glm::mat4>* modelMatrices
+            );
+
+            template<unsigned int Features>
+            static void renderSpecialised(
+                    Shader& shader,
+                    const std::shared_ptr<GeometryComponent>& object,
+                    CameraComponent* camera,
+                    const std::vector<glm::mat4>* modelMatrices
+            );
+
+            static RenderFunction getRenderFunction(unsigned int features);
+
+            void cacheUniformLocations();
+            void bindUboBlock(const std::shared_ptr<UboBlock>& ubo) const;
+
+            unsigned int m_features;
+            RenderFunction m_renderFunction;
+            GLint m_mvpUniform;
+            GLint m_tintUniform;
+            GLint m_textureSamplerUniform;
+            GLint m_bonePaletteUniform;
+            GLuint m_instanceBuffer;
+
+            std::weak_ptr<RenderManager> m_renderManager;
+            unsigned int m_shaderGeneration;
 
             std::pair<std::string, GLuint> m_shaderIdentifier;
             std::vector<std::shared_ptr<UboBlock>> m_boundUbos;
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <array>
+#include <sstream>
+#include <string>
+#include <utility>
+
+namespace Engine
+{
+    /**
+     * Feature keywords a shader source can declare with "#pragma shader_feature KEYWORD ...".
+     * Every enabled & declared keyword is injected into the source as "#define FEATURE_KEYWORD 1".
+     */
+    enum ShaderFeature : unsigned int
+    {
+        SHADER_FEATURE_NONE = 0,
+        SHADER_FEATURE_TEXTURED = 1 << 0,
+        SHADER_FEATURE_VERTEX_COLOR = 1 << 1,
+        SHADER_FEATURE_LIT = 1 << 2,
+        SHADER_FEATURE_INSTANCED = 1 << 3,
+        SHADER_FEATURE_ALPHA = 1 << 4,
+        SHADER_FEATURE_SKINNED = 1 << 5,
+        SHADER_FEATURE_DOUBLE_FLOAT = 1 << 6,
+        SHADER_FEATURE_PICKING = 1 << 7
+    };
+
+    inline constexpr unsigned int SHADER_FEATURE_COUNT = 8;
+    // Features past these only change the source, the render functions of Shader don't depend on them
+    inline constexpr unsigned int SHADER_FEATURE_RENDER_COUNT = 6;
+    inline constexpr unsigned int SHADER_FEATURE_PERMUTATIONS = 1 << SHADER_FEATURE_RENDER_COUNT;
+
+    inline const std::array<std::pair<ShaderFeature, const char*>, SHADER_FEATURE_COUNT> SHADER_FEATURE_KEYWORDS = { {
+            { SHADER_FEATURE_TEXTURED, "TEXTURED" },
+            { SHADER_FEATURE_VERTEX_COLOR, "VERTEX_COLOR" },
+            { SHADER_FEATURE_LIT, "LIT" },
+            { SHADER_FEATURE_INSTANCED, "INSTANCED" },
+            { SHADER_FEATURE_ALPHA, "ALPHA" },
+            { SHADER_FEATURE_SKINNED, "SKINNED" },
+            { SHADER_FEATURE_DOUBLE_FLOAT, "DOUBLE_FLOAT" },
+            { SHADER_FEATURE_PICKING, "PICKING" },
+    } };
+
+    /**
+     * Reads all feature keywords declared by "#pragma shader_feature" lines of a shader source.
+     *
+     * @param source The shader source code
+     * @return unsigned int the bitmask of all declared features
+     */
+    inline unsigned int GetDeclaredShaderFeatures(const std::string& source)
+    {
+        unsigned int declared = SHADER_FEATURE_NONE;
+
+        std::istringstream stream(source);
+        std::string line;
+        while(std::getline(stream, line))
+        {
+            std::istringstream lineStream(line);
+            std::string directive, pragma;
+            lineStream >> directive >> pragma;
+            if(directive != "#pragma" || pragma != "shader_feature")
+            {
+                continue;
+            }
+
+            std::string keyword;
+            while(lineStream >> keyword)
+            {
+                for(const auto& feature : SHADER_FEATURE_KEYWORDS)
+                {
+                    if(keyword == feature.second)
+                    {
+                        declared |= feature.first;
+                    }
+                }
+            }
+        }
+
+        return declared;
+    }
+
+    /**
+     * Builds the #define block for the given features
+     */
+    inline std::string GetShaderFeatureDefines(unsigned int features)
+    {
+        std::string defines;
+        for(const auto& feature : SHADER_FEATURE_KEYWORDS)
+        {
+            if(features & feature.first)
+            {
+                defines += std::string("#define FEATURE_") + feature.second + " 1\n";
+            }
+        }
+        return defines;
+    }
+
+    /**
+     * Builds a readable variant name suffix, e.g. "[TEXTURED|LIT]". Empty if no feature is set.
+     */
+    inline std::string GetShaderFeatureSuffix(unsigned int features)
+    {
+        std::string suffix;
+        for(const auto& feature : SHADER_FEATURE_KEYWORDS)
+        {
+            if(features & feature.first)
+            {
+                suffix += (suffix.empty() ? "[" : "|") + std::string(feature.second);
+            }
+        }
+        return suffix.empty() ? suffix : suffix + "]";
+    }
+} // namespace Engine
@@ -1,105 +1,109 @@
 #include "ShaderLoader.h"
+#include "../vfs/VirtualFileSystem.h"
+#include "ShaderFeatures.h"
+#include "backend/RenderBackend.h"
 
+#include <algorithm>
 #include <cstdio>
-#include <fstream>
 #include <iostream>
-#include <sstream>
-#include <vector>
 
 #include <GL/glew.h>
 
 using namespace std;
 
-GLuint LoadShaders(const char* vertex_file_path, const char* fragment_file_path)
+namespace
 {
-    // Create the shaders
-    GLuint VertexShaderID = glCreateShader(GL_VERTEX_SHADER);
-    GLuint FragmentShaderID = glCreateShader(GL_FRAGMENT_SHADER);
-
-    // Read the Vertex Shader code from the file
-    std::string VertexShaderCode;
-    std::ifstream VertexShaderStream(vertex_file_path, std::ios::in);
-    if(VertexShaderStream.is_open())
+    // The #version directive has to stay the first statement, so the defines go right after it
+    void injectDefines(std::string& source, const std::string& defines)
     {
-        std::stringstream sstr;
-        sstr << VertexShaderStream.rdbuf();
-        VertexShaderCode = sstr.str();
-        VertexShaderStream.close();
+        if(defines.empty())
+        {
+            return;
+        }
+
+        size_t versionPos = source.find("#version");
+        size_t insertPos = versionPos == std::string::npos ? 0 : source.find('\n', versionPos);
+        insertPos = insertPos == std::string::npos ? source.size() : insertPos + 1;
+
+        // Keep the line numbers of compile errors matching the file
+        const auto nextLine = std::count(source.begin(), source.begin() + (long)insertPos, '\n') + 1;
+        source.insert(insertPos, defines + "#line " + std::to_string(nextLine) + "\n");
     }
-    else
+
+    bool readFile(const char* filePath, std::string& content)
+    {
+        if(!SingletonManager::get<Engine::VirtualFileSystem>()->readFile(filePath, content))
+        {
+            printf("Impossible to open %s. Are you in the right directory ? Don't forget to read the FAQ !\n", filePath);
+            return false;
+        }
+        return true;
+    }
+} // namespace
+
+GLuint LoadShaders(
+        const char* vertex_file_path,
+        const char* fragment_file_path,
+        unsigned int features /* = 0 */,
+        unsigned int* declaredFeatures /* = nullptr */
+)
+{
+    std::string VertexShaderCode, FragmentShaderCode;
+    unsigned int declared = 0;
+    if(!ReadShaderSources(vertex_file_path, fragment_file_path, features, VertexShaderCode, FragmentShaderCode, &declared))
     {
-        printf("Impossible to open %s. Are you in the right directory ? Don't forget to read the FAQ !\n",
-               vertex_file_path);
         getchar();
         return 0;
     }
 
-    // Read the Fragment Shader code from the file
-    std::string FragmentShaderCode;
-    std::ifstream FragmentShaderStream(fragment_file_path, std::ios::in);
-    if(FragmentShaderStream.is_open())
+    if(declaredFeatures)
     {
-        std::stringstream sstr;
-        sstr << FragmentShaderStream.rdbuf();
-        FragmentShaderCode = sstr.str();
-        FragmentShaderStream.close();
+        *declaredFeatures = declared;
     }
 
-    GLint Result = GL_FALSE;
-    int InfoLogLength;
+    GLuint ProgramID = CreateShaderProgram(VertexShaderCode, FragmentShaderCode);
+    FinishShaderProgram(ProgramID, (vertex_file_path + Engine::GetShaderFeatureSuffix(features & declared)).c_str());
 
-    // Compile Vertex Shader
-    printf("Compiling and linking shader: %s\n", vertex_file_path);
-    const char* VertexSourcePointer = VertexShaderCode.c_str();
-    glShaderSource(VertexShaderID, 1, &VertexSourcePointer, nullptr);
-    glCompileShader(VertexShaderID);
-
-    // Check Vertex Shader
-    glGetShaderiv(VertexShaderID, GL_COMPILE_STATUS, &Result);
-    glGetShaderiv(VertexShaderID, GL_INFO_LOG_LENGTH, &InfoLogLength);
-    if(InfoLogLength > 0)
+    return ProgramID;
+}
+
+bool ReadShaderSources(
+        const char* vertex_file_path,
+        const char* fragment_file_path,
+        unsigned int features,
+        std::string& vertexCode,
+        std::string& fragmentCode,
+        unsigned int* declaredFeatures /* = nullptr */
+)
+{
+    if(!readFile(vertex_file_path, vertexCode) || !readFile(fragment_file_path, fragmentCode))
     {
-        std::vector<char> VertexShaderErrorMessage(InfoLogLength + 1);
-        glGetShaderInfoLog(VertexShaderID, InfoLogLength, nullptr, &VertexShaderErrorMessage[0]);
-        printf("%s\n", &VertexShaderErrorMessage[0]);
+        return false;
     }
 
-    // Compile Fragment Shader
-    const char* FragmentSourcePointer = FragmentShaderCode.c_str();
-    glShaderSource(FragmentShaderID, 1, &FragmentSourcePointer, nullptr);
-    glCompileShader(FragmentShaderID);
-
-    // Check Fragment Shader
-    glGetShaderiv(FragmentShaderID, GL_COMPILE_STATUS, &Result);
-    glGetShaderiv(FragmentShaderID, GL_INFO_LOG_LENGTH, &InfoLogLength);
-    if(InfoLogLength > 0)
+    // Only declared features create a variant, all others are stripped
+    const unsigned int declared = Engine::GetDeclaredShaderFeatures(vertexCode) |
+            Engine::GetDeclaredShaderFeatures(fragmentCode);
+    if(declaredFeatures)
     {
-        std::vector<char> FragmentShaderErrorMessage(InfoLogLength + 1);
-        glGetShaderInfoLog(FragmentShaderID, InfoLogLength, nullptr, &FragmentShaderErrorMessage[0]);
-        printf("%s\n", &FragmentShaderErrorMessage[0]);
+        *declaredFeatures = declared;
     }
 
-    // Link the program
-    GLuint ProgramID = glCreateProgram();
-    glAttachShader(ProgramID, VertexShaderID);
-    glAttachShader(ProgramID, FragmentShaderID);
-    glLinkProgram(ProgramID);
+    const std::string defines = Engine::GetShaderFeatureDefines(features & declared);
+    injectDefines(vertexCode, defines);
+    injectDefines(fragmentCode, defines);
 
-    // Check the program
-    glGetProgramiv(ProgramID, GL_LINK_STATUS, &Result);
-    glGetProgramiv(ProgramID, GL_INFO_LOG_LENGTH, &InfoLogLength);
-    if(InfoLogLength > 0)
-    {
-        std::vector<char> ProgramErrorMessage(InfoLogLength + 1);
-        glGetProgramInfoLog(ProgramID, InfoLogLength, nullptr, &ProgramErrorMessage[0]);
-        printf("%s\n", &ProgramErrorMessage[0]);
-    }
+    return true;
+}
 
-    glDetachShader(ProgramID, VertexShaderID);
-    glDetachShader(ProgramID, FragmentShaderID);
+GLuint CreateShaderProgram(const std::string& vertexCode, const std::string& fragmentCode)
+{
+    return Engine::RenderBackend::get().createProgram(vertexCode, fragmentCode);
+}
 
-    glDeleteShader(VertexShaderID);
-    glDeleteShader(FragmentShaderID);
+bool IsShaderProgramReady(GLuint programId) { return Engine::RenderBackend::get().isProgramReady(programId); }
 
-    return ProgramID;
-}
\ No newline at end of file
+bool FinishShaderProgram(GLuint programId, const char* name)
+{
+    return Engine::RenderBackend::get().finishProgram(programId, name);
+}
@@ -1,5 +1,54 @@
 #pragma once
 
+#include <string>
+
 #include <GL/glew.h>
 
-GLuint LoadShaders(const char* vertex_file_path, const char* fragment_file_path);
+/**
+ * @brief Compiles and links a shader program.
+ *
+ * @param features The ShaderFeature bitmask of the variant. Every feature declared by a "#pragma shader_feature"
+ * line gets injected as "#define FEATURE_KEYWORD 1" directly after the #version directive.
+ * @param declaredFeatures Optional output of all features declared by the vertex and fragment source.
+ */
+GLuint LoadShaders(
+        const char* vertex_file_path,
+        const char* fragment_file_path,
+        unsigned int features = 0,
+        unsigned int* declaredFeatures = nullptr
+);
+
+/**
+ * @brief Reads both shader sources and injects the feature defines. Doesn't touch GL, so it can run on any thread.
+ *
+ * @return true if both files could be read.
+ */
+bool ReadShaderSources(
+        const char* vertex_file_path,
+        const char* fragment_file_path,
+        unsigned int features,
+        std::string& vertexCode,
+        std::string& fragmentCode,
+        unsigned int* declaredFeatures = nullptr
+);
+
+/**
+ * @brief Starts compiling and linking a program from preprocessed sources without waiting for the result.
+ *
+ * With GL_KHR_parallel_shader_compile the driver compiles in the background, IsShaderProgramReady() can be polled
+ * to avoid stalling. FinishShaderProgram() has to be called on the returned program afterwards.
+ */
+GLuint CreateShaderProgram(const std::string& vertexCode, const std::string& fragmentCode);
+
+/**
+ * @return true once the linking of a program created by CreateShaderProgram() is done. Always true without
+ * GL_KHR_parallel_shader_compile.
+ */
+bool IsShaderProgramReady(GLuint programId);
+
+/**
+ * @brief Prints all compile and link logs of a program created by CreateShaderProgram() and releases its shaders.
+ *
+ * @return true if the program linked successfully.
+ */
+bool FinishShaderProgram(GLuint programId, const char* name);
@@ -0,0 +1,71 @@
+#include "StreamingBuffer.h"
+
+#include "backend/RenderBackend.h"
+
+#include <algorithm>
+#include <cstdio>
+
+using namespace Engine;
+
+StreamingBuffer::StreamingBuffer(GLenum target, size_t capacity)
+    : m_target(target)
+    , m_buffer(0)
+    , m_capacity(std::max(capacity, RANGE_ALIGNMENT))
+    , m_head(0)
+{
+    RenderBackend& backend = RenderBackend::get();
+    m_buffer = backend.createBuffer();
+    backend.bindBuffer(m_target, m_buffer);
+    backend.bufferData(m_target, m_capacity, nullptr, GL_STREAM_DRAW);
+}
+
+StreamingBuffer::~StreamingBuffer()
+{
+    if(m_buffer != 0)
+    {
+        RenderBackend::get().deleteBuffer(m_buffer);
+    }
+}
+
+void* StreamingBuffer::map(size_t size, size_t& offset)
+{
+    RenderBackend& backend = RenderBackend::get();
+    backend.bindBuffer(m_target, m_buffer);
+
+    GLbitfield access = GL_MAP_WRITE_BIT;
+    if(size > m_capacity)
+    {
+        m_capacity = std::max(size, m_capacity * 2);
+        backend.bufferData(m_target, m_capacity, nullptr, GL_STREAM_DRAW);
+        m_head = 0;
+    }
+
+    if(m_head + size > m_capacity)
+    {
+        // Orphaning, the storage still in use by the GPU gets released once it is done with it
+        access |= GL_MAP_INVALIDATE_BUFFER_BIT;
+        m_head = 0;
+    }
+    else
+    {
+        access |= GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT;
+    }
+
+    void* data = backend.mapBufferRange(m_target, m_head, size, access);
+    if(!data)
+    {
+        fprintf(stderr, "StreamingBuffer | Mapping %zu bytes failed!\n", size);
+        return nullptr;
+    }
+
+    offset = m_head;
+    m_head = (m_head + size + RANGE_ALIGNMENT - 1) / RANGE_ALIGNMENT * RANGE_ALIGNMENT;
+    return data;
+}
+
+void StreamingBuffer::unmap()
+{
+    RenderBackend& backend = RenderBackend::get();
+    backend.bindBuffer(m_target, m_buffer);
+    backend.unmapBuffer(m_target);
+}
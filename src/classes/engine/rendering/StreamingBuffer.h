@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+
+#include <GL/glew.h>
+
+namespace Engine
+{
+    /**
+     * @brief A GL buffer for data rewritten every frame, written through mapped ranges instead of glBufferData.
+     *
+     * Writes are appended to the buffer without synchronisation, so the GPU can still read earlier ranges while new
+     * ones are written. Once the buffer is full it gets orphaned, the driver hands out fresh storage and the old one
+     * stays alive until the GPU is done with it.
+     */
+    class StreamingBuffer
+    {
+        public:
+            StreamingBuffer(GLenum target, size_t capacity);
+            ~StreamingBuffer();
+
+            StreamingBuffer(const StreamingBuffer&) = delete;
+            StreamingBuffer& operator=(const StreamingBuffer&) = delete;
+
+            /**
+             * @brief Maps the next free range of the buffer for writing. Binds the buffer to its target.
+             *
+             * @param size The amount of bytes to write, the buffer grows if it is too small.
+             * @param offset Receives the byte offset of the range within the buffer.
+             * @return A pointer to write to, nullptr if mapping failed. Has to be followed by unmap().
+             */
+            void* map(size_t size, size_t& offset);
+
+            void unmap();
+
+            GLuint getBuffer() const { return m_buffer; };
+
+            size_t getCapacity() const { return m_capacity; };
+
+        private:
+            GLenum m_target;
+            GLuint m_buffer;
+            size_t m_capacity;
+            size_t m_head;
+
+            static constexpr size_t RANGE_ALIGNMENT = 64;
+    };
+} // namespace Engine
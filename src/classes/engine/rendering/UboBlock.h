@@ -1,5 +1,7 @@
 #pragma once
 
+#include "backend/RenderBackend.h"
+
 #include <GL/glew.h>
 #include <utility>
 
@@ -19,11 +21,12 @@ namespace Engine
                     return;
                 }
 
-                glGenBuffers(1, &m_uboId);
-                glBindBuffer(GL_UNIFORM_BUFFER, m_uboId);
-                glBufferData(GL_UNIFORM_BUFFER, m_size, nullptr, GL_STATIC_DRAW);
-                glBindBuffer(GL_UNIFORM_BUFFER, 0);
-                glBindBufferBase(GL_UNIFORM_BUFFER, m_bindingPoint.second, m_uboId);
+                RenderBackend& backend = RenderBackend::get();
+                m_uboId = backend.createBuffer();
+                backend.bindBuffer(GL_UNIFORM_BUFFER, m_uboId);
+                backend.bufferData(GL_UNIFORM_BUFFER, m_size, nullptr, GL_STATIC_DRAW);
+                backend.bindBuffer(GL_UNIFORM_BUFFER, 0);
+                backend.bindBufferBase(GL_UNIFORM_BUFFER, m_bindingPoint.second, m_uboId);
 
                 UpdateUbo();
             }
@@ -33,9 +36,10 @@ namespace Engine
             template<typename T>
             void LoadVariable(T data, int byteOffset)
             {
-                glBindBuffer(GL_UNIFORM_BUFFER, m_uboId);
-                glBufferSubData(GL_UNIFORM_BUFFER, byteOffset, sizeof(T), &data);
-                glBindBuffer(GL_UNIFORM_BUFFER, 0);
+                RenderBackend& backend = RenderBackend::get();
+                backend.bindBuffer(GL_UNIFORM_BUFFER, m_uboId);
+                backend.bufferSubData(GL_UNIFORM_BUFFER, byteOffset, sizeof(T), &data);
+                backend.bindBuffer(GL_UNIFORM_BUFFER, 0);
             }
 
             void setBindingPoint(std::pair<const char*, GLuint> point) { m_bindingPoint = point; }
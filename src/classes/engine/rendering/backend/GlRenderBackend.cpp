@@ -0,0 +1,457 @@
+#include "GlRenderBackend.h"
+
+#include <cstdio>
+#include <vector>
+
+using namespace Engine;
+
+namespace
+{
+    GLuint compileShader(GLenum type, const std::string& code)
+    {
+        GLuint ShaderID = glCreateShader(type);
+        const char* SourcePointer = code.c_str();
+        glShaderSource(ShaderID, 1, &SourcePointer, nullptr);
+        glCompileShader(ShaderID);
+        return ShaderID;
+    }
+
+    void printShaderLog(GLuint shaderId)
+    {
+        int InfoLogLength;
+        glGetShaderiv(shaderId, GL_INFO_LOG_LENGTH, &InfoLogLength);
+        if(InfoLogLength > 0)
+        {
+            std::vector<char> ShaderErrorMessage(InfoLogLength + 1);
+            glGetShaderInfoLog(shaderId, InfoLogLength, nullptr, &ShaderErrorMessage[0]);
+            printf("%s\n", &ShaderErrorMessage[0]);
+        }
+    }
+} // namespace
+
+GLuint GlRenderBackend::createBuffer()
+{
+    GLuint buffer = 0;
+    glGenBuffers(1, &buffer);
+    return buffer;
+}
+
+void GlRenderBackend::deleteBuffer(GLuint buffer) { glDeleteBuffers(1, &buffer); }
+
+void GlRenderBackend::bindBuffer(GLenum target, GLuint buffer) { glBindBuffer(target, buffer); }
+
+void GlRenderBackend::bufferData(GLenum target, size_t size, const void* data, GLenum usage)
+{
+    glBufferData(target, GLsizeiptr(size), data, usage);
+}
+
+void GlRenderBackend::bufferSubData(GLenum target, size_t offset, size_t size, const void* data)
+{
+    glBufferSubData(target, GLintptr(offset), GLsizeiptr(size), data);
+}
+
+void GlRenderBackend::bindBufferBase(GLenum target, GLuint index, GLuint buffer)
+{
+    glBindBufferBase(target, index, buffer);
+}
+
+void* GlRenderBackend::mapBufferRange(GLenum target, size_t offset, size_t size, GLbitfield access)
+{
+    return glMapBufferRange(target, GLintptr(offset), GLsizeiptr(size), access);
+}
+
+void GlRenderBackend::unmapBuffer(GLenum target) { glUnmapBuffer(target); }
+
+GLuint GlRenderBackend::createVertexArray()
+{
+    GLuint vertexArray = 0;
+    glGenVertexArrays(1, &vertexArray);
+    return vertexArray;
+}
+
+void GlRenderBackend::bindVertexArray(GLuint vertexArray) { glBindVertexArray(vertexArray); }
+
+void GlRenderBackend::enableVertexAttribute(GLuint index) { glEnableVertexAttribArray(index); }
+
+void GlRenderBackend::disableVertexAttribute(GLuint index) { glDisableVertexAttribArray(index); }
+
+void GlRenderBackend::vertexAttributePointer(
+        GLuint index,
+        int size,
+        GLenum type,
+        bool normalized,
+        int stride,
+        size_t offset
+)
+{
+    glVertexAttribPointer(index, size, type, normalized ? GL_TRUE : GL_FALSE, stride, (void*)offset);
+}
+
+void GlRenderBackend::vertexAttributeIntegerPointer(GLuint index, int size, GLenum type, int stride, size_t offset)
+{
+    glVertexAttribIPointer(index, size, type, stride, (void*)offset);
+}
+
+void GlRenderBackend::vertexAttributeDivisor(GLuint index, GLuint divisor) { glVertexAttribDivisor(index, divisor); }
+
+void GlRenderBackend::setVertexAttribute(GLuint index, const glm::vec4& value)
+{
+    glVertexAttrib4f(index, value.x, value.y, value.z, value.w);
+}
+
+void GlRenderBackend::setVertexAttribute(GLuint index, const glm::uvec4& value)
+{
+    glVertexAttribI4ui(index, value.x, value.y, value.z, value.w);
+}
+
+GLuint GlRenderBackend::createTexture()
+{
+    GLuint texture = 0;
+    glGenTextures(1, &texture);
+    return texture;
+}
+
+void GlRenderBackend::deleteTexture(GLuint texture) { glDeleteTextures(1, &texture); }
+
+void GlRenderBackend::activeTexture(GLuint unit) { glActiveTexture(GL_TEXTURE0 + unit); }
+
+void GlRenderBackend::bindTexture(GLenum target, GLuint texture) { glBindTexture(target, texture); }
+
+void GlRenderBackend::pixelStore(GLenum name, GLint value) { glPixelStorei(name, value); }
+
+void GlRenderBackend::texImage2D(
+        GLenum target,
+        GLint level,
+        GLint internalFormat,
+        GLsizei width,
+        GLsizei height,
+        GLenum format,
+        GLenum type,
+        const void* data
+)
+{
+    glTexImage2D(target, level, internalFormat, width, height, 0, format, type, data);
+}
+
+void GlRenderBackend::compressedTexImage2D(
+        GLenum target,
+        GLint level,
+        GLenum format,
+        GLsizei width,
+        GLsizei height,
+        GLsizei size,
+        const void* data
+)
+{
+    glCompressedTexImage2D(target, level, format, width, height, 0, size, data);
+}
+
+void GlRenderBackend::texParameter(GLenum target, GLenum name, GLint value) { glTexParameteri(target, name, value); }
+
+void GlRenderBackend::generateMipmap(GLenum target) { glGenerateMipmap(target); }
+
+void GlRenderBackend::texBuffer(GLenum target, GLenum format, GLuint buffer) { glTexBuffer(target, format, buffer); }
+
+GLuint GlRenderBackend::createFramebuffer()
+{
+    GLuint framebuffer = 0;
+    glGenFramebuffers(1, &framebuffer);
+    return framebuffer;
+}
+
+void GlRenderBackend::deleteFramebuffer(GLuint framebuffer) { glDeleteFramebuffers(1, &framebuffer); }
+
+void GlRenderBackend::bindFramebuffer(GLenum target, GLuint framebuffer) { glBindFramebuffer(target, framebuffer); }
+
+void GlRenderBackend::framebufferTexture2D(GLenum target, GLenum attachment, GLenum textureTarget, GLuint texture)
+{
+    glFramebufferTexture2D(target, attachment, textureTarget, texture, 0);
+}
+
+void GlRenderBackend::framebufferRenderbuffer(GLenum target, GLenum attachment, GLuint renderbuffer)
+{
+    glFramebufferRenderbuffer(target, attachment, GL_RENDERBUFFER, renderbuffer);
+}
+
+bool GlRenderBackend::isFramebufferComplete(GLenum target)
+{
+    return glCheckFramebufferStatus(target) == GL_FRAMEBUFFER_COMPLETE;
+}
+
+GLuint GlRenderBackend::createRenderbuffer()
+{
+    GLuint renderbuffer = 0;
+    glGenRenderbuffers(1, &renderbuffer);
+    return renderbuffer;
+}
+
+void GlRenderBackend::deleteRenderbuffer(GLuint renderbuffer) { glDeleteRenderbuffers(1, &renderbuffer); }
+
+void GlRenderBackend::renderbufferStorage(
+        GLuint renderbuffer,
+        int samples,
+        GLenum format,
+        GLsizei width,
+        GLsizei height
+)
+{
+    glBindRenderbuffer(GL_RENDERBUFFER, renderbuffer);
+    glRenderbufferStorageMultisample(GL_RENDERBUFFER, samples, format, width, height);
+}
+
+void GlRenderBackend::blitFramebuffer(
+        const glm::ivec2& sourceSize,
+        const glm::ivec2& destinationSize,
+        GLbitfield mask,
+        GLenum filter
+)
+{
+    glBlitFramebuffer(0, 0, sourceSize.x, sourceSize.y, 0, 0, destinationSize.x, destinationSize.y, mask, filter);
+}
+
+void GlRenderBackend::viewport(const glm::ivec2& origin, const glm::ivec2& size)
+{
+    glViewport(origin.x, origin.y, size.x, size.y);
+}
+
+void GlRenderBackend::scissor(const glm::ivec2& origin, const glm::ivec2& size)
+{
+    glScissor(origin.x, origin.y, size.x, size.y);
+}
+
+void GlRenderBackend::clearColorBuffer(GLint drawBuffer, const glm::uvec4& value)
+{
+    glClearBufferuiv(GL_COLOR, drawBuffer, &value[0]);
+}
+
+void GlRenderBackend::readPixels(
+        const glm::ivec2& origin,
+        const glm::ivec2& size,
+        GLenum format,
+        GLenum type,
+        size_t offset
+)
+{
+    // With a pack buffer bound the pointer is an offset into it
+    glReadPixels(origin.x, origin.y, size.x, size.y, format, type, reinterpret_cast<void*>(offset));
+}
+
+GLuint GlRenderBackend::createQuery()
+{
+    GLuint query = 0;
+    glGenQueries(1, &query);
+    return query;
+}
+
+void GlRenderBackend::deleteQuery(GLuint query) { glDeleteQueries(1, &query); }
+
+void GlRenderBackend::beginQuery(GLenum target, GLuint query) { glBeginQuery(target, query); }
+
+void GlRenderBackend::endQuery(GLenum target) { glEndQuery(target); }
+
+bool GlRenderBackend::getQueryResult(GLuint query, GLuint64& result)
+{
+    GLint available = GL_FALSE;
+    glGetQueryObjectiv(query, GL_QUERY_RESULT_AVAILABLE, &available);
+    if(!available)
+    {
+        return false;
+    }
+
+    glGetQueryObjectui64v(query, GL_QUERY_RESULT, &result);
+    return true;
+}
+
+void GlRenderBackend::queryTimestamp(GLuint query) { glQueryCounter(query, GL_TIMESTAMP); }
+
+GLint64 GlRenderBackend::getTimestamp()
+{
+    GLint64 timestamp = 0;
+    glGetInteger64v(GL_TIMESTAMP, &timestamp);
+    return timestamp;
+}
+
+void GlRenderBackend::beginConditionalRender(GLuint query, GLenum mode) { glBeginConditionalRender(query, mode); }
+
+void GlRenderBackend::endConditionalRender() { glEndConditionalRender(); }
+
+GLsync GlRenderBackend::createFence() { return glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0); }
+
+bool GlRenderBackend::isFenceSignaled(GLsync fence)
+{
+    GLint status = GL_UNSIGNALED;
+    glGetSynciv(fence, GL_SYNC_STATUS, 1, nullptr, &status);
+    return status == GL_SIGNALED;
+}
+
+bool GlRenderBackend::waitFence(GLsync fence, GLuint64 timeoutNs)
+{
+    const GLenum status = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, timeoutNs);
+    return status == GL_ALREADY_SIGNALED || status == GL_CONDITION_SATISFIED;
+}
+
+void GlRenderBackend::deleteFence(GLsync fence) { glDeleteSync(fence); }
+
+GLuint GlRenderBackend::createProgram(const std::string& vertexCode, const std::string& fragmentCode)
+{
+    // Compile Vertex & Fragment Shader
+    GLuint VertexShaderID = compileShader(GL_VERTEX_SHADER, vertexCode);
+    GLuint FragmentShaderID = compileShader(GL_FRAGMENT_SHADER, fragmentCode);
+
+    // Link the program
+    GLuint ProgramID = glCreateProgram();
+    glAttachShader(ProgramID, VertexShaderID);
+    glAttachShader(ProgramID, FragmentShaderID);
+    glLinkProgram(ProgramID);
+
+    return ProgramID;
+}
+
+bool GlRenderBackend::isProgramReady(GLuint program)
+{
+    if(!GLEW_KHR_parallel_shader_compile)
+    {
+        return true;
+    }
+
+    GLint Completed = GL_FALSE;
+    glGetProgramiv(program, GL_COMPLETION_STATUS_KHR, &Completed);
+    return Completed == GL_TRUE;
+}
+
+bool GlRenderBackend::finishProgram(GLuint program, const char* name)
+{
+    GLint numShaders = 0;
+    glGetProgramiv(program, GL_ATTACHED_SHADERS, &numShaders);
+    std::vector<GLuint> ShaderIDs(numShaders);
+    glGetAttachedShaders(program, numShaders, nullptr, ShaderIDs.data());
+
+    // Check Vertex & Fragment Shader
+    printf("Compiling and linking shader: %s\n", name);
+    for(GLuint ShaderID : ShaderIDs)
+    {
+        printShaderLog(ShaderID);
+    }
+
+    // Check the program
+    GLint Result = GL_FALSE;
+    int InfoLogLength;
+    glGetProgramiv(program, GL_LINK_STATUS, &Result);
+    glGetProgramiv(program, GL_INFO_LOG_LENGTH, &InfoLogLength);
+    if(InfoLogLength > 0)
+    {
+        std::vector<char> ProgramErrorMessage(InfoLogLength + 1);
+        glGetProgramInfoLog(program, InfoLogLength, nullptr, &ProgramErrorMessage[0]);
+        printf("%s\n", &ProgramErrorMessage[0]);
+    }
+
+    for(GLuint ShaderID : ShaderIDs)
+    {
+        glDetachShader(program, ShaderID);
+        glDeleteShader(ShaderID);
+    }
+
+    return Result == GL_TRUE;
+}
+
+void GlRenderBackend::deleteProgram(GLuint program)
+{
+    // Shaders of a program that never got finished are still attached
+    GLint numShaders = 0;
+    glGetProgramiv(program, GL_ATTACHED_SHADERS, &numShaders);
+    std::vector<GLuint> ShaderIDs(numShaders);
+    glGetAttachedShaders(program, numShaders, nullptr, ShaderIDs.data());
+    for(GLuint ShaderID : ShaderIDs)
+    {
+        glDetachShader(program, ShaderID);
+        glDeleteShader(ShaderID);
+    }
+
+    glDeleteProgram(program);
+}
+
+void GlRenderBackend::useProgram(GLuint program) { glUseProgram(program); }
+
+GLint GlRenderBackend::getUniformLocation(GLuint program, const char* name)
+{
+    return glGetUniformLocation(program, name);
+}
+
+GLuint GlRenderBackend::getUniformBlockIndex(GLuint program, const char* name)
+{
+    return glGetUniformBlockIndex(program, name);
+}
+
+void GlRenderBackend::uniformBlockBinding(GLuint program, GLuint blockIndex, GLuint bindingPoint)
+{
+    glUniformBlockBinding(program, blockIndex, bindingPoint);
+}
+
+void GlRenderBackend::setUniform(GLint location, int value) { glUniform1i(location, value); }
+
+void GlRenderBackend::setUniform(GLint location, unsigned int value) { glUniform1ui(location, value); }
+
+void GlRenderBackend::setUniform(GLint location, float value) { glUniform1f(location, value); }
+
+void GlRenderBackend::setUniform(GLint location, const glm::vec2& value) { glUniform2f(location, value.x, value.y); }
+
+void GlRenderBackend::setUniform(GLint location, const glm::vec3& value)
+{
+    glUniform3f(location, value.x, value.y, value.z);
+}
+
+void GlRenderBackend::setUniform(GLint location, const glm::vec4& value)
+{
+    glUniform4f(location, value.x, value.y, value.z, value.w);
+}
+
+void GlRenderBackend::setUniform(GLint location, const glm::mat4& value)
+{
+    glUniformMatrix4fv(location, 1, GL_FALSE, &value[0][0]);
+}
+
+void GlRenderBackend::drawArrays(GLenum mode, GLint first, GLsizei count) { glDrawArrays(mode, first, count); }
+
+void GlRenderBackend::drawArraysInstanced(GLenum mode, GLint first, GLsizei count, GLsizei instances)
+{
+    glDrawArraysInstanced(mode, first, count, instances);
+}
+
+void GlRenderBackend::drawElements(GLenum mode, GLsizei count, GLenum type, size_t offset)
+{
+    glDrawElements(mode, count, type, (void*)offset);
+}
+
+void GlRenderBackend::drawElementsInstanced(GLenum mode, GLsizei count, GLenum type, size_t offset, GLsizei instances)
+{
+    glDrawElementsInstanced(mode, count, type, (void*)offset, instances);
+}
+
+void GlRenderBackend::enable(GLenum capability) { glEnable(capability); }
+
+void GlRenderBackend::disable(GLenum capability) { glDisable(capability); }
+
+void GlRenderBackend::depthMask(bool write) { glDepthMask(write ? GL_TRUE : GL_FALSE); }
+
+void GlRenderBackend::colorMask(bool write)
+{
+    const GLboolean mask = write ? GL_TRUE : GL_FALSE;
+    glColorMask(mask, mask, mask, mask);
+}
+
+void GlRenderBackend::depthFunc(GLenum func) { glDepthFunc(func); }
+
+void GlRenderBackend::blendFunc(GLenum source, GLenum destination) { glBlendFunc(source, destination); }
+
+void GlRenderBackend::polygonMode(GLenum mode) { glPolygonMode(GL_FRONT_AND_BACK, mode); }
+
+GLenum GlRenderBackend::getPolygonMode()
+{
+    GLint polygonMode[2];
+    glGetIntegerv(GL_POLYGON_MODE, polygonMode);
+    return GLenum(polygonMode[0]);
+}
+
+void GlRenderBackend::clearColor(const glm::vec4& color) { glClearColor(color.x, color.y, color.z, color.w); }
+
+void GlRenderBackend::clear(GLbitfield mask) { glClear(mask); }
@@ -0,0 +1,529 @@
+#include "RecordingRenderBackend.h"
+
+#include <cstring>
+
+using namespace Engine;
+
+namespace
+{
+    size_t getBytesPerPixel(GLenum format)
+    {
+        switch(format)
+        {
+            case GL_RED:
+                return 1;
+            case GL_RG:
+                return 2;
+            case GL_RGB:
+            case GL_BGR:
+                return 3;
+            default:
+                return 4;
+        }
+    }
+} // namespace
+
+GLuint RecordingRenderBackend::createObject()
+{
+    m_stats.commands++;
+    m_stats.objectsCreated++;
+    return m_nextId++;
+}
+
+void RecordingRenderBackend::countBind(bool redundant, size_t& binds)
+{
+    m_stats.commands++;
+    binds++;
+    if(redundant)
+    {
+        m_stats.redundantBinds++;
+    }
+}
+
+void RecordingRenderBackend::countStateChange(bool redundant)
+{
+    m_stats.commands++;
+    m_stats.stateChanges++;
+    if(redundant)
+    {
+        m_stats.redundantStateChanges++;
+    }
+}
+
+GLuint RecordingRenderBackend::createBuffer() { return createObject(); }
+
+void RecordingRenderBackend::deleteBuffer(GLuint buffer)
+{
+    m_stats.commands++;
+    m_bufferStorage.erase(buffer);
+}
+
+void RecordingRenderBackend::bindBuffer(GLenum target, GLuint buffer)
+{
+    GLuint& bound = m_boundBuffers[target];
+    countBind(bound == buffer, m_stats.bufferBinds);
+    bound = buffer;
+}
+
+void RecordingRenderBackend::bufferData(GLenum target, size_t size, const void* data, GLenum usage)
+{
+    m_stats.commands++;
+    m_bufferStorage[m_boundBuffers[target]].resize(size);
+    if(data)
+    {
+        m_stats.bytesUploaded += size;
+    }
+}
+
+void RecordingRenderBackend::bufferSubData(GLenum target, size_t offset, size_t size, const void* data)
+{
+    m_stats.commands++;
+    m_stats.bytesUploaded += size;
+}
+
+void RecordingRenderBackend::bindBufferBase(GLenum target, GLuint index, GLuint buffer)
+{
+    countBind(false, m_stats.bufferBinds);
+    m_boundBuffers[target] = buffer;
+}
+
+void* RecordingRenderBackend::mapBufferRange(GLenum target, size_t offset, size_t size, GLbitfield access)
+{
+    m_stats.commands++;
+    std::vector<uint8_t>& storage = m_bufferStorage[m_boundBuffers[target]];
+    if(storage.size() < offset + size)
+    {
+        storage.resize(offset + size);
+    }
+
+    // Everything written into the mapping reaches the "GPU" on unmap
+    if(access & GL_MAP_WRITE_BIT)
+    {
+        m_stats.bytesUploaded += size;
+    }
+    return storage.data() + offset;
+}
+
+void RecordingRenderBackend::unmapBuffer(GLenum target) { m_stats.commands++; }
+
+GLuint RecordingRenderBackend::createVertexArray() { return createObject(); }
+
+void RecordingRenderBackend::bindVertexArray(GLuint vertexArray)
+{
+    countBind(m_vertexArray == vertexArray, m_stats.bufferBinds);
+    m_vertexArray = vertexArray;
+}
+
+void RecordingRenderBackend::enableVertexAttribute(GLuint index) { m_stats.commands++; }
+
+void RecordingRenderBackend::disableVertexAttribute(GLuint index) { m_stats.commands++; }
+
+void RecordingRenderBackend::vertexAttributePointer(
+        GLuint index,
+        int size,
+        GLenum type,
+        bool normalized,
+        int stride,
+        size_t offset
+)
+{
+    m_stats.commands++;
+}
+
+void RecordingRenderBackend::vertexAttributeIntegerPointer(
+        GLuint index,
+        int size,
+        GLenum type,
+        int stride,
+        size_t offset
+)
+{
+    m_stats.commands++;
+}
+
+void RecordingRenderBackend::vertexAttributeDivisor(GLuint index, GLuint divisor) { m_stats.commands++; }
+
+void RecordingRenderBackend::setVertexAttribute(GLuint index, const glm::vec4& value) { m_stats.commands++; }
+
+void RecordingRenderBackend::setVertexAttribute(GLuint index, const glm::uvec4& value) { m_stats.commands++; }
+
+GLuint RecordingRenderBackend::createTexture() { return createObject(); }
+
+void RecordingRenderBackend::deleteTexture(GLuint texture) { m_stats.commands++; }
+
+void RecordingRenderBackend::activeTexture(GLuint unit)
+{
+    m_stats.commands++;
+    m_activeTextureUnit = unit;
+}
+
+void RecordingRenderBackend::bindTexture(GLenum target, GLuint texture)
+{
+    GLuint& bound = m_boundTextures[{ m_activeTextureUnit, target }];
+    countBind(bound == texture, m_stats.textureBinds);
+    bound = texture;
+}
+
+void RecordingRenderBackend::pixelStore(GLenum name, GLint value) { m_stats.commands++; }
+
+void RecordingRenderBackend::texImage2D(
+        GLenum target,
+        GLint level,
+        GLint internalFormat,
+        GLsizei width,
+        GLsizei height,
+        GLenum format,
+        GLenum type,
+        const void* data
+)
+{
+    m_stats.commands++;
+    if(data)
+    {
+        m_stats.bytesUploaded += size_t(width) * size_t(height) * getBytesPerPixel(format);
+    }
+}
+
+void RecordingRenderBackend::compressedTexImage2D(
+        GLenum target,
+        GLint level,
+        GLenum format,
+        GLsizei width,
+        GLsizei height,
+        GLsizei size,
+        const void* data
+)
+{
+    m_stats.commands++;
+    m_stats.bytesUploaded += size_t(size);
+}
+
+void RecordingRenderBackend::texParameter(GLenum target, GLenum name, GLint value) { m_stats.commands++; }
+
+void RecordingRenderBackend::generateMipmap(GLenum target) { m_stats.commands++; }
+
+void RecordingRenderBackend::texBuffer(GLenum target, GLenum format, GLuint buffer) { m_stats.commands++; }
+
+GLuint RecordingRenderBackend::createFramebuffer() { return createObject(); }
+
+void RecordingRenderBackend::deleteFramebuffer(GLuint framebuffer) { m_stats.commands++; }
+
+void RecordingRenderBackend::bindFramebuffer(GLenum target, GLuint framebuffer)
+{
+    if(target == GL_FRAMEBUFFER)
+    {
+        const bool redundant = m_boundFramebuffers[GL_READ_FRAMEBUFFER] == framebuffer &&
+                               m_boundFramebuffers[GL_DRAW_FRAMEBUFFER] == framebuffer;
+        countBind(redundant, m_stats.framebufferBinds);
+        m_boundFramebuffers[GL_READ_FRAMEBUFFER] = framebuffer;
+        m_boundFramebuffers[GL_DRAW_FRAMEBUFFER] = framebuffer;
+        return;
+    }
+
+    GLuint& bound = m_boundFramebuffers[target];
+    countBind(bound == framebuffer, m_stats.framebufferBinds);
+    bound = framebuffer;
+}
+
+void RecordingRenderBackend::framebufferTexture2D(
+        GLenum target,
+        GLenum attachment,
+        GLenum textureTarget,
+        GLuint texture
+)
+{
+    m_stats.commands++;
+}
+
+void RecordingRenderBackend::framebufferRenderbuffer(GLenum target, GLenum attachment, GLuint renderbuffer)
+{
+    m_stats.commands++;
+}
+
+bool RecordingRenderBackend::isFramebufferComplete(GLenum target)
+{
+    m_stats.commands++;
+    return true;
+}
+
+GLuint RecordingRenderBackend::createRenderbuffer() { return createObject(); }
+
+void RecordingRenderBackend::deleteRenderbuffer(GLuint renderbuffer) { m_stats.commands++; }
+
+void RecordingRenderBackend::renderbufferStorage(
+        GLuint renderbuffer,
+        int samples,
+        GLenum format,
+        GLsizei width,
+        GLsizei height
+)
+{
+    m_stats.commands++;
+}
+
+void RecordingRenderBackend::blitFramebuffer(
+        const glm::ivec2& sourceSize,
+        const glm::ivec2& destinationSize,
+        GLbitfield mask,
+        GLenum filter
+)
+{
+    m_stats.commands++;
+}
+
+void RecordingRenderBackend::viewport(const glm::ivec2& origin, const glm::ivec2& size) { m_stats.commands++; }
+
+void RecordingRenderBackend::scissor(const glm::ivec2& origin, const glm::ivec2& size) { m_stats.commands++; }
+
+void RecordingRenderBackend::clearColorBuffer(GLint drawBuffer, const glm::uvec4& value) { m_stats.commands++; }
+
+void RecordingRenderBackend::readPixels(
+        const glm::ivec2& origin,
+        const glm::ivec2& size,
+        GLenum format,
+        GLenum type,
+        size_t offset
+)
+{
+    m_stats.commands++;
+    m_stats.pixelReads++;
+
+    // Every pixel read holds the set value, enough for single channel 32 bit formats
+    const size_t pixels = size_t(size.x) * size_t(size.y);
+    std::vector<uint8_t>& storage = m_bufferStorage[m_boundBuffers[GL_PIXEL_PACK_BUFFER]];
+    if(storage.size() < offset + pixels * sizeof(uint32_t))
+    {
+        storage.resize(offset + pixels * sizeof(uint32_t));
+    }
+    for(size_t i = 0; i < pixels; i++)
+    {
+        memcpy(storage.data() + offset + i * sizeof(uint32_t), &m_pixelValue, sizeof(uint32_t));
+    }
+}
+
+GLuint RecordingRenderBackend::createQuery() { return createObject(); }
+
+void RecordingRenderBackend::deleteQuery(GLuint query) { m_stats.commands++; }
+
+void RecordingRenderBackend::beginQuery(GLenum target, GLuint query) { m_stats.commands++; }
+
+void RecordingRenderBackend::endQuery(GLenum target) { m_stats.commands++; }
+
+bool RecordingRenderBackend::getQueryResult(GLuint query, GLuint64& result)
+{
+    m_stats.commands++;
+    result = m_queryResult;
+    return true;
+}
+
+void RecordingRenderBackend::queryTimestamp(GLuint query) { m_stats.commands++; }
+
+GLint64 RecordingRenderBackend::getTimestamp()
+{
+    // Timestamp queries return the query result, the GPU clock stands still at 0
+    m_stats.commands++;
+    return 0;
+}
+
+void RecordingRenderBackend::beginConditionalRender(GLuint query, GLenum mode)
+{
+    m_stats.commands++;
+    m_conditionalRender = true;
+}
+
+void RecordingRenderBackend::endConditionalRender()
+{
+    m_stats.commands++;
+    m_conditionalRender = false;
+}
+
+GLsync RecordingRenderBackend::createFence()
+{
+    // Never dereferenced, it only has to be unique & not null
+    m_stats.commands++;
+    return reinterpret_cast<GLsync>(uintptr_t(m_nextId++));
+}
+
+bool RecordingRenderBackend::isFenceSignaled(GLsync fence)
+{
+    m_stats.commands++;
+    return true;
+}
+
+bool RecordingRenderBackend::waitFence(GLsync fence, GLuint64 timeoutNs)
+{
+    m_stats.commands++;
+    return true;
+}
+
+void RecordingRenderBackend::deleteFence(GLsync fence) { m_stats.commands++; }
+
+GLuint RecordingRenderBackend::createProgram(const std::string& vertexCode, const std::string& fragmentCode)
+{
+    return createObject();
+}
+
+bool RecordingRenderBackend::isProgramReady(GLuint program)
+{
+    m_stats.commands++;
+    return true;
+}
+
+bool RecordingRenderBackend::finishProgram(GLuint program, const char* name)
+{
+    m_stats.commands++;
+    return true;
+}
+
+void RecordingRenderBackend::deleteProgram(GLuint program) { m_stats.commands++; }
+
+void RecordingRenderBackend::useProgram(GLuint program)
+{
+    countBind(m_program == program, m_stats.programBinds);
+    m_program = program;
+}
+
+GLint RecordingRenderBackend::getUniformLocation(GLuint program, const char* name)
+{
+    // Every name gets its own location, the same in all programs
+    m_stats.commands++;
+    return m_uniformLocations.try_emplace(name, GLint(m_uniformLocations.size())).first->second;
+}
+
+GLuint RecordingRenderBackend::getUniformBlockIndex(GLuint program, const char* name)
+{
+    m_stats.commands++;
+    return 0;
+}
+
+void RecordingRenderBackend::uniformBlockBinding(GLuint program, GLuint blockIndex, GLuint bindingPoint)
+{
+    m_stats.commands++;
+}
+
+void RecordingRenderBackend::setUniform(GLint location, int value)
+{
+    m_stats.commands++;
+    m_stats.uniformUploads++;
+}
+
+void RecordingRenderBackend::setUniform(GLint location, unsigned int value)
+{
+    m_stats.commands++;
+    m_stats.uniformUploads++;
+}
+
+void RecordingRenderBackend::setUniform(GLint location, float value)
+{
+    m_stats.commands++;
+    m_stats.uniformUploads++;
+}
+
+void RecordingRenderBackend::setUniform(GLint location, const glm::vec2& value)
+{
+    m_stats.commands++;
+    m_stats.uniformUploads++;
+}
+
+void RecordingRenderBackend::setUniform(GLint location, const glm::vec3& value)
+{
+    m_stats.commands++;
+    m_stats.uniformUploads++;
+}
+
+void RecordingRenderBackend::setUniform(GLint location, const glm::vec4& value)
+{
+    m_stats.commands++;
+    m_stats.uniformUploads++;
+}
+
+void RecordingRenderBackend::setUniform(GLint location, const glm::mat4& value)
+{
+    m_stats.commands++;
+    m_stats.uniformUploads++;
+}
+
+void RecordingRenderBackend::drawArrays(GLenum mode, GLint first, GLsizei count)
+{
+    drawArraysInstanced(mode, first, count, 1);
+}
+
+void RecordingRenderBackend::drawArraysInstanced(GLenum mode, GLint first, GLsizei count, GLsizei instances)
+{
+    m_stats.commands++;
+    m_stats.drawCalls++;
+    m_stats.conditionalDrawCalls += m_conditionalRender ? 1 : 0;
+    m_stats.instancesDrawn += size_t(instances);
+    m_stats.verticesDrawn += size_t(count) * size_t(instances);
+}
+
+void RecordingRenderBackend::drawElements(GLenum mode, GLsizei count, GLenum type, size_t offset)
+{
+    drawElementsInstanced(mode, count, type, offset, 1);
+}
+
+void RecordingRenderBackend::drawElementsInstanced(
+        GLenum mode,
+        GLsizei count,
+        GLenum type,
+        size_t offset,
+        GLsizei instances
+)
+{
+    m_stats.commands++;
+    m_stats.drawCalls++;
+    m_stats.conditionalDrawCalls += m_conditionalRender ? 1 : 0;
+    m_stats.instancesDrawn += size_t(instances);
+    m_stats.verticesDrawn += size_t(count) * size_t(instances);
+}
+
+void RecordingRenderBackend::enable(GLenum capability)
+{
+    countStateChange(!m_enabledCapabilities.insert(capability).second);
+}
+
+void RecordingRenderBackend::disable(GLenum capability)
+{
+    countStateChange(m_enabledCapabilities.erase(capability) == 0);
+}
+
+void RecordingRenderBackend::depthMask(bool write)
+{
+    countStateChange(m_depthWrite == write);
+    m_depthWrite = write;
+}
+
+void RecordingRenderBackend::colorMask(bool write)
+{
+    countStateChange(m_colorWrite == write);
+    m_colorWrite = write;
+}
+
+void RecordingRenderBackend::depthFunc(GLenum func)
+{
+    countStateChange(m_depthFunc == func);
+    m_depthFunc = func;
+}
+
+void RecordingRenderBackend::blendFunc(GLenum source, GLenum destination)
+{
+    const std::pair<GLenum, GLenum> blendFunc(source, destination);
+    countStateChange(m_blendFunc == blendFunc);
+    m_blendFunc = blendFunc;
+}
+
+void RecordingRenderBackend::polygonMode(GLenum mode)
+{
+    countStateChange(m_polygonMode == mode);
+    m_polygonMode = mode;
+}
+
+GLenum RecordingRenderBackend::getPolygonMode()
+{
+    m_stats.commands++;
+    return m_polygonMode;
+}
+
+void RecordingRenderBackend::clearColor(const glm::vec4& color) { m_stats.commands++; }
+
+void RecordingRenderBackend::clear(GLbitfield mask) { m_stats.commands++; }
@@ -0,0 +1,240 @@
+#pragma once
+
+#include "RenderBackend.h"
+
+#include <cstdint>
+#include <map>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace Engine
+{
+    /**
+     * @brief What a RecordingRenderBackend has seen since its stats were last reset.
+     */
+    struct RenderBackendStats
+    {
+            size_t commands = 0;
+            size_t drawCalls = 0;
+            size_t conditionalDrawCalls = 0;
+            size_t instancesDrawn = 0;
+            size_t verticesDrawn = 0;
+            size_t programBinds = 0;
+            size_t bufferBinds = 0;
+            size_t textureBinds = 0;
+            size_t framebufferBinds = 0;
+            size_t redundantBinds = 0;
+            size_t stateChanges = 0;
+            size_t redundantStateChanges = 0;
+            size_t uniformUploads = 0;
+            size_t bytesUploaded = 0;
+            size_t pixelReads = 0;
+            size_t objectsCreated = 0;
+    };
+
+    /**
+     * @brief A backend without a GPU behind it, it hands out ids & counts every command instead of executing it.
+     *
+     * Binds & state changes are tracked, so setting what is already set shows up as redundant. Mapped buffers are
+     * backed by memory, so code writing into them runs unchanged. Queries always have the result set with
+     * setQueryResult() right away, 0 unless set otherwise. Fences are signaled right away as well & pixels read
+     * into a pack buffer hold the value set with setPixelValue().
+     */
+    class RecordingRenderBackend final : public RenderBackend
+    {
+        public:
+            RecordingRenderBackend() = default;
+            ~RecordingRenderBackend() override = default;
+
+            const RenderBackendStats& getStats() const { return m_stats; };
+
+            void resetStats() { m_stats = RenderBackendStats(); };
+
+            /**
+             * @brief The result every query returns, the number of samples passed for samples queries.
+             */
+            void setQueryResult(GLuint64 result) { m_queryResult = result; };
+
+            /**
+             * @brief The value every pixel read with readPixels() holds, as a 32 bit pixel.
+             */
+            void setPixelValue(uint32_t value) { m_pixelValue = value; };
+
+            // Buffers
+            GLuint createBuffer() override;
+            void deleteBuffer(GLuint buffer) override;
+            void bindBuffer(GLenum target, GLuint buffer) override;
+            void bufferData(GLenum target, size_t size, const void* data, GLenum usage) override;
+            void bufferSubData(GLenum target, size_t offset, size_t size, const void* data) override;
+            void bindBufferBase(GLenum target, GLuint index, GLuint buffer) override;
+            void* mapBufferRange(GLenum target, size_t offset, size_t size, GLbitfield access) override;
+            void unmapBuffer(GLenum target) override;
+
+            // Vertex input
+            GLuint createVertexArray() override;
+            void bindVertexArray(GLuint vertexArray) override;
+            void enableVertexAttribute(GLuint index) override;
+            void disableVertexAttribute(GLuint index) override;
+            void vertexAttributePointer(
+                    GLuint index,
+                    int size,
+                    GLenum type,
+                    bool normalized,
+                    int stride,
+                    size_t offset
+            ) override;
+            void vertexAttributeIntegerPointer(GLuint index, int size, GLenum type, int stride, size_t offset) override;
+            void vertexAttributeDivisor(GLuint index, GLuint divisor) override;
+            void setVertexAttribute(GLuint index, const glm::vec4& value) override;
+            void setVertexAttribute(GLuint index, const glm::uvec4& value) override;
+
+            // Textures
+            GLuint createTexture() override;
+            void deleteTexture(GLuint texture) override;
+            void activeTexture(GLuint unit) override;
+            void bindTexture(GLenum target, GLuint texture) override;
+            void pixelStore(GLenum name, GLint value) override;
+            void texImage2D(
+                    GLenum target,
+                    GLint level,
+                    GLint internalFormat,
+                    GLsizei width,
+                    GLsizei height,
+                    GLenum format,
+                    GLenum type,
+                    const void* data
+            ) override;
+            void compressedTexImage2D(
+                    GLenum target,
+                    GLint level,
+                    GLenum format,
+                    GLsizei width,
+                    GLsizei height,
+                    GLsizei size,
+                    const void* data
+            ) override;
+            void texParameter(GLenum target, GLenum name, GLint value) override;
+            void generateMipmap(GLenum target) override;
+            void texBuffer(GLenum target, GLenum format, GLuint buffer) override;
+
+            // Framebuffers
+            GLuint createFramebuffer() override;
+            void deleteFramebuffer(GLuint framebuffer) override;
+            void bindFramebuffer(GLenum target, GLuint framebuffer) override;
+            void framebufferTexture2D(GLenum target, GLenum attachment, GLenum textureTarget, GLuint texture) override;
+            void framebufferRenderbuffer(GLenum target, GLenum attachment, GLuint renderbuffer) override;
+            bool isFramebufferComplete(GLenum target) override;
+            GLuint createRenderbuffer() override;
+            void deleteRenderbuffer(GLuint renderbuffer) override;
+            void renderbufferStorage(
+                    GLuint renderbuffer,
+                    int samples,
+                    GLenum format,
+                    GLsizei width,
+                    GLsizei height
+            ) override;
+            void blitFramebuffer(
+                    const glm::ivec2& sourceSize,
+                    const glm::ivec2& destinationSize,
+                    GLbitfield mask,
+                    GLenum filter
+            ) override;
+            void viewport(const glm::ivec2& origin, const glm::ivec2& size) override;
+            void scissor(const glm::ivec2& origin, const glm::ivec2& size) override;
+            void clearColorBuffer(GLint drawBuffer, const glm::uvec4& value) override;
+            void readPixels(
+                    const glm::ivec2& origin,
+                    const glm::ivec2& size,
+                    GLenum format,
+                    GLenum type,
+                    size_t offset
+            ) override;
+
+            // Queries
+            GLuint createQuery() override;
+            void deleteQuery(GLuint query) override;
+            void beginQuery(GLenum target, GLuint query) override;
+            void endQuery(GLenum target) override;
+            bool getQueryResult(GLuint query, GLuint64& result) override;
+            void queryTimestamp(GLuint query) override;
+            GLint64 getTimestamp() override;
+            void beginConditionalRender(GLuint query, GLenum mode) override;
+            void endConditionalRender() override;
+
+            // Fences
+            GLsync createFence() override;
+            bool isFenceSignaled(GLsync fence) override;
+            bool waitFence(GLsync fence, GLuint64 timeoutNs) override;
+            void deleteFence(GLsync fence) override;
+
+            // Programs
+            GLuint createProgram(const std::string& vertexCode, const std::string& fragmentCode) override;
+            bool isProgramReady(GLuint program) override;
+            bool finishProgram(GLuint program, const char* name) override;
+            void deleteProgram(GLuint program) override;
+            void useProgram(GLuint program) override;
+            GLint getUniformLocation(GLuint program, const char* name) override;
+            GLuint getUniformBlockIndex(GLuint program, const char* name) override;
+            void uniformBlockBinding(GLuint program, GLuint blockIndex, GLuint bindingPoint) override;
+            void setUniform(GLint location, int value) override;
+            void setUniform(GLint location, unsigned int value) override;
+            void setUniform(GLint location, float value) override;
+            void setUniform(GLint location, const glm::vec2& value) override;
+            void setUniform(GLint location, const glm::vec3& value) override;
+            void setUniform(GLint location, const glm::vec4& value) override;
+            void setUniform(GLint location, const glm::mat4& value) override;
+
+            // Draws
+            void drawArrays(GLenum mode, GLint first, GLsizei count) override;
+            void drawArraysInstanced(GLenum mode, GLint first, GLsizei count, GLsizei instances) override;
+            void drawElements(GLenum mode, GLsizei count, GLenum type, size_t offset) override;
+            void drawElementsInstanced(
+                    GLenum mode,
+                    GLsizei count,
+                    GLenum type,
+                    size_t offset,
+                    GLsizei instances
+            ) override;
+
+            // Fixed function state
+            void enable(GLenum capability) override;
+            void disable(GLenum capability) override;
+            void depthMask(bool write) override;
+            void colorMask(bool write) override;
+            void depthFunc(GLenum func) override;
+            void blendFunc(GLenum source, GLenum destination) override;
+            void polygonMode(GLenum mode) override;
+            GLenum getPolygonMode() override;
+            void clearColor(const glm::vec4& color) override;
+            void clear(GLbitfield mask) override;
+
+        private:
+            GLuint createObject();
+            void countBind(bool redundant, size_t& binds);
+            void countStateChange(bool redundant);
+
+            RenderBackendStats m_stats;
+            GLuint m_nextId = 1;
+
+            GLuint m_program = 0;
+            GLuint m_vertexArray = 0;
+            GLuint m_activeTextureUnit = 0;
+            std::unordered_map<GLenum, GLuint> m_boundBuffers;
+            std::unordered_map<GLenum, GLuint> m_boundFramebuffers;
+            std::map<std::pair<GLuint, GLenum>, GLuint> m_boundTextures;
+            std::unordered_map<GLuint, std::vector<uint8_t>> m_bufferStorage;
+            std::unordered_map<std::string, GLint> m_uniformLocations;
+
+            std::unordered_set<GLenum> m_enabledCapabilities;
+            bool m_depthWrite = true;
+            bool m_colorWrite = true;
+            GLenum m_depthFunc = GL_LESS;
+            std::pair<GLenum, GLenum> m_blendFunc = { GL_ONE, GL_ZERO };
+            GLenum m_polygonMode = GL_FILL;
+            GLuint64 m_queryResult = 0;
+            uint32_t m_pixelValue = 0;
+            bool m_conditionalRender = false;
+    };
+} // namespace Engine
@@ -0,0 +1,21 @@
+#include "RenderBackend.h"
+
+#include "GlRenderBackend.h"
+
+using namespace Engine;
+
+namespace
+{
+    std::unique_ptr<RenderBackend> activeBackend;
+} // namespace
+
+RenderBackend& RenderBackend::get()
+{
+    if(!activeBackend)
+    {
+        activeBackend = std::make_unique<GlRenderBackend>();
+    }
+    return *activeBackend;
+}
+
+void RenderBackend::set(std::unique_ptr<RenderBackend> backend) { activeBackend = std::move(backend); }
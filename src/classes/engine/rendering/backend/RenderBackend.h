@@ -0,0 +1,245 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+namespace Engine
+{
+    /**
+     * @brief The commands the renderer issues, one thin call per GL command it uses.
+     *
+     * All rendering code goes through RenderBackend::get() instead of calling GL directly. The GlRenderBackend forwards
+     * every command to the driver, the RecordingRenderBackend only counts them, so render paths can be tested &
+     * benchmarked without a context. GL enums are kept as arguments, a backend maps them to whatever it needs.
+     */
+    class RenderBackend
+    {
+        public:
+            virtual ~RenderBackend() = default;
+
+            /**
+             * @brief The backend all rendering goes through. A GlRenderBackend unless another one has been set.
+             */
+            static RenderBackend& get();
+
+            /**
+             * @brief Replaces the backend, nullptr restores the GlRenderBackend. Objects created with the previous
+             * backend must not be used with the new one.
+             */
+            static void set(std::unique_ptr<RenderBackend> backend);
+
+            // Buffers
+            virtual GLuint createBuffer() = 0;
+            virtual void deleteBuffer(GLuint buffer) = 0;
+            virtual void bindBuffer(GLenum target, GLuint buffer) = 0;
+            virtual void bufferData(GLenum target, size_t size, const void* data, GLenum usage) = 0;
+            virtual void bufferSubData(GLenum target, size_t offset, size_t size, const void* data) = 0;
+            virtual void bindBufferBase(GLenum target, GLuint index, GLuint buffer) = 0;
+            virtual void* mapBufferRange(GLenum target, size_t offset, size_t size, GLbitfield access) = 0;
+            virtual void unmapBuffer(GLenum target) = 0;
+
+            // Vertex input
+            virtual GLuint createVertexArray() = 0;
+            virtual void bindVertexArray(GLuint vertexArray) = 0;
+            virtual void enableVertexAttribute(GLuint index) = 0;
+            virtual void disableVertexAttribute(GLuint index) = 0;
+            virtual void vertexAttributePointer(
+                    GLuint index,
+                    int size,
+                    GLenum type,
+                    bool normalized,
+                    int stride,
+                    size_t offset
+            ) = 0;
+            virtual void vertexAttributeIntegerPointer(
+                    GLuint index,
+                    int size,
+                    GLenum type,
+                    int stride,
+                    size_t offset
+            ) = 0;
+            virtual void vertexAttributeDivisor(GLuint index, GLuint divisor) = 0;
+            virtual void setVertexAttribute(GLuint index, const glm::vec4& value) = 0;
+            virtual void setVertexAttribute(GLuint index, const glm::uvec4& value) = 0;
+
+            // Textures
+            virtual GLuint createTexture() = 0;
+            virtual void deleteTexture(GLuint texture) = 0;
+            virtual void activeTexture(GLuint unit) = 0;
+            virtual void bindTexture(GLenum target, GLuint texture) = 0;
+            virtual void pixelStore(GLenum name, GLint value) = 0;
+            virtual void texImage2D(
+                    GLenum target,
+                    GLint level,
+                    GLint internalFormat,
+                    GLsizei width,
+                    GLsizei height,
+                    GLenum format,
+                    GLenum type,
+                    const void* data
+            ) = 0;
+            virtual void compressedTexImage2D(
+                    GLenum target,
+                    GLint level,
+                    GLenum format,
+                    GLsizei width,
+                    GLsizei height,
+                    GLsizei size,
+                    const void* data
+            ) = 0;
+            virtual void texParameter(GLenum target, GLenum name, GLint value) = 0;
+            virtual void generateMipmap(GLenum target) = 0;
+            virtual void texBuffer(GLenum target, GLenum format, GLuint buffer) = 0;
+
+            // Framebuffers
+            virtual GLuint createFramebuffer() = 0;
+            virtual void deleteFramebuffer(GLuint framebuffer) = 0;
+            virtual void bindFramebuffer(GLenum target, GLuint framebuffer) = 0;
+            virtual void framebufferTexture2D(
+                    GLenum target,
+                    GLenum attachment,
+                    GLenum textureTarget,
+                    GLuint texture
+            ) = 0;
+            virtual void framebufferRenderbuffer(GLenum target, GLenum attachment, GLuint renderbuffer) = 0;
+            virtual bool isFramebufferComplete(GLenum target) = 0;
+            virtual GLuint createRenderbuffer() = 0;
+            virtual void deleteRenderbuffer(GLuint renderbuffer) = 0;
+            virtual void renderbufferStorage(
+                    GLuint renderbuffer,
+                    int samples,
+                    GLenum format,
+                    GLsizei width,
+                    GLsizei height
+            ) = 0;
+            virtual void blitFramebuffer(
+                    const glm::ivec2& sourceSize,
+                    const glm::ivec2& destinationSize,
+                    GLbitfield mask,
+                    GLenum filter
+            ) = 0;
+            virtual void viewport(const glm::ivec2& origin, const glm::ivec2& size) = 0;
+            virtual void scissor(const glm::ivec2& origin, const glm::ivec2& size) = 0;
+
+            /**
+             * @brief Clears a color attachment of an integer format, glClear leaves those undefined.
+             */
+            virtual void clearColorBuffer(GLint drawBuffer, const glm::uvec4& value) = 0;
+
+            /**
+             * @brief Reads pixels of the read framebuffer into the buffer bound to GL_PIXEL_PACK_BUFFER at the
+             * offset. Doesn't wait for the GPU, the buffer is ready once a fence issued after it is signaled.
+             */
+            virtual void readPixels(
+                    const glm::ivec2& origin,
+                    const glm::ivec2& size,
+                    GLenum format,
+                    GLenum type,
+                    size_t offset
+            ) = 0;
+
+            // Queries
+            virtual GLuint createQuery() = 0;
+            virtual void deleteQuery(GLuint query) = 0;
+            virtual void beginQuery(GLenum target, GLuint query) = 0;
+            virtual void endQuery(GLenum target) = 0;
+
+            /**
+             * @return true & the result once it is available, false without waiting otherwise.
+             */
+            virtual bool getQueryResult(GLuint query, GLuint64& result) = 0;
+
+            /**
+             * @brief Records the GPU time once all commands before it are done, in nanoseconds.
+             */
+            virtual void queryTimestamp(GLuint query) = 0;
+
+            /**
+             * @return The current GPU time in nanoseconds, to relate timestamps to the CPU clock.
+             */
+            virtual GLint64 getTimestamp() = 0;
+
+            /**
+             * @brief Draws until endConditionalRender() only get executed if the samples query passed.
+             */
+            virtual void beginConditionalRender(GLuint query, GLenum mode) = 0;
+            virtual void endConditionalRender() = 0;
+
+            // Fences
+            /**
+             * @brief Inserts a fence after all commands issued so far.
+             */
+            virtual GLsync createFence() = 0;
+
+            /**
+             * @return true once the GPU is done with the commands before the fence, without waiting for it.
+             */
+            virtual bool isFenceSignaled(GLsync fence) = 0;
+
+            /**
+             * @brief Blocks until the fence is signaled or the timeout passed.
+             *
+             * @return true if the fence got signaled.
+             */
+            virtual bool waitFence(GLsync fence, GLuint64 timeoutNs) = 0;
+            virtual void deleteFence(GLsync fence) = 0;
+
+            // Programs
+            /**
+             * @brief Starts compiling & linking a program from preprocessed sources without waiting for the result.
+             */
+            virtual GLuint createProgram(const std::string& vertexCode, const std::string& fragmentCode) = 0;
+
+            /**
+             * @return true once linking a program from createProgram() is done.
+             */
+            virtual bool isProgramReady(GLuint program) = 0;
+
+            /**
+             * @brief Prints the compile & link logs of a program from createProgram() & releases its shaders.
+             *
+             * @return true if the program linked successfully.
+             */
+            virtual bool finishProgram(GLuint program, const char* name) = 0;
+            virtual void deleteProgram(GLuint program) = 0;
+            virtual void useProgram(GLuint program) = 0;
+            virtual GLint getUniformLocation(GLuint program, const char* name) = 0;
+            virtual GLuint getUniformBlockIndex(GLuint program, const char* name) = 0;
+            virtual void uniformBlockBinding(GLuint program, GLuint blockIndex, GLuint bindingPoint) = 0;
+            virtual void setUniform(GLint location, int value) = 0;
+            virtual void setUniform(GLint location, unsigned int value) = 0;
+            virtual void setUniform(GLint location, float value) = 0;
+            virtual void setUniform(GLint location, const glm::vec2& value) = 0;
+            virtual void setUniform(GLint location, const glm::vec3& value) = 0;
+            virtual void setUniform(GLint location, const glm::vec4& value) = 0;
+            virtual void setUniform(GLint location, const glm::mat4& value) = 0;
+
+            // Draws
+            virtual void drawArrays(GLenum mode, GLint first, GLsizei count) = 0;
+            virtual void drawArraysInstanced(GLenum mode, GLint first, GLsizei count, GLsizei instances) = 0;
+            virtual void drawElements(GLenum mode, GLsizei count, GLenum type, size_t offset) = 0;
+            virtual void drawElementsInstanced(
+                    GLenum mode,
+                    GLsizei count,
+                    GLenum type,
+                    size_t offset,
+                    GLsizei instances
+            ) = 0;
+
+            // Fixed function state
+            virtual void enable(GLenum capability) = 0;
+            virtual void disable(GLenum capability) = 0;
+            virtual void depthMask(bool write) = 0;
+            virtual void colorMask(bool write) = 0;
+            virtual void depthFunc(GLenum func) = 0;
+            virtual void blendFunc(GLenum source, GLenum destination) = 0;
+            virtual void polygonMode(GLenum mode) = 0;
+            virtual GLenum getPolygonMode() = 0;
+            virtual void clearColor(const glm::vec4& color) = 0;
+            virtual void clear(GLbitfield mask) = 0;
+    };
+} // namespace Engine
@@ -1,3 +1,5 @@
+#pragma once
+
 #include "../UboBlock.h"
 #include "LightingPoints.h"
 
@@ -0,0 +1,230 @@
+#include "LightBaker.h"
+
+#include "../../../nodeComponents/GeometryComponent.h"
+#include "../../ThreadPool.h"
+#include "../Shader.h"
+#include "../backend/RenderBackend.h"
+#include "AmbientLightUbo.h"
+#include "DiffuseLightUbo.h"
+
+#include <iostream>
+
+#include <glm/gtc/constants.hpp>
+
+using namespace Engine::Lighting;
+
+namespace
+{
+    float radicalInverse(unsigned int bits)
+    {
+        bits = (bits << 16u) | (bits >> 16u);
+        bits = ((bits & 0x55555555u) << 1u) | ((bits & 0xAAAAAAAAu) >> 1u);
+        bits = ((bits & 0x33333333u) << 2u) | ((bits & 0xCCCCCCCCu) >> 2u);
+        bits = ((bits & 0x0F0F0F0Fu) << 4u) | ((bits & 0xF0F0F0F0u) >> 4u);
+        bits = ((bits & 0x00FF00FFu) << 8u) | ((bits & 0xFF00FF00u) >> 8u);
+        return float(bits) * 2.3283064365386963e-10f;
+    }
+
+    unsigned int hashSeed(unsigned int value)
+    {
+        value ^= value >> 16u;
+        value *= 0x7feb352du;
+        value ^= value >> 15u;
+        value *= 0x846ca68bu;
+        value ^= value >> 16u;
+        return value;
+    }
+} // namespace
+
+LightBaker::LightBaker(BakeSettings settings) : m_settings(settings), m_bakeStarted(false) {}
+
+LightBaker::~LightBaker()
+{
+    if(m_bakeResult.valid())
+    {
+        m_bakeResult.wait();
+    }
+}
+
+void LightBaker::addStaticGeometry(
+        const std::shared_ptr<GeometryComponent>& node,
+        std::vector<glm::vec4> albedo,
+        const glm::mat4& modelMatrix
+)
+{
+    if(m_bakeStarted)
+    {
+        fprintf(stderr, "LightBaker | Can't add geometry after the bake was started!\n");
+        return;
+    }
+
+    if(!node || !node->getObjectData())
+    {
+        return;
+    }
+
+    m_instances.push_back({ node, node->getObjectData(), modelMatrix, std::move(albedo), {} });
+}
+
+void LightBaker::addStaticGeometry(
+        const std::shared_ptr<GeometryComponent>& node,
+        const glm::vec4& albedo,
+        const glm::mat4& modelMatrix
+)
+{
+    addStaticGeometry(node, std::vector<glm::vec4>(1, albedo), modelMatrix);
+}
+
+void LightBaker::bakeAsync(const AmbientLightUbo& ambientLight, const DiffuseLightUbo& diffuseLight)
+{
+    if(m_bakeStarted)
+    {
+        fprintf(stderr, "LightBaker | Bake was already started!\n");
+        return;
+    }
+
+    LightSnapshot lights;
+    lights.useAmbient = ambientLight.isActive();
+    lights.ambient = ambientLight.getColor() * ambientLight.getIntensity();
+    lights.useDiffuse = diffuseLight.isActive();
+    lights.diffuse = diffuseLight.getColor() * diffuseLight.getIntensity();
+    lights.diffuseDir = glm::normalize(diffuseLight.getDir());
+
+    m_bakeStarted = true;
+    m_bakeResult = SingletonManager::get<ThreadPool>()->enqueue([this, lights]() { bake(lights); });
+}
+
+bool LightBaker::isBakeFinished() const
+{
+    return m_bakeResult.valid() && m_bakeResult.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+}
+
+void LightBaker::bake(const LightSnapshot& lights)
+{
+    for(const BakeInstance& instance : m_instances)
+    {
+        const auto& vertices = instance.objectData->m_vertexData;
+        for(const triData& tri : instance.objectData->m_vertexIndices)
+        {
+            m_bvh.addTriangle(
+                    glm::vec3(instance.modelMatrix * glm::vec4(vertices[std::get<0>(tri)], 1.f)),
+                    glm::vec3(instance.modelMatrix * glm::vec4(vertices[std::get<1>(tri)], 1.f)),
+                    glm::vec3(instance.modelMatrix * glm::vec4(vertices[std::get<2>(tri)], 1.f))
+            );
+        }
+    }
+    m_bvh.build();
+
+    SingletonManager::get<ThreadPool>()->parallelFor(
+            m_instances.size(),
+            [this, &lights](size_t begin, size_t end)
+            {
+                for(size_t i = begin; i < end; ++i)
+                {
+                    BakeInstance& instance = m_instances[i];
+                    const auto& vertices = instance.objectData->m_vertexData;
+                    const auto& normals = instance.objectData->m_vertexNormals;
+                    const glm::mat3 normalMatrix = glm::transpose(glm::inverse(glm::mat3(instance.modelMatrix)));
+
+                    instance.bakedColors.resize(vertices.size());
+                    for(size_t v = 0; v < vertices.size(); ++v)
+                    {
+                        const glm::vec3 pos = glm::vec3(instance.modelMatrix * glm::vec4(vertices[v], 1.f));
+                        const glm::vec3 normal = v < normals.size() ? glm::normalize(normalMatrix * normals[v])
+                                                                    : glm::vec3(0.f, 1.f, 0.f);
+                        const glm::vec3 rayOrigin = pos + normal * m_settings.rayBias;
+
+                        glm::vec3 light = glm::vec3(0.f);
+                        if(lights.useAmbient)
+                        {
+                            const auto seed = (unsigned int)(i * 7919u + v);
+                            light += lights.ambient * computeAmbientOcclusion(rayOrigin, normal, seed);
+                        }
+
+                        if(lights.useDiffuse)
+                        {
+                            const float nDotL = std::max(glm::dot(normal, lights.diffuseDir), 0.f);
+                            const bool inShadow = m_settings.castShadows && nDotL > 0.f &&
+                                    m_bvh.isOccluded(rayOrigin, lights.diffuseDir, m_settings.shadowDistance);
+                            light += inShadow ? glm::vec3(0.f) : lights.diffuse * nDotL;
+                        }
+
+                        const glm::vec4 albedo = instance.albedo.size() > v ? instance.albedo[v]
+                                                                            : instance.albedo.back();
+                        instance.bakedColors[v] = glm::vec4(glm::vec3(albedo) * light, albedo.w);
+                    }
+                }
+            },
+            16
+    );
+}
+
+float LightBaker::computeAmbientOcclusion(const glm::vec3& pos, const glm::vec3& normal, unsigned int seed) const
+{
+    if(m_settings.aoSampleCount <= 0)
+    {
+        return 1.f;
+    }
+
+    // Orthonormal basis around the normal
+    const glm::vec3 helper = std::abs(normal.y) < 0.99f ? glm::vec3(0.f, 1.f, 0.f) : glm::vec3(1.f, 0.f, 0.f);
+    const glm::vec3 tangent = glm::normalize(glm::cross(helper, normal));
+    const glm::vec3 bitangent = glm::cross(normal, tangent);
+
+    // Hammersley points, randomly rotated per vertex to avoid banding between neighbours
+    const float rotation = float(hashSeed(seed)) * 2.3283064365386963e-10f;
+
+    int unoccluded = 0;
+    for(int i = 0; i < m_settings.aoSampleCount; ++i)
+    {
+        const float u = (float(i) + 0.5f) / float(m_settings.aoSampleCount);
+        const float phi = 2.f * glm::pi<float>() * std::fmod(radicalInverse(i) + rotation, 1.f);
+
+        // Cosine weighted hemisphere sample
+        const float radius = std::sqrt(u);
+        const glm::vec3 dir = tangent * (radius * std::cos(phi)) + bitangent * (radius * std::sin(phi)) +
+                normal * std::sqrt(std::max(0.f, 1.f - u));
+
+        if(!m_bvh.isOccluded(pos, dir, m_settings.aoDistance))
+        {
+            unoccluded++;
+        }
+    }
+
+    const float visibility = float(unoccluded) / float(m_settings.aoSampleCount);
+    return glm::mix(1.f, visibility, m_settings.aoStrength);
+}
+
+bool LightBaker::applyBakedLighting(const std::shared_ptr<Shader>& bakedShader)
+{
+    if(!isBakeFinished())
+    {
+        return false;
+    }
+    m_bakeResult.get();
+
+    for(BakeInstance& instance : m_instances)
+    {
+        const std::shared_ptr<GeometryComponent> node = instance.node.lock();
+        if(!node || instance.bakedColors.empty())
+        {
+            continue;
+        }
+
+        GLuint previousBuffer = node->getTextureBuffer();
+        node->setTextureBuffer(RenderManager::createBuffer(instance.bakedColors));
+        node->setShader(bakedShader);
+
+        // The unlit color buffer is replaced by the baked one
+        if(previousBuffer != 0 && previousBuffer != -1)
+        {
+            RenderBackend::get().deleteBuffer(previousBuffer);
+        }
+    }
+
+    std::cout << "LightBaker | Baked " << m_instances.size() << " instances against " << m_bvh.getTriangleCount()
+              << " triangles" << std::endl;
+
+    m_instances.clear();
+    return true;
+}
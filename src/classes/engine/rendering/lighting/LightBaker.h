@@ -0,0 +1,123 @@
+#pragma once
+
+#include "TriangleBvh.h"
+
+#include <atomic>
+#include <future>
+#include <memory>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+namespace Engine
+{
+    class GeometryComponent;
+    class Shader;
+    struct ObjectData;
+
+    namespace Lighting
+    {
+        class AmbientLightUbo;
+        class DiffuseLightUbo;
+
+        struct BakeSettings
+        {
+                int aoSampleCount = 16;
+                float aoDistance = 4.f;
+                float aoStrength = 1.f;
+                bool castShadows = true;
+                float shadowDistance = 1000.f;
+                float rayBias = 0.001f;
+        };
+
+        /**
+         * @brief Bakes ambient, diffuse lighting and ambient occlusion into per vertex colors of static geometry.
+         *
+         * All ray casts run against a BVH of the registered geometry on the engines ThreadPool. The baked colors
+         * already contain the lighting, so the geometry can be drawn with an unlit shader afterwards.
+         * bakeAsync() snapshots all required data, so the scene can keep running while the bake is in progress.
+         */
+        class LightBaker
+        {
+            public:
+                explicit LightBaker(BakeSettings settings = BakeSettings());
+                ~LightBaker();
+
+                /**
+                 * @brief Registers static geometry, which casts shadows and receives baked lighting.
+                 *
+                 * @param node The geometry node. Its transform must not change after the bake.
+                 * @param albedo The unlit color for every vertex of the nodes object data.
+                 * @param modelMatrix The global transform of the node. Passed explicitly, the node may be registered
+                 * while it is still queued to join its parent.
+                 */
+                void addStaticGeometry(
+                        const std::shared_ptr<GeometryComponent>& node,
+                        std::vector<glm::vec4> albedo,
+                        const glm::mat4& modelMatrix
+                );
+
+                /**
+                 * @brief Registers static geometry with a single unlit color.
+                 */
+                void addStaticGeometry(
+                        const std::shared_ptr<GeometryComponent>& node,
+                        const glm::vec4& albedo,
+                        const glm::mat4& modelMatrix
+                );
+
+                /**
+                 * @brief Starts the bake on the ThreadPool using the current state of the given lights.
+                 */
+                void bakeAsync(const AmbientLightUbo& ambientLight, const DiffuseLightUbo& diffuseLight);
+
+                /**
+                 * @brief Checks wether or not a started bake has finished.
+                 */
+                bool isBakeFinished() const;
+
+                /**
+                 * @brief Uploads the baked colors and switches all baked nodes to the given unlit shader.
+                 *
+                 * The previous color buffer of every baked node gets deleted. Has to be called from the thread
+                 * owning the GL context. Does nothing while the bake is running.
+                 *
+                 * @param bakedShader The shader to draw the baked nodes with.
+                 * @return True if the bake got applied, false if it is not finished yet.
+                 */
+                bool applyBakedLighting(const std::shared_ptr<Shader>& bakedShader);
+
+                BakeSettings getSettings() const { return m_settings; };
+
+                void setSettings(const BakeSettings& settings) { m_settings = settings; };
+
+            private:
+                struct BakeInstance
+                {
+                        std::weak_ptr<GeometryComponent> node;
+                        std::shared_ptr<ObjectData> objectData;
+                        glm::mat4 modelMatrix;
+                        std::vector<glm::vec4> albedo;
+                        std::vector<glm::vec4> bakedColors;
+                };
+
+                struct LightSnapshot
+                {
+                        bool useAmbient;
+                        glm::vec3 ambient;
+                        bool useDiffuse;
+                        glm::vec3 diffuse;
+                        glm::vec3 diffuseDir;
+                };
+
+                void bake(const LightSnapshot& lights);
+                float computeAmbientOcclusion(const glm::vec3& pos, const glm::vec3& normal, unsigned int seed) const;
+
+                BakeSettings m_settings;
+                std::vector<BakeInstance> m_instances;
+                TriangleBvh m_bvh;
+                std::future<void> m_bakeResult;
+                bool m_bakeStarted;
+        };
+    } // namespace Lighting
+} // namespace Engine
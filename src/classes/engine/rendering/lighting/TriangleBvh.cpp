@@ -0,0 +1,179 @@
+#include "TriangleBvh.h"
+
+#include <algorithm>
+#include <limits>
+
+using namespace Engine::Lighting;
+
+void TriangleBvh::addTriangle(const glm::vec3& a, const glm::vec3& b, const glm::vec3& c)
+{
+    m_triangles.push_back({ a, b, c, (a + b + c) / 3.f });
+}
+
+void TriangleBvh::build()
+{
+    m_nodes.clear();
+    if(m_triangles.empty())
+    {
+        return;
+    }
+
+    m_nodes.reserve(m_triangles.size() * 2);
+    m_nodes.emplace_back();
+    buildRecursive(0, 0, (unsigned int)m_triangles.size());
+}
+
+void TriangleBvh::buildRecursive(unsigned int nodeIndex, unsigned int first, unsigned int count)
+{
+    glm::vec3 boundsMin(std::numeric_limits<float>::max());
+    glm::vec3 boundsMax(std::numeric_limits<float>::lowest());
+    glm::vec3 centroidMin(std::numeric_limits<float>::max());
+    glm::vec3 centroidMax(std::numeric_limits<float>::lowest());
+    for(unsigned int i = first; i < first + count; ++i)
+    {
+        const Triangle& tri = m_triangles[i];
+        boundsMin = glm::min(boundsMin, glm::min(tri.a, glm::min(tri.b, tri.c)));
+        boundsMax = glm::max(boundsMax, glm::max(tri.a, glm::max(tri.b, tri.c)));
+        centroidMin = glm::min(centroidMin, tri.centroid);
+        centroidMax = glm::max(centroidMax, tri.centroid);
+    }
+
+    m_nodes[nodeIndex].boundsMin = boundsMin;
+    m_nodes[nodeIndex].boundsMax = boundsMax;
+
+    const glm::vec3 extent = centroidMax - centroidMin;
+    int axis = 0;
+    if(extent.y > extent.x)
+    {
+        axis = 1;
+    }
+    if(extent.z > extent[axis])
+    {
+        axis = 2;
+    }
+
+    if(count <= MAX_LEAF_TRIANGLES || extent[axis] <= 0.f)
+    {
+        m_nodes[nodeIndex].rightChildOrFirstTriangle = first;
+        m_nodes[nodeIndex].triangleCount = count;
+        return;
+    }
+
+    // Median split along the longest centroid axis
+    const unsigned int half = count / 2;
+    std::nth_element(
+            m_triangles.begin() + first,
+            m_triangles.begin() + first + half,
+            m_triangles.begin() + first + count,
+            [axis](const Triangle& a, const Triangle& b) { return a.centroid[axis] < b.centroid[axis]; }
+    );
+
+    const auto leftIndex = (unsigned int)m_nodes.size();
+    m_nodes.emplace_back();
+    buildRecursive(leftIndex, first, half);
+
+    const auto rightIndex = (unsigned int)m_nodes.size();
+    m_nodes.emplace_back();
+    buildRecursive(rightIndex, first + half, count - half);
+
+    m_nodes[nodeIndex].rightChildOrFirstTriangle = rightIndex;
+    m_nodes[nodeIndex].triangleCount = 0;
+}
+
+bool TriangleBvh::isOccluded(const glm::vec3& origin, const glm::vec3& dir, float maxDistance) const
+{
+    if(m_nodes.empty())
+    {
+        return false;
+    }
+
+    const glm::vec3 invDir(1.f / dir.x, 1.f / dir.y, 1.f / dir.z);
+
+    unsigned int stack[64];
+    int stackSize = 0;
+    stack[stackSize++] = 0;
+
+    while(stackSize > 0)
+    {
+        const unsigned int nodeIndex = stack[--stackSize];
+        const Node& node = m_nodes[nodeIndex];
+
+        if(!intersectBounds(node, origin, invDir, maxDistance))
+        {
+            continue;
+        }
+
+        if(node.triangleCount > 0)
+        {
+            for(unsigned int i = 0; i < node.triangleCount; ++i)
+            {
+                if(intersectTriangle(m_triangles[node.rightChildOrFirstTriangle + i], origin, dir, maxDistance))
+                {
+                    return true;
+                }
+            }
+            continue;
+        }
+
+        stack[stackSize++] = node.rightChildOrFirstTriangle;
+        stack[stackSize++] = nodeIndex + 1;
+    }
+
+    return false;
+}
+
+bool TriangleBvh::intersectBounds(const Node& node, const glm::vec3& origin, const glm::vec3& invDir, float maxDistance)
+{
+    float tMin = 0.f;
+    float tMax = maxDistance;
+    for(int axis = 0; axis < 3; ++axis)
+    {
+        float t0 = (node.boundsMin[axis] - origin[axis]) * invDir[axis];
+        float t1 = (node.boundsMax[axis] - origin[axis]) * invDir[axis];
+        if(t0 > t1)
+        {
+            std::swap(t0, t1);
+        }
+
+        tMin = std::max(tMin, t0);
+        tMax = std::min(tMax, t1);
+        if(tMax < tMin)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Möller–Trumbore ray triangle intersection
+bool TriangleBvh::intersectTriangle(const Triangle& tri, const glm::vec3& origin, const glm::vec3& dir, float maxDistance)
+{
+    constexpr float epsilon = 1e-7f;
+
+    const glm::vec3 edge1 = tri.b - tri.a;
+    const glm::vec3 edge2 = tri.c - tri.a;
+    const glm::vec3 p = glm::cross(dir, edge2);
+    const float det = glm::dot(edge1, p);
+    if(det > -epsilon && det < epsilon)
+    {
+        return false;
+    }
+
+    const float invDet = 1.f / det;
+    const glm::vec3 s = origin - tri.a;
+    const float u = glm::dot(s, p) * invDet;
+    if(u < 0.f || u > 1.f)
+    {
+        return false;
+    }
+
+    const glm::vec3 q = glm::cross(s, edge1);
+    const float v = glm::dot(dir, q) * invDet;
+    if(v < 0.f || u + v > 1.f)
+    {
+        return false;
+    }
+
+    const float t = glm::dot(edge2, q) * invDet;
+    return t > epsilon && t < maxDistance;
+}
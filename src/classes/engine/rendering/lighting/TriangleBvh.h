@@ -0,0 +1,80 @@
+#pragma once
+
+#include <vector>
+
+#include <glm/glm.hpp>
+
+namespace Engine::Lighting
+{
+    /**
+     * @brief A bounding volume hierarchy over world space triangles, used for CPU side ray casts.
+     *
+     * The tree is stored as a flat array of nodes, where the left child of an inner node always directly follows
+     * its parent.
+     */
+    class TriangleBvh
+    {
+        public:
+            TriangleBvh() = default;
+            ~TriangleBvh() = default;
+
+            /**
+             * @brief Adds a triangle to the hierarchy. build() has to be called afterwards.
+             */
+            void addTriangle(const glm::vec3& a, const glm::vec3& b, const glm::vec3& c);
+
+            /**
+             * @brief Builds the hierarchy over all added triangles.
+             */
+            void build();
+
+            /**
+             * @brief Checks if a ray hits any triangle before reaching the max distance.
+             *
+             * @param origin The origin of the ray.
+             * @param dir The normalized direction of the ray.
+             * @param maxDistance The maximum distance a hit counts for.
+             * @return True if anything got hit, false otherwise.
+             */
+            bool isOccluded(const glm::vec3& origin, const glm::vec3& dir, float maxDistance) const;
+
+            size_t getTriangleCount() const { return m_triangles.size(); };
+
+        private:
+            struct Triangle
+            {
+                    glm::vec3 a;
+                    glm::vec3 b;
+                    glm::vec3 c;
+                    glm::vec3 centroid;
+            };
+
+            struct Node
+            {
+                    glm::vec3 boundsMin;
+                    glm::vec3 boundsMax;
+                    unsigned int rightChildOrFirstTriangle;
+                    unsigned int triangleCount; // 0 for inner nodes
+            };
+
+            void buildRecursive(unsigned int nodeIndex, unsigned int first, unsigned int count);
+
+            static bool intersectBounds(
+                    const Node& node,
+                    const glm::vec3& origin,
+                    const glm::vec3& invDir,
+                    float maxDistance
+            );
+            static bool intersectTriangle(
+                    const Triangle& tri,
+                    const glm::vec3& origin,
+                    const glm::vec3& dir,
+                    float maxDistance
+            );
+
+            std::vector<Triangle> m_triangles;
+            std::vector<Node> m_nodes;
+
+            static constexpr unsigned int MAX_LEAF_TRIANGLES = 4;
+    };
+} // namespace Engine::Lighting
@@ -0,0 +1,319 @@
+#include "AssetArchive.h"
+
+#include <lz4.h>
+#include <lz4hc.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+
+using namespace Engine;
+
+namespace
+{
+    uint64_t alignOffset(uint64_t offset)
+    {
+        return (offset + ASSET_ARCHIVE_ALIGNMENT - 1) & ~(ASSET_ARCHIVE_ALIGNMENT - 1);
+    }
+
+    bool writePadding(FILE* file, uint64_t& offset)
+    {
+        static const uint8_t zeros[ASSET_ARCHIVE_ALIGNMENT] = {};
+        const uint64_t aligned = alignOffset(offset);
+        const bool success = aligned == offset || fwrite(zeros, size_t(aligned - offset), 1, file) == 1;
+        offset = aligned;
+        return success;
+    }
+
+    /**
+     * @return Whether [offset, offset + size) lies within a file of fileSize bytes, without overflowing on corrupt
+     * offsets
+     */
+    bool isInside(uint64_t offset, uint64_t size, uint64_t fileSize)
+    {
+        return offset <= fileSize && size <= fileSize - offset;
+    }
+
+    // Already compressed or read in place through the zero copy paths, LZ4 would only cost load time
+    bool isStoredUncompressed(const std::string& extension)
+    {
+        return extension == ".glb" || extension == ".dds" || extension == ".DDS" || extension == ".png" ||
+               extension == ".jpg";
+    }
+
+    bool readWholeFile(const std::filesystem::path& filePath, std::vector<uint8_t>& data)
+    {
+        std::ifstream stream(filePath, std::ios::binary);
+        if(!stream.is_open())
+        {
+            return false;
+        }
+
+        data.assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+        return !stream.bad();
+    }
+} // namespace
+
+bool AssetArchive::open(const std::string& archivePath)
+{
+    m_archivePath = archivePath;
+    m_entries = nullptr;
+    m_paths = nullptr;
+    m_entryCount = 0;
+
+    // Entries get looked up all over the file, read ahead would only waste I/O
+    if(!m_file.open(archivePath.c_str(), false))
+    {
+        return false;
+    }
+
+    AssetArchiveHeader header;
+    if(m_file.size() < sizeof(header))
+    {
+        std::cout << "Asset archive [" << archivePath << "] is too small" << std::endl;
+        return false;
+    }
+    memcpy(&header, m_file.data(), sizeof(header));
+
+    const uint64_t indexSize = uint64_t(header.entryCount) * sizeof(AssetArchiveEntry);
+    if(header.magic != ASSET_ARCHIVE_MAGIC || header.version != ASSET_ARCHIVE_VERSION ||
+       header.indexOffset % alignof(AssetArchiveEntry) != 0 ||
+       !isInside(header.indexOffset, indexSize, m_file.size()) ||
+       !isInside(header.pathsOffset, header.pathsSize, m_file.size()))
+    {
+        std::cout << "Asset archive [" << archivePath << "] has an invalid header" << std::endl;
+        m_file.close();
+        return false;
+    }
+
+    m_entries = reinterpret_cast<const AssetArchiveEntry*>(m_file.data() + header.indexOffset);
+    m_paths = reinterpret_cast<const char*>(m_file.data() + header.pathsOffset);
+    m_entryCount = header.entryCount;
+
+    // Validated once, so lookups & reads don't have to check the bounds again
+    for(size_t i = 0; i < m_entryCount; i++)
+    {
+        const AssetArchiveEntry& entry = m_entries[i];
+        // LZ4 blocks are limited to int sizes, anything larger can only come from a corrupt index
+        const bool compressed = entry.flags & ASSET_ENTRY_LZ4;
+        if(!isInside(entry.offset, entry.storedSize, m_file.size()) ||
+           !isInside(entry.pathOffset, entry.pathLength, header.pathsSize) ||
+           (!compressed && entry.storedSize != entry.size) ||
+           (compressed && (entry.storedSize > uint64_t(LZ4_MAX_INPUT_SIZE) || entry.size > uint64_t(INT32_MAX))) ||
+           (i > 0 && m_entries[i - 1].pathHash > entry.pathHash))
+        {
+            std::cout << "Asset archive [" << archivePath << "] has an invalid index" << std::endl;
+            m_entries = nullptr;
+            m_paths = nullptr;
+            m_entryCount = 0;
+            m_file.close();
+            return false;
+        }
+    }
+
+    return true;
+}
+
+const AssetArchiveEntry* AssetArchive::find(std::string_view filePath) const
+{
+    if(m_entryCount == 0)
+    {
+        return nullptr;
+    }
+
+    const std::string path = normalizePath(filePath);
+    const uint64_t hash = hashPath(path);
+    const AssetArchiveEntry* end = m_entries + m_entryCount;
+    const AssetArchiveEntry* entry = std::lower_bound(
+            m_entries,
+            end,
+            hash,
+            [](const AssetArchiveEntry& element, uint64_t value) { return element.pathHash < value; }
+    );
+
+    for(; entry != end && entry->pathHash == hash; entry++)
+    {
+        if(std::string_view(m_paths + entry->pathOffset, entry->pathLength) == path)
+        {
+            return entry;
+        }
+    }
+    return nullptr;
+}
+
+const uint8_t* AssetArchive::getPayload(const AssetArchiveEntry& entry) const
+{
+    return entry.flags & ASSET_ENTRY_LZ4 ? nullptr : m_file.data() + entry.offset;
+}
+
+bool AssetArchive::read(const AssetArchiveEntry& entry, std::vector<uint8_t>& data) const
+{
+    data.resize(size_t(entry.size));
+    if(!(entry.flags & ASSET_ENTRY_LZ4))
+    {
+        memcpy(data.data(), m_file.data() + entry.offset, data.size());
+        return true;
+    }
+
+    const int decompressed = LZ4_decompress_safe(
+            reinterpret_cast<const char*>(m_file.data() + entry.offset),
+            reinterpret_cast<char*>(data.data()),
+            int(entry.storedSize),
+            int(entry.size)
+    );
+    if(decompressed != int(entry.size))
+    {
+        std::cout << "Asset archive [" << m_archivePath << "] has a corrupt entry ["
+                  << std::string_view(m_paths + entry.pathOffset, entry.pathLength) << "]" << std::endl;
+        data.clear();
+        return false;
+    }
+    return true;
+}
+
+bool AssetArchive::write(const std::string& archivePath, std::vector<SourceFile>& files)
+{
+    FILE* file = fopen(archivePath.c_str(), "wb");
+    if(file == nullptr)
+    {
+        std::cout << "Couldn't write asset archive [" << archivePath << "]" << std::endl;
+        return false;
+    }
+
+    std::vector<AssetArchiveEntry> entries;
+    std::string paths;
+    entries.reserve(files.size());
+
+    AssetArchiveHeader header = {};
+    uint64_t offset = sizeof(header);
+    bool success = fwrite(&header, sizeof(header), 1, file) == 1;
+
+    std::vector<char> compressed;
+    for(SourceFile& source : files)
+    {
+        const std::string path = normalizePath(source.archivePath);
+
+        AssetArchiveEntry entry = {};
+        entry.pathHash = hashPath(path);
+        entry.size = source.data.size();
+        entry.pathOffset = uint32_t(paths.size());
+        entry.pathLength = uint32_t(path.size());
+        paths += path;
+
+        const char* payload = reinterpret_cast<const char*>(source.data.data());
+        entry.storedSize = entry.size;
+        if(source.compress && !source.data.empty() && source.data.size() < size_t(LZ4_MAX_INPUT_SIZE))
+        {
+            compressed.resize(size_t(LZ4_compressBound(int(source.data.size()))));
+            const int compressedSize = LZ4_compress_HC(
+                    payload,
+                    compressed.data(),
+                    int(source.data.size()),
+                    int(compressed.size()),
+                    LZ4HC_CLEVEL_DEFAULT
+            );
+            if(compressedSize > 0 && float(compressedSize) <= float(entry.size) * (1.f - MIN_COMPRESSION_SAVING))
+            {
+                payload = compressed.data();
+                entry.storedSize = uint64_t(compressedSize);
+                entry.flags |= ASSET_ENTRY_LZ4;
+            }
+        }
+
+        success = success && writePadding(file, offset);
+        entry.offset = offset;
+        success = success && (entry.storedSize == 0 || fwrite(payload, size_t(entry.storedSize), 1, file) == 1);
+        offset += entry.storedSize;
+
+        entries.push_back(entry);
+    }
+
+    std::sort(
+            entries.begin(),
+            entries.end(),
+            [](const AssetArchiveEntry& a, const AssetArchiveEntry& b) { return a.pathHash < b.pathHash; }
+    );
+
+    success = success && writePadding(file, offset);
+    header.indexOffset = offset;
+    success = success &&
+              (entries.empty() || fwrite(entries.data(), sizeof(AssetArchiveEntry), entries.size(), file) == entries.size());
+    offset += entries.size() * sizeof(AssetArchiveEntry);
+
+    header.pathsOffset = offset;
+    header.pathsSize = paths.size();
+    success = success && (paths.empty() || fwrite(paths.data(), paths.size(), 1, file) == 1);
+
+    // The header goes in last, a partially written archive never passes validation
+    header.magic = ASSET_ARCHIVE_MAGIC;
+    header.version = ASSET_ARCHIVE_VERSION;
+    header.entryCount = uint32_t(entries.size());
+    success = success && fseek(file, 0, SEEK_SET) == 0 && fwrite(&header, sizeof(header), 1, file) == 1;
+
+    success = success && ferror(file) == 0;
+    fclose(file);
+
+    if(!success)
+    {
+        std::cout << "Couldn't write asset archive [" << archivePath << "]" << std::endl;
+        std::remove(archivePath.c_str());
+    }
+    return success;
+}
+
+bool AssetArchive::collectFiles(const std::string& directory, std::vector<SourceFile>& files)
+{
+    std::error_code error;
+    for(const auto& entry : std::filesystem::recursive_directory_iterator(directory, error))
+    {
+        const std::string extension = entry.path().extension().string();
+        // Cooked models are tied to the stamp of their loose source & get rebuilt next to it
+        if(!entry.is_regular_file() || extension == ".cmdl")
+        {
+            continue;
+        }
+
+        SourceFile file;
+        file.archivePath = entry.path().generic_string();
+        file.compress = !isStoredUncompressed(extension);
+        if(!readWholeFile(entry.path(), file.data))
+        {
+            std::cout << "Couldn't read file [" << file.archivePath << "]" << std::endl;
+            return false;
+        }
+        files.push_back(std::move(file));
+    }
+
+    if(error)
+    {
+        std::cout << "Couldn't read directory [" << directory << "]: " << error.message() << std::endl;
+        return false;
+    }
+    return true;
+}
+
+std::string AssetArchive::normalizePath(std::string_view filePath)
+{
+    std::string path(filePath);
+    std::replace(path.begin(), path.end(), '\\', '/');
+    while(path.rfind("./", 0) == 0)
+    {
+        path.erase(0, 2);
+    }
+    return path;
+}
+
+uint64_t AssetArchive::hashPath(std::string_view filePath)
+{
+    uint64_t hash = 0xCBF29CE484222325ull;
+    for(const char character : filePath)
+    {
+        hash ^= uint8_t(character);
+        hash *= 0x100000001B3ull;
+    }
+    return hash;
+}
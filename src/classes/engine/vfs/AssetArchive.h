@@ -0,0 +1,133 @@
+#pragma once
+
+#include "../../helper/MappedFile.h"
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Engine
+{
+    static constexpr uint32_t ASSET_ARCHIVE_MAGIC = 0x4B415045; // Equivalent to "EPAK" in ASCII
+    static constexpr uint32_t ASSET_ARCHIVE_VERSION = 1;
+
+    // Payloads start on cache line boundaries, so uncompressed entries can be used straight from the mapping
+    static constexpr uint64_t ASSET_ARCHIVE_ALIGNMENT = 64;
+
+    enum AssetArchiveFlags : uint32_t
+    {
+        ASSET_ENTRY_LZ4 = 1 << 0,
+    };
+
+    struct AssetArchiveHeader
+    {
+            uint32_t magic;
+            uint32_t version;
+            uint32_t entryCount;
+            uint32_t reserved;
+            uint64_t indexOffset;
+            uint64_t pathsOffset;
+            uint64_t pathsSize;
+    };
+
+    /**
+     * @brief One file of the archive. The index is sorted by path hash, the path itself resolves hash collisions.
+     */
+    struct AssetArchiveEntry
+    {
+            uint64_t pathHash;
+            uint64_t offset;
+            uint64_t storedSize;
+            uint64_t size;
+            uint32_t pathOffset;
+            uint32_t pathLength;
+            uint32_t flags;
+            uint32_t reserved;
+    };
+
+    /**
+     * @brief A memory mapped archive of packed asset files, written by AssetArchive::write.
+     *
+     * The whole archive is a single file: the aligned payloads, followed by the index & the path strings. Looking up
+     * a file is a binary search over the index, uncompressed payloads are used in place, LZ4 blocks get decompressed
+     * into the callers buffer.
+     */
+    class AssetArchive
+    {
+        public:
+            /**
+             * @brief A file to pack, see write.
+             */
+            struct SourceFile
+            {
+                    std::string archivePath;
+                    std::vector<uint8_t> data;
+                    bool compress = true;
+            };
+
+            AssetArchive() = default;
+            ~AssetArchive() = default;
+
+            /**
+             * @brief Maps the archive & validates its header & index.
+             *
+             * @return false if the file is no valid archive
+             */
+            bool open(const std::string& archivePath);
+
+            /**
+             * @return The entry stored under the path, nullptr if the archive doesn't contain it
+             */
+            const AssetArchiveEntry* find(std::string_view filePath) const;
+
+            /**
+             * @return The payload of an uncompressed entry inside the mapping, nullptr for compressed entries
+             */
+            const uint8_t* getPayload(const AssetArchiveEntry& entry) const;
+
+            /**
+             * @brief Decompresses or copies the entry into the buffer.
+             */
+            bool read(const AssetArchiveEntry& entry, std::vector<uint8_t>& data) const;
+
+            size_t getEntryCount() const { return m_entryCount; };
+
+            const std::string& getArchivePath() const { return m_archivePath; };
+
+            /**
+             * @brief Packs the files into a new archive. Files are only stored compressed if LZ4 saves enough space.
+             *
+             * @return false if the archive couldn't be written
+             */
+            static bool write(const std::string& archivePath, std::vector<SourceFile>& files);
+
+            /**
+             * @brief Appends every file below the directory, stored under the path it is found at. Formats that are
+             * already compressed or read in place don't get compressed again, cooked models are skipped.
+             *
+             * @return false if the directory or one of its files couldn't be read
+             */
+            static bool collectFiles(const std::string& directory, std::vector<SourceFile>& files);
+
+            /**
+             * @brief Brings a path into the form stored in the archive: forward slashes, without leading "./".
+             */
+            static std::string normalizePath(std::string_view filePath);
+
+            /**
+             * @return The 64 bit FNV-1a hash of a normalized path
+             */
+            static uint64_t hashPath(std::string_view filePath);
+
+        private:
+            std::string m_archivePath;
+            MappedFile m_file;
+            const AssetArchiveEntry* m_entries = nullptr;
+            const char* m_paths = nullptr;
+            size_t m_entryCount = 0;
+
+            // Compressing has to save at least this share, otherwise mapping the raw data is the better deal
+            static constexpr float MIN_COMPRESSION_SAVING = 0.1f;
+    };
+} // namespace Engine
@@ -0,0 +1,112 @@
+#include "VirtualFileSystem.h"
+
+#include <filesystem>
+#include <iostream>
+#include <mutex>
+
+using namespace Engine;
+
+bool VirtualFileSystem::mountArchive(const std::string& archivePath)
+{
+    auto archive = std::make_unique<AssetArchive>();
+    if(!archive->open(archivePath))
+    {
+        return false;
+    }
+
+    std::cout << "Mounted asset archive [" << archivePath << "] with " << archive->getEntryCount() << " files"
+              << std::endl;
+
+    std::unique_lock lock(m_archiveMutex);
+    m_archives.push_back(std::move(archive));
+    return true;
+}
+
+void VirtualFileSystem::unmountAll()
+{
+    std::unique_lock lock(m_archiveMutex);
+    m_archives.clear();
+}
+
+size_t VirtualFileSystem::getMountedArchiveCount() const
+{
+    std::shared_lock lock(m_archiveMutex);
+    return m_archives.size();
+}
+
+bool VirtualFileSystem::openFile(const std::string& filePath, AssetFile& file) const
+{
+    file.m_mapping.close();
+    file.m_buffer.clear();
+    file.m_data = nullptr;
+    file.m_size = 0;
+    file.m_isEmpty = false;
+
+    {
+        std::shared_lock lock(m_archiveMutex);
+        for(auto archive = m_archives.rbegin(); archive != m_archives.rend(); ++archive)
+        {
+            const AssetArchiveEntry* entry = (*archive)->find(filePath);
+            if(entry == nullptr)
+            {
+                continue;
+            }
+
+            file.m_size = size_t(entry->size);
+            file.m_isEmpty = entry->size == 0;
+            file.m_data = (*archive)->getPayload(*entry);
+            if(file.m_data == nullptr)
+            {
+                if(!(*archive)->read(*entry, file.m_buffer))
+                {
+                    file.m_size = 0;
+                    return false;
+                }
+                file.m_data = file.m_buffer.data();
+            }
+            return true;
+        }
+    }
+
+    // Loose file fallback, empty files can't be mapped but are valid all the same
+    if(file.m_mapping.open(filePath.c_str()))
+    {
+        file.m_data = file.m_mapping.data();
+        file.m_size = file.m_mapping.size();
+        return true;
+    }
+
+    std::error_code error;
+    file.m_isEmpty =
+            std::filesystem::is_regular_file(filePath, error) && std::filesystem::file_size(filePath, error) == 0;
+    return file.m_isEmpty;
+}
+
+bool VirtualFileSystem::readFile(const std::string& filePath, std::string& content) const
+{
+    AssetFile file;
+    if(!openFile(filePath, file))
+    {
+        return false;
+    }
+
+    content.assign(reinterpret_cast<const char*>(file.data()), file.size());
+    return true;
+}
+
+bool VirtualFileSystem::exists(const std::string& filePath) const
+{
+    {
+        std::shared_lock lock(m_archiveMutex);
+        for(const auto& archive : m_archives)
+        {
+            if(archive->find(filePath))
+            {
+                return true;
+            }
+        }
+    }
+
+    std::error_code error;
+    return std::filesystem::is_regular_file(filePath, error);
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "../../SingletonManager.h"
+#include "../../helper/MappedFile.h"
+#include "AssetArchive.h"
+
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <vector>
+
+namespace Engine
+{
+    /**
+     * @brief The contents of a file opened through the VirtualFileSystem.
+     *
+     * Depending on where the file came from the data is a view into a mounted archive, a decompressed buffer or a
+     * mapping of the loose file. Views into archives stay valid until the archive gets unmounted.
+     */
+    class AssetFile
+    {
+        public:
+            AssetFile() = default;
+            AssetFile(const AssetFile&) = delete;
+            AssetFile& operator=(const AssetFile&) = delete;
+
+            const uint8_t* data() const { return m_data; };
+
+            size_t size() const { return m_size; };
+
+            bool isOpen() const { return m_data != nullptr || m_isEmpty; };
+
+            /**
+             * @return true if the data is read straight from a mapping, without any copy
+             */
+            bool isMapped() const { return m_buffer.empty() && m_data != nullptr; };
+
+        private:
+            friend class VirtualFileSystem;
+
+            MappedFile m_mapping;
+            std::vector<uint8_t> m_buffer;
+            const uint8_t* m_data = nullptr;
+            size_t m_size = 0;
+            bool m_isEmpty = false;
+    };
+
+    /**
+     * @brief Resolves asset paths to packed archives first & loose files second.
+     *
+     * Release builds mount a single archive instead of opening every asset on its own, which saves one open & seek
+     * per asset on slow drives. Without a mounted archive every path falls back to the loose files, which is what
+     * hot reloading works on during development. Files can be opened from any thread.
+     */
+    class VirtualFileSystem : public SingletonBase
+    {
+        public:
+            VirtualFileSystem() = default;
+            ~VirtualFileSystem() = default;
+
+            /**
+             * @brief Mounts an archive written by AssetArchive::write, archives mounted later take precedence.
+             *
+             * @return false if the archive doesn't exist or is invalid
+             */
+            bool mountArchive(const std::string& archivePath);
+
+            /**
+             * @brief Unmounts all archives, files opened from them must not be used anymore.
+             */
+            void unmountAll();
+
+            size_t getMountedArchiveCount() const;
+
+            /**
+             * @brief Opens a file from the mounted archives, or the loose file if none of them contains it.
+             */
+            bool openFile(const std::string& filePath, AssetFile& file) const;
+
+            /**
+             * @brief Reads a whole text file, see openFile.
+             */
+            bool readFile(const std::string& filePath, std::string& content) const;
+
+            /**
+             * @return true if a mounted archive contains the file or it exists as loose file
+             */
+            bool exists(const std::string& filePath) const;
+
+        private:
+            std::vector<std::unique_ptr<AssetArchive>> m_archives;
+            mutable std::shared_mutex m_archiveMutex;
+    };
+} // namespace Engine
@@ -0,0 +1,376 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "TriDataDef.h"
+
+namespace Engine
+{
+    /**
+     * @brief A mesh in the layout the engine uploads, ready to be turned into an ObjectData.
+     */
+    struct CookedMesh
+    {
+            bool valid = false;
+            std::string name;
+            unsigned int materialIndex = 0;
+            std::vector<glm::vec3> vertexData;
+            std::vector<glm::vec2> uvData;
+            std::vector<glm::vec3> vertexNormals;
+            std::vector<glm::vec4> vertexTangents; // w holds the handedness of the bitangent
+            std::vector<triData> triIndexData;
+
+            // Only filled for skinned imports, up to 4 bone influences per vertex with weights summing up to 1
+            std::vector<glm::uvec4> boneIndices;
+            std::vector<glm::vec4> boneWeights;
+    };
+
+    struct CookedMaterial
+    {
+            std::string name;
+            glm::vec4 diffuseColor = glm::vec4(1.f);
+            std::string diffuseTexture; // relative to the model file
+    };
+
+    /**
+     * @brief A node of the skeleton hierarchy with its rest pose, relative to its parent.
+     */
+    struct SkeletonJoint
+    {
+            std::string name;
+            int parent = -1; // Parents always come before their children
+            glm::vec4 translation = glm::vec4(0.f);
+            glm::vec4 rotation = glm::vec4(0.f, 0.f, 0.f, 1.f); // Quaternion as x, y, z, w
+            glm::vec4 scale = glm::vec4(1.f, 1.f, 1.f, 0.f);
+    };
+
+    /**
+     * @brief A joint vertices are bound to. The bone indices of a mesh refer to these, not to the joints.
+     */
+    struct SkinBone
+    {
+            int joint = 0;
+            glm::mat4 inverseBindMatrix = glm::mat4(1.f);
+    };
+
+    /**
+     * @brief The keyframes of one joint, times are in seconds. A track without keys leaves the rest pose in place.
+     */
+    struct AnimationChannel
+    {
+            int joint = 0;
+            std::vector<float> translationTimes;
+            std::vector<glm::vec4> translations;
+            std::vector<float> rotationTimes;
+            std::vector<glm::vec4> rotations;
+            std::vector<float> scaleTimes;
+            std::vector<glm::vec4> scales;
+    };
+
+    struct AnimationClip
+    {
+            std::string name;
+            float duration = 0.f;
+            std::vector<AnimationChannel> channels;
+    };
+
+    struct Skeleton
+    {
+            std::vector<SkeletonJoint> joints;
+            std::vector<SkinBone> bones;
+            std::vector<AnimationClip> clips;
+
+            /**
+             * @return The index of the clip with the given name, -1 if there is none.
+             */
+            int findClip(const std::string& name) const
+            {
+                for(size_t i = 0; i < clips.size(); i++)
+                {
+                    if(clips[i].name == name)
+                    {
+                        return int(i);
+                    }
+                }
+                return -1;
+            }
+    };
+
+    struct CookedModel
+    {
+            std::vector<CookedMesh> meshes;
+            std::vector<CookedMaterial> materials;
+            Skeleton skeleton; // Empty for static imports
+    };
+
+    /**
+     * @brief Identifies the state of a source file, a cooked file is only valid for the exact stamp it was cooked from.
+     */
+    struct CookedSourceStamp
+    {
+            uint64_t fileSize = 0;
+            int64_t writeTime = 0;
+
+            bool operator==(const CookedSourceStamp& other) const = default;
+    };
+
+    static constexpr uint32_t COOKED_MODEL_MAGIC = 0x4C444D43; // Equivalent to "CMDL" in ASCII
+    static constexpr uint32_t COOKED_MODEL_VERSION = 2;
+
+    /**
+     * @return The stamp of the source file, or an empty stamp if it doesn't exist.
+     */
+    static CookedSourceStamp getCookedSourceStamp(const std::string& sourcePath)
+    {
+        std::error_code error;
+        CookedSourceStamp stamp;
+        stamp.fileSize = std::filesystem::file_size(sourcePath, error);
+        if(error)
+        {
+            return {};
+        }
+        stamp.writeTime = std::filesystem::last_write_time(sourcePath, error).time_since_epoch().count();
+        return stamp;
+    }
+
+    template<typename T>
+    static void writeCookedArray(FILE* file, const std::vector<T>& data)
+    {
+        const uint32_t count = uint32_t(data.size());
+        fwrite(&count, sizeof(count), 1, file);
+        if(count > 0)
+        {
+            fwrite(data.data(), sizeof(T), count, file);
+        }
+    }
+
+    template<typename T>
+    static bool readCookedArray(FILE* file, std::vector<T>& data)
+    {
+        uint32_t count = 0;
+        if(fread(&count, sizeof(count), 1, file) != 1)
+        {
+            return false;
+        }
+        data.resize(count);
+        return count == 0 || fread(data.data(), sizeof(T), count, file) == count;
+    }
+
+    static void writeCookedString(FILE* file, const std::string& string)
+    {
+        writeCookedArray(file, std::vector<char>(string.begin(), string.end()));
+    }
+
+    static bool readCookedString(FILE* file, std::string& string)
+    {
+        std::vector<char> data;
+        if(!readCookedArray(file, data))
+        {
+            return false;
+        }
+        string.assign(data.begin(), data.end());
+        return true;
+    }
+
+    static void writeCookedSkeleton(FILE* file, const Skeleton& skeleton)
+    {
+        const uint32_t counts[3] = { uint32_t(skeleton.joints.size()),
+                                     uint32_t(skeleton.bones.size()),
+                                     uint32_t(skeleton.clips.size()) };
+        fwrite(counts, sizeof(counts), 1, file);
+
+        for(const SkeletonJoint& joint : skeleton.joints)
+        {
+            writeCookedString(file, joint.name);
+            fwrite(&joint.parent, sizeof(joint.parent), 1, file);
+            fwrite(&joint.translation, sizeof(joint.translation), 1, file);
+            fwrite(&joint.rotation, sizeof(joint.rotation), 1, file);
+            fwrite(&joint.scale, sizeof(joint.scale), 1, file);
+        }
+
+        writeCookedArray(file, skeleton.bones);
+
+        for(const AnimationClip& clip : skeleton.clips)
+        {
+            writeCookedString(file, clip.name);
+            fwrite(&clip.duration, sizeof(clip.duration), 1, file);
+
+            const uint32_t channelCount = uint32_t(clip.channels.size());
+            fwrite(&channelCount, sizeof(channelCount), 1, file);
+            for(const AnimationChannel& channel : clip.channels)
+            {
+                fwrite(&channel.joint, sizeof(channel.joint), 1, file);
+                writeCookedArray(file, channel.translationTimes);
+                writeCookedArray(file, channel.translations);
+                writeCookedArray(file, channel.rotationTimes);
+                writeCookedArray(file, channel.rotations);
+                writeCookedArray(file, channel.scaleTimes);
+                writeCookedArray(file, channel.scales);
+            }
+        }
+    }
+
+    static bool readCookedSkeleton(FILE* file, Skeleton& skeleton)
+    {
+        uint32_t counts[3];
+        if(fread(counts, sizeof(counts), 1, file) != 1)
+        {
+            return false;
+        }
+
+        bool success = true;
+        skeleton.joints.resize(counts[0]);
+        for(SkeletonJoint& joint : skeleton.joints)
+        {
+            success = success && readCookedString(file, joint.name) &&
+                      fread(&joint.parent, sizeof(joint.parent), 1, file) == 1 &&
+                      fread(&joint.translation, sizeof(joint.translation), 1, file) == 1 &&
+                      fread(&joint.rotation, sizeof(joint.rotation), 1, file) == 1 &&
+                      fread(&joint.scale, sizeof(joint.scale), 1, file) == 1;
+        }
+
+        success = success && readCookedArray(file, skeleton.bones) && skeleton.bones.size() == counts[1];
+
+        skeleton.clips.resize(counts[2]);
+        for(AnimationClip& clip : skeleton.clips)
+        {
+            uint32_t channelCount = 0;
+            success = success && readCookedString(file, clip.name) &&
+                      fread(&clip.duration, sizeof(clip.duration), 1, file) == 1 &&
+                      fread(&channelCount, sizeof(channelCount), 1, file) == 1;
+            if(!success)
+            {
+                break;
+            }
+
+            clip.channels.resize(channelCount);
+            for(AnimationChannel& channel : clip.channels)
+            {
+                success = success && fread(&channel.joint, sizeof(channel.joint), 1, file) == 1 &&
+                          readCookedArray(file, channel.translationTimes) && readCookedArray(file, channel.translations) &&
+                          readCookedArray(file, channel.rotationTimes) && readCookedArray(file, channel.rotations) &&
+                          readCookedArray(file, channel.scaleTimes) && readCookedArray(file, channel.scales);
+            }
+        }
+
+        return success;
+    }
+
+    /**
+     * Writes a cooked model into the engines binary format. Every array is stored as its element count followed by
+     * the raw elements, so reading it back is little more than a few bulk reads.
+     *
+     * @param filePath The path of the cooked file.
+     * @param model The model to write.
+     * @param stamp The stamp of the source file the model was cooked from.
+     * @return True if the file was written successfully, false otherwise.
+     */
+    static bool writeCookedModel(const std::string& filePath, const CookedModel& model, const CookedSourceStamp& stamp)
+    {
+        FILE* file = fopen(filePath.c_str(), "wb");
+        if(file == nullptr)
+        {
+            std::cout << "Couldn't write cooked model [" << filePath << "]" << std::endl;
+            return false;
+        }
+
+        const uint32_t header[4] = { COOKED_MODEL_MAGIC,
+                                     COOKED_MODEL_VERSION,
+                                     uint32_t(model.meshes.size()),
+                                     uint32_t(model.materials.size()) };
+        fwrite(header, sizeof(header), 1, file);
+        fwrite(&stamp.fileSize, sizeof(stamp.fileSize), 1, file);
+        fwrite(&stamp.writeTime, sizeof(stamp.writeTime), 1, file);
+
+        for(const CookedMaterial& material : model.materials)
+        {
+            writeCookedString(file, material.name);
+            fwrite(&material.diffuseColor, sizeof(material.diffuseColor), 1, file);
+            writeCookedString(file, material.diffuseTexture);
+        }
+
+        for(const CookedMesh& mesh : model.meshes)
+        {
+            writeCookedString(file, mesh.name);
+            fwrite(&mesh.materialIndex, sizeof(mesh.materialIndex), 1, file);
+            writeCookedArray(file, mesh.vertexData);
+            writeCookedArray(file, mesh.uvData);
+            writeCookedArray(file, mesh.vertexNormals);
+            writeCookedArray(file, mesh.vertexTangents);
+            writeCookedArray(file, mesh.triIndexData);
+            writeCookedArray(file, mesh.boneIndices);
+            writeCookedArray(file, mesh.boneWeights);
+        }
+
+        writeCookedSkeleton(file, model.skeleton);
+
+        const bool success = ferror(file) == 0;
+        fclose(file);
+        return success;
+    }
+
+    /**
+     * Reads a cooked model, written by writeCookedModel.
+     *
+     * @param filePath The path of the cooked file.
+     * @param model The model to fill.
+     * @param stamp The stamp of the current source file, a cooked file from a different source state is rejected.
+     * @return True if the file was read successfully & is up to date, false otherwise.
+     */
+    static bool readCookedModel(const std::string& filePath, CookedModel& model, const CookedSourceStamp& stamp)
+    {
+        FILE* file = fopen(filePath.c_str(), "rb");
+        if(file == nullptr)
+        {
+            return false;
+        }
+
+        uint32_t header[4];
+        CookedSourceStamp cookedStamp;
+        if(fread(header, sizeof(header), 1, file) != 1 || header[0] != COOKED_MODEL_MAGIC ||
+           header[1] != COOKED_MODEL_VERSION || fread(&cookedStamp.fileSize, sizeof(cookedStamp.fileSize), 1, file) != 1 ||
+           fread(&cookedStamp.writeTime, sizeof(cookedStamp.writeTime), 1, file) != 1 || cookedStamp != stamp)
+        {
+            fclose(file);
+            return false;
+        }
+
+        bool success = true;
+        model.materials.resize(header[3]);
+        for(CookedMaterial& material : model.materials)
+        {
+            success = success && readCookedString(file, material.name) &&
+                      fread(&material.diffuseColor, sizeof(material.diffuseColor), 1, file) == 1 &&
+                      readCookedString(file, material.diffuseTexture);
+        }
+
+        model.meshes.resize(header[2]);
+        for(CookedMesh& mesh : model.meshes)
+        {
+            success = success && readCookedString(file, mesh.name) &&
+                      fread(&mesh.materialIndex, sizeof(mesh.materialIndex), 1, file) == 1 &&
+                      readCookedArray(file, mesh.vertexData) && readCookedArray(file, mesh.uvData) &&
+                      readCookedArray(file, mesh.vertexNormals) && readCookedArray(file, mesh.vertexTangents) &&
+                      readCookedArray(file, mesh.triIndexData) && readCookedArray(file, mesh.boneIndices) &&
+                      readCookedArray(file, mesh.boneWeights);
+            mesh.valid = success;
+        }
+
+        success = success && readCookedSkeleton(file, model.skeleton);
+
+        fclose(file);
+        if(!success)
+        {
+            std::cout << "Cooked model [" << filePath << "] is corrupt" << std::endl;
+            model = CookedModel();
+        }
+        return success;
+    }
+} // namespace Engine
@@ -3,6 +3,12 @@
 #include <GL/glew.h>
 #include <glm/glm.hpp>
 
+#include "../engine/rendering/backend/RenderBackend.h"
+#include "../engine/vfs/VirtualFileSystem.h"
+#include "TextureImage.h"
+
+#include <algorithm>
+#include <cstring>
 #include <iostream>
 #include <vector>
 
@@ -12,6 +18,34 @@
 
 namespace Engine
 {
+    /**
+     * Reads the next line of a file like fgets, lines longer than the buffer are split.
+     *
+     * @param cursor The read position in the file, advanced past the line.
+     * @return False once the end of the file is reached.
+     */
+    static bool readAssetLine(const AssetFile& file, size_t& cursor, char* line, size_t lineSize)
+    {
+        if(cursor >= file.size() || lineSize < 2)
+        {
+            return false;
+        }
+
+        size_t length = 0;
+        const char* data = reinterpret_cast<const char*>(file.data());
+        while(cursor < file.size() && length < lineSize - 1)
+        {
+            const char character = data[cursor++];
+            line[length++] = character;
+            if(character == '\n')
+            {
+                break;
+            }
+        }
+        line[length] = '\0';
+        return true;
+    }
+
     /**
      * Loads an OBJ file and extracts the vertex positions, texture coordinates, and normals.
      *
@@ -32,17 +66,18 @@ namespace Engine
         std::vector<glm::vec3> temp_vertices, temp_normals;
         std::vector<glm::vec2> temp_uvs;
 
-        FILE* file = fopen(filePath, "r");
-        if(file == nullptr)
+        AssetFile file;
+        if(!SingletonManager::get<VirtualFileSystem>()->openFile(filePath, file))
         {
             std::cout << "Couldn't open file [" << filePath << "]" << std::endl;
             return false;
         }
 
+        size_t cursor = 0;
         while(true)
         {
             char line[128];
-            if(fgets(line, 128, file) == nullptr)
+            if(!readAssetLine(file, cursor, line, sizeof(line)))
             {
                 break;
             }
@@ -168,223 +203,277 @@ namespace Engine
     }
 
     /**
-     * Loads a DDS file and returns the OpenGL texture ID.
+     * Reads a DDS file into memory.
      *
      * @param filePath The path to the DDS file.
-     * @return The OpenGL texture ID if the file was loaded successfully, -1 otherwise.
+     * @param image The image to fill, only valid if the file was read successfully.
+     * @return True if the file was read successfully, false otherwise.
      */
-    static GLuint loadFileDDS(const char* filePath)
+    static bool readFileDDS(const char* filePath, TextureImage& image)
     {
         unsigned char header[124];
 
-        FILE* fp;
-
         /* try to open the file */
-        fp = fopen(filePath, "rb");
-        if(fp == nullptr)
+        AssetFile file;
+        if(!SingletonManager::get<VirtualFileSystem>()->openFile(filePath, file))
         {
             printf("%s could not be opened. Are you in the right directory ? Don't forget to read the FAQ !\n",
                    filePath);
-            getchar();
-            return -1;
+            return false;
         }
 
         /* verify the type of file */
-        char filecode[4];
-        fread(filecode, 1, 4, fp);
-        if(strncmp(filecode, "DDS ", 4) != 0)
+        if(file.size() < 4 + sizeof(header) || strncmp((const char*)file.data(), "DDS ", 4) != 0)
         {
-            fclose(fp);
-            return -1;
+            return false;
         }
 
         /* get the surface desc */
-        fread(&header, 124, 1, fp);
+        memcpy(header, file.data() + 4, sizeof(header));
 
-        unsigned int height = *(unsigned int*)&(header[8]);
-        unsigned int width = *(unsigned int*)&(header[12]);
         unsigned int linearSize = *(unsigned int*)&(header[16]);
-        unsigned int mipMapCount = *(unsigned int*)&(header[24]);
         unsigned int fourCC = *(unsigned int*)&(header[80]);
+        image.height = *(unsigned int*)&(header[8]);
+        image.width = *(unsigned int*)&(header[12]);
+        image.mipMapCount = *(unsigned int*)&(header[24]);
 
-        unsigned char* buffer;
-        unsigned int bufsize;
-        /* how big is it going to be including all mipmaps? */
-        bufsize = mipMapCount > 1 ? linearSize * 2 : linearSize;
-        buffer = (unsigned char*)malloc(bufsize * sizeof(unsigned char));
-        fread(buffer, 1, bufsize, fp);
-        /* close the file pointer */
-        fclose(fp);
-
-        unsigned int format;
         switch(fourCC)
         {
             case FOURCC_DXT1:
-                format = GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
+                image.format = GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
                 break;
             case FOURCC_DXT3:
-                format = GL_COMPRESSED_RGBA_S3TC_DXT3_EXT;
+                image.format = GL_COMPRESSED_RGBA_S3TC_DXT3_EXT;
                 break;
             case FOURCC_DXT5:
-                format = GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+                image.format = GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
                 break;
             default:
-                free(buffer);
-                return 0;
+                return false;
         }
 
-        // Create one OpenGL texture
-        GLuint textureID;
-        glGenTextures(1, &textureID);
-
-        // "Bind" the newly created texture : all future texture functions will modify this texture
-        glBindTexture(GL_TEXTURE_2D, textureID);
-        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-
-        unsigned int blockSize = (format == GL_COMPRESSED_RGBA_S3TC_DXT1_EXT) ? 8 : 16;
-        unsigned int offset = 0;
-
-        /* load the mipmaps */
-        for(unsigned int level = 0; level < mipMapCount && (width || height); ++level)
-        {
-            unsigned int size = ((width + 3) / 4) * ((height + 3) / 4) * blockSize;
-            glCompressedTexImage2D(
-                    GL_TEXTURE_2D,
-                    GLint(level),
-                    format,
-                    GLsizei(width),
-                    GLsizei(height),
-                    0,
-                    GLsizei(size),
-                    buffer + offset
-            );
-
-            offset += size;
-            width /= 2;
-            height /= 2;
-
-            // Deal with Non-Power-Of-Two textures. This code is not included in the webpage to reduce clutter.
-            if(width < 1)
-            {
-                width = 1;
-            }
-            if(height < 1)
-            {
-                height = 1;
-            }
-        }
-
-        free(buffer);
+        /* how big is it going to be including all mipmaps? */
+        const size_t dataOffset = 4 + sizeof(header);
+        const size_t linearBufsize = image.mipMapCount > 1 ? linearSize * 2 : linearSize;
+        const size_t bufsize = std::min<size_t>(linearBufsize, file.size() - dataOffset);
+        image.data.assign(file.data() + dataOffset, file.data() + dataOffset + bufsize);
 
-        return textureID;
+        image.compressed = true;
+        image.valid = true;
+        return true;
     }
 
     /**
-     * Loads a BMP file and returns the OpenGL texture ID.
+     * Reads a BMP file into memory.
      *
      * @param filePath The path to the BMP file.
-     * @return The OpenGL texture ID if the file was loaded successfully, -1 otherwise.
+     * @param image The image to fill, only valid if the file was read successfully.
+     * @return True if the file was read successfully, false otherwise.
      */
-    static GLuint loadFileBMP(const char* filePath)
+    static bool readFileBMP(const char* filePath, TextureImage& image)
     {
         // Data read from the header of the BMP file
-        unsigned int width, height;
-        unsigned char* data;
         unsigned char header[54];
         unsigned int dataPos;
         unsigned int imageSize;
 
         // Open the file
-        FILE* file = fopen(filePath, "rb");
-        if(!file)
+        AssetFile file;
+        if(!SingletonManager::get<VirtualFileSystem>()->openFile(filePath, file))
         {
             std::cout << "Couldn't open file [" << filePath << "]" << std::endl;
-            return -1;
+            return false;
         }
 
         // Read the header, i.e. the 54 first bytes
 
         // If less than 54 bytes are read, problem
-        if(fread(header, 1, 54, file) != 54)
+        if(file.size() < 54)
         {
             std::cout << "BMP file is not correct [" << filePath << "]" << std::endl;
-            fclose(file);
-            return -1;
+            return false;
         }
+        memcpy(header, file.data(), 54);
         // A BMP files always begins with "BM"
         if(header[0] != 'B' || header[1] != 'M')
         {
             std::cout << "BMP file is not correct [" << filePath << "]" << std::endl;
-            fclose(file);
-            return -1;
+            return false;
         }
         // Make sure this is a 24bpp file
         if(*(int*)&(header[0x1E]) != 0)
         {
             std::cout << "BMP file is not correct [" << filePath << "]" << std::endl;
-            fclose(file);
-            return -1;
+            return false;
         }
         if(*(int*)&(header[0x1C]) != 24)
         {
             std::cout << "BMP file is not correct [" << filePath << "]" << std::endl;
-            fclose(file);
-            return -1;
+            return false;
         }
 
         // Read the information about the image
         dataPos = *(int*)&(header[0x0A]);
         imageSize = *(int*)&(header[0x22]) * 3;
-        width = *(int*)&(header[0x12]);
-        height = *(int*)&(header[0x16]);
+        image.width = *(int*)&(header[0x12]);
+        image.height = *(int*)&(header[0x16]);
 
         // Some BMP files are misformatted, guess missing information
         if(imageSize == 0)
         {
-            imageSize = width * height * 3; // 3 : one byte for each Red, Green and Blue component
+            imageSize = image.width * image.height * 3; // 3 : one byte for each Red, Green and Blue component
         }
         if(dataPos == 0)
         {
             dataPos = 54; // The BMP header is done that way
         }
 
-        // Create a buffer
-        data = new unsigned char[imageSize];
+        // Copy the actual data out of the file, a truncated file leaves the rest black
+        image.data.assign(imageSize, 0);
+        if(dataPos < file.size())
+        {
+            memcpy(image.data.data(), file.data() + dataPos, std::min<size_t>(imageSize, file.size() - dataPos));
+        }
 
-        // Read the actual data from the file into the buffer
-        fseek(file, dataPos, SEEK_SET);
-        fread(data, 1, imageSize, file);
+        image.format = GL_BGR;
+        image.compressed = false;
+        image.valid = true;
+        return true;
+    }
+
+    /**
+     * Uploads an image read by readFileBMP or readFileDDS.
+     *
+     * @param image The image to upload.
+     * @param existingTexture Optional texture to upload into instead of creating a new one, used for hot reloading.
+     * @return The OpenGL texture ID if the image was uploaded successfully, -1 otherwise.
+     */
+    static GLuint uploadTextureImage(const TextureImage& image, GLuint existingTexture = 0)
+    {
+        if(!image.valid)
+        {
+            return -1;
+        }
 
-        // Everything is in memory now, the file can be closed.
-        fclose(file);
+        RenderBackend& backend = RenderBackend::get();
 
-        // TODO: read up what all of this does in more detail
         // Create one OpenGL texture
-        GLuint textureID;
-        glGenTextures(1, &textureID);
+        GLuint textureID = existingTexture;
+        if(textureID == 0)
+        {
+            textureID = backend.createTexture();
+        }
 
         // "Bind" the newly created texture : all future texture functions will modify this texture
-        glBindTexture(GL_TEXTURE_2D, textureID);
+        backend.bindTexture(GL_TEXTURE_2D, textureID);
 
-        // Give the image to OpenGL
-        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, GLsizei(width), GLsizei(height), 0, GL_BGR, GL_UNSIGNED_BYTE, data);
+        if(image.compressed)
+        {
+            backend.pixelStore(GL_UNPACK_ALIGNMENT, 1);
+
+            unsigned int blockSize = (image.format == GL_COMPRESSED_RGBA_S3TC_DXT1_EXT) ? 8 : 16;
+            unsigned int offset = 0;
+            unsigned int width = image.width;
+            unsigned int height = image.height;
+
+            /* load the mipmaps */
+            for(unsigned int level = 0; level < image.mipMapCount && (width || height); ++level)
+            {
+                unsigned int size = ((width + 3) / 4) * ((height + 3) / 4) * blockSize;
+                if(offset + size > image.data.size())
+                {
+                    break;
+                }
+
+                backend.compressedTexImage2D(
+                        GL_TEXTURE_2D,
+                        GLint(level),
+                        image.format,
+                        GLsizei(width),
+                        GLsizei(height),
+                        GLsizei(size),
+                        image.data.data() + offset
+                );
+
+                offset += size;
+                width /= 2;
+                height /= 2;
+
+                // Deal with Non-Power-Of-Two textures. This code is not included in the webpage to reduce clutter.
+                if(width < 1)
+                {
+                    width = 1;
+                }
+                if(height < 1)
+                {
+                    height = 1;
+                }
+            }
+
+            return textureID;
+        }
 
-        // OpenGL has now copied the data. Free our own version
-        delete[] data;
+        // Give the image to OpenGL
+        backend.texImage2D(
+                GL_TEXTURE_2D,
+                0,
+                GL_RGB,
+                GLsizei(image.width),
+                GLsizei(image.height),
+                image.format,
+                GL_UNSIGNED_BYTE,
+                image.data.data()
+        );
 
         // Poor filtering...
         // glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
         // glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
 
         // Nice trilinear filtering ...
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+        backend.texParameter(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
+        backend.texParameter(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
+        backend.texParameter(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        backend.texParameter(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
         // ... which requires mipmaps. Generate them automatically.
-        glGenerateMipmap(GL_TEXTURE_2D);
+        backend.generateMipmap(GL_TEXTURE_2D);
 
         // Return the ID of the texture we just created
         return textureID;
     }
+
+    /**
+     * Loads a DDS file and returns the OpenGL texture ID.
+     *
+     * @param filePath The path to the DDS file.
+     * @param existingTexture Optional texture to upload into instead of creating a new one, used for hot reloading.
+     * @return The OpenGL texture ID if the file was loaded successfully, -1 otherwise.
+     */
+    static GLuint loadFileDDS(const char* filePath, GLuint existingTexture = 0)
+    {
+        TextureImage image;
+        if(!readFileDDS(filePath, image))
+        {
+            return -1;
+        }
+
+        return uploadTextureImage(image, existingTexture);
+    }
+
+    /**
+     * Loads a BMP file and returns the OpenGL texture ID.
+     *
+     * @param filePath The path to the BMP file.
+     * @param existingTexture Optional texture to upload into instead of creating a new one, used for hot reloading.
+     * @return The OpenGL texture ID if the file was loaded successfully, -1 otherwise.
+     */
+    static GLuint loadFileBMP(const char* filePath, GLuint existingTexture = 0)
+    {
+        TextureImage image;
+        if(!readFileBMP(filePath, image))
+        {
+            return -1;
+        }
+
+        return uploadTextureImage(image, existingTexture);
+    }
 } // namespace Engine
\ No newline at end of file
@@ -0,0 +1,711 @@
+#pragma once
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ENGINE_GLB_SSE2 1
+#endif
+
+#include "../engine/rendering/backend/RenderBackend.h"
+#include "../engine/vfs/VirtualFileSystem.h"
+#include "CookedModel.h"
+#include "JsonParser.h"
+
+#define GLB_MAGIC 0x46546C67      // Equivalent to "glTF" in ASCII
+#define GLB_CHUNK_JSON 0x4E4F534A // Equivalent to "JSON" in ASCII
+#define GLB_CHUNK_BIN 0x004E4942  // Equivalent to "BIN\0" in ASCII
+
+namespace Engine
+{
+    /**
+     * @brief One triangle primitive of a GLB file, living only on the GPU.
+     */
+    struct GlbPrimitive
+    {
+            GLuint vertexBuffer = -1;
+            GLuint uvBuffer = -1;
+            GLuint normalBuffer = -1;
+            GLuint indexBuffer = -1;
+            int vertexCount = 0;
+            int indexCount = 0;
+            glm::vec3 boundsMin = glm::vec3(0.f);
+            glm::vec3 boundsMax = glm::vec3(0.f);
+            bool hasBounds = false;
+            CookedMaterial material;
+    };
+
+    /**
+     * @brief A validated, strided view into the binary chunk of a GLB file.
+     */
+    struct GlbAccessor
+    {
+            const uint8_t* data = nullptr;
+            size_t count = 0;
+            size_t stride = 0;
+            GLenum componentType = 0;
+            int componentCount = 0;
+            bool normalized = false;
+
+            size_t getElementSize() const { return getGlbComponentSize(componentType) * componentCount; };
+
+            bool isTightlyPacked() const { return stride == getElementSize(); };
+
+            static size_t getGlbComponentSize(GLenum type)
+            {
+                switch(type)
+                {
+                    case GL_BYTE:
+                    case GL_UNSIGNED_BYTE:
+                        return 1;
+                    case GL_SHORT:
+                    case GL_UNSIGNED_SHORT:
+                        return 2;
+                    case GL_UNSIGNED_INT:
+                    case GL_FLOAT:
+                        return 4;
+                    default:
+                        return 0;
+                }
+            }
+    };
+
+    static GLuint uploadGlbBuffer(const void* data, size_t dataSize)
+    {
+        RenderBackend& backend = RenderBackend::get();
+        GLuint vbo = backend.createBuffer();
+        backend.bindBuffer(GL_ARRAY_BUFFER, vbo);
+        backend.bufferData(GL_ARRAY_BUFFER, dataSize, data, GL_STATIC_DRAW);
+        return vbo;
+    }
+
+    static float readGlbComponent(const uint8_t* data, GLenum type, bool normalized)
+    {
+        switch(type)
+        {
+            case GL_FLOAT:
+            {
+                float value;
+                memcpy(&value, data, sizeof(value));
+                return value;
+            }
+            case GL_UNSIGNED_BYTE:
+                return normalized ? float(*data) / 255.f : float(*data);
+            case GL_BYTE:
+                return normalized ? glm::max(float(int8_t(*data)) / 127.f, -1.f) : float(int8_t(*data));
+            case GL_UNSIGNED_SHORT:
+            {
+                uint16_t value;
+                memcpy(&value, data, sizeof(value));
+                return normalized ? float(value) / 65535.f : float(value);
+            }
+            case GL_SHORT:
+            {
+                int16_t value;
+                memcpy(&value, data, sizeof(value));
+                return normalized ? glm::max(float(value) / 32767.f, -1.f) : float(value);
+            }
+            default:
+                return 0.f;
+        }
+    }
+
+    /**
+     * Converts a tightly packed array of integer components into floats, eight at a time.
+     *
+     * @return The amount of components converted, the caller handles the remaining tail.
+     */
+    static size_t convertGlbComponentsSimd(const uint8_t* source, size_t count, GLenum type, bool normalized, float* target)
+    {
+#if defined(ENGINE_GLB_SSE2)
+        float scale = 1.f;
+        if(normalized)
+        {
+            scale = type == GL_UNSIGNED_BYTE ? 1.f / 255.f
+                  : type == GL_BYTE          ? 1.f / 127.f
+                  : type == GL_UNSIGNED_SHORT ? 1.f / 65535.f
+                                              : 1.f / 32767.f;
+        }
+        const __m128 scaleVector = _mm_set1_ps(scale);
+        const __m128 minVector = _mm_set1_ps(normalized ? -1.f : -3.4e38f);
+        const __m128i zero = _mm_setzero_si128();
+
+        size_t i = 0;
+        for(; i + 8 <= count; i += 8)
+        {
+            __m128i low, high;
+            switch(type)
+            {
+                case GL_UNSIGNED_BYTE:
+                {
+                    const __m128i words = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i*)(source + i)), zero);
+                    low = _mm_unpacklo_epi16(words, zero);
+                    high = _mm_unpackhi_epi16(words, zero);
+                    break;
+                }
+                case GL_BYTE:
+                {
+                    // Placing the byte in the top of each lane & shifting back arithmetically sign extends it
+                    const __m128i bytes = _mm_loadl_epi64((const __m128i*)(source + i));
+                    const __m128i words = _mm_unpacklo_epi8(bytes, bytes);
+                    low = _mm_srai_epi32(_mm_unpacklo_epi16(words, words), 24);
+                    high = _mm_srai_epi32(_mm_unpackhi_epi16(words, words), 24);
+                    break;
+                }
+                case GL_UNSIGNED_SHORT:
+                {
+                    const __m128i words = _mm_loadu_si128((const __m128i*)(source + i * 2));
+                    low = _mm_unpacklo_epi16(words, zero);
+                    high = _mm_unpackhi_epi16(words, zero);
+                    break;
+                }
+                case GL_SHORT:
+                {
+                    const __m128i words = _mm_loadu_si128((const __m128i*)(source + i * 2));
+                    low = _mm_srai_epi32(_mm_unpacklo_epi16(words, words), 16);
+                    high = _mm_srai_epi32(_mm_unpackhi_epi16(words, words), 16);
+                    break;
+                }
+                default:
+                    return i;
+            }
+
+            _mm_storeu_ps(target + i, _mm_max_ps(_mm_mul_ps(_mm_cvtepi32_ps(low), scaleVector), minVector));
+            _mm_storeu_ps(target + i + 4, _mm_max_ps(_mm_mul_ps(_mm_cvtepi32_ps(high), scaleVector), minVector));
+        }
+        return i;
+#else
+        return 0;
+#endif
+    }
+
+    /**
+     * Converts an attribute, which layout doesn't match the engines vertex format, into tightly packed floats.
+     * Missing components get filled with 0, surplus ones dropped.
+     */
+    static std::vector<float> convertGlbAttribute(const GlbAccessor& accessor, int components)
+    {
+        std::vector<float> converted(accessor.count * components);
+        const size_t componentSize = GlbAccessor::getGlbComponentSize(accessor.componentType);
+
+        size_t convertedComponents = 0;
+        if(accessor.isTightlyPacked() && accessor.componentCount == components && accessor.componentType != GL_FLOAT)
+        {
+            convertedComponents = convertGlbComponentsSimd(
+                    accessor.data,
+                    accessor.count * components,
+                    accessor.componentType,
+                    accessor.normalized,
+                    converted.data()
+            );
+        }
+
+        for(size_t element = convertedComponents / components; element < accessor.count; element++)
+        {
+            const uint8_t* source = accessor.data + element * accessor.stride;
+            float* target = converted.data() + element * components;
+            for(int component = 0; component < components; component++)
+            {
+                target[component] = component < accessor.componentCount
+                                          ? readGlbComponent(source + component * componentSize, accessor.componentType, accessor.normalized)
+                                          : 0.f;
+            }
+        }
+
+        return converted;
+    }
+
+    /**
+     * @return The highest index, found eight at a time.
+     */
+    static uint16_t getGlbMaxIndex(const uint16_t* indices, size_t count)
+    {
+        size_t i = 0;
+        uint16_t maxIndex = 0;
+#if defined(ENGINE_GLB_SSE2)
+        // SSE2 only has a signed 16 bit max, flipping the sign bit maps unsigned order onto signed order
+        const __m128i signBit = _mm_set1_epi16(short(0x8000));
+        __m128i maxVector = _mm_set1_epi16(short(0x8000));
+        for(; i + 8 <= count; i += 8)
+        {
+            maxVector = _mm_max_epi16(maxVector, _mm_xor_si128(_mm_loadu_si128((const __m128i*)(indices + i)), signBit));
+        }
+
+        alignas(16) uint16_t lanes[8];
+        _mm_store_si128((__m128i*)lanes, _mm_xor_si128(maxVector, signBit));
+        for(uint16_t lane : lanes)
+        {
+            maxIndex = glm::max(maxIndex, lane);
+        }
+#endif
+        for(; i < count; i++)
+        {
+            maxIndex = glm::max(maxIndex, indices[i]);
+        }
+        return maxIndex;
+    }
+
+    /**
+     * Converts 8 or 32 bit indices into the engines 16 bit indices. 32 bit indices have to be below 65536.
+     */
+    static std::vector<uint16_t> convertGlbIndices(const GlbAccessor& accessor)
+    {
+        std::vector<uint16_t> converted(accessor.count);
+        size_t i = 0;
+
+        if(accessor.isTightlyPacked())
+        {
+#if defined(ENGINE_GLB_SSE2)
+            if(accessor.componentType == GL_UNSIGNED_BYTE)
+            {
+                const __m128i zero = _mm_setzero_si128();
+                for(; i + 16 <= accessor.count; i += 16)
+                {
+                    const __m128i bytes = _mm_loadu_si128((const __m128i*)(accessor.data + i));
+                    _mm_storeu_si128((__m128i*)(converted.data() + i), _mm_unpacklo_epi8(bytes, zero));
+                    _mm_storeu_si128((__m128i*)(converted.data() + i + 8), _mm_unpackhi_epi8(bytes, zero));
+                }
+            }
+            else if(accessor.componentType == GL_UNSIGNED_INT)
+            {
+                // SSE2 can only pack with signed saturation, so the values get shifted into the signed range & back
+                const __m128i bias32 = _mm_set1_epi32(0x8000);
+                const __m128i bias16 = _mm_set1_epi16(short(0x8000));
+                for(; i + 8 <= accessor.count; i += 8)
+                {
+                    const __m128i low = _mm_sub_epi32(_mm_loadu_si128((const __m128i*)(accessor.data + i * 4)), bias32);
+                    const __m128i high = _mm_sub_epi32(_mm_loadu_si128((const __m128i*)(accessor.data + i * 4 + 16)), bias32);
+                    _mm_storeu_si128((__m128i*)(converted.data() + i), _mm_xor_si128(_mm_packs_epi32(low, high), bias16));
+                }
+            }
+#endif
+        }
+
+        for(; i < accessor.count; i++)
+        {
+            const uint8_t* source = accessor.data + i * accessor.stride;
+            uint32_t index = 0;
+            if(accessor.componentType == GL_UNSIGNED_BYTE)
+            {
+                index = *source;
+            }
+            else if(accessor.componentType == GL_UNSIGNED_SHORT)
+            {
+                uint16_t value;
+                memcpy(&value, source, sizeof(value));
+                index = value;
+            }
+            else
+            {
+                memcpy(&index, source, sizeof(index));
+            }
+            converted[i] = uint16_t(index);
+        }
+
+        return converted;
+    }
+
+    enum GlbLoadResult
+    {
+        GLB_LOADED,
+        GLB_UNSUPPORTED, // Valid glTF using features the fast path doesn't cover, import it instead
+        GLB_FAILED
+    };
+
+    /**
+     * @brief A memory mapped GLB file with its parsed JSON chunk, opened through the VirtualFileSystem.
+     */
+    class GlbFile
+    {
+        public:
+            /**
+             * Maps the file and parses its header & JSON chunk. No buffer data gets touched yet.
+             *
+             * @return True if the file is a valid GLB container, false otherwise.
+             */
+            bool open(const char* filePath)
+            {
+                m_filePath = filePath;
+                if(!SingletonManager::get<VirtualFileSystem>()->openFile(filePath, m_file))
+                {
+                    std::cout << "Couldn't open file [" << filePath << "]" << std::endl;
+                    return false;
+                }
+
+                const uint8_t* data = m_file.data();
+                uint32_t header[5];
+                if(m_file.size() < sizeof(header))
+                {
+                    return fail("too small");
+                }
+                memcpy(header, data, sizeof(header));
+
+                if(header[0] != GLB_MAGIC || header[1] != 2 || header[2] > m_file.size() || header[4] != GLB_CHUNK_JSON ||
+                   size_t(header[3]) + 20 > header[2])
+                {
+                    return fail("invalid header");
+                }
+
+                if(!JsonValue::parse(std::string_view((const char*)data + 20, header[3]), m_json))
+                {
+                    return fail("invalid JSON chunk");
+                }
+
+                // The binary chunk is optional & follows the 4 byte aligned JSON chunk
+                const size_t binHeader = 20 + ((size_t(header[3]) + 3) & ~size_t(3));
+                if(binHeader + 8 <= header[2])
+                {
+                    uint32_t chunk[2];
+                    memcpy(chunk, data + binHeader, sizeof(chunk));
+                    if(chunk[1] == GLB_CHUNK_BIN && binHeader + 8 + chunk[0] <= header[2])
+                    {
+                        m_bin = data + binHeader + 8;
+                        m_binSize = chunk[0];
+                    }
+                }
+
+                return true;
+            }
+
+            const JsonValue& getJson() const { return m_json; };
+
+            /**
+             * @return The amount of primitives over all meshes.
+             */
+            size_t getPrimitiveCount() const
+            {
+                size_t count = 0;
+                for(size_t i = 0; i < m_json["meshes"].size(); i++)
+                {
+                    count += m_json["meshes"][i]["primitives"].size();
+                }
+                return count;
+            }
+
+            /**
+             * Checks whether the fast path can load the file as is: node transforms have to be identity, all data has
+             * to live in the binary chunk & every primitive has to be an indexable triangle list.
+             */
+            bool isFastPathCompatible() const
+            {
+                const JsonValue& buffers = m_json["buffers"];
+                if(buffers.size() > 1 || buffers[size_t(0)].contains("uri") || m_json.contains("extensionsRequired"))
+                {
+                    return false;
+                }
+
+                const JsonValue& nodes = m_json["nodes"];
+                for(size_t i = 0; i < nodes.size(); i++)
+                {
+                    const JsonValue& node = nodes[i];
+                    if(node.contains("matrix") || node.contains("translation") || node.contains("rotation") ||
+                       node.contains("scale"))
+                    {
+                        return false;
+                    }
+                }
+
+                const JsonValue& meshes = m_json["meshes"];
+                for(size_t i = 0; i < meshes.size(); i++)
+                {
+                    const JsonValue& primitives = meshes[i]["primitives"];
+                    for(size_t j = 0; j < primitives.size(); j++)
+                    {
+                        const JsonValue& primitive = primitives[j];
+                        const JsonValue& position = m_json["accessors"][size_t(primitive["attributes"]["POSITION"].asInt(-1))];
+                        if(primitive["mode"].asInt(GL_TRIANGLES) != GL_TRIANGLES || position.isNull() ||
+                           position["count"].asInt() > 0xFFFF)
+                        {
+                            return false;
+                        }
+                    }
+                }
+
+                return getPrimitiveCount() > 0;
+            }
+
+            /**
+             * Uploads every primitive. Attributes already matching the engines vertex format go from the mapping
+             * straight into their GL buffer, only mismatching ones get converted.
+             *
+             * @param primitives The vector to store the primitives in, the caller owns the created buffers.
+             */
+            GlbLoadResult loadPrimitives(std::vector<GlbPrimitive>& primitives)
+            {
+                if(!isFastPathCompatible())
+                {
+                    return GLB_UNSUPPORTED;
+                }
+
+                const JsonValue& meshes = m_json["meshes"];
+                for(size_t i = 0; i < meshes.size(); i++)
+                {
+                    const JsonValue& meshPrimitives = meshes[i]["primitives"];
+                    for(size_t j = 0; j < meshPrimitives.size(); j++)
+                    {
+                        GlbPrimitive primitive;
+                        if(!loadPrimitive(meshPrimitives[j], primitive))
+                        {
+                            deletePrimitive(primitive);
+                            for(GlbPrimitive& loaded : primitives)
+                            {
+                                deletePrimitive(loaded);
+                            }
+                            primitives.clear();
+                            return GLB_FAILED;
+                        }
+                        primitives.push_back(std::move(primitive));
+                    }
+                }
+
+                return GLB_LOADED;
+            }
+
+            static void deletePrimitive(GlbPrimitive& primitive)
+            {
+                for(GLuint* buffer :
+                    { &primitive.vertexBuffer, &primitive.uvBuffer, &primitive.normalBuffer, &primitive.indexBuffer })
+                {
+                    if(*buffer != -1)
+                    {
+                        RenderBackend::get().deleteBuffer(*buffer);
+                        *buffer = -1;
+                    }
+                }
+            }
+
+        private:
+            /**
+             * @return The JSON number as size, SIZE_MAX for negative, fractional or huge numbers so they fail any
+             * bounds check instead of wrapping around
+             */
+            static size_t readGlbSize(const JsonValue& json)
+            {
+                const double value = json.asNumber();
+                const bool exact = value >= 0.0 && value <= 9007199254740992.0 && std::floor(value) == value;
+                return exact ? size_t(value) : SIZE_MAX;
+            }
+
+            bool fail(const char* reason) const
+            {
+                std::cout << "GLB file [" << m_filePath << "] " << reason << std::endl;
+                return false;
+            }
+
+            bool getAccessor(int accessorIndex, GlbAccessor& accessor) const
+            {
+                const JsonValue& json = m_json["accessors"][size_t(accessorIndex)];
+                if(json.isNull() || json.contains("sparse") || !json.contains("bufferView"))
+                {
+                    return fail("uses a missing or sparse accessor");
+                }
+
+                static const std::pair<const char*, int> TYPES[] = {
+                    { "SCALAR", 1 },
+                    { "VEC2", 2 },
+                    { "VEC3", 3 },
+                    { "VEC4", 4 }
+                };
+                accessor.componentCount = 0;
+                for(const auto& [name, count] : TYPES)
+                {
+                    if(json["type"].asString() == name)
+                    {
+                        accessor.componentCount = count;
+                    }
+                }
+
+                accessor.componentType = GLenum(json["componentType"].asInt());
+                accessor.normalized = json["normalized"].asBool();
+                accessor.count = readGlbSize(json["count"]);
+
+                const size_t componentSize = GlbAccessor::getGlbComponentSize(accessor.componentType);
+                if(componentSize == 0 || accessor.componentCount == 0 || accessor.count == 0)
+                {
+                    return fail("has an accessor of unsupported type");
+                }
+
+                const JsonValue& bufferView = m_json["bufferViews"][size_t(json["bufferView"].asInt())];
+                const size_t viewOffset = readGlbSize(bufferView["byteOffset"]);
+                const size_t viewLength = readGlbSize(bufferView["byteLength"]);
+                const size_t accessorOffset = readGlbSize(json["byteOffset"]);
+
+                accessor.stride = readGlbSize(bufferView["byteStride"]);
+                if(accessor.stride == 0)
+                {
+                    accessor.stride = accessor.getElementSize();
+                }
+
+                // Everything an accessor can reach has to stay inside its view & the view inside the binary chunk.
+                // Written as subtractions, so huge counts or offsets can't overflow past the checks
+                const size_t elementSize = accessor.getElementSize();
+                if(bufferView.isNull() || bufferView["buffer"].asInt() != 0 || viewOffset > m_binSize ||
+                   viewLength > m_binSize - viewOffset || accessor.stride < elementSize ||
+                   accessorOffset % componentSize != 0 || accessorOffset > viewLength ||
+                   elementSize > viewLength - accessorOffset ||
+                   accessor.count - 1 > (viewLength - accessorOffset - elementSize) / accessor.stride)
+                {
+                    return fail("has an accessor out of bounds");
+                }
+
+                accessor.data = m_bin + viewOffset + accessorOffset;
+                return true;
+            }
+
+            static GLuint uploadAttribute(const GlbAccessor& accessor, int components)
+            {
+                if(accessor.componentType == GL_FLOAT && accessor.componentCount == components && accessor.isTightlyPacked())
+                {
+                    return uploadGlbBuffer(accessor.data, accessor.count * accessor.getElementSize());
+                }
+
+                const std::vector<float> converted = convertGlbAttribute(accessor, components);
+                return uploadGlbBuffer(converted.data(), converted.size() * sizeof(float));
+            }
+
+            bool loadPrimitive(const JsonValue& json, GlbPrimitive& primitive) const
+            {
+                const JsonValue& attributes = json["attributes"];
+
+                GlbAccessor positions;
+                if(!getAccessor(attributes["POSITION"].asInt(), positions) || positions.componentCount != 3)
+                {
+                    return false;
+                }
+                primitive.vertexCount = int(positions.count);
+                primitive.vertexBuffer = uploadAttribute(positions, 3);
+
+                // glTF requires min & max on positions, files breaking that just don't get bounds
+                const JsonValue& positionJson = m_json["accessors"][size_t(attributes["POSITION"].asInt())];
+                primitive.hasBounds = positionJson["min"].size() == 3 && positionJson["max"].size() == 3;
+                for(int i = 0; i < 3 && primitive.hasBounds; i++)
+                {
+                    primitive.boundsMin[i] = float(positionJson["min"][size_t(i)].asNumber());
+                    primitive.boundsMax[i] = float(positionJson["max"][size_t(i)].asNumber());
+                }
+
+                GlbAccessor uvs;
+                if(attributes.contains("TEXCOORD_0"))
+                {
+                    if(!getAccessor(attributes["TEXCOORD_0"].asInt(), uvs) || uvs.count != positions.count)
+                    {
+                        return false;
+                    }
+                    primitive.uvBuffer = uploadAttribute(uvs, 2);
+                }
+
+                GlbAccessor normals;
+                if(attributes.contains("NORMAL"))
+                {
+                    if(!getAccessor(attributes["NORMAL"].asInt(), normals) || normals.count != positions.count)
+                    {
+                        return false;
+                    }
+                    primitive.normalBuffer = uploadAttribute(normals, 3);
+                }
+
+                if(json.contains("indices"))
+                {
+                    GlbAccessor indices;
+                    if(!getAccessor(json["indices"].asInt(), indices) || indices.componentCount != 1 ||
+                       indices.count % 3 != 0)
+                    {
+                        return false;
+                    }
+
+                    std::vector<uint16_t> converted;
+                    const uint16_t* indexData = (const uint16_t*)indices.data;
+                    if(indices.componentType != GL_UNSIGNED_SHORT || !indices.isTightlyPacked() ||
+                       uintptr_t(indexData) % alignof(uint16_t) != 0)
+                    {
+                        converted = convertGlbIndices(indices);
+                        indexData = converted.data();
+                    }
+
+                    // 32 bit indices beyond 16 bits have been truncated, which this catches as well
+                    if(indices.componentType == GL_UNSIGNED_INT || getGlbMaxIndex(indexData, indices.count) >= positions.count)
+                    {
+                        for(size_t i = 0; i < indices.count; i++)
+                        {
+                            uint32_t index = indexData[i];
+                            if(indices.componentType == GL_UNSIGNED_INT)
+                            {
+                                memcpy(&index, indices.data + i * indices.stride, sizeof(index));
+                            }
+                            if(index >= positions.count)
+                            {
+                                return fail("has an index out of range");
+                            }
+                        }
+                    }
+
+                    primitive.indexCount = int(indices.count);
+                    primitive.indexBuffer = uploadGlbBuffer(indexData, indices.count * sizeof(uint16_t));
+                }
+                else
+                {
+                    if(positions.count % 3 != 0)
+                    {
+                        return fail("has a non indexed primitive which isn't a triangle list");
+                    }
+
+                    std::vector<uint16_t> sequential(positions.count);
+                    for(size_t i = 0; i < sequential.size(); i++)
+                    {
+                        sequential[i] = uint16_t(i);
+                    }
+                    primitive.indexCount = int(sequential.size());
+                    primitive.indexBuffer = uploadGlbBuffer(sequential.data(), sequential.size() * sizeof(uint16_t));
+                }
+
+                loadMaterial(json["material"].asInt(-1), primitive.material);
+                return true;
+            }
+
+            void loadMaterial(int materialIndex, CookedMaterial& material) const
+            {
+                const JsonValue& json = m_json["materials"][size_t(materialIndex)];
+                if(materialIndex < 0 || json.isNull())
+                {
+                    return;
+                }
+
+                material.name = json["name"].asString();
+
+                const JsonValue& pbr = json["pbrMetallicRoughness"];
+                const JsonValue& baseColor = pbr["baseColorFactor"];
+                if(baseColor.size() == 4)
+                {
+                    material.diffuseColor = glm::vec4(
+                            float(baseColor[size_t(0)].asNumber()),
+                            float(baseColor[1].asNumber()),
+                            float(baseColor[2].asNumber()),
+                            float(baseColor[3].asNumber())
+                    );
+                }
+
+                // Only external images can be used, images embedded in buffer views aren't supported
+                const JsonValue& texture = m_json["textures"][size_t(pbr["baseColorTexture"]["index"].asInt(-1))];
+                const JsonValue& image = m_json["images"][size_t(texture["source"].asInt(-1))];
+                const std::string& uri = image["uri"].asString();
+                if(!uri.empty() && uri.rfind("data:", 0) != 0)
+                {
+                    material.diffuseTexture = uri;
+                }
+            }
+
+            std::string m_filePath;
+            AssetFile m_file; // Mapped in place, unless it is a compressed archive entry
+            JsonValue m_json;
+            const uint8_t* m_bin = nullptr;
+            size_t m_binSize = 0;
+    };
+} // namespace Engine
@@ -0,0 +1,356 @@
+#pragma once
+
+#include <cctype>
+#include <cstdlib>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace Engine
+{
+    /**
+     * @brief A parsed JSON value. Just enough of JSON for asset headers (glTF), not meant for large documents.
+     *
+     * Lookups of missing keys or indices return a null value instead of failing, so optional fields can be read with
+     * a default in one expression.
+     */
+    class JsonValue
+    {
+        public:
+            enum Type
+            {
+                JSON_NULL,
+                JSON_BOOL,
+                JSON_NUMBER,
+                JSON_STRING,
+                JSON_ARRAY,
+                JSON_OBJECT
+            };
+
+            Type getType() const { return m_type; };
+
+            bool isNull() const { return m_type == JSON_NULL; };
+
+            bool isNumber() const { return m_type == JSON_NUMBER; };
+
+            bool isArray() const { return m_type == JSON_ARRAY; };
+
+            bool isObject() const { return m_type == JSON_OBJECT; };
+
+            double asNumber(double defaultValue = 0.0) const { return m_type == JSON_NUMBER ? m_number : defaultValue; };
+
+            int asInt(int defaultValue = 0) const { return m_type == JSON_NUMBER ? int(m_number) : defaultValue; };
+
+            bool asBool(bool defaultValue = false) const { return m_type == JSON_BOOL ? m_bool : defaultValue; };
+
+            const std::string& asString() const { return m_string; };
+
+            /**
+             * @return The amount of elements of an array or members of an object, 0 for every other type.
+             */
+            size_t size() const { return m_values.size(); };
+
+            bool contains(std::string_view key) const { return !(*this)[key].isNull(); };
+
+            const JsonValue& operator[](size_t index) const
+            {
+                return m_type == JSON_ARRAY && index < m_values.size() ? m_values[index] : getNull();
+            }
+
+            const JsonValue& operator[](std::string_view key) const
+            {
+                if(m_type == JSON_OBJECT)
+                {
+                    for(size_t i = 0; i < m_keys.size(); i++)
+                    {
+                        if(m_keys[i] == key)
+                        {
+                            return m_values[i];
+                        }
+                    }
+                }
+                return getNull();
+            }
+
+            /**
+             * Parses a JSON document.
+             *
+             * @param text The document, doesn't need to be null terminated.
+             * @param value The value to store the document in.
+             * @return True if the whole document was valid JSON, false otherwise.
+             */
+            static bool parse(std::string_view text, JsonValue& value)
+            {
+                const char* current = text.data();
+                const char* end = text.data() + text.size();
+                if(!parseValue(current, end, value, 0))
+                {
+                    value = JsonValue();
+                    return false;
+                }
+
+                skipWhitespace(current, end);
+                return current == end || *current == '\0';
+            }
+
+        private:
+            static const JsonValue& getNull()
+            {
+                static const JsonValue NULL_VALUE;
+                return NULL_VALUE;
+            }
+
+            static void skipWhitespace(const char*& current, const char* end)
+            {
+                while(current < end && (*current == ' ' || *current == '\t' || *current == '\n' || *current == '\r'))
+                {
+                    current++;
+                }
+            }
+
+            static bool parseLiteral(const char*& current, const char* end, std::string_view literal)
+            {
+                if(size_t(end - current) < literal.size() || std::string_view(current, literal.size()) != literal)
+                {
+                    return false;
+                }
+                current += literal.size();
+                return true;
+            }
+
+            static bool parseString(const char*& current, const char* end, std::string& string)
+            {
+                // current points at the opening quote
+                current++;
+                string.clear();
+                while(current < end && *current != '"')
+                {
+                    if(*current != '\\')
+                    {
+                        string += *current++;
+                        continue;
+                    }
+
+                    if(++current >= end)
+                    {
+                        return false;
+                    }
+
+                    switch(*current++)
+                    {
+                        case '"':
+                            string += '"';
+                            break;
+                        case '\\':
+                            string += '\\';
+                            break;
+                        case '/':
+                            string += '/';
+                            break;
+                        case 'b':
+                            string += '\b';
+                            break;
+                        case 'f':
+                            string += '\f';
+                            break;
+                        case 'n':
+                            string += '\n';
+                            break;
+                        case 'r':
+                            string += '\r';
+                            break;
+                        case 't':
+                            string += '\t';
+                            break;
+                        case 'u':
+                        {
+                            if(end - current < 4)
+                            {
+                                return false;
+                            }
+                            const unsigned long codePoint = std::strtoul(std::string(current, 4).c_str(), nullptr, 16);
+                            current += 4;
+
+                            // Encoded as UTF-8, surrogate pairs aren't combined
+                            if(codePoint < 0x80)
+                            {
+                                string += char(codePoint);
+                            }
+                            else if(codePoint < 0x800)
+                            {
+                                string += char(0xC0 | (codePoint >> 6));
+                                string += char(0x80 | (codePoint & 0x3F));
+                            }
+                            else
+                            {
+                                string += char(0xE0 | (codePoint >> 12));
+                                string += char(0x80 | ((codePoint >> 6) & 0x3F));
+                                string += char(0x80 | (codePoint & 0x3F));
+                            }
+                            break;
+                        }
+                        default:
+                            return false;
+                    }
+                }
+
+                if(current >= end)
+                {
+                    return false;
+                }
+                current++;
+                return true;
+            }
+
+            static bool parseValue(const char*& current, const char* end, JsonValue& value, int depth)
+            {
+                static constexpr int MAX_DEPTH = 128;
+                if(depth > MAX_DEPTH)
+                {
+                    return false;
+                }
+
+                skipWhitespace(current, end);
+                if(current >= end)
+                {
+                    return false;
+                }
+
+                switch(*current)
+                {
+                    case '{':
+                    {
+                        value.m_type = JSON_OBJECT;
+                        current++;
+                        skipWhitespace(current, end);
+                        if(current < end && *current == '}')
+                        {
+                            current++;
+                            return true;
+                        }
+
+                        while(true)
+                        {
+                            skipWhitespace(current, end);
+                            if(current >= end || *current != '"')
+                            {
+                                return false;
+                            }
+
+                            std::string key;
+                            if(!parseString(current, end, key))
+                            {
+                                return false;
+                            }
+
+                            skipWhitespace(current, end);
+                            if(current >= end || *current++ != ':')
+                            {
+                                return false;
+                            }
+
+                            value.m_keys.push_back(std::move(key));
+                            value.m_values.emplace_back();
+                            if(!parseValue(current, end, value.m_values.back(), depth + 1))
+                            {
+                                return false;
+                            }
+
+                            skipWhitespace(current, end);
+                            if(current >= end)
+                            {
+                                return false;
+                            }
+                            if(*current == '}')
+                            {
+                                current++;
+                                return true;
+                            }
+                            if(*current++ != ',')
+                            {
+                                return false;
+                            }
+                        }
+                    }
+                    case '[':
+                    {
+                        value.m_type = JSON_ARRAY;
+                        current++;
+                        skipWhitespace(current, end);
+                        if(current < end && *current == ']')
+                        {
+                            current++;
+                            return true;
+                        }
+
+                        while(true)
+                        {
+                            value.m_values.emplace_back();
+                            if(!parseValue(current, end, value.m_values.back(), depth + 1))
+                            {
+                                return false;
+                            }
+
+                            skipWhitespace(current, end);
+                            if(current >= end)
+                            {
+                                return false;
+                            }
+                            if(*current == ']')
+                            {
+                                current++;
+                                return true;
+                            }
+                            if(*current++ != ',')
+                            {
+                                return false;
+                            }
+                        }
+                    }
+                    case '"':
+                        value.m_type = JSON_STRING;
+                        return parseString(current, end, value.m_string);
+                    case 't':
+                        value.m_type = JSON_BOOL;
+                        value.m_bool = true;
+                        return parseLiteral(current, end, "true");
+                    case 'f':
+                        value.m_type = JSON_BOOL;
+                        value.m_bool = false;
+                        return parseLiteral(current, end, "false");
+                    case 'n':
+                        value.m_type = JSON_NULL;
+                        return parseLiteral(current, end, "null");
+                    default:
+                    {
+                        // strtod needs a terminated string, numbers are short enough to copy
+                        const char* numberEnd = current;
+                        while(numberEnd < end && (std::isdigit((unsigned char)*numberEnd) || *numberEnd == '-' ||
+                                                  *numberEnd == '+' || *numberEnd == '.' || *numberEnd == 'e' ||
+                                                  *numberEnd == 'E'))
+                        {
+                            numberEnd++;
+                        }
+                        if(numberEnd == current)
+                        {
+                            return false;
+                        }
+
+                        const std::string number(current, numberEnd);
+                        char* parsedEnd = nullptr;
+                        value.m_type = JSON_NUMBER;
+                        value.m_number = std::strtod(number.c_str(), &parsedEnd);
+                        current = numberEnd;
+                        return parsedEnd == number.c_str() + number.size();
+                    }
+                }
+            }
+
+            Type m_type = JSON_NULL;
+            bool m_bool = false;
+            double m_number = 0.0;
+            std::string m_string;
+            std::vector<std::string> m_keys;
+            std::vector<JsonValue> m_values;
+    };
+} // namespace Engine
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Engine
+{
+    /**
+     * @brief A read only memory mapping of a whole file.
+     */
+    class MappedFile
+    {
+        public:
+            MappedFile() = default;
+            MappedFile(const MappedFile&) = delete;
+            MappedFile& operator=(const MappedFile&) = delete;
+
+            ~MappedFile() { close(); }
+
+            /**
+             * @param sequential Hints the OS to read ahead, for files that get read front to back exactly once
+             */
+            bool open(const char* filePath, bool sequential = true)
+            {
+                close();
+#if defined(_WIN32)
+                m_file = CreateFileA(filePath, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+                if(m_file == INVALID_HANDLE_VALUE)
+                {
+                    return false;
+                }
+
+                LARGE_INTEGER fileSize;
+                GetFileSizeEx(m_file, &fileSize);
+                m_size = size_t(fileSize.QuadPart);
+
+                m_mapping = CreateFileMappingA(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+                m_data = m_mapping ? (const uint8_t*)MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+#else
+                m_file = ::open(filePath, O_RDONLY);
+                if(m_file < 0)
+                {
+                    return false;
+                }
+
+                struct stat fileStat;
+                if(fstat(m_file, &fileStat) != 0 || fileStat.st_size == 0)
+                {
+                    close();
+                    return false;
+                }
+                m_size = size_t(fileStat.st_size);
+
+                void* mapping = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, m_file, 0);
+                m_data = mapping == MAP_FAILED ? nullptr : (const uint8_t*)mapping;
+                if(m_data && sequential)
+                {
+                    madvise(mapping, m_size, MADV_SEQUENTIAL);
+                }
+#endif
+                if(m_data == nullptr)
+                {
+                    close();
+                    return false;
+                }
+                return true;
+            }
+
+            void close()
+            {
+#if defined(_WIN32)
+                if(m_data)
+                {
+                    UnmapViewOfFile(m_data);
+                }
+                if(m_mapping)
+                {
+                    CloseHandle(m_mapping);
+                }
+                if(m_file != INVALID_HANDLE_VALUE)
+                {
+                    CloseHandle(m_file);
+                }
+                m_mapping = nullptr;
+                m_file = INVALID_HANDLE_VALUE;
+#else
+                if(m_data)
+                {
+                    munmap((void*)m_data, m_size);
+                }
+                if(m_file >= 0)
+                {
+                    ::close(m_file);
+                }
+                m_file = -1;
+#endif
+                m_data = nullptr;
+                m_size = 0;
+            }
+
+            const uint8_t* data() const { return m_data; };
+
+            size_t size() const { return m_size; };
+
+        private:
+#if defined(_WIN32)
+            HANDLE m_file = INVALID_HANDLE_VALUE;
+            HANDLE m_mapping = nullptr;
+#else
+            int m_file = -1;
+#endif
+            const uint8_t* m_data = nullptr;
+            size_t m_size = 0;
+    };
+} // namespace Engine
@@ -33,6 +33,7 @@ namespace Engine
                 , m_filePath(std::move(filePath))
                 , m_vertexIndices(std::move(vertexIndices))
             {
+                computeBounds();
             }
 
             std::string m_filePath;
@@ -43,9 +44,44 @@ namespace Engine
             std::vector<glm::vec3> m_vertexData;
             std::vector<glm::vec2> m_vertexUvs;
             std::vector<glm::vec3> m_vertexNormals;
+            std::vector<glm::vec4> m_vertexTangents;
+            GLuint m_tangentBuffer = -1;
 
             std::vector<triData> m_vertexIndices;
 
-            int getVertexCount() const { return int(m_vertexIndices.size() * 3); };
+            // Skinned meshes only, the bone indices refer to the bones of the skeleton the mesh was imported with
+            std::vector<glm::uvec4> m_boneIndices;
+            std::vector<glm::vec4> m_boneWeights;
+            GLuint m_boneIndexBuffer = -1;
+            GLuint m_boneWeightBuffer = -1;
+
+            bool isSkinned() const { return m_boneIndexBuffer != -1 && m_boneWeightBuffer != -1; };
+
+            // Objects uploaded straight from a file (GLB fast path) only live on the GPU & have no CPU side data
+            int m_gpuIndexCount = 0;
+
+            bool isGpuOnly() const { return m_vertexIndices.empty() && m_gpuIndexCount > 0; };
+
+            // Bumped whenever a hot reload swaps the data in place, for copies of it to notice
+            unsigned int m_generation = 0;
+
+            int getVertexCount() const { return isGpuOnly() ? m_gpuIndexCount : int(m_vertexIndices.size() * 3); };
+
+            // Local space bounds of the vertices, GPU only objects take them from the file
+            glm::vec3 m_boundsMin = glm::vec3(0.f);
+            glm::vec3 m_boundsMax = glm::vec3(0.f);
+            bool m_hasBounds = false;
+
+            void computeBounds()
+            {
+                m_hasBounds = !m_vertexData.empty();
+                m_boundsMin = m_hasBounds ? m_vertexData[0] : glm::vec3(0.f);
+                m_boundsMax = m_boundsMin;
+                for(const glm::vec3& vertex : m_vertexData)
+                {
+                    m_boundsMin = glm::min(m_boundsMin, vertex);
+                    m_boundsMax = glm::max(m_boundsMax, vertex);
+                }
+            }
     };
 } // namespace Engine
\ No newline at end of file
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <vector>
+
+namespace Engine
+{
+    /**
+     * @brief A texture read into memory, ready to be uploaded. Reading needs no GL context, so it can happen on any
+     * thread.
+     */
+    struct TextureImage
+    {
+            bool valid = false;
+            bool compressed = false;
+            unsigned int width = 0;
+            unsigned int height = 0;
+            unsigned int format = 0;
+            unsigned int mipMapCount = 0;
+            std::vector<unsigned char> data;
+    };
+} // namespace Engine
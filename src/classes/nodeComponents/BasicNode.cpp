@@ -1,16 +1,37 @@
 #include "BasicNode.h"
 
 #include "../engine/EngineManager.h"
-#include "GeometryComponent.h"
-#include "UiDebugWindow.h"
+#include "../engine/NodeLifecycleQueue.h"
+#include "../engine/SceneIndex.h"
 
 #include <iostream>
+#include <unordered_set>
 
 namespace Engine
 {
-    unsigned int BasicNode::LASTID = 0;
+    std::atomic<unsigned int> BasicNode::LASTID = 0;
 
-    BasicNode::BasicNode() : m_parentNode(std::weak_ptr<BasicNode>()) { m_nodeId = getNewUniqueId(); }
+    BasicNode::BasicNode()
+        : m_name(NameTable::EMPTY)
+        , m_parentNode(std::weak_ptr<BasicNode>())
+        , m_indexed(false)
+        , m_started(false)
+    {
+        m_nodeId = getNewUniqueId();
+    }
+
+    unsigned int BasicNode::getNewUniqueId()
+    {
+        thread_local unsigned int nextId = 0;
+        thread_local unsigned int blockEnd = 0;
+        if(nextId == blockEnd)
+        {
+            // IDs start at 1, 0 stands for no node
+            nextId = LASTID.fetch_add(ID_BLOCK_SIZE, std::memory_order_relaxed) + 1;
+            blockEnd = nextId + ID_BLOCK_SIZE;
+        }
+        return nextId++;
+    }
 
     BasicNode::~BasicNode()
     {
@@ -20,19 +41,24 @@ namespace Engine
         }
     }
 
+    void BasicNode::setName(std::string_view name)
+    {
+        const NameId nameId = NameTable::intern(name);
+        if(m_indexed && nameId != m_name)
+        {
+            SingletonManager::get<EngineManager>()->getSceneIndex()->rename(*this, nameId);
+        }
+        m_name = nameId;
+    }
+
     void BasicNode::cleanupNode()
     {
         setParent(nullptr);
 
-        const auto& thisNode = shared_from_this();
-        if(const auto geometry = std::dynamic_pointer_cast<GeometryComponent>(thisNode))
-        {
-            SingletonManager::get<EngineManager>()->removeGeometryFromScene(geometry->getNodeId());
-        }
-        else if(const auto debugUi = std::dynamic_pointer_cast<Ui::UiDebugWindow>(thisNode))
-        {
-            SingletonManager::get<EngineManager>()->removeDebugUiFromScene(debugUi->getNodeId());
-        }
+        // The whole subtree leaves the scene with its root
+        std::unordered_set<unsigned int> nodeIds;
+        callOnAllChildrenRecursiveAndSelf([&nodeIds](BasicNode* node) { nodeIds.insert(node->getNodeId()); });
+        SingletonManager::get<EngineManager>()->removeNodesFromScene(nodeIds);
     }
 
     std::shared_ptr<BasicNode> BasicNode::getChildNode(int pos) const
@@ -45,27 +71,72 @@ namespace Engine
     }
 
     void BasicNode::addChild(const std::shared_ptr<BasicNode>& node)
+    {
+        addChildDetached(node);
+
+        std::vector<std::shared_ptr<BasicNode>> nodes;
+        node->collectDetachedNodes(nodes);
+        SingletonManager::get<EngineManager>()->addNodesToScene(nodes);
+
+        node->startSubtree();
+
+        if(!node->getName().empty())
+        {
+            std::cout << "Object [" << node->getName() << "] initialised" << std::endl;
+        }
+    }
+
+    void BasicNode::addChildDetached(const std::shared_ptr<BasicNode>& node)
     {
         m_childNodes.emplace_back(node);
         node->setParent(shared_from_this());
+    }
 
-        if(auto geometry = std::dynamic_pointer_cast<GeometryComponent>(node))
+    void BasicNode::collectDetachedNodes(std::vector<std::shared_ptr<BasicNode>>& nodes)
+    {
+        if(!m_indexed)
         {
-            SingletonManager::get<EngineManager>()->addGeometryToScene(geometry);
+            nodes.push_back(shared_from_this());
         }
-        else if(auto debugUi = std::dynamic_pointer_cast<Ui::UiDebugWindow>(node))
+        for(const auto& childNode : m_childNodes)
         {
-            SingletonManager::get<EngineManager>()->addDebugUiToScene(debugUi);
+            childNode->collectDetachedNodes(nodes);
         }
+    }
 
-        node->start();
+    void BasicNode::startSubtree()
+    {
+        // Collected first, start() may add children of its own, which get started by their addChild
+        std::vector<std::shared_ptr<BasicNode>> nodes;
+        collectUnstartedNodes(nodes);
 
-        if(!node->getName().empty())
+        for(const auto& node : nodes)
         {
-            std::cout << "Object [" << node->getName() << "] initialised" << std::endl;
+            if(!node->m_started)
+            {
+                node->m_started = true;
+                node->start();
+            }
         }
     }
 
+    void BasicNode::collectUnstartedNodes(std::vector<std::shared_ptr<BasicNode>>& nodes)
+    {
+        if(!m_started)
+        {
+            nodes.push_back(shared_from_this());
+        }
+        for(const auto& childNode : m_childNodes)
+        {
+            childNode->collectUnstartedNodes(nodes);
+        }
+    }
+
+    void BasicNode::addChildDeferred(const std::shared_ptr<BasicNode>& node)
+    {
+        SingletonManager::get<NodeLifecycleQueue>()->queueAddChild(shared_from_this(), node);
+    }
+
     std::shared_ptr<BasicNode> BasicNode::detatchChild(const std::shared_ptr<BasicNode>& node)
     {
         return detatchChild(node->getNodeId());
@@ -93,13 +164,16 @@ namespace Engine
 
     std::vector<std::shared_ptr<BasicNode>> BasicNode::detatchAllChildren()
     {
+        // Collected first, removing the whole subtrees from the scene is then a single pass per registry
+        std::unordered_set<unsigned int> nodeIds;
+        for(const auto& child : m_childNodes)
+        {
+            child->callOnAllChildrenRecursiveAndSelf([&nodeIds](BasicNode* node) { nodeIds.insert(node->getNodeId()); });
+        }
+        SingletonManager::get<EngineManager>()->removeNodesFromScene(nodeIds);
+
         for(const auto& child : m_childNodes)
         {
-            const auto& engineManager = SingletonManager::get<EngineManager>();
-            child->callOnAllChildrenRecursiveAndSelf(
-                    [engineManager](BasicNode* node) -> void { engineManager->removeGeometryFromScene(node); }
-            );
-            child->cleanupNode();
             child->setParent(nullptr);
         }
 
@@ -108,17 +182,28 @@ namespace Engine
 
     void BasicNode::deleteAllChildren() { detatchAllChildren(); }
 
+    void BasicNode::deleteAllChildrenDeferred()
+    {
+        const auto& lifecycleQueue = SingletonManager::get<NodeLifecycleQueue>();
+        for(const auto& child : m_childNodes)
+        {
+            lifecycleQueue->queueDestroy(child);
+        }
+    }
+
     void BasicNode::detatchFromParent()
     {
-        const auto& engineManager = SingletonManager::get<EngineManager>();
-        callOnAllChildrenRecursiveAndSelf(
-                [engineManager](BasicNode* node) -> void { engineManager->removeGeometryFromScene(node); }
-        );
+        std::unordered_set<unsigned int> nodeIds;
+        callOnAllChildrenRecursiveAndSelf([&nodeIds](BasicNode* node) { nodeIds.insert(node->getNodeId()); });
+        SingletonManager::get<EngineManager>()->removeNodesFromScene(nodeIds);
+
         setParent(nullptr);
     }
 
     void BasicNode::deleteNode() { detatchFromParent(); }
 
+    void BasicNode::deleteNodeDeferred() { SingletonManager::get<NodeLifecycleQueue>()->queueDestroy(shared_from_this()); }
+
     void BasicNode::callOnAllChildren(const std::function<void(BasicNode*)>& func)
     {
         for(const auto& childNode : m_childNodes)
@@ -1,9 +1,11 @@
 #pragma once
 
+#include "../engine/NameTable.h"
 #include "TransformComponent.h"
 
+#include <atomic>
 #include <string>
-#include <utility>
+#include <string_view>
 #include <vector>
 
 namespace Engine
@@ -57,14 +59,21 @@ namespace Engine
              *
              * @param name The name of the node.
              */
-            void setName(std::string name) { m_name = std::move(name); };
+            void setName(std::string_view name);
 
             /**
              * @brief Gets the name of the node.
              *
-             * @return The name of the node.
+             * @return The name of the node, interned in the NameTable.
              */
-            std::string getName() const { return m_name; };
+            const std::string& getName() const { return NameTable::getString(m_name); };
+
+            /**
+             * @brief Gets the interned name of the node, cheap to compare & hash.
+             *
+             * @return The NameTable id of the name of the node.
+             */
+            NameId getNameId() const { return m_name; };
 
             /**
              * @brief Sets the parent node of this node.
@@ -74,12 +83,46 @@ namespace Engine
             void setParent(const std::shared_ptr<BasicNode> node) { m_parentNode = node; };
 
             /**
-             * @brief Adds a child node to this node.
+             * @brief Adds a child node to this node. Children the node got through addChildDetached join the scene
+             * with it, registered in one bulk add & started parents first, see startSubtree. Has to be called on the
+             * main thread.
              *
              * @param node The child node to add.
              */
             void addChild(const std::shared_ptr<BasicNode>& node);
 
+            /**
+             * @brief Only links the child to this node, without registering it with the engine or starting it.
+             *
+             * Touches no engine state, so whole subtrees can be built on worker threads, one thread per subtree.
+             * The subtree joins the scene once its root gets added with addChild, addChildDeferred or as the scene.
+             * This node must not be part of the scene itself.
+             *
+             * @param node The child node to link.
+             */
+            void addChildDetached(const std::shared_ptr<BasicNode>& node);
+
+            /**
+             * @brief Appends this node & all nodes below it that aren't registered with the engine, parents before
+             * their children.
+             */
+            void collectDetachedNodes(std::vector<std::shared_ptr<BasicNode>>& nodes);
+
+            /**
+             * @brief Calls start() on this node & every node below it that was never started, parents before their
+             * children. Nodes that were started before, like a detached subtree that gets attached again, keep their
+             * state & don't create their children a second time.
+             */
+            void startSubtree();
+
+            /**
+             * @brief Queues adding a child node, applied together with all other queued adds at the start of the next
+             * update. Use this when adding many nodes at once.
+             *
+             * @param node The child node to add.
+             */
+            void addChildDeferred(const std::shared_ptr<BasicNode>& node);
+
             /**
              * @brief Detatches a child node from this node.
              *
@@ -116,6 +159,11 @@ namespace Engine
              */
             void deleteAllChildren();
 
+            /**
+             * @brief Queues deleting all the child nodes of this node, see deleteNodeDeferred.
+             */
+            void deleteAllChildrenDeferred();
+
             /**
              * @brief Detatches this node from its parents.
              */
@@ -126,6 +174,12 @@ namespace Engine
              */
             void deleteNode();
 
+            /**
+             * @brief Queues deleting this node and all its children. They leave the scene at the start of the next
+             * update & get released over the following frames, references kept elsewhere lose their children.
+             */
+            void deleteNodeDeferred();
+
             /**
              * @brief Gets the parent node of this node.
              *
@@ -272,14 +326,36 @@ namespace Engine
              */
             unsigned int getNodeId() const { return m_nodeId; }
 
+            /**
+             * @return Whether the node is registered with the engine, i.e. not part of a detached subtree.
+             */
+            bool isInScene() const { return m_indexed; }
+
         private:
-            std::string m_name;
+            friend class NodeLifecycleQueue;
+            friend class SceneIndex;
+
+            void collectUnstartedNodes(std::vector<std::shared_ptr<BasicNode>>& nodes);
+
+            NameId m_name;
             std::weak_ptr<BasicNode> m_parentNode;
             std::vector<std::shared_ptr<BasicNode>> m_childNodes;
             unsigned int m_nodeId;
 
-            static unsigned int LASTID;
+            // Set while the SceneIndex holds the node, only renames of indexed nodes have to reach it
+            bool m_indexed;
+            // Unlike m_indexed kept when the node leaves the scene, start() only ever runs once
+            bool m_started;
+
+            // Scenes get constructed on the ThreadPool while the main thread creates nodes as well
+            static std::atomic<unsigned int> LASTID;
+
+            /**
+             * @brief Every thread takes its IDs from a block of its own, threads building subtrees in parallel only
+             * share the counter once per block.
+             */
+            static unsigned int getNewUniqueId();
 
-            static unsigned int getNewUniqueId() { return ++LASTID; }
+            static constexpr unsigned int ID_BLOCK_SIZE = 256;
     };
 } // namespace Engine
\ No newline at end of file
@@ -0,0 +1,99 @@
+#include "ColliderComponent.h"
+
+#include "GeometryComponent.h"
+
+using namespace Engine;
+
+ColliderComponent::ColliderComponent()
+    : m_bodyId(INVALID_COLLISION_BODY)
+    , m_boundsMin(glm::vec3(-0.5f))
+    , m_boundsMax(glm::vec3(0.5f))
+    , m_useGeometryBounds(true)
+    , m_layer(1)
+    , m_mask(UINT32_MAX)
+{
+}
+
+void ColliderComponent::setBounds(const glm::vec3& min, const glm::vec3& max)
+{
+    m_boundsMin = min;
+    m_boundsMax = max;
+    m_useGeometryBounds = false;
+}
+
+void ColliderComponent::setCollisionLayer(uint32_t layer)
+{
+    m_layer = layer;
+    if(m_bodyId != INVALID_COLLISION_BODY)
+    {
+        SingletonManager::get<CollisionWorld>()->setLayer(m_bodyId, m_layer, m_mask);
+    }
+}
+
+void ColliderComponent::setCollisionMask(uint32_t mask)
+{
+    m_mask = mask;
+    if(m_bodyId != INVALID_COLLISION_BODY)
+    {
+        SingletonManager::get<CollisionWorld>()->setLayer(m_bodyId, m_layer, m_mask);
+    }
+}
+
+void ColliderComponent::getOverlappingNodes(std::vector<unsigned int>& nodeIds) const
+{
+    if(m_bodyId == INVALID_COLLISION_BODY)
+    {
+        return;
+    }
+
+    const auto& collisionWorld = SingletonManager::get<CollisionWorld>();
+    std::vector<CollisionBodyId> overlaps;
+    collisionWorld->getOverlaps(m_bodyId, overlaps);
+    for(const CollisionBodyId body : overlaps)
+    {
+        nodeIds.push_back(collisionWorld->getUserId(body));
+    }
+}
+
+void ColliderComponent::createCollisionBody()
+{
+    if(m_bodyId == INVALID_COLLISION_BODY)
+    {
+        m_bodyId = SingletonManager::get<CollisionWorld>()->addBody(m_boundsMin, m_boundsMax, m_layer, m_mask, getNodeId());
+    }
+}
+
+void ColliderComponent::destroyCollisionBody()
+{
+    if(m_bodyId != INVALID_COLLISION_BODY)
+    {
+        SingletonManager::get<CollisionWorld>()->removeBody(m_bodyId);
+        m_bodyId = INVALID_COLLISION_BODY;
+    }
+}
+
+void ColliderComponent::syncCollisionBody()
+{
+    if(m_bodyId == INVALID_COLLISION_BODY)
+    {
+        return;
+    }
+
+    glm::vec3 min = m_boundsMin;
+    glm::vec3 max = m_boundsMax;
+    if(m_useGeometryBounds)
+    {
+        // Looked up every frame, the object data may get swapped by a hot reload or a skinned mesh
+        const auto* geometry = dynamic_cast<const GeometryComponent*>(this);
+        const auto& objectData = geometry ? geometry->getObjectData() : nullptr;
+        if(objectData && objectData->m_hasBounds)
+        {
+            min = objectData->m_boundsMin;
+            max = objectData->m_boundsMax;
+        }
+    }
+
+    const auto& collisionWorld = SingletonManager::get<CollisionWorld>();
+    collisionWorld->setLocalBounds(m_bodyId, min, max);
+    collisionWorld->setTransform(m_bodyId, getGlobalModelMatrix());
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "../engine/collision/CollisionWorld.h"
+#include "BasicNode.h"
+
+#include <cstdint>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+namespace Engine
+{
+    /**
+     * @brief Gives a node a body in the CollisionWorld, following the global transform of the node.
+     *
+     * Combined with a GeometryComponent the box defaults to the bounds of its object data, otherwise or after
+     * setBounds the given box is used. The EngineManager moves all colliders after the update of the scene & runs the
+     * broadphase, overlaps can be read from lateUpdate on or in the update of the next frame.
+     */
+    class ColliderComponent : virtual public BasicNode
+    {
+        public:
+            ColliderComponent();
+            ~ColliderComponent() = default;
+
+            /**
+             * @brief Sets the box of the collider in the space of the node, replacing the bounds of the geometry.
+             */
+            void setBounds(const glm::vec3& min, const glm::vec3& max);
+
+            /**
+             * @brief Goes back to using the bounds of the object data, if the node has geometry.
+             */
+            void useGeometryBounds() { m_useGeometryBounds = true; };
+
+            uint32_t getCollisionLayer() const { return m_layer; };
+
+            /**
+             * @brief Sets the layer bits this collider is on.
+             */
+            void setCollisionLayer(uint32_t layer);
+
+            uint32_t getCollisionMask() const { return m_mask; };
+
+            /**
+             * @brief Sets the layer bits this collider reports overlaps with.
+             */
+            void setCollisionMask(uint32_t mask);
+
+            CollisionBodyId getBodyId() const { return m_bodyId; };
+
+            /**
+             * @brief Appends the node ids of all colliders overlapping this one in the last broadphase.
+             */
+            void getOverlappingNodes(std::vector<unsigned int>& nodeIds) const;
+
+            /**
+             * @brief Adds the body to the collision world, called when the node gets added to the scene.
+             */
+            void createCollisionBody();
+
+            /**
+             * @brief Removes the body from the collision world, called when the node leaves the scene.
+             */
+            void destroyCollisionBody();
+
+            /**
+             * @brief Moves the body to the current global transform. Only touches its own body, so all colliders can be
+             * synced in parallel.
+             */
+            void syncCollisionBody();
+
+        private:
+            CollisionBodyId m_bodyId;
+            glm::vec3 m_boundsMin;
+            glm::vec3 m_boundsMax;
+            bool m_useGeometryBounds;
+            uint32_t m_layer;
+            uint32_t m_mask;
+    };
+} // namespace Engine
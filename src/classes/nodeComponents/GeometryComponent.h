@@ -2,6 +2,7 @@
 
 #include "../engine/EngineManager.h"
 #include "../engine/rendering/RenderManager.h"
+#include "../engine/rendering/backend/RenderBackend.h"
 #include "../helper/ObjectData.h"
 #include "BasicNode.h"
 #include "CameraComponent.h"
@@ -30,6 +31,8 @@ namespace Engine
                 , m_isTranslucent(false)
                 , m_customIndexBuffer(0)
                 , m_customVertexIndices(std::vector<triData>())
+                , m_sortedObjectData(nullptr)
+                , m_sortedGeneration(0)
             {
                 setIsTranslucent(m_tint.w < 1.f);
             }
@@ -62,7 +65,11 @@ namespace Engine
              * @brief Set the object data for the geometry.
              * @param objData A shared pointer to the ObjectData.
              */
-            void setObjectData(std::shared_ptr<ObjectData> objData) { m_objectData = std::move(objData); };
+            void setObjectData(std::shared_ptr<ObjectData> objData)
+            {
+                m_objectData = std::move(objData);
+                m_sortedObjectData = nullptr;
+            };
 
             /**
              * @brief Get the texture buffer ID associated with the geometry.
@@ -102,9 +109,18 @@ namespace Engine
 
             void depthSortTriangles()
             {
-                if(m_customVertexIndices.empty())
+                // Without CPU side triangles there is nothing to sort, the object gets drawn in file order
+                if(m_objectData->isGpuOnly())
+                {
+                    return;
+                }
+
+                // The object data may have been replaced or swapped in place by a hot reload
+                if(m_sortedObjectData != m_objectData.get() || m_sortedGeneration != m_objectData->m_generation)
                 {
                     m_customVertexIndices = m_objectData->m_vertexIndices;
+                    m_sortedObjectData = m_objectData.get();
+                    m_sortedGeneration = m_objectData->m_generation;
                 }
 
                 const auto& cameraPos = SingletonManager::get<EngineManager>()->getCamera()->getGlobalPosition();
@@ -118,23 +134,17 @@ namespace Engine
                         { return depthSortTrianglesAlgorithm(cameraPos, nodePos, vertices, a, b); }
                 );
 
+                RenderBackend& backend = RenderBackend::get();
                 unsigned int dataSize = m_customVertexIndices.size() * sizeof(triData);
                 if(m_customIndexBuffer == 0)
                 {
                     // Generate a buffer with our identifier
-                    glGenBuffers(1, &m_customIndexBuffer);
-                    glBindBuffer(GL_ARRAY_BUFFER, m_customIndexBuffer);
-
-                    // Give vertices to OpenGL
-                    glBufferData(GL_ARRAY_BUFFER, dataSize, &m_customVertexIndices[0], GL_STATIC_DRAW);
-                }
-                else
-                {
-                    glBindBuffer(GL_ARRAY_BUFFER, m_customIndexBuffer);
-                    // Give vertices to OpenGL
-                    glBufferData(GL_ARRAY_BUFFER, dataSize, &m_customVertexIndices[0], GL_STATIC_DRAW);
+                    m_customIndexBuffer = backend.createBuffer();
                 }
-                // glFinish();
+                backend.bindBuffer(GL_ARRAY_BUFFER, m_customIndexBuffer);
+
+                // Give vertices to OpenGL
+                backend.bufferData(GL_ARRAY_BUFFER, dataSize, &m_customVertexIndices[0], GL_STATIC_DRAW);
             }
 
             /**
@@ -143,7 +153,7 @@ namespace Engine
              */
             GLuint getIndexBuffer() const
             {
-                if(m_isTranslucent)
+                if(m_isTranslucent && m_customIndexBuffer != 0)
                 {
                     return m_customIndexBuffer;
                 }
@@ -160,6 +170,9 @@ namespace Engine
 
             GLuint m_customIndexBuffer;
             std::vector<triData> m_customVertexIndices;
+            // The object data the sorted indices were copied from
+            const ObjectData* m_sortedObjectData;
+            unsigned int m_sortedGeneration;
     };
 
 } // namespace Engine
@@ -0,0 +1,387 @@
+#include "ParticleEmitter.h"
+
+#include "../engine/ThreadPool.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+
+#include <glm/glm.hpp>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ENGINE_PARTICLES_SSE2 1
+#endif
+
+using namespace Engine;
+
+namespace
+{
+    uint32_t packColor(float r, float g, float b, float a)
+    {
+        const auto toByte = [](float value) { return uint32_t(std::clamp(value, 0.f, 1.f) * 255.f + 0.5f); };
+        return toByte(r) | (toByte(g) << 8) | (toByte(b) << 16) | (toByte(a) << 24);
+    }
+
+    /**
+     * @brief Maps a float onto an unsigned integer with the same order, so depths can be radix sorted.
+     */
+    uint32_t toSortableKey(float value)
+    {
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        return bits ^ ((bits & 0x80000000u) ? 0xFFFFFFFFu : 0x80000000u);
+    }
+} // namespace
+
+ParticleEmitter::ParticleEmitter()
+    : m_particleCount(0)
+    , m_drawOrderValid(false)
+    , m_maxParticles(0)
+    , m_emitting(true)
+    , m_emissionRate(100.f)
+    , m_emissionAccumulator(0.f)
+    , m_emissionRadius(0.f)
+    , m_minLifetime(1.f)
+    , m_maxLifetime(2.f)
+    , m_minSpeed(1.f)
+    , m_maxSpeed(2.f)
+    , m_spread(0.3f)
+    , m_gravity(glm::vec3(0.f, -9.81f, 0.f))
+    , m_drag(0.f)
+    , m_startSize(0.1f)
+    , m_endSize(0.1f)
+    , m_startColor(glm::vec4(1.f))
+    , m_endColor(glm::vec4(1.f, 1.f, 1.f, 0.f))
+    , m_blendMode(PARTICLE_BLEND_ALPHA)
+    , m_sorted(true)
+    , m_randomState(0x9E3779B9u ^ getNodeId())
+{
+    setMaxParticles(10000);
+}
+
+void ParticleEmitter::setMaxParticles(unsigned int maxParticles)
+{
+    m_maxParticles = maxParticles;
+    m_particleCount = std::min(m_particleCount, size_t(maxParticles));
+
+    for(std::vector<float>* data : { &m_positionX,
+                                     &m_positionY,
+                                     &m_positionZ,
+                                     &m_velocityX,
+                                     &m_velocityY,
+                                     &m_velocityZ,
+                                     &m_age,
+                                     &m_ageRate })
+    {
+        data->resize(maxParticles);
+    }
+    m_drawOrderValid = false;
+}
+
+void ParticleEmitter::setLifetime(float minLifetime, float maxLifetime)
+{
+    m_minLifetime = std::max(minLifetime, 0.001f);
+    m_maxLifetime = std::max(maxLifetime, m_minLifetime);
+}
+
+void ParticleEmitter::setSpeed(float minSpeed, float maxSpeed)
+{
+    m_minSpeed = minSpeed;
+    m_maxSpeed = std::max(maxSpeed, minSpeed);
+}
+
+void ParticleEmitter::setSize(float startSize, float endSize)
+{
+    m_startSize = startSize;
+    m_endSize = endSize;
+}
+
+void ParticleEmitter::setColor(const glm::vec4& startColor, const glm::vec4& endColor)
+{
+    m_startColor = startColor;
+    m_endColor = endColor;
+}
+
+void ParticleEmitter::simulate(float deltaTime)
+{
+    m_drawOrderValid = false;
+
+    const float drag = std::max(1.f - m_drag * deltaTime, 0.f);
+    const glm::vec3 gravityStep = m_gravity * deltaTime;
+
+    SingletonManager::get<ThreadPool>()->parallelFor(
+            m_particleCount,
+            [this, deltaTime, drag, gravityStep](size_t begin, size_t end)
+            {
+                size_t i = begin;
+#if defined(ENGINE_PARTICLES_SSE2)
+                const __m128 dt = _mm_set1_ps(deltaTime);
+                const __m128 dragFactor = _mm_set1_ps(drag);
+                const __m128 gravityX = _mm_set1_ps(gravityStep.x);
+                const __m128 gravityY = _mm_set1_ps(gravityStep.y);
+                const __m128 gravityZ = _mm_set1_ps(gravityStep.z);
+
+                for(; i + 4 <= end; i += 4)
+                {
+                    const __m128 age = _mm_add_ps(_mm_loadu_ps(&m_age[i]), _mm_mul_ps(_mm_loadu_ps(&m_ageRate[i]), dt));
+                    _mm_storeu_ps(&m_age[i], age);
+
+                    const __m128 velocityX = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(&m_velocityX[i]), dragFactor), gravityX);
+                    const __m128 velocityY = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(&m_velocityY[i]), dragFactor), gravityY);
+                    const __m128 velocityZ = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(&m_velocityZ[i]), dragFactor), gravityZ);
+                    _mm_storeu_ps(&m_velocityX[i], velocityX);
+                    _mm_storeu_ps(&m_velocityY[i], velocityY);
+                    _mm_storeu_ps(&m_velocityZ[i], velocityZ);
+
+                    _mm_storeu_ps(&m_positionX[i], _mm_add_ps(_mm_loadu_ps(&m_positionX[i]), _mm_mul_ps(velocityX, dt)));
+                    _mm_storeu_ps(&m_positionY[i], _mm_add_ps(_mm_loadu_ps(&m_positionY[i]), _mm_mul_ps(velocityY, dt)));
+                    _mm_storeu_ps(&m_positionZ[i], _mm_add_ps(_mm_loadu_ps(&m_positionZ[i]), _mm_mul_ps(velocityZ, dt)));
+                }
+#endif
+                for(; i < end; i++)
+                {
+                    m_age[i] += m_ageRate[i] * deltaTime;
+                    m_velocityX[i] = m_velocityX[i] * drag + gravityStep.x;
+                    m_velocityY[i] = m_velocityY[i] * drag + gravityStep.y;
+                    m_velocityZ[i] = m_velocityZ[i] * drag + gravityStep.z;
+                    m_positionX[i] += m_velocityX[i] * deltaTime;
+                    m_positionY[i] += m_velocityY[i] * deltaTime;
+                    m_positionZ[i] += m_velocityZ[i] * deltaTime;
+                }
+            },
+            SIMULATION_CHUNK_SIZE
+    );
+
+    removeDeadParticles();
+
+    if(m_emitting)
+    {
+        m_emissionAccumulator += m_emissionRate * deltaTime;
+        const float emitCount = std::floor(m_emissionAccumulator);
+        m_emissionAccumulator -= emitCount;
+        emit((unsigned int)emitCount);
+    }
+}
+
+void ParticleEmitter::burst(unsigned int count)
+{
+    emit(count);
+    m_drawOrderValid = false;
+}
+
+void ParticleEmitter::removeDeadParticles()
+{
+    size_t i = 0;
+    while(i < m_particleCount)
+    {
+        if(m_age[i] < 1.f)
+        {
+            i++;
+            continue;
+        }
+
+        const size_t last = --m_particleCount;
+        m_positionX[i] = m_positionX[last];
+        m_positionY[i] = m_positionY[last];
+        m_positionZ[i] = m_positionZ[last];
+        m_velocityX[i] = m_velocityX[last];
+        m_velocityY[i] = m_velocityY[last];
+        m_velocityZ[i] = m_velocityZ[last];
+        m_age[i] = m_age[last];
+        m_ageRate[i] = m_ageRate[last];
+    }
+}
+
+void ParticleEmitter::emit(unsigned int count)
+{
+    count = (unsigned int)std::min(size_t(count), m_maxParticles - m_particleCount);
+    if(count == 0)
+    {
+        return;
+    }
+
+    const glm::vec3 origin = getGlobalPosition();
+    const glm::vec3 up = getUp();
+
+    for(unsigned int n = 0; n < count; n++)
+    {
+        const glm::vec3 random =
+                glm::vec3(getRandom() * 2.f - 1.f, getRandom() * 2.f - 1.f, getRandom() * 2.f - 1.f);
+        const glm::vec3 position = origin + random * m_emissionRadius;
+
+        glm::vec3 direction = up + random * m_spread;
+        const float length = glm::length(direction);
+        direction = length > 0.f ? direction / length : up;
+        const glm::vec3 velocity = direction * (m_minSpeed + (m_maxSpeed - m_minSpeed) * getRandom());
+
+        const size_t i = m_particleCount++;
+        m_positionX[i] = position.x;
+        m_positionY[i] = position.y;
+        m_positionZ[i] = position.z;
+        m_velocityX[i] = velocity.x;
+        m_velocityY[i] = velocity.y;
+        m_velocityZ[i] = velocity.z;
+        m_age[i] = 0.f;
+        m_ageRate[i] = 1.f / (m_minLifetime + (m_maxLifetime - m_minLifetime) * getRandom());
+    }
+}
+
+float ParticleEmitter::getRandom()
+{
+    // xorshift32, cheap & good enough for visual randomness
+    m_randomState ^= m_randomState << 13;
+    m_randomState ^= m_randomState >> 17;
+    m_randomState ^= m_randomState << 5;
+    return float(m_randomState >> 8) * (1.f / 16777216.f);
+}
+
+void ParticleEmitter::sortByDepth(const glm::vec3& cameraPosition, const glm::vec3& viewDirection)
+{
+    const size_t count = m_particleCount;
+    m_sortEntries.resize(count);
+    m_sortScratch.resize(count);
+    m_drawOrder.resize(count);
+
+    // Inverted keys, so the farthest particle comes first
+    SingletonManager::get<ThreadPool>()->parallelFor(
+            count,
+            [this, &cameraPosition, &viewDirection](size_t begin, size_t end)
+            {
+                for(size_t i = begin; i < end; i++)
+                {
+                    const float depth = (m_positionX[i] - cameraPosition.x) * viewDirection.x +
+                                        (m_positionY[i] - cameraPosition.y) * viewDirection.y +
+                                        (m_positionZ[i] - cameraPosition.z) * viewDirection.z;
+                    m_sortEntries[i] = (uint64_t(~toSortableKey(depth)) << 32) | uint64_t(i);
+                }
+            },
+            SIMULATION_CHUNK_SIZE
+    );
+
+    // LSD radix sort over the 32 key bits, 3 passes of 11 bits. The histograms of all passes are counted at once
+    constexpr int DIGIT_BITS = 11;
+    constexpr int PASS_COUNT = 3;
+    constexpr size_t BUCKET_COUNT = size_t(1) << DIGIT_BITS;
+    std::array<std::array<size_t, BUCKET_COUNT>, PASS_COUNT> offsets {};
+    for(size_t i = 0; i < count; i++)
+    {
+        const uint32_t key = uint32_t(m_sortEntries[i] >> 32);
+        for(int pass = 0; pass < PASS_COUNT; pass++)
+        {
+            offsets[pass][(key >> (pass * DIGIT_BITS)) & (BUCKET_COUNT - 1)]++;
+        }
+    }
+
+    for(int pass = 0; pass < PASS_COUNT; pass++)
+    {
+        size_t sum = 0;
+        for(size_t& offset : offsets[pass])
+        {
+            const size_t bucketSize = offset;
+            offset = sum;
+            sum += bucketSize;
+        }
+
+        const int shift = 32 + pass * DIGIT_BITS;
+        for(size_t i = 0; i < count; i++)
+        {
+            m_sortScratch[offsets[pass][(m_sortEntries[i] >> shift) & (BUCKET_COUNT - 1)]++] = m_sortEntries[i];
+        }
+        m_sortEntries.swap(m_sortScratch);
+    }
+
+    for(size_t i = 0; i < count; i++)
+    {
+        m_drawOrder[i] = uint32_t(m_sortEntries[i]);
+    }
+    m_drawOrderValid = true;
+}
+
+void ParticleEmitter::writeInstances(glm::vec4* positionSize, uint32_t* colors) const
+{
+    const uint32_t* order = m_drawOrderValid && m_drawOrder.size() == m_particleCount ? m_drawOrder.data() : nullptr;
+
+    SingletonManager::get<ThreadPool>()->parallelFor(
+            m_particleCount,
+            [this, positionSize, colors, order](size_t begin, size_t end)
+            {
+                size_t i = begin;
+#if defined(ENGINE_PARTICLES_SSE2)
+                const auto load = [order](const std::vector<float>& data, size_t index)
+                {
+                    if(!order)
+                    {
+                        return _mm_loadu_ps(&data[index]);
+                    }
+                    return _mm_setr_ps(
+                            data[order[index]],
+                            data[order[index + 1]],
+                            data[order[index + 2]],
+                            data[order[index + 3]]
+                    );
+                };
+
+                const __m128 zero = _mm_setzero_ps();
+                const __m128 one = _mm_set1_ps(1.f);
+                const __m128 startSize = _mm_set1_ps(m_startSize);
+                const __m128 sizeRange = _mm_set1_ps(m_endSize - m_startSize);
+                const __m128 scale = _mm_set1_ps(255.f);
+                std::array<__m128, 4> startColor;
+                std::array<__m128, 4> colorRange;
+                for(int channel = 0; channel < 4; channel++)
+                {
+                    startColor[channel] = _mm_set1_ps(m_startColor[channel]);
+                    colorRange[channel] = _mm_set1_ps(m_endColor[channel] - m_startColor[channel]);
+                }
+
+                for(; i + 4 <= end; i += 4)
+                {
+                    const __m128 t = _mm_min_ps(load(m_age, i), one);
+
+                    // 4 particles x (x, y, z, size) transposed into 4 vec4s
+                    __m128 x = load(m_positionX, i);
+                    __m128 y = load(m_positionY, i);
+                    __m128 z = load(m_positionZ, i);
+                    __m128 size = _mm_add_ps(startSize, _mm_mul_ps(sizeRange, t));
+                    _MM_TRANSPOSE4_PS(x, y, z, size);
+                    _mm_storeu_ps(&positionSize[i].x, x);
+                    _mm_storeu_ps(&positionSize[i + 1].x, y);
+                    _mm_storeu_ps(&positionSize[i + 2].x, z);
+                    _mm_storeu_ps(&positionSize[i + 3].x, size);
+
+                    std::array<__m128i, 4> channels;
+                    for(int channel = 0; channel < 4; channel++)
+                    {
+                        const __m128 value = _mm_add_ps(startColor[channel], _mm_mul_ps(colorRange[channel], t));
+                        channels[channel] = _mm_cvtps_epi32(_mm_mul_ps(_mm_max_ps(_mm_min_ps(value, one), zero), scale));
+                    }
+
+                    // Bytes R0-3 B0-3 G0-3 A0-3, interleaved twice into R G B A per particle
+                    const __m128i packed = _mm_packus_epi16(
+                            _mm_packs_epi32(channels[0], channels[2]),
+                            _mm_packs_epi32(channels[1], channels[3])
+                    );
+                    const __m128i pairs = _mm_unpacklo_epi8(packed, _mm_srli_si128(packed, 8));
+                    _mm_storeu_si128((__m128i*)&colors[i], _mm_unpacklo_epi16(pairs, _mm_srli_si128(pairs, 8)));
+                }
+#endif
+                for(; i < end; i++)
+                {
+                    const size_t index = order ? order[i] : i;
+                    const float t = std::min(m_age[index], 1.f);
+                    positionSize[i] = glm::vec4(
+                            m_positionX[index],
+                            m_positionY[index],
+                            m_positionZ[index],
+                            m_startSize + (m_endSize - m_startSize) * t
+                    );
+
+                    const glm::vec4 color = m_startColor + (m_endColor - m_startColor) * t;
+                    colors[i] = packColor(color.x, color.y, color.z, color.w);
+                }
+            },
+            SIMULATION_CHUNK_SIZE
+    );
+}
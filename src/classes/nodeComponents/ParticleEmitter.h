@@ -0,0 +1,169 @@
+#pragma once
+
+#include "BasicNode.h"
+
+#include <cstdint>
+#include <vector>
+
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+
+namespace Engine
+{
+    enum ParticleBlendMode
+    {
+        PARTICLE_BLEND_ALPHA,   // Needs depth sorting to look right
+        PARTICLE_BLEND_ADDITIVE // Order independent, never sorted
+    };
+
+    /**
+     * @brief Spawns particles at the nodes transform & simulates them in world space.
+     *
+     * Particles are kept as structure of arrays, so the simulation & the instance upload run 4 particles at a time
+     * with SSE, split over the ThreadPool. Dead particles are swapped with the last one, the arrays stay packed.
+     * All emitters get simulated by the EngineManager after the update of the scene and drawn as camera facing quads
+     * with one instanced draw call each, after the translucent geometry.
+     */
+    class ParticleEmitter : virtual public BasicNode
+    {
+        public:
+            ParticleEmitter();
+            ~ParticleEmitter() = default;
+
+            /**
+             * @brief Ages, moves & removes particles, then emits new ones for this frame.
+             */
+            void simulate(float deltaTime);
+
+            /**
+             * @brief Emits particles right away, independent from the emission rate.
+             */
+            void burst(unsigned int count);
+
+            void clearParticles() { m_particleCount = 0; };
+
+            /**
+             * @brief Sorts the particles back to front along the view direction, for alpha blending.
+             */
+            void sortByDepth(const glm::vec3& cameraPosition, const glm::vec3& viewDirection);
+
+            /**
+             * @brief Writes the instance data of all particles, in draw order.
+             *
+             * @param positionSize Receives position & size per particle.
+             * @param colors Receives the color per particle as normalized RGBA8.
+             */
+            void writeInstances(glm::vec4* positionSize, uint32_t* colors) const;
+
+            size_t getParticleCount() const { return m_particleCount; };
+
+            unsigned int getMaxParticles() const { return m_maxParticles; };
+
+            void setMaxParticles(unsigned int maxParticles);
+
+            bool isEmitting() const { return m_emitting; };
+
+            void setEmitting(bool emitting) { m_emitting = emitting; };
+
+            /**
+             * @brief Particles emitted per second.
+             */
+            float getEmissionRate() const { return m_emissionRate; };
+
+            void setEmissionRate(float rate) { m_emissionRate = rate; };
+
+            /**
+             * @brief Particles spawn within a sphere of this radius around the node.
+             */
+            float getEmissionRadius() const { return m_emissionRadius; };
+
+            void setEmissionRadius(float radius) { m_emissionRadius = radius; };
+
+            void setLifetime(float minLifetime, float maxLifetime);
+
+            /**
+             * @brief Particles start moving along the nodes up direction with a random speed in the given range.
+             */
+            void setSpeed(float minSpeed, float maxSpeed);
+
+            /**
+             * @brief How far the start direction may deviate from the nodes up direction, 0 being none.
+             */
+            float getSpread() const { return m_spread; };
+
+            void setSpread(float spread) { m_spread = spread; };
+
+            glm::vec3 getGravity() const { return m_gravity; };
+
+            void setGravity(const glm::vec3& gravity) { m_gravity = gravity; };
+
+            /**
+             * @brief Fraction of the velocity lost per second.
+             */
+            float getDrag() const { return m_drag; };
+
+            void setDrag(float drag) { m_drag = drag; };
+
+            /**
+             * @brief Size & color get interpolated from start to end over the lifetime of a particle.
+             */
+            void setSize(float startSize, float endSize);
+
+            void setColor(const glm::vec4& startColor, const glm::vec4& endColor);
+
+            ParticleBlendMode getBlendMode() const { return m_blendMode; };
+
+            void setBlendMode(ParticleBlendMode blendMode) { m_blendMode = blendMode; };
+
+            /**
+             * @brief Only alpha blended particles get sorted, sorting can be turned off if the order doesn't show.
+             */
+            bool isSorted() const { return m_sorted && m_blendMode == PARTICLE_BLEND_ALPHA; };
+
+            void setSorted(bool sorted) { m_sorted = sorted; };
+
+        private:
+            void emit(unsigned int count);
+            void removeDeadParticles();
+            float getRandom();
+
+            // Structure of arrays, one entry per particle
+            std::vector<float> m_positionX;
+            std::vector<float> m_positionY;
+            std::vector<float> m_positionZ;
+            std::vector<float> m_velocityX;
+            std::vector<float> m_velocityY;
+            std::vector<float> m_velocityZ;
+            std::vector<float> m_age;     // Normalized, the particle dies at 1
+            std::vector<float> m_ageRate; // 1 / lifetime
+            size_t m_particleCount;
+
+            // Draw order, only used while sorted. Entries hold the depth key in the upper & the index in the lower half
+            std::vector<uint32_t> m_drawOrder;
+            std::vector<uint64_t> m_sortEntries;
+            std::vector<uint64_t> m_sortScratch;
+            bool m_drawOrderValid;
+
+            unsigned int m_maxParticles;
+            bool m_emitting;
+            float m_emissionRate;
+            float m_emissionAccumulator;
+            float m_emissionRadius;
+            float m_minLifetime;
+            float m_maxLifetime;
+            float m_minSpeed;
+            float m_maxSpeed;
+            float m_spread;
+            glm::vec3 m_gravity;
+            float m_drag;
+            float m_startSize;
+            float m_endSize;
+            glm::vec4 m_startColor;
+            glm::vec4 m_endColor;
+            ParticleBlendMode m_blendMode;
+            bool m_sorted;
+            uint32_t m_randomState;
+
+            static constexpr size_t SIMULATION_CHUNK_SIZE = 4096;
+    };
+} // namespace Engine
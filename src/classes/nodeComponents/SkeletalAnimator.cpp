@@ -0,0 +1,338 @@
+#include "SkeletalAnimator.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ENGINE_ANIMATION_SSE2 1
+#endif
+
+using namespace Engine;
+
+namespace
+{
+#if defined(ENGINE_ANIMATION_SSE2)
+    /**
+     * @brief Dot product of two vec4, broadcast into all lanes.
+     */
+    __m128 dot4(__m128 a, __m128 b)
+    {
+        const __m128 product = _mm_mul_ps(a, b);
+        const __m128 pairs = _mm_add_ps(product, _mm_shuffle_ps(product, product, _MM_SHUFFLE(2, 3, 0, 1)));
+        return _mm_add_ps(pairs, _mm_shuffle_ps(pairs, pairs, _MM_SHUFFLE(1, 0, 3, 2)));
+    }
+#endif
+
+    glm::vec4 lerpVector(const glm::vec4& a, const glm::vec4& b, float t)
+    {
+#if defined(ENGINE_ANIMATION_SSE2)
+        const __m128 from = _mm_loadu_ps(&a.x);
+        glm::vec4 result;
+        _mm_storeu_ps(&result.x, _mm_add_ps(from, _mm_mul_ps(_mm_sub_ps(_mm_loadu_ps(&b.x), from), _mm_set1_ps(t))));
+        return result;
+#else
+        return a + (b - a) * t;
+#endif
+    }
+
+    /**
+     * @brief Normalized lerp along the shorter arc. Close enough to slerp for neighbouring keys & cross fades.
+     */
+    glm::vec4 nlerpQuaternion(const glm::vec4& a, const glm::vec4& b, float t)
+    {
+#if defined(ENGINE_ANIMATION_SSE2)
+        const __m128 from = _mm_loadu_ps(&a.x);
+        __m128 to = _mm_loadu_ps(&b.x);
+
+        // q & -q are the same rotation, flipping the target by the sign of the dot product takes the shorter way
+        const __m128 signMask = _mm_set1_ps(-0.f);
+        to = _mm_xor_ps(to, _mm_and_ps(dot4(from, to), signMask));
+
+        const __m128 blended = _mm_add_ps(from, _mm_mul_ps(_mm_sub_ps(to, from), _mm_set1_ps(t)));
+        glm::vec4 result;
+        _mm_storeu_ps(&result.x, _mm_div_ps(blended, _mm_sqrt_ps(dot4(blended, blended))));
+        return result;
+#else
+        const float sign = a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w < 0.f ? -1.f : 1.f;
+        const glm::vec4 blended = a + (b * sign - a) * t;
+        return blended / std::sqrt(blended.x * blended.x + blended.y * blended.y + blended.z * blended.z + blended.w * blended.w);
+#endif
+    }
+
+    /**
+     * @brief The matrix applying scale, rotation & translation in that order.
+     */
+    glm::mat4 composeMatrix(const glm::vec4& translation, const glm::vec4& rotation, const glm::vec4& scale)
+    {
+        const float x = rotation.x, y = rotation.y, z = rotation.z, w = rotation.w;
+        return glm::mat4(
+                glm::vec4(1.f - 2.f * (y * y + z * z), 2.f * (x * y + w * z), 2.f * (x * z - w * y), 0.f) * scale.x,
+                glm::vec4(2.f * (x * y - w * z), 1.f - 2.f * (x * x + z * z), 2.f * (y * z + w * x), 0.f) * scale.y,
+                glm::vec4(2.f * (x * z + w * y), 2.f * (y * z - w * x), 1.f - 2.f * (x * x + y * y), 0.f) * scale.z,
+                glm::vec4(translation.x, translation.y, translation.z, 1.f)
+        );
+    }
+
+    void multiplyMatrices(const glm::mat4& a, const glm::mat4& b, glm::mat4& result)
+    {
+#if defined(ENGINE_ANIMATION_SSE2)
+        const __m128 columns[4] = { _mm_loadu_ps(&a[0][0]),
+                                    _mm_loadu_ps(&a[1][0]),
+                                    _mm_loadu_ps(&a[2][0]),
+                                    _mm_loadu_ps(&a[3][0]) };
+        for(int column = 0; column < 4; column++)
+        {
+            __m128 sum = _mm_mul_ps(columns[0], _mm_set1_ps(b[column][0]));
+            sum = _mm_add_ps(sum, _mm_mul_ps(columns[1], _mm_set1_ps(b[column][1])));
+            sum = _mm_add_ps(sum, _mm_mul_ps(columns[2], _mm_set1_ps(b[column][2])));
+            sum = _mm_add_ps(sum, _mm_mul_ps(columns[3], _mm_set1_ps(b[column][3])));
+            _mm_storeu_ps(&result[column][0], sum);
+        }
+#else
+        result = a * b;
+#endif
+    }
+
+    size_t findKey(const std::vector<float>& times, float time, uint32_t& cache)
+    {
+        // Playback moves forward a little each frame, so the search starts at the last key. Loops start over
+        size_t key = cache < times.size() && times[cache] <= time ? cache : 0;
+        while(key + 1 < times.size() && times[key + 1] <= time)
+        {
+            key++;
+        }
+        cache = uint32_t(key);
+        return key;
+    }
+
+    template<bool Rotation>
+    glm::vec4 sampleTrack(const std::vector<float>& times, const std::vector<glm::vec4>& values, float time, uint32_t& cache)
+    {
+        if(values.size() == 1 || time <= times.front())
+        {
+            return values.front();
+        }
+
+        const size_t key = findKey(times, time, cache);
+        if(key + 1 >= values.size())
+        {
+            return values[key];
+        }
+
+        const float span = times[key + 1] - times[key];
+        const float t = span > 0.f ? (time - times[key]) / span : 0.f;
+        return Rotation ? nlerpQuaternion(values[key], values[key + 1], t) : lerpVector(values[key], values[key + 1], t);
+    }
+} // namespace
+
+SkeletalAnimator::SkeletalAnimator()
+    : m_skeleton(nullptr)
+    , m_fadeTime(0.f)
+    , m_fadeDuration(0.f)
+    , m_speed(1.f)
+    , m_looping(true)
+    , m_poseDirty(true)
+    , m_paletteVersion(0)
+{
+}
+
+void SkeletalAnimator::setSkeleton(std::shared_ptr<const Skeleton> skeleton)
+{
+    m_skeleton = std::move(skeleton);
+    m_current = PlaybackLayer();
+    m_previous = PlaybackLayer();
+    m_fadeDuration = 0.f;
+
+    const size_t jointCount = m_skeleton ? m_skeleton->joints.size() : 0;
+    for(std::vector<glm::vec4>* pose :
+        { &m_translations, &m_rotations, &m_scales, &m_fadeTranslations, &m_fadeRotations, &m_fadeScales })
+    {
+        pose->resize(jointCount);
+    }
+    m_jointMatrices.resize(jointCount);
+    m_bonePalette.assign(m_skeleton ? m_skeleton->bones.size() : 0, glm::mat4(1.f));
+    m_poseDirty = true;
+}
+
+bool SkeletalAnimator::play(const std::string& clipName, float fadeDuration /* = 0.f */)
+{
+    const int clipIndex = m_skeleton ? m_skeleton->findClip(clipName) : -1;
+    if(clipIndex < 0)
+    {
+        fprintf(stderr, "SkeletalAnimator | No animation named %s!\n", clipName.c_str());
+        return false;
+    }
+
+    play(clipIndex, fadeDuration);
+    return true;
+}
+
+void SkeletalAnimator::play(int clipIndex, float fadeDuration /* = 0.f */)
+{
+    if(!m_skeleton || clipIndex < 0 || clipIndex >= int(m_skeleton->clips.size()))
+    {
+        return;
+    }
+
+    if(fadeDuration > 0.f)
+    {
+        // The clip playing so far keeps running while it fades out
+        m_previous = std::move(m_current);
+        m_fadeTime = 0.f;
+    }
+    m_fadeDuration = std::max(fadeDuration, 0.f);
+
+    startLayer(m_current, clipIndex);
+    m_poseDirty = true;
+}
+
+void SkeletalAnimator::stop()
+{
+    m_current = PlaybackLayer();
+    m_fadeDuration = 0.f;
+    m_poseDirty = true;
+}
+
+void SkeletalAnimator::evaluate(float deltaTime)
+{
+    // A stopped skeleton stays in its rest pose, there is nothing to recompute
+    if(!m_skeleton || (!m_poseDirty && m_current.clip < 0 && m_fadeDuration <= 0.f))
+    {
+        return;
+    }
+
+    advanceLayer(m_current, deltaTime * m_speed);
+    sampleLayer(m_current, m_translations.data(), m_rotations.data(), m_scales.data());
+
+    if(m_fadeDuration > 0.f)
+    {
+        m_fadeTime += deltaTime;
+        const float weight = m_fadeTime / m_fadeDuration;
+        if(weight < 1.f)
+        {
+            advanceLayer(m_previous, deltaTime * m_speed);
+            sampleLayer(m_previous, m_fadeTranslations.data(), m_fadeRotations.data(), m_fadeScales.data());
+
+            for(size_t i = 0; i < m_translations.size(); i++)
+            {
+                m_translations[i] = lerpVector(m_fadeTranslations[i], m_translations[i], weight);
+                m_rotations[i] = nlerpQuaternion(m_fadeRotations[i], m_rotations[i], weight);
+                m_scales[i] = lerpVector(m_fadeScales[i], m_scales[i], weight);
+            }
+        }
+        else
+        {
+            m_fadeDuration = 0.f;
+            m_previous = PlaybackLayer();
+        }
+    }
+
+    buildPalette();
+    m_poseDirty = false;
+}
+
+void SkeletalAnimator::startLayer(PlaybackLayer& layer, int clipIndex) const
+{
+    layer.clip = clipIndex;
+    layer.time = 0.f;
+    layer.keyCache.assign(m_skeleton->clips[clipIndex].channels.size() * 3, 0);
+}
+
+void SkeletalAnimator::advanceLayer(PlaybackLayer& layer, float deltaTime) const
+{
+    if(layer.clip < 0)
+    {
+        return;
+    }
+
+    const float duration = m_skeleton->clips[layer.clip].duration;
+    layer.time += deltaTime;
+    if(duration <= 0.f)
+    {
+        layer.time = 0.f;
+    }
+    else if(m_looping)
+    {
+        layer.time = std::fmod(layer.time, duration);
+        if(layer.time < 0.f)
+        {
+            layer.time += duration;
+        }
+    }
+    else
+    {
+        layer.time = std::clamp(layer.time, 0.f, duration);
+    }
+}
+
+void SkeletalAnimator::sampleLayer(
+        PlaybackLayer& layer,
+        glm::vec4* translations,
+        glm::vec4* rotations,
+        glm::vec4* scales
+) const
+{
+    // Joints without a channel keep their rest pose
+    resetToRestPose(translations, rotations, scales);
+    if(layer.clip < 0)
+    {
+        return;
+    }
+
+    const AnimationClip& clip = m_skeleton->clips[layer.clip];
+    for(size_t i = 0; i < clip.channels.size(); i++)
+    {
+        const AnimationChannel& channel = clip.channels[i];
+        uint32_t* cache = &layer.keyCache[i * 3];
+        if(!channel.translations.empty())
+        {
+            translations[channel.joint] =
+                    sampleTrack<false>(channel.translationTimes, channel.translations, layer.time, cache[0]);
+        }
+        if(!channel.rotations.empty())
+        {
+            rotations[channel.joint] = sampleTrack<true>(channel.rotationTimes, channel.rotations, layer.time, cache[1]);
+        }
+        if(!channel.scales.empty())
+        {
+            scales[channel.joint] = sampleTrack<false>(channel.scaleTimes, channel.scales, layer.time, cache[2]);
+        }
+    }
+}
+
+void SkeletalAnimator::resetToRestPose(glm::vec4* translations, glm::vec4* rotations, glm::vec4* scales) const
+{
+    for(size_t i = 0; i < m_skeleton->joints.size(); i++)
+    {
+        const SkeletonJoint& joint = m_skeleton->joints[i];
+        translations[i] = joint.translation;
+        rotations[i] = joint.rotation;
+        scales[i] = joint.scale;
+    }
+}
+
+void SkeletalAnimator::buildPalette()
+{
+    const std::vector<SkeletonJoint>& joints = m_skeleton->joints;
+    for(size_t i = 0; i < joints.size(); i++)
+    {
+        const glm::mat4 local = composeMatrix(m_translations[i], m_rotations[i], m_scales[i]);
+        if(joints[i].parent < 0)
+        {
+            m_jointMatrices[i] = local;
+        }
+        else
+        {
+            // Parents come first, their matrix is already final
+            multiplyMatrices(m_jointMatrices[joints[i].parent], local, m_jointMatrices[i]);
+        }
+    }
+
+    const std::vector<SkinBone>& bones = m_skeleton->bones;
+    for(size_t i = 0; i < bones.size(); i++)
+    {
+        multiplyMatrices(m_jointMatrices[bones[i].joint], bones[i].inverseBindMatrix, m_bonePalette[i]);
+    }
+    m_paletteVersion++;
+}
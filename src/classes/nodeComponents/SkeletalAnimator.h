@@ -0,0 +1,116 @@
+#pragma once
+
+#include "../helper/CookedModel.h"
+#include "BasicNode.h"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+namespace Engine
+{
+    /**
+     * @brief Plays the animations of a skeleton and evaluates the bone palette its skinned meshes are drawn with.
+     *
+     * Poses are kept as arrays of translations, quaternions & scales, one vec4 each per joint, so sampling, cross
+     * fading and building the joint matrices run with SSE. All animators get evaluated by the EngineManager after the
+     * update of the scene, spread over the ThreadPool. The palette is in the space of the model, the node transform
+     * of the skinned mesh places it in the world.
+     */
+    class SkeletalAnimator : virtual public BasicNode
+    {
+        public:
+            SkeletalAnimator();
+            ~SkeletalAnimator() = default;
+
+            /**
+             * @brief Sets the skeleton to animate, resetting it into its rest pose.
+             */
+            void setSkeleton(std::shared_ptr<const Skeleton> skeleton);
+
+            const std::shared_ptr<const Skeleton>& getSkeleton() const { return m_skeleton; };
+
+            /**
+             * @brief Starts playing a clip from its beginning.
+             *
+             * @param fadeDuration Seconds over which the previous clip gets blended out, 0 switches instantly.
+             * @return False if the skeleton has no clip with that name.
+             */
+            bool play(const std::string& clipName, float fadeDuration = 0.f);
+
+            void play(int clipIndex, float fadeDuration = 0.f);
+
+            /**
+             * @brief Stops playback, the skeleton returns to its rest pose.
+             */
+            void stop();
+
+            int getClip() const { return m_current.clip; };
+
+            float getTime() const { return m_current.time; };
+
+            void setTime(float time) { m_current.time = time; };
+
+            float getSpeed() const { return m_speed; };
+
+            void setSpeed(float speed) { m_speed = speed; };
+
+            bool isLooping() const { return m_looping; };
+
+            void setLooping(bool looping) { m_looping = looping; };
+
+            /**
+             * @brief Advances playback & recomputes the bone palette. Animators don't share state, so different
+             * animators can be evaluated in parallel.
+             */
+            void evaluate(float deltaTime);
+
+            /**
+             * @brief Per bone of the skeleton the matrix moving a vertex from the bind pose into the current pose.
+             */
+            const std::vector<glm::mat4>& getBonePalette() const { return m_bonePalette; };
+
+            /**
+             * @brief Gets incremented whenever the palette changed, so uploads can be skipped for paused animators.
+             */
+            uint32_t getPaletteVersion() const { return m_paletteVersion; };
+
+        private:
+            struct PlaybackLayer
+            {
+                    int clip = -1;
+                    float time = 0.f;
+                    std::vector<uint32_t> keyCache; // Last key per channel & track, playback rarely jumps
+            };
+
+            void startLayer(PlaybackLayer& layer, int clipIndex) const;
+            void advanceLayer(PlaybackLayer& layer, float deltaTime) const;
+            void sampleLayer(PlaybackLayer& layer, glm::vec4* translations, glm::vec4* rotations, glm::vec4* scales) const;
+            void resetToRestPose(glm::vec4* translations, glm::vec4* rotations, glm::vec4* scales) const;
+            void buildPalette();
+
+            std::shared_ptr<const Skeleton> m_skeleton;
+
+            PlaybackLayer m_current;
+            PlaybackLayer m_previous;
+            float m_fadeTime;
+            float m_fadeDuration;
+            float m_speed;
+            bool m_looping;
+            bool m_poseDirty;
+
+            // Local pose per joint, the faded out clip gets sampled into the second set
+            std::vector<glm::vec4> m_translations;
+            std::vector<glm::vec4> m_rotations;
+            std::vector<glm::vec4> m_scales;
+            std::vector<glm::vec4> m_fadeTranslations;
+            std::vector<glm::vec4> m_fadeRotations;
+            std::vector<glm::vec4> m_fadeScales;
+
+            std::vector<glm::mat4> m_jointMatrices;
+            std::vector<glm::mat4> m_bonePalette;
+            uint32_t m_paletteVersion;
+    };
+} // namespace Engine
@@ -0,0 +1,246 @@
+#include "SkinnedMeshComponent.h"
+
+#include "../engine/ThreadPool.h"
+#include "../engine/rendering/Shader.h"
+#include "../engine/rendering/backend/RenderBackend.h"
+#include "SkeletalAnimator.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ENGINE_SKINNING_SSE2 1
+#endif
+
+using namespace Engine;
+
+SkinnedMeshComponent::SkinnedMeshComponent()
+    : m_animator(nullptr)
+    , m_sourceData(nullptr)
+    , m_cpuSkinnedData(nullptr)
+    , m_sourceChanged(false)
+    , m_skinnedVersion(0)
+    , m_skinnedVertexBuffer(0)
+    , m_skinnedNormalBuffer(0)
+    , m_paletteBuffer(0)
+    , m_paletteTexture(0)
+    , m_uploadedVersion(0)
+{
+}
+
+SkinnedMeshComponent::~SkinnedMeshComponent()
+{
+    RenderBackend& backend = RenderBackend::get();
+    for(GLuint buffer : { m_skinnedVertexBuffer, m_skinnedNormalBuffer, m_paletteBuffer })
+    {
+        if(buffer != 0)
+        {
+            backend.deleteBuffer(buffer);
+        }
+    }
+
+    if(m_paletteTexture != 0)
+    {
+        backend.deleteTexture(m_paletteTexture);
+    }
+}
+
+bool SkinnedMeshComponent::usesGpuSkinning() const
+{
+    const auto& source = m_sourceData ? m_sourceData : getObjectData();
+    return getShader() && getShader()->hasFeature(SHADER_FEATURE_SKINNED) && source && source->isSkinned();
+}
+
+void SkinnedMeshComponent::refreshSource()
+{
+    const auto& objectData = getObjectData();
+    if(objectData && objectData != m_cpuSkinnedData && objectData != m_sourceData)
+    {
+        m_sourceData = objectData;
+        m_sourceChanged = true;
+        m_skinnedVersion = 0;
+        m_uploadedVersion = 0;
+    }
+}
+
+void SkinnedMeshComponent::skinVertices()
+{
+    refreshSource();
+    if(!m_animator || !m_sourceData || usesGpuSkinning())
+    {
+        return;
+    }
+
+    const std::vector<glm::mat4>& palette = m_animator->getBonePalette();
+    const ObjectData& source = *m_sourceData;
+    const size_t vertexCount = source.m_vertexData.size();
+    if(palette.empty() || source.m_boneIndices.size() != vertexCount || source.m_boneWeights.size() != vertexCount ||
+       m_animator->getPaletteVersion() == m_skinnedVersion)
+    {
+        return;
+    }
+
+    const bool hasNormals = source.m_vertexNormals.size() == vertexCount;
+    m_skinnedPositions.resize(vertexCount);
+    m_skinnedNormals.resize(hasNormals ? vertexCount : 0);
+
+    SingletonManager::get<ThreadPool>()->parallelFor(
+            vertexCount,
+            [this, &palette, &source, hasNormals](size_t begin, size_t end)
+            {
+                const unsigned int lastBone = unsigned(palette.size() - 1);
+                for(size_t i = begin; i < end; i++)
+                {
+                    const glm::uvec4& indices = source.m_boneIndices[i];
+                    const glm::vec4& weights = source.m_boneWeights[i];
+                    const glm::vec3& position = source.m_vertexData[i];
+#if defined(ENGINE_SKINNING_SSE2)
+                    // The weighted sum of up to 4 bone matrices, one column per register
+                    __m128 columns[4] = { _mm_setzero_ps(), _mm_setzero_ps(), _mm_setzero_ps(), _mm_setzero_ps() };
+                    for(int influence = 0; influence < 4; influence++)
+                    {
+                        if(weights[influence] == 0.f)
+                        {
+                            continue;
+                        }
+
+                        const glm::mat4& bone = palette[std::min(indices[influence], lastBone)];
+                        const __m128 weight = _mm_set1_ps(weights[influence]);
+                        for(int column = 0; column < 4; column++)
+                        {
+                            columns[column] = _mm_add_ps(columns[column], _mm_mul_ps(_mm_loadu_ps(&bone[column][0]), weight));
+                        }
+                    }
+
+                    alignas(16) float result[4];
+                    __m128 skinned = _mm_add_ps(_mm_mul_ps(columns[0], _mm_set1_ps(position.x)), columns[3]);
+                    skinned = _mm_add_ps(skinned, _mm_mul_ps(columns[1], _mm_set1_ps(position.y)));
+                    skinned = _mm_add_ps(skinned, _mm_mul_ps(columns[2], _mm_set1_ps(position.z)));
+                    _mm_store_ps(result, skinned);
+                    m_skinnedPositions[i] = glm::vec3(result[0], result[1], result[2]);
+
+                    if(hasNormals)
+                    {
+                        const glm::vec3& normal = source.m_vertexNormals[i];
+                        skinned = _mm_mul_ps(columns[0], _mm_set1_ps(normal.x));
+                        skinned = _mm_add_ps(skinned, _mm_mul_ps(columns[1], _mm_set1_ps(normal.y)));
+                        skinned = _mm_add_ps(skinned, _mm_mul_ps(columns[2], _mm_set1_ps(normal.z)));
+                        _mm_store_ps(result, skinned);
+
+                        const float length = std::sqrt(result[0] * result[0] + result[1] * result[1] + result[2] * result[2]);
+                        m_skinnedNormals[i] = length > 0.f ? glm::vec3(result[0], result[1], result[2]) / length : normal;
+                    }
+#else
+                    glm::mat4 skin = glm::mat4(0.f);
+                    for(int influence = 0; influence < 4; influence++)
+                    {
+                        if(weights[influence] != 0.f)
+                        {
+                            skin += palette[std::min(indices[influence], lastBone)] * weights[influence];
+                        }
+                    }
+
+                    m_skinnedPositions[i] = glm::vec3(skin * glm::vec4(position, 1.f));
+                    if(hasNormals)
+                    {
+                        m_skinnedNormals[i] = glm::normalize(glm::vec3(skin * glm::vec4(source.m_vertexNormals[i], 0.f)));
+                    }
+#endif
+                }
+            },
+            SKINNING_CHUNK_SIZE
+    );
+
+    m_skinnedVersion = m_animator->getPaletteVersion();
+}
+
+void SkinnedMeshComponent::uploadSkinning()
+{
+    refreshSource();
+    if(!m_animator || !m_sourceData)
+    {
+        return;
+    }
+
+    RenderBackend& backend = RenderBackend::get();
+
+    if(usesGpuSkinning())
+    {
+        if(getObjectData() != m_sourceData)
+        {
+            setObjectData(m_sourceData);
+        }
+
+        const std::vector<glm::mat4>& palette = m_animator->getBonePalette();
+        if(palette.empty() || m_animator->getPaletteVersion() == m_uploadedVersion)
+        {
+            return;
+        }
+
+        if(m_paletteBuffer == 0)
+        {
+            m_paletteBuffer = backend.createBuffer();
+            m_paletteTexture = backend.createTexture();
+        }
+
+        // Orphaned every upload, the previous palette may still be read by the last frame
+        backend.bindBuffer(GL_TEXTURE_BUFFER, m_paletteBuffer);
+        backend.bufferData(GL_TEXTURE_BUFFER, palette.size() * sizeof(glm::mat4), palette.data(), GL_STREAM_DRAW);
+        backend.bindTexture(GL_TEXTURE_BUFFER, m_paletteTexture);
+        backend.texBuffer(GL_TEXTURE_BUFFER, GL_RGBA32F, m_paletteBuffer);
+        backend.bindTexture(GL_TEXTURE_BUFFER, 0);
+
+        m_uploadedVersion = m_animator->getPaletteVersion();
+        return;
+    }
+
+    if(m_skinnedPositions.empty() || m_skinnedVersion == m_uploadedVersion)
+    {
+        return;
+    }
+
+    if(!m_cpuSkinnedData || m_sourceChanged)
+    {
+        if(m_skinnedVertexBuffer == 0)
+        {
+            m_skinnedVertexBuffer = backend.createBuffer();
+            m_skinnedNormalBuffer = backend.createBuffer();
+        }
+
+        // Shares uvs & indices with the source, only positions & normals are replaced. Without bones, the shader
+        // doesn't try to skin it a second time
+        m_cpuSkinnedData = std::make_shared<ObjectData>(*m_sourceData);
+        m_cpuSkinnedData->m_vertexBuffer = m_skinnedVertexBuffer;
+        m_cpuSkinnedData->m_normalBuffer = m_skinnedNormals.empty() ? -1 : m_skinnedNormalBuffer;
+        m_cpuSkinnedData->m_boneIndexBuffer = -1;
+        m_cpuSkinnedData->m_boneWeightBuffer = -1;
+        m_cpuSkinnedData->m_boneIndices.clear();
+        m_cpuSkinnedData->m_boneWeights.clear();
+        m_sourceChanged = false;
+    }
+
+    backend.bindBuffer(GL_ARRAY_BUFFER, m_skinnedVertexBuffer);
+    backend.bufferData(
+            GL_ARRAY_BUFFER,
+            m_skinnedPositions.size() * sizeof(glm::vec3),
+            m_skinnedPositions.data(),
+            GL_STREAM_DRAW
+    );
+    if(!m_skinnedNormals.empty())
+    {
+        backend.bindBuffer(GL_ARRAY_BUFFER, m_skinnedNormalBuffer);
+        backend.bufferData(
+                GL_ARRAY_BUFFER,
+                m_skinnedNormals.size() * sizeof(glm::vec3),
+                m_skinnedNormals.data(),
+                GL_STREAM_DRAW
+        );
+    }
+
+    if(getObjectData() != m_cpuSkinnedData)
+    {
+        setObjectData(m_cpuSkinnedData);
+    }
+    m_uploadedVersion = m_skinnedVersion;
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include "GeometryComponent.h"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace Engine
+{
+    class SkeletalAnimator;
+
+    /**
+     * @brief Geometry deformed by the bone palette of a SkeletalAnimator.
+     *
+     * The object data has to come from RenderManager::registerSkinnedModel. With a shader variant declaring
+     * SHADER_FEATURE_SKINNED the palette gets uploaded into a buffer texture & the vertex shader skins the mesh.
+     * Any other shader draws vertices skinned on the CPU with SSE, split over the ThreadPool & streamed into buffers
+     * of this component, for shaders or contexts that can't skin on the GPU.
+     */
+    class SkinnedMeshComponent : public GeometryComponent
+    {
+        public:
+            SkinnedMeshComponent();
+            ~SkinnedMeshComponent();
+
+            std::shared_ptr<SkeletalAnimator> getAnimator() const { return m_animator; };
+
+            void setAnimator(std::shared_ptr<SkeletalAnimator> animator) { m_animator = std::move(animator); };
+
+            /**
+             * @return True if the shader skins the vertices, false if they get skinned on the CPU.
+             */
+            bool usesGpuSkinning() const;
+
+            /**
+             * @brief Skins the vertices of the mesh with the current palette. Only does work for the CPU path & doesn't
+             * touch GL, so the skinned meshes can be processed in parallel.
+             */
+            void skinVertices();
+
+            /**
+             * @brief Uploads the palette or the CPU skinned vertices. Has to be called from the thread owning the GL
+             * context, before drawing.
+             */
+            void uploadSkinning();
+
+            /**
+             * @brief The buffer texture holding the palette as 4 RGBA32F texels per bone, 0 for the CPU path.
+             */
+            GLuint getPaletteTexture() const { return m_paletteTexture; };
+
+        private:
+            /**
+             * @brief Picks up object data set since the last frame. The CPU path swaps in a copy with own vertex &
+             * normal buffers, the set data stays the source of the bind pose.
+             */
+            void refreshSource();
+
+            std::shared_ptr<SkeletalAnimator> m_animator;
+            std::shared_ptr<ObjectData> m_sourceData;
+            std::shared_ptr<ObjectData> m_cpuSkinnedData;
+
+            bool m_sourceChanged;
+
+            std::vector<glm::vec3> m_skinnedPositions;
+            std::vector<glm::vec3> m_skinnedNormals;
+            uint32_t m_skinnedVersion;
+            GLuint m_skinnedVertexBuffer;
+            GLuint m_skinnedNormalBuffer;
+
+            GLuint m_paletteBuffer;
+            GLuint m_paletteTexture;
+            uint32_t m_uploadedVersion;
+
+            static constexpr size_t SKINNING_CHUNK_SIZE = 1024;
+    };
+} // namespace Engine
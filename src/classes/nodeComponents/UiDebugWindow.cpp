@@ -1,28 +1,175 @@
 #include "UiDebugWindow.h"
 
+#include <algorithm>
+#include <cstring>
+
+#include <imgui_internal.h>
+
 using namespace Engine::Ui;
 
 UiDebugWindow::UiDebugWindow(ImGuiWindowFlags flags)
     : m_content(std::vector<std::shared_ptr<UiElement>>())
     , m_windowOpen(true)
     , m_flags(flags)
+    , m_cachingEnabled(true)
+    , m_isDirty(true)
+    , m_isInteracting(false)
+    , m_reusedCache(false)
+    , m_refreshInterval(0.25)
+    , m_lastRebuildTime(0)
+    , m_hasCache(false)
 {
     setName(m_windowTitle);
 }
 
 void UiDebugWindow::drawUi()
 {
+    m_reusedCache = false;
+
     if(!m_windowOpen && m_windowIsClosable)
     {
         return;
     }
 
+    // Skipping the window for a frame would make ImGui treat it as appearing again, which focuses & raises it
+    m_reusedCache = canReuseCache();
+    if(m_reusedCache)
+    {
+        // Without its widgets the window would size itself & clamp its scrolling to an empty content
+        ImGui::SetNextWindowContentSize(m_cachedContentSize);
+    }
+
     ImGui::Begin(m_windowTitle.c_str(), m_windowIsClosable ? &m_windowOpen : nullptr, m_flags);
 
+    ImDrawList* drawList = ImGui::GetWindowDrawList();
+    if(m_reusedCache)
+    {
+        replayContent(drawList);
+        ImGui::End();
+        return;
+    }
+
+    const int firstVertex = drawList->VtxBuffer.Size;
+    const int firstIndex = drawList->IdxBuffer.Size;
+    const int firstCommand = drawList->CmdBuffer.Size - 1;
+
     for(const auto& element : m_content)
     {
         element->drawUi();
     }
 
+    // Any hover or active widget keeps the window live, so ImGui keeps receiving its input
+    m_isInteracting = ImGui::IsWindowHovered(
+                              ImGuiHoveredFlags_RootAndChildWindows | ImGuiHoveredFlags_AllowWhenBlockedByActiveItem
+                      ) ||
+            (ImGui::IsWindowFocused(ImGuiFocusedFlags_RootAndChildWindows) && ImGui::IsAnyItemActive());
+
+    m_cachedWindowPos = ImGui::GetWindowPos();
+    m_cachedWindowSize = ImGui::GetWindowSize();
+
+    if(m_cachingEnabled)
+    {
+        const ImGuiWindow* window = ImGui::GetCurrentWindow();
+        m_cachedContentSize = ImVec2(
+                window->DC.CursorMaxPos.x - window->DC.CursorStartPos.x,
+                window->DC.CursorMaxPos.y - window->DC.CursorStartPos.y
+        );
+        captureContent(drawList, firstVertex, firstIndex, firstCommand);
+        m_cachedDisplaySize = ImGui::GetIO().DisplaySize;
+    }
+
     ImGui::End();
+
+    m_isDirty = false;
+    m_lastRebuildTime = ImGui::GetTime();
+}
+
+bool UiDebugWindow::canReuseCache() const
+{
+    if(!m_cachingEnabled || !m_hasCache || m_isInteracting)
+    {
+        return false;
+    }
+
+    const ImGuiIO& io = ImGui::GetIO();
+    if(io.DisplaySize.x != m_cachedDisplaySize.x || io.DisplaySize.y != m_cachedDisplaySize.y)
+    {
+        return false;
+    }
+
+    // The mouse entering the window has to reach ImGui in the same frame. The margin covers the resize borders.
+    constexpr float margin = 8.f;
+    if(io.MousePos.x >= m_cachedWindowPos.x - margin && io.MousePos.y >= m_cachedWindowPos.y - margin &&
+       io.MousePos.x <= m_cachedWindowPos.x + m_cachedWindowSize.x + margin &&
+       io.MousePos.y <= m_cachedWindowPos.y + m_cachedWindowSize.y + margin)
+    {
+        return false;
+    }
+
+    // Data changes are only picked up with the throttled refresh rate
+    return !m_isDirty || ImGui::GetTime() - m_lastRebuildTime < m_refreshInterval;
+}
+
+void UiDebugWindow::captureContent(const ImDrawList* drawList, int firstVertex, int firstIndex, int firstCommand)
+{
+    const ImDrawVert* vertices = drawList->VtxBuffer.Data;
+    m_cachedVertices.assign(vertices + firstVertex, vertices + drawList->VtxBuffer.Size);
+    m_cachedIndices.clear();
+    m_cachedCommands.clear();
+
+    for(int i = std::max(firstCommand, 0); i < drawList->CmdBuffer.Size; i++)
+    {
+        const ImDrawCmd& command = drawList->CmdBuffer[i];
+
+        // The command that was current after Begin() may start with indices of the window decoration
+        const unsigned int begin = std::max(command.IdxOffset, (unsigned int)firstIndex);
+        const unsigned int end = command.IdxOffset + command.ElemCount;
+        if(command.UserCallback || begin >= end)
+        {
+            continue;
+        }
+
+        CachedCommand cached;
+        cached.clipRect = command.ClipRect;
+        cached.textureId = command.TextureId;
+        cached.firstIndex = (unsigned int)m_cachedIndices.size();
+        cached.indexCount = end - begin;
+        for(unsigned int index = begin; index < end; index++)
+        {
+            m_cachedIndices.push_back(command.VtxOffset + drawList->IdxBuffer[int(index)] - (unsigned int)firstVertex);
+        }
+        m_cachedCommands.push_back(cached);
+    }
+
+    m_hasCache = true;
+}
+
+void UiDebugWindow::replayContent(ImDrawList* drawList) const
+{
+    for(const CachedCommand& command : m_cachedCommands)
+    {
+        const unsigned int* indices = m_cachedIndices.data() + command.firstIndex;
+        const auto [first, last] = std::minmax_element(indices, indices + command.indexCount);
+        const int vertexCount = int(*last - *first + 1);
+
+        drawList->PushClipRect(
+                ImVec2(command.clipRect.x, command.clipRect.y),
+                ImVec2(command.clipRect.z, command.clipRect.w)
+        );
+        drawList->PushTextureID(command.textureId);
+
+        // Reserving starts a new vertex offset if the 16 bit indices would overflow
+        drawList->PrimReserve(int(command.indexCount), vertexCount);
+        memcpy(drawList->_VtxWritePtr, m_cachedVertices.data() + *first, vertexCount * sizeof(ImDrawVert));
+        for(unsigned int i = 0; i < command.indexCount; i++)
+        {
+            drawList->_IdxWritePtr[i] = ImDrawIdx(drawList->_VtxCurrentIdx + indices[i] - *first);
+        }
+        drawList->_VtxWritePtr += vertexCount;
+        drawList->_IdxWritePtr += command.indexCount;
+        drawList->_VtxCurrentIdx += (unsigned int)vertexCount;
+
+        drawList->PopTextureID();
+        drawList->PopClipRect();
+    }
 }
@@ -33,9 +33,44 @@ namespace Engine::Ui
              *
              * This function is called to render the UI elements inside the debug window.
              * It overrides the drawUi() function from the UiElement class.
+             * While the window is neither dirty nor interacted with, its content isn't rebuilt. The window still
+             * goes through Begin/End every frame, so it keeps its focus & z-order, & the vertices of the last rebuild
+             * get replayed into its draw list.
              */
             void drawUi() override;
 
+            /**
+             * @brief Marks the content as changed, so the window gets rebuilt through ImGui.
+             */
+            void markDirty() { m_isDirty = true; };
+
+            /**
+             * @brief Whether drawUi() replayed the cached content in the current frame instead of rebuilding it.
+             */
+            bool isReusingCache() const { return m_reusedCache; };
+
+            /**
+             * @brief Sets the minimum time between two rebuilds caused by markDirty().
+             *
+             * Interaction with the window always rebuilds it right away.
+             *
+             * @param seconds The minimum time between two rebuilds.
+             */
+            void setRefreshInterval(double seconds) { m_refreshInterval = seconds; };
+
+            double getRefreshInterval() const { return m_refreshInterval; };
+
+            /**
+             * @brief Enables or disables reusing the content of idle frames.
+             */
+            void setUiCaching(bool enabled)
+            {
+                m_cachingEnabled = enabled;
+                markDirty();
+            };
+
+            bool isUiCaching() const { return m_cachingEnabled; };
+
             /**
              * @brief Gets the content of the debug window.
              *
@@ -51,6 +86,7 @@ namespace Engine::Ui
             void addContent(const std::shared_ptr<UiElement>& newContent)
             {
                 m_content.emplace_back(newContent);
+                markDirty();
             };
 
             /**
@@ -61,6 +97,7 @@ namespace Engine::Ui
             void removeContent(const std::shared_ptr<UiElement>& content)
             {
                 m_content.erase(std::remove(m_content.begin(), m_content.end(), content), m_content.end());
+                markDirty();
             }
 
             /**
@@ -114,6 +151,7 @@ namespace Engine::Ui
             {
                 m_windowTitle = std::move(title);
                 setName(m_windowTitle);
+                markDirty();
             };
 
             bool getIsWindowClosable() const { return m_windowIsClosable; };
@@ -121,10 +159,44 @@ namespace Engine::Ui
             void setIsWindowClosable(bool isClosable) { m_windowIsClosable = std::move(isClosable); };
 
         private:
+            // A draw command of the content, its indices point into m_cachedVertices
+            struct CachedCommand
+            {
+                    ImVec4 clipRect;
+                    ImTextureID textureId;
+                    unsigned int firstIndex = 0;
+                    unsigned int indexCount = 0;
+            };
+
+            bool canReuseCache() const;
+
+            /**
+             * @brief Copies everything drawn into the draw list since the given marks, i.e. the content of the window
+             * without what Begin() draws itself.
+             */
+            void captureContent(const ImDrawList* drawList, int firstVertex, int firstIndex, int firstCommand);
+
+            void replayContent(ImDrawList* drawList) const;
+
             std::vector<std::shared_ptr<UiElement>> m_content;
             bool m_windowOpen;
             bool m_windowIsClosable;
             ImGuiWindowFlags m_flags;
             std::string m_windowTitle = "Hello, World!";
+
+            bool m_cachingEnabled;
+            bool m_isDirty;
+            bool m_isInteracting;
+            bool m_reusedCache;
+            double m_refreshInterval;
+            double m_lastRebuildTime;
+            bool m_hasCache;
+            std::vector<ImDrawVert> m_cachedVertices;
+            std::vector<unsigned int> m_cachedIndices;
+            std::vector<CachedCommand> m_cachedCommands;
+            ImVec2 m_cachedContentSize;
+            ImVec2 m_cachedWindowPos;
+            ImVec2 m_cachedWindowSize;
+            ImVec2 m_cachedDisplaySize;
     };
 } // namespace Engine::Ui
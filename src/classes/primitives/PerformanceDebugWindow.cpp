@@ -1,13 +1,19 @@
 #include "PerformanceDebugWindow.h"
 
 #include "../engine/EngineManager.h"
+#include "../engine/FramePacer.h"
 #include "../engine/WindowManager.h"
+#include "../engine/rendering/DynamicResolution.h"
+#include "../engine/rendering/RenderGraph.h"
 #include "../engine/rendering/RenderManager.h"
 #include "../uiElements/UiElementButton.h"
 #include "../uiElements/UiElementPlot.h"
 #include "../uiElements/UiElementRadio.h"
+#include "../uiElements/UiElementSlider.h"
 #include "../uiElements/UiElementText.h"
 
+#include <cstdio>
+
 using namespace Engine::Ui;
 
 PerformanceDebugWindow::PerformanceDebugWindow()
@@ -19,9 +25,13 @@ PerformanceDebugWindow::PerformanceDebugWindow()
     m_lastTimeStamp = glfwGetTime();
     m_engineManager = SingletonManager::get<EngineManager>();
     m_windowManager = SingletonManager::get<WindowManager>();
+    m_framePacer = SingletonManager::get<FramePacer>();
 
     setWindowTitle("Performance Monitor");
 
+    // The counters only change every 0.5 seconds anyway
+    setRefreshInterval(0.5);
+
     m_fpsCounter = std::make_shared<UiElementPlot>("FPS: inf");
     addContent(m_fpsCounter);
 
@@ -34,12 +44,57 @@ PerformanceDebugWindow::PerformanceDebugWindow()
             std::bind(&PerformanceDebugWindow::onVsyncToggle, this, std::placeholders::_1)
     );
     addContent(vsyncRadio);
+
+    auto lowLatencyRadio = std::make_shared<UiElementRadio>(
+            m_framePacer->isLowLatencyEnabled(),
+            "Low latency",
+            std::bind(&PerformanceDebugWindow::onLowLatencyToggle, this, std::placeholders::_1)
+    );
+    addContent(lowLatencyRadio);
+
+    m_latency = std::make_shared<UiElementText>("Latency: no input yet");
+    addContent(m_latency);
+
+    const auto& dynamicResolution = m_engineManager->getDynamicResolution();
+    auto dynamicResolutionRadio = std::make_shared<UiElementRadio>(
+            dynamicResolution->isEnabled(),
+            "Dynamic resolution",
+            std::bind(&PerformanceDebugWindow::onDynamicResolutionToggle, this, std::placeholders::_1)
+    );
+    addContent(dynamicResolutionRadio);
+
+    auto frameBudgetSlider = std::make_shared<UiElementSlider<float>>(
+            dynamicResolution->getTargetFrameTime(),
+            4.f,
+            33.f,
+            "GPU budget (ms)",
+            std::bind(&PerformanceDebugWindow::onFrameBudgetChange, this, std::placeholders::_1)
+    );
+    addContent(frameBudgetSlider);
+
+    m_renderScale = std::make_shared<UiElementText>("Render scale: 100%");
+    addContent(m_renderScale);
+
+    m_renderTargets = std::make_shared<UiElementText>("Render targets: 0");
+    addContent(m_renderTargets);
 }
 
 void PerformanceDebugWindow::update() { updateFrameCounter(); }
 
 void PerformanceDebugWindow::onVsyncToggle(bool value) { m_windowManager->setVsync(value); }
 
+void PerformanceDebugWindow::onLowLatencyToggle(bool value) { m_framePacer->setLowLatency(value); }
+
+void PerformanceDebugWindow::onDynamicResolutionToggle(bool value)
+{
+    m_engineManager->getDynamicResolution()->setEnabled(value);
+}
+
+void PerformanceDebugWindow::onFrameBudgetChange(float value)
+{
+    m_engineManager->getDynamicResolution()->setTargetFrameTime(value);
+}
+
 void PerformanceDebugWindow::updateFrameCounter()
 {
     if(glfwGetTime() - m_lastTimeStamp >= 0.5)
@@ -53,6 +108,41 @@ void PerformanceDebugWindow::updateFrameCounter()
         fpsText = "Average ms/frame: " + std::to_string(msTime);
         m_frameTimer->setText(fpsText);
 
+        // Scan-out after the GPU finished isn't measurable, it adds up to a refresh interval on top
+        const LatencyStats& latency = m_framePacer->getStats();
+        if(latency.inputSamples > 0)
+        {
+            char latencyText[160];
+            snprintf(
+                    latencyText,
+                    sizeof(latencyText),
+                    "Latency: input->swap %.1f ms, input->GPU %.1f ms, poll->GPU %.1f ms, slept %.1f ms, %zu in flight",
+                    latency.inputToSwapMs,
+                    latency.inputToGpuMs,
+                    latency.pollToGpuMs,
+                    latency.sleepMs,
+                    latency.framesInFlight
+            );
+            m_latency->setText(latencyText);
+        }
+
+        const auto& dynamicResolution = m_engineManager->getDynamicResolution();
+        m_renderScale->setText(
+                "Render scale: " + std::to_string(int(dynamicResolution->getScale() * 100.f + 0.5f)) +
+                "% (scene GPU ms: " + std::to_string(dynamicResolution->getGpuFrameTime()) + ")"
+        );
+
+        const RenderGraphStats& graphStats = m_engineManager->getRenderGraph()->getStats();
+        m_renderTargets->setText(
+                "Render targets: " + std::to_string(graphStats.physicalTargets) + " for " +
+                std::to_string(graphStats.transientTargets) + " transients, " +
+                std::to_string(graphStats.physicalBytes / (1024 * 1024)) + " of " +
+                std::to_string(graphStats.transientBytes / (1024 * 1024)) + " MB, " +
+                std::to_string(graphStats.passes - graphStats.culledPasses) + "/" +
+                std::to_string(graphStats.passes) + " passes"
+        );
+        markDirty();
+
         m_lastTimeStamp = glfwGetTime();
     }
 }
\ No newline at end of file
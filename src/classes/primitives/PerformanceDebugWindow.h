@@ -5,6 +5,7 @@
 namespace Engine
 {
     class EngineManager;
+    class FramePacer;
     class WindowManager;
 
     namespace Ui
@@ -22,11 +23,18 @@ namespace Engine
 
             private:
                 void onVsyncToggle(bool value);
+                void onLowLatencyToggle(bool value);
+                void onDynamicResolutionToggle(bool value);
+                void onFrameBudgetChange(float value);
 
                 std::shared_ptr<EngineManager> m_engineManager;
                 std::shared_ptr<WindowManager> m_windowManager;
+                std::shared_ptr<FramePacer> m_framePacer;
                 std::shared_ptr<UiElementPlot> m_fpsCounter;
                 std::shared_ptr<UiElementText> m_frameTimer;
+                std::shared_ptr<UiElementText> m_latency;
+                std::shared_ptr<UiElementText> m_renderScale;
+                std::shared_ptr<UiElementText> m_renderTargets;
 
                 // Fps counter stuff
                 void updateFrameCounter();
@@ -2,9 +2,11 @@
 
 #include "../engine/EngineManager.h"
 #include "../engine/WindowManager.h"
+#include "../engine/rendering/OcclusionCuller.h"
 #include "../engine/rendering/RenderManager.h"
 #include "../uiElements/UiElementColorEdit.h"
 #include "../uiElements/UiElementRadio.h"
+#include "../uiElements/UiElementText.h"
 
 using namespace Engine::Ui;
 
@@ -32,6 +34,30 @@ SceneSettingsDebugWindow::SceneSettingsDebugWindow()
     );
     addContent(wireframeRadio);
 
+    auto depthPrePassRadio = std::make_shared<UiElementRadio>(
+            m_engineManager->isDepthPrePassEnabled(),
+            "Depth pre-pass",
+            std::bind(&SceneSettingsDebugWindow::onDepthPrePassToggle, this, std::placeholders::_1)
+    );
+    addContent(depthPrePassRadio);
+
+    auto overdrawRadio = std::make_shared<UiElementRadio>(
+            m_engineManager->isOverdrawViewEnabled(),
+            "Overdraw",
+            std::bind(&SceneSettingsDebugWindow::onOverdrawToggle, this, std::placeholders::_1)
+    );
+    addContent(overdrawRadio);
+
+    auto occlusionCullingRadio = std::make_shared<UiElementRadio>(
+            m_engineManager->isOcclusionCullingEnabled(),
+            "Occlusion culling",
+            std::bind(&SceneSettingsDebugWindow::onOcclusionCullingToggle, this, std::placeholders::_1)
+    );
+    addContent(occlusionCullingRadio);
+
+    m_occlusionCounters = std::make_shared<UiElementText>("");
+    addContent(m_occlusionCounters);
+
     float* currClearColor = m_engineManager->getClearColor();
     const auto& clearColorCallback = ([this](float value[4]) { m_engineManager->setClearColor(value); });
     std::shared_ptr<UiElementColorEdit> clearColorEdit =
@@ -46,4 +72,30 @@ void SceneSettingsDebugWindow::onWireframeToggle(bool value) const
 
 void SceneSettingsDebugWindow::onGridToggle(bool value) const { m_engineManager->setGridVisibility(value); }
 
-void SceneSettingsDebugWindow::update() {}
\ No newline at end of file
+void SceneSettingsDebugWindow::onDepthPrePassToggle(bool value) const { m_engineManager->setDepthPrePass(value); }
+
+void SceneSettingsDebugWindow::onOverdrawToggle(bool value) const { m_engineManager->setOverdrawView(value); }
+
+void SceneSettingsDebugWindow::onOcclusionCullingToggle(bool value) const
+{
+    m_engineManager->setOcclusionCulling(value);
+}
+
+void SceneSettingsDebugWindow::update()
+{
+    std::string counters;
+    if(m_engineManager->isOcclusionCullingEnabled())
+    {
+        const OcclusionCullingStats& stats = m_engineManager->getOcclusionCuller()->getStats();
+        counters = "Visible: " + std::to_string(stats.visibleNodes) + ", culled: " +
+                   std::to_string(stats.occludedNodes) + " (" + std::to_string(stats.occludedGroups) + " groups), " +
+                   std::to_string(stats.queries) + " queries";
+    }
+
+    // The window only gets redrawn when the counters changed
+    if(counters != m_occlusionCounters->getText())
+    {
+        m_occlusionCounters->setText(counters);
+        markDirty();
+    }
+}
\ No newline at end of file
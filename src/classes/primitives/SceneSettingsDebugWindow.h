@@ -22,8 +22,12 @@ namespace Engine
             private:
                 void onWireframeToggle(bool value) const;
                 void onGridToggle(bool value) const;
+                void onDepthPrePassToggle(bool value) const;
+                void onOverdrawToggle(bool value) const;
+                void onOcclusionCullingToggle(bool value) const;
 
                 std::shared_ptr<EngineManager> m_engineManager;
+                std::shared_ptr<UiElementText> m_occlusionCounters;
         };
     } // namespace Ui
 } // namespace Engine
\ No newline at end of file
@@ -7,6 +7,8 @@
 #include "../../classes/uiElements/UiElementText.h"
 #include "MandelbrotUbo.h"
 
+#include <cstdio>
+
 using namespace Engine::Ui;
 
 MandelbrotDebugWindow::MandelbrotDebugWindow(const std::shared_ptr<MandelbrotUbo>& ubo) : m_mandelbrotUbo(ubo)
@@ -23,4 +25,30 @@ MandelbrotDebugWindow::MandelbrotDebugWindow(const std::shared_ptr<MandelbrotUbo
             std::make_shared<UiElementSlider<int>>(iterations, 0, 500, "x", iterationsCallback);
     iterationsEdit->setSameLine(true);
     addContent(iterationsEdit);
+
+    m_zoomText = std::make_shared<UiElementText>("");
+    addContent(m_zoomText);
+
+    m_kernelText = std::make_shared<UiElementText>("");
+    addContent(m_kernelText);
+    setDoubleFloat(false);
+}
+
+void MandelbrotDebugWindow::update()
+{
+    char zoom[32];
+    snprintf(zoom, sizeof(zoom), "Zoom: %.3g", m_mandelbrotUbo->getZoom());
+
+    // The window only gets redrawn when the zoom changed
+    if(m_zoomText->getText() != zoom)
+    {
+        m_zoomText->setText(zoom);
+        markDirty();
+    }
+}
+
+void MandelbrotDebugWindow::setDoubleFloat(bool doubleFloat)
+{
+    m_kernelText->setText(doubleFloat ? "Kernel: double-float (emulated)" : "Kernel: float");
+    markDirty();
 }
@@ -2,6 +2,11 @@
 
 #include "../../classes/nodeComponents/UiDebugWindow.h"
 
+namespace Engine::Ui
+{
+    class UiElementText;
+} // namespace Engine::Ui
+
 class MandelbrotUbo;
 
 class MandelbrotDebugWindow : public Engine::Ui::UiDebugWindow
@@ -10,6 +15,15 @@ class MandelbrotDebugWindow : public Engine::Ui::UiDebugWindow
         MandelbrotDebugWindow(const std::shared_ptr<MandelbrotUbo>& ubo);
         ~MandelbrotDebugWindow() = default;
 
+        void update() override;
+
+        /**
+         * @brief Shows which kernel the scene draws with.
+         */
+        void setDoubleFloat(bool doubleFloat);
+
     private:
         std::shared_ptr<MandelbrotUbo> m_mandelbrotUbo;
+        std::shared_ptr<Engine::Ui::UiElementText> m_zoomText;
+        std::shared_ptr<Engine::Ui::UiElementText> m_kernelText;
 };
\ No newline at end of file
@@ -10,7 +10,22 @@
 #include "MandelbrotDebugWindow.h"
 #include "MandelbrotUbo.h"
 
-MandelbrotSceneOrigin::MandelbrotSceneOrigin() : m_mandelbrotUbo(nullptr) {}
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+MandelbrotSceneOrigin::MandelbrotSceneOrigin() : m_mandelbrotUbo(nullptr), m_doubleFloat(false) {}
+
+Engine::SceneAssets MandelbrotSceneOrigin::getSceneAssets()
+{
+    Engine::SceneAssets assets;
+    assets.objects = { "resources/objects/plane.obj" };
+    assets.shaders = {
+        { "resources/shader/mandelbrot", "mandelbrot" },
+        { "resources/shader/mandelbrot", "mandelbrot", Engine::SHADER_FEATURE_DOUBLE_FLOAT },
+    };
+    return assets;
+}
 
 void MandelbrotSceneOrigin::start()
 {
@@ -23,9 +38,9 @@ void MandelbrotSceneOrigin::start()
 
     m_mandelbrotUbo = std::make_shared<MandelbrotUbo>();
     m_mandelbrotUbo->setScreenSize(SingletonManager::get<Engine::WindowManager>()->getWindowDimensions());
-    std::shared_ptr<BasicNode> mandelbrotDebugWindow = std::make_shared<MandelbrotDebugWindow>(m_mandelbrotUbo);
-    mandelbrotDebugWindow->setName("mandelbrotDebugWindow");
-    addChild(mandelbrotDebugWindow);
+    m_mandelbrotDebugWindow = std::make_shared<MandelbrotDebugWindow>(m_mandelbrotUbo);
+    m_mandelbrotDebugWindow->setName("mandelbrotDebugWindow");
+    addChild(m_mandelbrotDebugWindow);
 
     std::shared_ptr<Engine::CameraComponent> camera = std::make_shared<Engine::CameraComponent>();
     camera->setZFar(1000.f);
@@ -36,22 +51,27 @@ void MandelbrotSceneOrigin::start()
 
     const auto& renderManager = m_engineManager->getRenderManager();
 
-    std::shared_ptr<Engine::GeometryComponent> mandelbrotPlane = std::make_shared<Engine::GeometryComponent>();
-    mandelbrotPlane->setObjectData(renderManager->registerObject("resources/objects/plane.obj"));
-    mandelbrotPlane->setShader(std::make_shared<MandelbrotShader>(renderManager, m_mandelbrotUbo));
-    mandelbrotPlane->setPosition(glm::vec3(0.f, 0.f, 0.f));
+    // Both kernels are compiled up front, switching between them is only a matter of setting the shader
+    m_floatShader = std::make_shared<MandelbrotShader>(renderManager, m_mandelbrotUbo);
+    m_floatShader->bindUbo(m_mandelbrotUbo);
+    m_doubleFloatShader =
+            std::make_shared<MandelbrotShader>(renderManager, m_mandelbrotUbo, Engine::SHADER_FEATURE_DOUBLE_FLOAT);
+    m_doubleFloatShader->bindUbo(m_mandelbrotUbo);
+
+    m_mandelbrotPlane = std::make_shared<Engine::GeometryComponent>();
+    m_mandelbrotPlane->setObjectData(renderManager->registerObject("resources/objects/plane.obj"));
+    m_mandelbrotPlane->setShader(m_floatShader);
+    m_mandelbrotPlane->setPosition(glm::vec3(0.f, 0.f, 0.f));
 
     std::vector<glm::vec4> g_color_buffer_data;
-    for(int v = 0; v < mandelbrotPlane->getObjectData()->getVertexCount(); v++)
+    for(int v = 0; v < m_mandelbrotPlane->getObjectData()->getVertexCount(); v++)
     {
         g_color_buffer_data.emplace_back(1.f, 1.f, 1.f, 1.f);
     }
 
-    mandelbrotPlane->setTextureBuffer(renderManager->createBuffer(g_color_buffer_data));
-    mandelbrotPlane->setName("plane");
-    addChild(mandelbrotPlane);
-
-    mandelbrotPlane->getShader()->bindUbo(m_mandelbrotUbo);
+    m_mandelbrotPlane->setTextureBuffer(renderManager->createBuffer(g_color_buffer_data));
+    m_mandelbrotPlane->setName("plane");
+    addChild(m_mandelbrotPlane);
 }
 
 void MandelbrotSceneOrigin::increaseZoom()
@@ -60,7 +80,7 @@ void MandelbrotSceneOrigin::increaseZoom()
     auto currZoom = m_mandelbrotUbo->getZoom();
     auto newZoom = currZoom + (currZoom * 2) * deltaTime * 0.25f;
 
-    m_mandelbrotUbo->setZoom(newZoom);
+    m_mandelbrotUbo->setZoom(std::min(newZoom, MAX_ZOOM));
 }
 
 void MandelbrotSceneOrigin::decreaseZoom()
@@ -78,7 +98,7 @@ void MandelbrotSceneOrigin::moveCam(glm::vec2 movement)
     auto currZoom = m_mandelbrotUbo->getZoom();
     auto currOffset = m_mandelbrotUbo->getOffset();
     movement *= deltaTime * 400.f;
-    auto newOffset = currOffset + movement / currZoom;
+    auto newOffset = currOffset + glm::dvec2(movement) / currZoom;
 
     m_mandelbrotUbo->setOffset(newOffset);
 }
@@ -108,4 +128,25 @@ void MandelbrotSceneOrigin::update()
     {
         moveCam(movement);
     }
+
+    updateKernel();
+}
+
+void MandelbrotSceneOrigin::updateKernel()
+{
+    // The distance between neighbouring floats grows with the coordinates, the view reaches out about 2 units
+    const glm::dvec2 offset = m_mandelbrotUbo->getOffset();
+    const double coordinateScale = std::max({ std::abs(offset.x), std::abs(offset.y), 2.0 });
+    const double pixelSteps = 1.0 / (m_mandelbrotUbo->getZoom() * coordinateScale * FLT_EPSILON);
+
+    const bool doubleFloat = m_doubleFloat ? pixelSteps < MIN_PIXEL_STEPS * SWITCH_BACK_FACTOR
+                                           : pixelSteps < MIN_PIXEL_STEPS;
+    if(doubleFloat == m_doubleFloat)
+    {
+        return;
+    }
+
+    m_doubleFloat = doubleFloat;
+    m_mandelbrotPlane->setShader(m_doubleFloat ? m_doubleFloatShader : m_floatShader);
+    m_mandelbrotDebugWindow->setDoubleFloat(m_doubleFloat);
 }
\ No newline at end of file
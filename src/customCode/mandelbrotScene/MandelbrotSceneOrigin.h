@@ -1,13 +1,17 @@
 #pragma once
 
+#include "../../classes/engine/SceneManager.h"
 #include "../../classes/nodeComponents/BasicNode.h"
 
 namespace Engine
 {
     class EngineManager;
+    class GeometryComponent;
     class UserEventManager;
 } // namespace Engine
 
+class MandelbrotDebugWindow;
+class MandelbrotShader;
 class MandelbrotUbo;
 
 class MandelbrotSceneOrigin : public Engine::BasicNode
@@ -16,6 +20,11 @@ class MandelbrotSceneOrigin : public Engine::BasicNode
         MandelbrotSceneOrigin();
         ~MandelbrotSceneOrigin() = default;
 
+        /**
+         * @brief The assets start() registers, for preloading the scene through the SceneManager.
+         */
+        static Engine::SceneAssets getSceneAssets();
+
         void increaseZoom();
         void decreaseZoom();
         void moveCam(glm::vec2 movement);
@@ -27,5 +36,23 @@ class MandelbrotSceneOrigin : public Engine::BasicNode
         void start() override;
         void update() override;
 
+        /**
+         * @brief Switches the plane to the emulated double precision kernel once a pixel spans too few floats at
+         * the current zoom & back to the fast one when zooming out again.
+         */
+        void updateKernel();
+
         std::shared_ptr<MandelbrotUbo> m_mandelbrotUbo;
+        std::shared_ptr<MandelbrotDebugWindow> m_mandelbrotDebugWindow;
+        std::shared_ptr<Engine::GeometryComponent> m_mandelbrotPlane;
+        std::shared_ptr<MandelbrotShader> m_floatShader;
+        std::shared_ptr<MandelbrotShader> m_doubleFloatShader;
+        bool m_doubleFloat;
+
+        // Float steps a pixel has to span at least, fewer show up as blocks
+        static constexpr double MIN_PIXEL_STEPS = 16.0;
+        // Zooming out switches back only once a pixel spans this many times more steps, so it doesn't flicker
+        static constexpr double SWITCH_BACK_FACTOR = 2.0;
+        // Past this the double-float kernel runs out of precision as well
+        static constexpr double MAX_ZOOM = 1e13;
 };
@@ -1,9 +1,21 @@
-
 #include "MandelbrotUbo.h"
 
+#include <utility>
+
+namespace
+{
+    // The float closest to the value & the rounding error of it
+    std::pair<float, float> splitDouble(double value)
+    {
+        const auto high = static_cast<float>(value);
+        return { high, static_cast<float>(value - static_cast<double>(high)) };
+    }
+} // namespace
+
 MandelbrotUbo::MandelbrotUbo() : m_iterations(300), m_zoom(400), m_screenSize(1200, 600), m_offset(0, 0)
 {
-    setSize(24);
+    // std140 rounds the block up to a multiple of 16 bytes
+    setSize(48);
     setBindingPoint({ "MandelbrotBlock", 5 });
 
     setupUbo();
@@ -12,9 +24,9 @@ MandelbrotUbo::MandelbrotUbo() : m_iterations(300), m_zoom(400), m_screenSize(12
 void MandelbrotUbo::UpdateUbo()
 {
     LoadVariable(m_iterations, 0);
-    LoadVariable(m_zoom, 4);
     LoadVariable(m_screenSize, 8);
-    LoadVariable(m_offset, 16);
+    loadZoom();
+    loadOffset();
 }
 
 void MandelbrotUbo::resetData()
@@ -33,10 +45,10 @@ void MandelbrotUbo::setIterations(int itr)
     LoadVariable(m_iterations, 0);
 }
 
-void MandelbrotUbo::setZoom(float zoom)
+void MandelbrotUbo::setZoom(double zoom)
 {
     m_zoom = zoom;
-    LoadVariable(m_zoom, 4);
+    loadZoom();
 }
 
 void MandelbrotUbo::setScreenSize(glm::vec2 screenSize)
@@ -45,8 +57,23 @@ void MandelbrotUbo::setScreenSize(glm::vec2 screenSize)
     LoadVariable(m_screenSize, 8);
 }
 
-void MandelbrotUbo::setOffset(glm::vec2 offset)
+void MandelbrotUbo::setOffset(glm::dvec2 offset)
 {
     m_offset = offset;
-    LoadVariable(m_offset, 16);
+    loadOffset();
+}
+
+void MandelbrotUbo::loadZoom()
+{
+    const auto [high, low] = splitDouble(m_zoom);
+    LoadVariable(high, 4);
+    LoadVariable(low, 32);
+}
+
+void MandelbrotUbo::loadOffset()
+{
+    const auto [highX, lowX] = splitDouble(m_offset.x);
+    const auto [highY, lowY] = splitDouble(m_offset.y);
+    LoadVariable(glm::vec2(highX, highY), 16);
+    LoadVariable(glm::vec2(lowX, lowY), 24);
 }
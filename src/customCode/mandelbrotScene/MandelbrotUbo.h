@@ -3,6 +3,10 @@
 
 #include <glm/vec2.hpp>
 
+/**
+ * Zoom & offset are kept as doubles & uploaded as pairs of floats, the high part being the value rounded to a float
+ * & the low part what got lost by the rounding. The float kernel of the shader only reads the high parts.
+ */
 class MandelbrotUbo : public Engine::UboBlock
 {
     public:
@@ -15,23 +19,26 @@ class MandelbrotUbo : public Engine::UboBlock
 
         void setIterations(int itr);
 
-        float getZoom() const { return m_zoom; };
+        double getZoom() const { return m_zoom; };
 
-        void setZoom(float zoom);
+        void setZoom(double zoom);
 
         glm::vec2 getScreenSize() const { return m_screenSize; };
 
         void setScreenSize(glm::vec2 screenSize);
 
-        glm::vec2 getOffset() const { return m_offset; };
+        glm::dvec2 getOffset() const { return m_offset; };
 
-        void setOffset(glm::vec2 offset);
+        void setOffset(glm::dvec2 offset);
 
         void resetData();
 
     private:
+        void loadZoom();
+        void loadOffset();
+
         int m_iterations;
-        float m_zoom;
+        double m_zoom;
         glm::vec2 m_screenSize;
-        glm::vec2 m_offset;
-};
\ No newline at end of file
+        glm::dvec2 m_offset;
+};
@@ -4,15 +4,32 @@
 #include "../../classes/engine/EngineManager.h"
 #include "../../classes/engine/UserEventManager.h"
 #include "../../classes/engine/WindowManager.h"
+#include "../../classes/engine/rendering/ShaderFeatures.h"
+#include "../../classes/nodeComponents/ParticleEmitter.h"
 #include "../../classes/primitives/DebugManagerWindow.h"
 #include "../../resources/shader/ColorShader.h"
 #include "../../resources/shader/TextureShader.h"
 #include "CameraActor.h"
 #include "TestObject.h"
 
+Engine::SceneAssets TestSceneOrigin::getSceneAssets()
+{
+    Engine::SceneAssets assets;
+    assets.objects = { "resources/objects/tree.obj", "resources/objects/suzanne.obj" };
+    assets.textures = { "resources/textures/treeTexture.bmp" };
+    // The TextureShader of the tree & the ColorShader of the ape
+    const unsigned int textureFeatures = SHADER_FEATURE_TEXTURED | SHADER_FEATURE_LIT | SHADER_FEATURE_ALPHA;
+    const unsigned int colorFeatures = SHADER_FEATURE_VERTEX_COLOR | SHADER_FEATURE_LIT | SHADER_FEATURE_ALPHA;
+    assets.shaders = { { "resources/shader/standard", "standard", textureFeatures },
+                       { "resources/shader/standard", "standard", colorFeatures } };
+    return assets;
+}
+
 void TestSceneOrigin::start()
 {
     m_engineManager = SingletonManager::get<EngineManager>();
+    // The tree covers itself many times over, its lit & textured fragments only get shaded once this way
+    m_engineManager->setDepthPrePass(true);
 
     std::shared_ptr<BasicNode> debugWindow = std::make_shared<Engine::Ui::DebugManagerWindow>();
     debugWindow->setName("debugWindow");
@@ -43,6 +60,17 @@ void TestSceneOrigin::start()
     m_tree->setTint(glm::vec4(1.f, 1.f, 1.f, 1.f));
     addChild(m_tree);
 
+    const auto sparks = std::make_shared<ParticleEmitter>();
+    sparks->setPosition(glm::vec3(0.f, 2.f, 0.f));
+    sparks->setEmissionRate(2000.f);
+    sparks->setEmissionRadius(0.2f);
+    sparks->setSpeed(3.f, 5.f);
+    sparks->setColor(glm::vec4(1.f, 0.8f, 0.3f, 1.f), glm::vec4(1.f, 0.2f, 0.f, 0.f));
+    sparks->setSize(0.08f, 0.02f);
+    sparks->setBlendMode(PARTICLE_BLEND_ADDITIVE);
+    sparks->setName("sparks");
+    m_tree->addChild(sparks);
+
     m_ape = std::make_shared<TestObject>();
     m_ape->setObjectData(renderManager->registerObject("resources/objects/suzanne.obj"));
     m_ape->setShader(std::make_shared<ColorShader>(renderManager));
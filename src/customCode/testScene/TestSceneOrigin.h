@@ -1,5 +1,6 @@
 #pragma once
 
+#include "../../classes/engine/SceneManager.h"
 #include "../../classes/nodeComponents/BasicNode.h"
 
 namespace Engine
@@ -16,6 +17,11 @@ class TestSceneOrigin : public Engine::BasicNode
         TestSceneOrigin() = default;
         ~TestSceneOrigin() = default;
 
+        /**
+         * @brief The assets start() registers, for preloading the scene through the SceneManager.
+         */
+        static Engine::SceneAssets getSceneAssets();
+
     private:
         std::shared_ptr<Engine::EngineManager> m_engineManager;
 
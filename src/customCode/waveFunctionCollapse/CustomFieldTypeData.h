@@ -37,6 +37,26 @@ inline static glm::vec3 EnumToColorValue(int field)
     }
 }
 
+// Cost of walking onto a tile for NavigationGrid, 0 can't be walked on
+inline static uint8_t GetNavigationCost(int field)
+{
+    switch(field)
+    {
+        case FieldTypeEnum::shallowWater:
+            return 4;
+        case FieldTypeEnum::beach:
+            return 2;
+        case FieldTypeEnum::grass:
+            return 1;
+        case FieldTypeEnum::stone:
+            return 2;
+        case FieldTypeEnum::hill:
+            return 3;
+        default:
+            return 0;
+    }
+}
+
 struct DeepWaterFieldDataStruct : BasicFieldDataStruct
 {
         DeepWaterFieldDataStruct();
@@ -2,7 +2,9 @@
 #include "IslandGenerator.h"
 
 #include "../../classes/engine/UserEventManager.h"
+#include "../../classes/engine/rendering/lighting/LightBaker.h"
 #include "../../classes/nodeComponents/GeometryComponent.h"
+#include "../../resources/shader/BakedShader.h"
 #include "../../resources/shader/ColorShader.h"
 #include "CustomFieldTypeData.h"
 #include "Field.h"
@@ -15,6 +17,10 @@ IslandGenerator::IslandGenerator(const glm::ivec2& gridDimensions, const double&
 
 void IslandGenerator::start()
 {
+    const auto& renderManager = SingletonManager::get<Engine::EngineManager>()->getRenderManager();
+    m_tileShader = std::make_shared<ColorShader>(renderManager);
+    m_lightBaker = std::make_shared<Engine::Lighting::LightBaker>();
+
     addFieldTypes({ DeepWaterFieldDataStruct(),
                     ShallowWaterFieldDataStruct(),
                     BeachFieldDataStruct(),
@@ -26,15 +32,52 @@ void IslandGenerator::start()
     addDefaultTiles(true, true, (int)(((float)GRID_SIZE.x * (float)GRID_SIZE.y) * 0.005f));
     generateGrid();
 
+    m_navigation = std::make_shared<NavigationGrid>(GRID_SIZE);
+    for(const auto& [pos, cost] : m_pendingTileCosts)
+    {
+        m_navigation->setTileCost(pos, cost);
+    }
+    m_pendingTileCosts.clear();
+    m_navigation->build();
+
+    m_lightBaker->bakeAsync(*renderManager->getAmbientLightUbo(), *renderManager->getDiffuseLightUbo());
+
     // getUserEventManager()->addListener(std::pair<int, int>(GLFW_KEY_SPACE, GLFW_PRESS), ([this]() { generateNextField(); }));
 }
 
+void IslandGenerator::update()
+{
+    if(m_navigation)
+    {
+        m_navigation->update();
+    }
+
+    if(!m_lightBaker || !m_lightBaker->isBakeFinished())
+    {
+        return;
+    }
+
+    const auto& renderManager = SingletonManager::get<Engine::EngineManager>()->getRenderManager();
+    m_bakedTileShader = std::make_shared<BakedShader>(renderManager);
+    m_lightBaker->applyBakedLighting(m_bakedTileShader);
+    m_lightBaker = nullptr;
+}
+
 void IslandGenerator::setFieldCallback(const std::shared_ptr<Field>& field, const BasicFieldDataStruct& tileType)
 {
     static const float startPosX = (FIELD_SIZE.x * ((float)GRID_SIZE.x - 1.f)) / 2.f;
     static const float startPosY = (FIELD_SIZE.y * ((float)GRID_SIZE.y - 1.f)) / 2.f;
 
     const glm::ivec2 fieldPos = field->getPosition();
+    if(m_navigation)
+    {
+        m_navigation->setTileCost(fieldPos, GetNavigationCost(tileType.uniqueTileTypeId));
+    }
+    else
+    {
+        m_pendingTileCosts.emplace_back(fieldPos, GetNavigationCost(tileType.uniqueTileTypeId));
+    }
+
     const float posX = (fieldPos.x * FIELD_SIZE.x) - startPosX;
     const float posY = (fieldPos.y * FIELD_SIZE.y) - startPosY;
 
@@ -43,7 +86,7 @@ void IslandGenerator::setFieldCallback(const std::shared_ptr<Field>& field, cons
 
     std::shared_ptr<Engine::GeometryComponent> planeObj = std::make_shared<Engine::GeometryComponent>();
     planeObj->setObjectData(renderManager->registerObject("resources/objects/plane.obj"));
-    planeObj->setShader(std::make_shared<ColorShader>(renderManager));
+    planeObj->setShader(m_tileShader);
     planeObj->setRotation(glm::vec3(-90.f, 0.f, 0.f));
     planeObj->setPosition(glm::vec3(posX, 0.f, posY));
 
@@ -56,7 +99,12 @@ void IslandGenerator::setFieldCallback(const std::shared_ptr<Field>& field, cons
 
     planeObj->setTextureBuffer(renderManager->createBuffer(g_color_buffer_data));
 
-    addChild(planeObj);
+    // An island has thousands of tiles, they join the scene together with the next flush
+    addChildDeferred(planeObj);
+
+    // The tile only joins the generator with the next flush, its global transform is composed here
+    const glm::mat4 modelMatrix = getGlobalModelMatrix() * planeObj->getModelMatrix();
+    m_lightBaker->addStaticGeometry(planeObj, glm::vec4(color, 1.f), modelMatrix);
 }
 
 void IslandGenerator::addDefaultTiles(const bool waterOnEdges, const bool landInMiddle, const uint8_t landTilesToAdd)
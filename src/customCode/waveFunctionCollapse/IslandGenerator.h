@@ -2,8 +2,19 @@
 
 #include "../../classes/nodeComponents/BasicNode.h"
 #include "FieldTypeUtils.h"
+#include "NavigationGrid.h"
 #include "WafeFunctionCollapseGenerator.h"
 
+namespace Engine
+{
+    class Shader;
+
+    namespace Lighting
+    {
+        class LightBaker;
+    }
+} // namespace Engine
+
 class IslandGenerator
     : public Engine::BasicNode
     , public WafeFunctionCollapseGenerator
@@ -12,11 +23,26 @@ class IslandGenerator
         IslandGenerator(const glm::ivec2& gridDimensions, const double& seed = 0);
         ~IslandGenerator() = default;
 
+        /**
+         * @return The pathfinding grid of the island, nullptr until the island got generated
+         */
+        const std::shared_ptr<NavigationGrid>& getNavigation() const { return m_navigation; }
+
     protected:
         void addDefaultTiles(const bool waterOnEdges, const bool landInMiddle, const uint8_t landTilesToAdd);
         void setFieldCallback(const std::shared_ptr<Field>& field, const BasicFieldDataStruct& tileType) override;
         void start() override;
+        void update() override;
 
     private:
         static inline glm::vec2 FIELD_SIZE = glm::vec2(0.f);
+
+        // The island is static after generation, so its lighting gets baked once instead of shaded every frame
+        std::shared_ptr<Engine::Shader> m_tileShader;
+        std::shared_ptr<Engine::Shader> m_bakedTileShader;
+        std::shared_ptr<Engine::Lighting::LightBaker> m_lightBaker;
+
+        // Tile costs get collected while generating, the grid is built once at the end & updated per changed cluster
+        std::vector<std::pair<glm::ivec2, uint8_t>> m_pendingTileCosts;
+        std::shared_ptr<NavigationGrid> m_navigation;
 };
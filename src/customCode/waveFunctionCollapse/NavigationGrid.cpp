@@ -0,0 +1,848 @@
+#include "NavigationGrid.h"
+
+#include "../../classes/engine/ThreadPool.h"
+#include "FieldTypeUtils.h"
+
+#include <glm/glm.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <set>
+
+namespace
+{
+    const std::vector<glm::ivec2> NEIGHBOR_OFFSETS = GetNeighborOffsets();
+
+    constexpr uint32_t STRAIGHT_STEP = 10;
+    constexpr uint32_t DIAGONAL_STEP = 14;
+
+    bool isDiagonal(int direction)
+    {
+        return NEIGHBOR_OFFSETS[direction].x != 0 && NEIGHBOR_OFFSETS[direction].y != 0;
+    }
+
+    // Priority in the upper & index in the lower half, so the heap only compares plain integers
+    using OpenEntry = uint64_t;
+
+    void pushOpen(std::vector<OpenEntry>& open, uint32_t priority, int index)
+    {
+        open.push_back((OpenEntry(priority) << 32) | uint32_t(index));
+        std::push_heap(open.begin(), open.end(), std::greater<>());
+    }
+
+    std::pair<uint32_t, int> popOpen(std::vector<OpenEntry>& open)
+    {
+        std::pop_heap(open.begin(), open.end(), std::greater<>());
+        const OpenEntry entry = open.back();
+        open.pop_back();
+        return { uint32_t(entry >> 32), int(uint32_t(entry)) };
+    }
+
+    /**
+     * @brief Per thread search state. Generation stamps mark valid entries, so nothing needs clearing between queries.
+     */
+    struct SearchScratch
+    {
+            std::vector<uint32_t> costs;
+            std::vector<uint32_t> stamps;
+            std::vector<int> parents;
+            std::vector<uint32_t> targetStamps;
+            std::vector<OpenEntry> open;
+            uint32_t generation = 0;
+
+            void reset(size_t size)
+            {
+                if(costs.size() < size)
+                {
+                    costs.resize(size);
+                    stamps.resize(size, 0);
+                    parents.resize(size);
+                    targetStamps.resize(size, 0);
+                }
+                if(++generation == 0)
+                {
+                    std::fill(stamps.begin(), stamps.end(), 0);
+                    std::fill(targetStamps.begin(), targetStamps.end(), 0);
+                    generation = 1;
+                }
+                open.clear();
+            }
+
+            uint32_t getCost(int index) const
+            {
+                return stamps[index] == generation ? costs[index] : NavigationGrid::UNREACHABLE;
+            }
+
+            void setCost(int index, uint32_t cost, int parent)
+            {
+                costs[index] = cost;
+                stamps[index] = generation;
+                parents[index] = parent;
+            }
+    };
+
+    // Local searches index the tiles relative to their bounds, the abstract search indexes nodes
+    thread_local SearchScratch s_localScratch;
+    thread_local SearchScratch s_abstractScratch;
+} // namespace
+
+bool FlowField::isReachable(const glm::ivec2& pos) const
+{
+    if(pos.x < 0 || pos.y < 0 || pos.x >= dimensions.x || pos.y >= dimensions.y)
+    {
+        return false;
+    }
+    return integration[pos.y * dimensions.x + pos.x] != NavigationGrid::UNREACHABLE;
+}
+
+glm::ivec2 FlowField::getDirection(const glm::ivec2& pos) const
+{
+    if(!isReachable(pos))
+    {
+        return glm::ivec2(0);
+    }
+
+    const int direction = directions[pos.y * dimensions.x + pos.x];
+    return direction < 0 ? glm::ivec2(0) : NEIGHBOR_OFFSETS[direction];
+}
+
+NavigationGrid::NavigationGrid(const glm::ivec2& dimensions, int clusterSize /* = 16 */)
+    : m_dimensions(dimensions)
+    , m_clusterSize(std::max(clusterSize, 2))
+    , m_clusterCount((dimensions + m_clusterSize - 1) / m_clusterSize)
+    , m_costs(size_t(dimensions.x) * size_t(dimensions.y), 0)
+    , m_stepMasks(m_costs.size(), 0)
+    , m_clusterNodes(size_t(m_clusterCount.x) * size_t(m_clusterCount.y))
+    , m_clusterDirty(m_clusterNodes.size(), false)
+{
+}
+
+void NavigationGrid::setTileCost(const glm::ivec2& pos, uint8_t cost)
+{
+    if(!isInside(pos) || m_costs[toCell(pos)] == cost)
+    {
+        return;
+    }
+    m_costs[toCell(pos)] = cost;
+
+    // Steps are checked in every search, so their walkability is kept up to date here instead
+    updateStepMask(pos);
+    for(const glm::ivec2& offset : NEIGHBOR_OFFSETS)
+    {
+        if(isInside(pos + offset))
+        {
+            updateStepMask(pos + offset);
+        }
+    }
+
+    const int cluster = getCluster(pos);
+    if(!m_clusterDirty[cluster])
+    {
+        m_clusterDirty[cluster] = true;
+        m_dirtyClusters.push_back(cluster);
+    }
+
+    std::lock_guard<std::mutex> lock(m_flowFieldMutex);
+    m_flowFields.clear();
+}
+
+uint8_t NavigationGrid::getTileCost(const glm::ivec2& pos) const
+{
+    return isInside(pos) ? m_costs[toCell(pos)] : 0;
+}
+
+void NavigationGrid::build()
+{
+    m_nodes.clear();
+    m_freeNodes.clear();
+    for(std::vector<uint32_t>& nodes : m_clusterNodes)
+    {
+        nodes.clear();
+    }
+
+    for(int y = 0; y < m_clusterCount.y; y++)
+    {
+        for(int x = 0; x < m_clusterCount.x; x++)
+        {
+            const int cluster = y * m_clusterCount.x + x;
+            if(x + 1 < m_clusterCount.x)
+            {
+                createEntrances(cluster, cluster + 1);
+            }
+            if(y + 1 < m_clusterCount.y)
+            {
+                createEntrances(cluster, cluster + m_clusterCount.x);
+            }
+        }
+    }
+
+    // Clusters only write the edges of their own nodes, so they can be connected in parallel
+    SingletonManager::get<Engine::ThreadPool>()->parallelFor(
+            m_clusterNodes.size(),
+            [this](size_t begin, size_t end)
+            {
+                for(size_t cluster = begin; cluster < end; cluster++)
+                {
+                    connectClusterNodes(int(cluster));
+                }
+            },
+            16
+    );
+
+    for(int cluster : m_dirtyClusters)
+    {
+        m_clusterDirty[cluster] = false;
+    }
+    m_dirtyClusters.clear();
+}
+
+void NavigationGrid::update()
+{
+    if(m_dirtyClusters.empty())
+    {
+        return;
+    }
+
+    // The entrances on all four borders of a dirty cluster may have changed, and with them the nodes of the neighbors
+    std::set<std::pair<int, int>> borders;
+    std::set<int> affected;
+    for(int cluster : m_dirtyClusters)
+    {
+        const glm::ivec2 clusterPos(cluster % m_clusterCount.x, cluster / m_clusterCount.x);
+        affected.insert(cluster);
+
+        if(clusterPos.x > 0)
+        {
+            borders.emplace(cluster - 1, cluster);
+            affected.insert(cluster - 1);
+        }
+        if(clusterPos.x + 1 < m_clusterCount.x)
+        {
+            borders.emplace(cluster, cluster + 1);
+            affected.insert(cluster + 1);
+        }
+        if(clusterPos.y > 0)
+        {
+            borders.emplace(cluster - m_clusterCount.x, cluster);
+            affected.insert(cluster - m_clusterCount.x);
+        }
+        if(clusterPos.y + 1 < m_clusterCount.y)
+        {
+            borders.emplace(cluster, cluster + m_clusterCount.x);
+            affected.insert(cluster + m_clusterCount.x);
+        }
+
+        m_clusterDirty[cluster] = false;
+    }
+    m_dirtyClusters.clear();
+
+    for(const auto& [clusterA, clusterB] : borders)
+    {
+        removeEntrances(clusterA, clusterB);
+        createEntrances(clusterA, clusterB);
+    }
+
+    const std::vector<int> clusters(affected.begin(), affected.end());
+    SingletonManager::get<Engine::ThreadPool>()->parallelFor(
+            clusters.size(),
+            [this, &clusters](size_t begin, size_t end)
+            {
+                for(size_t i = begin; i < end; i++)
+                {
+                    connectClusterNodes(clusters[i]);
+                }
+            },
+            4
+    );
+}
+
+std::vector<glm::ivec2> NavigationGrid::findPath(const glm::ivec2& start, const glm::ivec2& goal) const
+{
+    std::vector<glm::ivec2> path;
+    if(!isWalkable(start) || !isWalkable(goal))
+    {
+        return path;
+    }
+
+    const int startCell = toCell(start);
+    const int goalCell = toCell(goal);
+    const int startCluster = getCluster(start);
+    const int goalCluster = getCluster(goal);
+
+    path.push_back(start);
+    if(startCell == goalCell)
+    {
+        return path;
+    }
+
+    // Short paths between the same or touching clusters usually don't need the abstract graph at all
+    if(std::abs(startCluster % m_clusterCount.x - goalCluster % m_clusterCount.x) <= 1 &&
+       std::abs(startCluster / m_clusterCount.x - goalCluster / m_clusterCount.x) <= 1)
+    {
+        const Bounds startBounds = getClusterBounds(startCluster);
+        const Bounds goalBounds = getClusterBounds(goalCluster);
+        const Bounds bounds = { glm::min(startBounds.min, goalBounds.min), glm::max(startBounds.max, goalBounds.max) };
+        if(findLocalPath(startCell, goalCell, bounds, path))
+        {
+            return path;
+        }
+    }
+
+    // Connect start & goal to the nodes of their clusters
+    std::vector<int> startTargets;
+    for(uint32_t node : m_clusterNodes[startCluster])
+    {
+        startTargets.push_back(m_nodes[node].cell);
+    }
+    std::vector<uint32_t> startCosts;
+    searchLocal(startCell, getClusterBounds(startCluster), false, startTargets, startCosts);
+
+    std::vector<int> goalTargets;
+    for(uint32_t node : m_clusterNodes[goalCluster])
+    {
+        goalTargets.push_back(m_nodes[node].cell);
+    }
+    std::vector<uint32_t> goalCosts;
+    searchLocal(goalCell, getClusterBounds(goalCluster), true, goalTargets, goalCosts);
+
+    // A* over the abstract graph, with two virtual nodes for start & goal
+    const int startNode = int(m_nodes.size());
+    const int goalNode = startNode + 1;
+    SearchScratch& scratch = s_abstractScratch;
+    scratch.reset(m_nodes.size() + 2);
+    scratch.setCost(startNode, 0, -1);
+    pushOpen(scratch.open, getHeuristic(start, goal), startNode);
+
+    const auto relax = [&](int from, int to, uint32_t edgeCost)
+    {
+        const uint32_t cost = scratch.getCost(from) + edgeCost;
+        if(cost < scratch.getCost(to))
+        {
+            scratch.setCost(to, cost, from);
+            const uint32_t heuristic = to == goalNode ? 0 : getHeuristic(toPos(m_nodes[to].cell), goal);
+            pushOpen(scratch.open, cost + heuristic, to);
+        }
+    };
+
+    bool found = false;
+    while(!scratch.open.empty())
+    {
+        const auto [priority, current] = popOpen(scratch.open);
+        if(current == goalNode)
+        {
+            found = true;
+            break;
+        }
+        const uint32_t heuristic = current == startNode ? getHeuristic(start, goal)
+                                                        : getHeuristic(toPos(m_nodes[current].cell), goal);
+        if(priority > scratch.getCost(current) + heuristic)
+        {
+            continue; // Outdated entry
+        }
+
+        if(current == startNode)
+        {
+            for(size_t i = 0; i < startCosts.size(); i++)
+            {
+                if(startCosts[i] != UNREACHABLE)
+                {
+                    relax(current, int(m_clusterNodes[startCluster][i]), startCosts[i]);
+                }
+            }
+            continue;
+        }
+
+        const AbstractNode& node = m_nodes[current];
+        for(const AbstractEdge& edge : node.edges)
+        {
+            relax(current, int(edge.to), edge.cost);
+        }
+        if(node.peer >= 0)
+        {
+            relax(current, node.peer, node.peerCost);
+        }
+        if(node.cluster == goalCluster)
+        {
+            const auto& goalNodes = m_clusterNodes[goalCluster];
+            const size_t index = std::find(goalNodes.begin(), goalNodes.end(), uint32_t(current)) - goalNodes.begin();
+            if(goalCosts[index] != UNREACHABLE)
+            {
+                relax(current, goalNode, goalCosts[index]);
+            }
+        }
+    }
+
+    if(!found)
+    {
+        return {};
+    }
+
+    std::vector<int> abstractPath;
+    for(int node = scratch.parents[goalNode]; node != startNode; node = scratch.parents[node])
+    {
+        abstractPath.push_back(node);
+    }
+    std::reverse(abstractPath.begin(), abstractPath.end());
+
+    // Refine the abstract path, every hop is either an entrance crossing or lies within one cluster
+    int previous = startNode;
+    int previousCell = startCell;
+    for(int node : abstractPath)
+    {
+        const int cell = m_nodes[node].cell;
+        if(previous != startNode && m_nodes[previous].peer == node)
+        {
+            path.push_back(toPos(cell));
+        }
+        else if(cell != previousCell)
+        {
+            const int cluster = previous == startNode ? startCluster : m_nodes[previous].cluster;
+            findLocalPath(previousCell, cell, getClusterBounds(cluster), path);
+        }
+        previous = node;
+        previousCell = cell;
+    }
+    if(previousCell != goalCell)
+    {
+        findLocalPath(previousCell, goalCell, getClusterBounds(goalCluster), path);
+    }
+
+    return path;
+}
+
+void NavigationGrid::findPaths(
+        const std::vector<std::pair<glm::ivec2, glm::ivec2>>& queries,
+        std::vector<std::vector<glm::ivec2>>& paths
+) const
+{
+    paths.resize(queries.size());
+    SingletonManager::get<Engine::ThreadPool>()->parallelFor(
+            queries.size(),
+            [this, &queries, &paths](size_t begin, size_t end)
+            {
+                for(size_t i = begin; i < end; i++)
+                {
+                    paths[i] = findPath(queries[i].first, queries[i].second);
+                }
+            },
+            16
+    );
+}
+
+std::shared_ptr<const FlowField> NavigationGrid::getFlowField(const glm::ivec2& goal) const
+{
+    if(!isInside(goal))
+    {
+        return nullptr;
+    }
+
+    const int goalCell = toCell(goal);
+    {
+        std::lock_guard<std::mutex> lock(m_flowFieldMutex);
+        const auto iterator = m_flowFields.find(goalCell);
+        if(iterator != m_flowFields.end())
+        {
+            return iterator->second;
+        }
+    }
+
+    std::shared_ptr<FlowField> flowField = std::make_shared<FlowField>();
+    flowField->goal = goal;
+    flowField->dimensions = m_dimensions;
+    flowField->integration.assign(m_costs.size(), UNREACHABLE);
+    flowField->directions.assign(m_costs.size(), -1);
+
+    // Dijkstra from the goal over the whole grid. Step costs are small integers, so a ring of buckets (Dial's
+    // algorithm) replaces the heap
+    std::vector<uint32_t>& integration = flowField->integration;
+    if(isWalkable(goal))
+    {
+        constexpr uint32_t BUCKET_COUNT = 255 * DIAGONAL_STEP + 1;
+        std::vector<std::vector<int>> buckets(BUCKET_COUNT);
+        std::vector<int> bucket;
+        size_t pending = 1;
+        integration[goalCell] = 0;
+        buckets[0].push_back(goalCell);
+
+        for(uint32_t cost = 0; pending > 0; cost++)
+        {
+            bucket.clear();
+            std::swap(bucket, buckets[cost % BUCKET_COUNT]);
+            pending -= bucket.size();
+
+            for(int cell : bucket)
+            {
+                if(integration[cell] != cost)
+                {
+                    continue;
+                }
+
+                const glm::ivec2 pos = toPos(cell);
+                for(int direction = 0; direction < 8; direction++)
+                {
+                    if(!canStep(pos, direction))
+                    {
+                        continue;
+                    }
+
+                    // Coming from the neighbor means entering this tile
+                    const int neighbor = toCell(pos + NEIGHBOR_OFFSETS[direction]);
+                    const uint32_t neighborCost = cost + getStepCost(pos, direction);
+                    if(neighborCost < integration[neighbor])
+                    {
+                        integration[neighbor] = neighborCost;
+                        buckets[neighborCost % BUCKET_COUNT].push_back(neighbor);
+                        pending++;
+                    }
+                }
+            }
+        }
+    }
+
+    SingletonManager::get<Engine::ThreadPool>()->parallelFor(
+            size_t(m_dimensions.y),
+            [this, &flowField, &integration](size_t begin, size_t end)
+            {
+                for(int y = int(begin); y < int(end); y++)
+                {
+                    for(int x = 0; x < m_dimensions.x; x++)
+                    {
+                        const glm::ivec2 pos(x, y);
+                        const int cell = toCell(pos);
+                        if(integration[cell] == 0 || integration[cell] == UNREACHABLE)
+                        {
+                            continue;
+                        }
+
+                        uint32_t bestCost = UNREACHABLE;
+                        for(int direction = 0; direction < 8; direction++)
+                        {
+                            if(!canStep(pos, direction))
+                            {
+                                continue;
+                            }
+
+                            const glm::ivec2 next = pos + NEIGHBOR_OFFSETS[direction];
+                            const uint32_t cost = integration[toCell(next)];
+                            if(cost != UNREACHABLE && cost + getStepCost(next, direction) < bestCost)
+                            {
+                                bestCost = cost + getStepCost(next, direction);
+                                flowField->directions[cell] = int8_t(direction);
+                            }
+                        }
+                    }
+                }
+            },
+            8
+    );
+
+    std::lock_guard<std::mutex> lock(m_flowFieldMutex);
+    if(m_flowFields.size() >= MAX_CACHED_FLOW_FIELDS)
+    {
+        m_flowFields.clear();
+    }
+    m_flowFields.emplace(goalCell, flowField);
+    return flowField;
+}
+
+NavigationGrid::Bounds NavigationGrid::getClusterBounds(int cluster) const
+{
+    const glm::ivec2 min = glm::ivec2(cluster % m_clusterCount.x, cluster / m_clusterCount.x) * m_clusterSize;
+    return { min, glm::min(min + m_clusterSize, m_dimensions) };
+}
+
+void NavigationGrid::updateStepMask(const glm::ivec2& pos)
+{
+    uint8_t mask = 0;
+    for(int direction = 0; direction < 8 && isWalkable(pos); direction++)
+    {
+        const glm::ivec2& offset = NEIGHBOR_OFFSETS[direction];
+        if(!isWalkable(pos + offset))
+        {
+            continue;
+        }
+
+        // No cutting corners, both tiles next to a diagonal step have to be walkable
+        if(!isDiagonal(direction) ||
+           (isWalkable(glm::ivec2(pos.x + offset.x, pos.y)) && isWalkable(glm::ivec2(pos.x, pos.y + offset.y))))
+        {
+            mask |= uint8_t(1 << direction);
+        }
+    }
+    m_stepMasks[toCell(pos)] = mask;
+}
+
+uint32_t NavigationGrid::getStepCost(const glm::ivec2& to, int direction) const
+{
+    return uint32_t(m_costs[toCell(to)]) * (isDiagonal(direction) ? DIAGONAL_STEP : STRAIGHT_STEP);
+}
+
+uint32_t NavigationGrid::getHeuristic(const glm::ivec2& from, const glm::ivec2& to) const
+{
+    // Octile distance with the cheapest tile cost of 1
+    const uint32_t dx = uint32_t(std::abs(from.x - to.x));
+    const uint32_t dy = uint32_t(std::abs(from.y - to.y));
+    return STRAIGHT_STEP * std::max(dx, dy) + (DIAGONAL_STEP - STRAIGHT_STEP) * std::min(dx, dy);
+}
+
+void NavigationGrid::searchLocal(
+        int source,
+        const Bounds& bounds,
+        bool reverse,
+        const std::vector<int>& targets,
+        std::vector<uint32_t>& costs
+) const
+{
+    const glm::ivec2 size = bounds.max - bounds.min;
+    const auto toLocal = [&bounds, &size](const glm::ivec2& pos)
+    {
+        return (pos.y - bounds.min.y) * size.x + (pos.x - bounds.min.x);
+    };
+
+    SearchScratch& scratch = s_localScratch;
+    scratch.reset(size_t(size.x) * size_t(size.y));
+    const glm::ivec2 sourcePos = toPos(source);
+    scratch.setCost(toLocal(sourcePos), 0, -1);
+    pushOpen(scratch.open, 0, toLocal(sourcePos));
+
+    // The search can stop as soon as every target is settled
+    size_t remainingTargets = 0;
+    for(int target : targets)
+    {
+        const int local = toLocal(toPos(target));
+        if(scratch.targetStamps[local] != scratch.generation)
+        {
+            scratch.targetStamps[local] = scratch.generation;
+            remainingTargets++;
+        }
+    }
+
+    while(!scratch.open.empty() && remainingTargets > 0)
+    {
+        const auto [cost, current] = popOpen(scratch.open);
+        if(cost > scratch.getCost(current))
+        {
+            continue;
+        }
+        if(scratch.targetStamps[current] == scratch.generation)
+        {
+            remainingTargets--;
+        }
+
+        const glm::ivec2 pos = bounds.min + glm::ivec2(current % size.x, current / size.x);
+        for(int direction = 0; direction < 8; direction++)
+        {
+            const glm::ivec2 next = pos + NEIGHBOR_OFFSETS[direction];
+            if(next.x < bounds.min.x || next.y < bounds.min.y || next.x >= bounds.max.x || next.y >= bounds.max.y ||
+               !canStep(pos, direction))
+            {
+                continue;
+            }
+
+            // Steps are symmetric in walkability, only the tile being entered differs
+            const uint32_t nextCost = cost + (reverse ? getStepCost(pos, direction) : getStepCost(next, direction));
+            const int local = toLocal(next);
+            if(nextCost < scratch.getCost(local))
+            {
+                scratch.setCost(local, nextCost, current);
+                pushOpen(scratch.open, nextCost, local);
+            }
+        }
+    }
+
+    costs.resize(targets.size());
+    for(size_t i = 0; i < targets.size(); i++)
+    {
+        costs[i] = scratch.getCost(toLocal(toPos(targets[i])));
+    }
+}
+
+bool NavigationGrid::findLocalPath(int start, int goal, const Bounds& bounds, std::vector<glm::ivec2>& path) const
+{
+    const glm::ivec2 size = bounds.max - bounds.min;
+    const auto toLocal = [&bounds, &size](const glm::ivec2& pos)
+    {
+        return (pos.y - bounds.min.y) * size.x + (pos.x - bounds.min.x);
+    };
+
+    const glm::ivec2 goalPos = toPos(goal);
+    const int localGoal = toLocal(goalPos);
+
+    SearchScratch& scratch = s_localScratch;
+    scratch.reset(size_t(size.x) * size_t(size.y));
+    const glm::ivec2 startPos = toPos(start);
+    scratch.setCost(toLocal(startPos), 0, -1);
+    pushOpen(scratch.open, getHeuristic(startPos, goalPos), toLocal(startPos));
+
+    bool found = false;
+    while(!scratch.open.empty())
+    {
+        const auto [priority, current] = popOpen(scratch.open);
+        if(current == localGoal)
+        {
+            found = true;
+            break;
+        }
+
+        const glm::ivec2 pos = bounds.min + glm::ivec2(current % size.x, current / size.x);
+        const uint32_t cost = scratch.getCost(current);
+        if(priority > cost + getHeuristic(pos, goalPos))
+        {
+            continue;
+        }
+
+        for(int direction = 0; direction < 8; direction++)
+        {
+            const glm::ivec2 next = pos + NEIGHBOR_OFFSETS[direction];
+            if(next.x < bounds.min.x || next.y < bounds.min.y || next.x >= bounds.max.x || next.y >= bounds.max.y ||
+               !canStep(pos, direction))
+            {
+                continue;
+            }
+
+            const uint32_t nextCost = cost + getStepCost(next, direction);
+            const int local = toLocal(next);
+            if(nextCost < scratch.getCost(local))
+            {
+                scratch.setCost(local, nextCost, current);
+                pushOpen(scratch.open, nextCost + getHeuristic(next, goalPos), local);
+            }
+        }
+    }
+
+    if(!found)
+    {
+        return false;
+    }
+
+    const size_t firstNew = path.size();
+    for(int local = localGoal; scratch.parents[local] >= 0; local = scratch.parents[local])
+    {
+        path.push_back(bounds.min + glm::ivec2(local % size.x, local / size.x));
+    }
+    std::reverse(path.begin() + firstNew, path.end());
+    return true;
+}
+
+void NavigationGrid::createEntrances(int clusterA, int clusterB)
+{
+    // clusterB is always to the right of or below clusterA
+    const Bounds boundsA = getClusterBounds(clusterA);
+    const bool horizontal = clusterB == clusterA + 1;
+    const glm::ivec2 first = horizontal ? glm::ivec2(boundsA.max.x - 1, boundsA.min.y)
+                                        : glm::ivec2(boundsA.min.x, boundsA.max.y - 1);
+    const glm::ivec2 along = horizontal ? glm::ivec2(0, 1) : glm::ivec2(1, 0);
+    const glm::ivec2 across = horizontal ? glm::ivec2(1, 0) : glm::ivec2(0, 1);
+    const int length = horizontal ? boundsA.max.y - boundsA.min.y : boundsA.max.x - boundsA.min.x;
+
+    const auto addTransition = [this, &first, &along, &across, clusterA, clusterB](int offset)
+    {
+        const glm::ivec2 posA = first + along * offset;
+        const uint32_t nodeA = createNode(toCell(posA), clusterA);
+        const uint32_t nodeB = createNode(toCell(posA + across), clusterB);
+        m_nodes[nodeA].peer = int(nodeB);
+        m_nodes[nodeA].peerCost = uint32_t(m_costs[toCell(posA + across)]) * STRAIGHT_STEP;
+        m_nodes[nodeB].peer = int(nodeA);
+        m_nodes[nodeB].peerCost = uint32_t(m_costs[toCell(posA)]) * STRAIGHT_STEP;
+    };
+
+    // Every maximal run of tiles that are walkable on both sides forms one entrance
+    int runStart = -1;
+    for(int i = 0; i <= length; i++)
+    {
+        const bool open = i < length && isWalkable(first + along * i) && isWalkable(first + along * i + across);
+        if(open && runStart < 0)
+        {
+            runStart = i;
+        }
+        else if(!open && runStart >= 0)
+        {
+            if(i - runStart < ENTRANCE_SPLIT_LENGTH)
+            {
+                addTransition(runStart + (i - runStart) / 2);
+            }
+            else
+            {
+                addTransition(runStart);
+                addTransition(i - 1);
+            }
+            runStart = -1;
+        }
+    }
+}
+
+void NavigationGrid::removeEntrances(int clusterA, int clusterB)
+{
+    std::vector<uint32_t> removed;
+    for(uint32_t node : m_clusterNodes[clusterA])
+    {
+        const int peer = m_nodes[node].peer;
+        if(peer >= 0 && m_nodes[peer].cluster == clusterB)
+        {
+            removed.push_back(node);
+            removed.push_back(uint32_t(peer));
+        }
+    }
+
+    for(uint32_t node : removed)
+    {
+        releaseNode(node);
+    }
+}
+
+void NavigationGrid::connectClusterNodes(int cluster)
+{
+    const std::vector<uint32_t>& nodes = m_clusterNodes[cluster];
+    const Bounds bounds = getClusterBounds(cluster);
+
+    std::vector<int> cells;
+    for(uint32_t node : nodes)
+    {
+        cells.push_back(m_nodes[node].cell);
+    }
+
+    std::vector<uint32_t> costs;
+    for(size_t i = 0; i < nodes.size(); i++)
+    {
+        AbstractNode& node = m_nodes[nodes[i]];
+        node.edges.clear();
+        searchLocal(node.cell, bounds, false, cells, costs);
+
+        for(size_t j = 0; j < nodes.size(); j++)
+        {
+            if(i != j && costs[j] != UNREACHABLE)
+            {
+                node.edges.push_back({ nodes[j], costs[j] });
+            }
+        }
+    }
+}
+
+uint32_t NavigationGrid::createNode(int cell, int cluster)
+{
+    uint32_t node;
+    if(!m_freeNodes.empty())
+    {
+        node = m_freeNodes.back();
+        m_freeNodes.pop_back();
+    }
+    else
+    {
+        node = uint32_t(m_nodes.size());
+        m_nodes.emplace_back();
+    }
+
+    m_nodes[node].cell = cell;
+    m_nodes[node].cluster = cluster;
+    m_clusterNodes[cluster].push_back(node);
+    return node;
+}
+
+void NavigationGrid::releaseNode(uint32_t node)
+{
+    std::vector<uint32_t>& clusterNodes = m_clusterNodes[m_nodes[node].cluster];
+    clusterNodes.erase(std::find(clusterNodes.begin(), clusterNodes.end(), node));
+    m_nodes[node] = AbstractNode();
+    m_freeNodes.push_back(node);
+}
@@ -0,0 +1,185 @@
+#pragma once
+
+#include <glm/ext/vector_int2.hpp>
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief Directions towards one goal for every tile of the grid, shared by all agents heading there.
+ */
+struct FlowField
+{
+        glm::ivec2 goal;
+        glm::ivec2 dimensions;
+        std::vector<uint32_t> integration; // Cost to reach the goal, NavigationGrid::UNREACHABLE without a path
+        std::vector<int8_t> directions;    // Index into GetNeighborOffsets(), -1 at the goal & unreachable tiles
+
+        bool isReachable(const glm::ivec2& pos) const;
+
+        /**
+         * @return The offset to the next tile towards the goal, (0, 0) at the goal or if the goal can't be reached
+         */
+        glm::ivec2 getDirection(const glm::ivec2& pos) const;
+};
+
+/**
+ * @brief Hierarchical pathfinding (HPA*) over a tile grid with per tile movement costs.
+ *
+ * The grid is split into square clusters. Walkable runs along the cluster borders become entrances, whose nodes get
+ * connected by the cheapest path inside their cluster. A query only searches the tiles of the start & goal cluster
+ * and the small abstract graph in between, then refines the abstract path cluster by cluster.
+ * Changing a tile only marks its cluster dirty, update() rebuilds just the dirty clusters & their neighbors.
+ *
+ * Movement is 8-directional without cutting corners, entering a tile costs its cost (x1.4 diagonally).
+ * Queries are const & thread safe, as long as no tiles change or update() runs at the same time.
+ */
+class NavigationGrid
+{
+    public:
+        explicit NavigationGrid(const glm::ivec2& dimensions, int clusterSize = 16);
+        ~NavigationGrid() = default;
+
+        /**
+         * @param pos The tile to change
+         * @param cost The cost of entering the tile, 0 makes it unwalkable
+         */
+        void setTileCost(const glm::ivec2& pos, uint8_t cost);
+
+        uint8_t getTileCost(const glm::ivec2& pos) const;
+
+        bool isWalkable(const glm::ivec2& pos) const { return isInside(pos) && getTileCost(pos) != 0; }
+
+        /**
+         * @brief Builds the whole abstraction, the clusters get processed on the ThreadPool.
+         */
+        void build();
+
+        /**
+         * @brief Rebuilds the clusters touched by setTileCost since the last update. Cheap if nothing changed.
+         */
+        void update();
+
+        bool isDirty() const { return !m_dirtyClusters.empty(); }
+
+        /**
+         * @return The tiles from start to goal, both included. Empty if there is no path.
+         */
+        std::vector<glm::ivec2> findPath(const glm::ivec2& start, const glm::ivec2& goal) const;
+
+        /**
+         * @brief Answers many queries at once, spread over the ThreadPool.
+         *
+         * @param queries Pairs of start & goal
+         * @param paths Receives one path per query, in the same order
+         */
+        void findPaths(
+                const std::vector<std::pair<glm::ivec2, glm::ivec2>>& queries,
+                std::vector<std::vector<glm::ivec2>>& paths
+        ) const;
+
+        /**
+         * @brief Gets the flow field towards a goal. It is computed once & shared until a tile changes.
+         */
+        std::shared_ptr<const FlowField> getFlowField(const glm::ivec2& goal) const;
+
+        glm::ivec2 getDimensions() const { return m_dimensions; }
+
+        size_t getAbstractNodeCount() const { return m_nodes.size() - m_freeNodes.size(); }
+
+        static constexpr uint32_t UNREACHABLE = UINT32_MAX;
+
+    private:
+        struct AbstractEdge
+        {
+                uint32_t to;
+                uint32_t cost;
+        };
+
+        struct AbstractNode
+        {
+                int cell = -1;
+                int cluster = -1;
+                int peer = -1; // The node on the other side of the entrance
+                uint32_t peerCost = 0;
+                std::vector<AbstractEdge> edges; // Within the cluster
+        };
+
+        struct Bounds
+        {
+                glm::ivec2 min;
+                glm::ivec2 max; // Exclusive
+        };
+
+        bool isInside(const glm::ivec2& pos) const
+        {
+            return pos.x >= 0 && pos.y >= 0 && pos.x < m_dimensions.x && pos.y < m_dimensions.y;
+        }
+
+        int toCell(const glm::ivec2& pos) const { return pos.y * m_dimensions.x + pos.x; }
+
+        glm::ivec2 toPos(int cell) const { return glm::ivec2(cell % m_dimensions.x, cell / m_dimensions.x); }
+
+        int getCluster(const glm::ivec2& pos) const
+        {
+            return (pos.y / m_clusterSize) * m_clusterCount.x + pos.x / m_clusterSize;
+        }
+
+        Bounds getClusterBounds(int cluster) const;
+
+        bool canStep(const glm::ivec2& from, int direction) const
+        {
+            return m_stepMasks[toCell(from)] & (1 << direction);
+        }
+
+        void updateStepMask(const glm::ivec2& pos);
+        uint32_t getStepCost(const glm::ivec2& to, int direction) const;
+        uint32_t getHeuristic(const glm::ivec2& from, const glm::ivec2& to) const;
+
+        /**
+         * @brief Dijkstra over the tiles within bounds.
+         *
+         * @param reverse False for the costs from source to the targets, true for the costs from the targets to source
+         * @param costs Receives one cost per target, UNREACHABLE if there is no path within bounds
+         */
+        void searchLocal(
+                int source,
+                const Bounds& bounds,
+                bool reverse,
+                const std::vector<int>& targets,
+                std::vector<uint32_t>& costs
+        ) const;
+
+        /**
+         * @brief A* over the tiles within bounds, appending the path without its first tile.
+         */
+        bool findLocalPath(int start, int goal, const Bounds& bounds, std::vector<glm::ivec2>& path) const;
+
+        void createEntrances(int clusterA, int clusterB);
+        void removeEntrances(int clusterA, int clusterB);
+        void connectClusterNodes(int cluster);
+        uint32_t createNode(int cell, int cluster);
+        void releaseNode(uint32_t node);
+
+        glm::ivec2 m_dimensions;
+        int m_clusterSize;
+        glm::ivec2 m_clusterCount;
+        std::vector<uint8_t> m_costs;
+        std::vector<uint8_t> m_stepMasks; // One bit per direction that can be walked from a tile
+
+        std::vector<AbstractNode> m_nodes;
+        std::vector<uint32_t> m_freeNodes;
+        std::vector<std::vector<uint32_t>> m_clusterNodes;
+        std::vector<int> m_dirtyClusters;
+        std::vector<bool> m_clusterDirty;
+
+        mutable std::mutex m_flowFieldMutex;
+        mutable std::map<int, std::shared_ptr<const FlowField>> m_flowFields;
+
+        static constexpr int ENTRANCE_SPLIT_LENGTH = 6; // Longer runs get a transition at both ends
+        static constexpr size_t MAX_CACHED_FLOW_FIELDS = 32;
+};
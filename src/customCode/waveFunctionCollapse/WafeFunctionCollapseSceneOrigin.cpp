@@ -4,6 +4,7 @@
 #include "../../classes/engine/EngineManager.h"
 #include "../../classes/engine/UserEventManager.h"
 #include "../../classes/engine/WindowManager.h"
+#include "../../classes/engine/rendering/ShaderFeatures.h"
 #include "../../classes/helper/DebugUtils.h"
 #include "../../classes/primitives/DebugManagerWindow.h"
 #include "../../resources/shader/ColorShader.h"
@@ -11,6 +12,18 @@
 
 WafeFunctionCollapseSceneOrigin::WafeFunctionCollapseSceneOrigin() {}
 
+Engine::SceneAssets WafeFunctionCollapseSceneOrigin::getSceneAssets()
+{
+    Engine::SceneAssets assets;
+    assets.objects = { "resources/objects/plane.obj" };
+    // The ColorShader of the tiles & the BakedShader once the lighting is baked
+    const unsigned int colorFeatures =
+            Engine::SHADER_FEATURE_VERTEX_COLOR | Engine::SHADER_FEATURE_LIT | Engine::SHADER_FEATURE_ALPHA;
+    assets.shaders = { { "resources/shader/standard", "standard", colorFeatures },
+                       { "resources/shader/standard", "standard", Engine::SHADER_FEATURE_VERTEX_COLOR } };
+    return assets;
+}
+
 void WafeFunctionCollapseSceneOrigin::start()
 {
     const glm::ivec2 gridDimension = glm::ivec2(50, 50);
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "../../classes/engine/SceneManager.h"
 #include "../../classes/nodeComponents/BasicNode.h"
 
 namespace Engine
@@ -13,6 +14,11 @@ class WafeFunctionCollapseSceneOrigin : public Engine::BasicNode
         WafeFunctionCollapseSceneOrigin();
         ~WafeFunctionCollapseSceneOrigin() = default;
 
+        /**
+         * @brief The assets start() registers, for preloading the scene through the SceneManager.
+         */
+        static Engine::SceneAssets getSceneAssets();
+
     private:
         void start() override;
         void update() override {};
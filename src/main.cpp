@@ -1,6 +1,7 @@
 
 #include "classes/engine/EngineManager.h"
 #include "classes/engine/GameInterface.h"
+#include "classes/engine/StartupOrchestrator.h"
 #include "classes/engine/rendering/RenderManager.h"
 #include "customCode/mandelbrotScene/MandelbrotSceneOrigin.h"
 #include "customCode/testScene/TestSceneOrigin.h"
@@ -18,7 +19,16 @@ int main()
     std::cout << "PROD MODE" << std::endl;
 #endif
 
+    // using StartScene = TestSceneOrigin;
+    using StartScene = WafeFunctionCollapseSceneOrigin;
+    // using StartScene = MandelbrotSceneOrigin;
+
+    // The assets of the first scene get read & decoded while the window & context are created
+    const std::shared_ptr<StartupOrchestrator> startup = SingletonManager::get<StartupOrchestrator>();
+    startup->prepareAssets(StartScene::getSceneAssets());
+
     const std::shared_ptr<GameInterface> game = std::make_shared<GameInterface>();
+    startup->uploadAssets();
     const std::shared_ptr<EngineManager> engineManager = SingletonManager::get<EngineManager>();
 
     auto& ambientLight = engineManager->getRenderManager()->getAmbientLightUbo();
@@ -34,10 +44,7 @@ int main()
 
     diffuseLight->setIsActive(false);
 
-    // std::shared_ptr<TestSceneOrigin> startNode = std::make_shared<TestSceneOrigin>();
-    std::shared_ptr<WafeFunctionCollapseSceneOrigin> startNode =
-            std::make_shared<WafeFunctionCollapseSceneOrigin>();
-    // std::shared_ptr<MandelbrotSceneOrigin> startNode = std::make_shared<MandelbrotSceneOrigin>();
+    std::shared_ptr<StartScene> startNode = std::make_shared<StartScene>();
 
     startNode->setName("Scene Origin");
     engineManager->setScene(startNode);
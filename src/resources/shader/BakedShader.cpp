@@ -0,0 +1,10 @@
+
+#include "BakedShader.h"
+
+using namespace Engine;
+
+BakedShader::BakedShader(const std::shared_ptr<RenderManager>& renderManager)
+{
+    // Lighting is already part of the vertex colors, so the unlit variant is enough
+    registerShader(renderManager, "resources/shader/standard", "standard", SHADER_FEATURE_VERTEX_COLOR);
+}
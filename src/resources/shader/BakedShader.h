@@ -0,0 +1,10 @@
+#pragma once
+
+#include "../../classes/engine/rendering/Shader.h"
+
+class BakedShader : public Engine::Shader
+{
+    public:
+        explicit BakedShader(const std::shared_ptr<Engine::RenderManager>& renderManager);
+        ~BakedShader() = default;
+};
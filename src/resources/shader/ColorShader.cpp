@@ -5,10 +5,13 @@ using namespace Engine;
 
 ColorShader::ColorShader(const std::shared_ptr<RenderManager>& renderManager)
 {
-    registerShader(renderManager, "resources/shader/color", "color");
+    registerShader(
+            renderManager,
+            "resources/shader/standard",
+            "standard",
+            SHADER_FEATURE_VERTEX_COLOR | SHADER_FEATURE_LIT | SHADER_FEATURE_ALPHA
+    );
 
     bindUbo(renderManager->getAmbientLightUbo());
     bindUbo(renderManager->getDiffuseLightUbo());
-
-    setVisualPassStyle(Shader::PASS_COLOR);
 }
@@ -0,0 +1,67 @@
+#include "DepthShader.h"
+
+#include "../../classes/engine/rendering/backend/RenderBackend.h"
+
+#include <array>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+using namespace Engine;
+
+namespace
+{
+    // Two triangles per face of the unit cube, wound counter clockwise seen from outside
+    std::array<glm::vec3, 36> createUnitCube()
+    {
+        constexpr std::array<int, 36> corners = { 0, 2, 3, 0, 3, 1, 4, 5, 7, 4, 7, 6, 0, 1, 5, 0, 5, 4,
+                                                  2, 6, 7, 2, 7, 3, 0, 4, 6, 0, 6, 2, 1, 3, 7, 1, 7, 5 };
+
+        std::array<glm::vec3, 36> vertices;
+        for(size_t i = 0; i < corners.size(); i++)
+        {
+            const int corner = corners[i];
+            vertices[i] = glm::vec3(corner & 1 ? 1.f : 0.f, corner & 2 ? 1.f : 0.f, corner & 4 ? 1.f : 0.f);
+        }
+        return vertices;
+    }
+} // namespace
+
+DepthShader::DepthShader(const std::shared_ptr<RenderManager>& renderManager, bool skinned)
+    : m_boxBuffer(0)
+{
+    registerShader(
+            renderManager,
+            "resources/shader/depth",
+            "depth",
+            skinned ? SHADER_FEATURE_SKINNED : SHADER_FEATURE_NONE
+    );
+}
+
+DepthShader::~DepthShader()
+{
+    if(m_boxBuffer != 0)
+    {
+        RenderBackend::get().deleteBuffer(m_boxBuffer);
+    }
+}
+
+void DepthShader::renderBox(const glm::vec3& min, const glm::vec3& max, CameraComponent* camera)
+{
+    RenderBackend& backend = RenderBackend::get();
+    if(m_boxBuffer == 0)
+    {
+        const std::array<glm::vec3, 36> vertices = createUnitCube();
+        m_boxBuffer = backend.createBuffer();
+        backend.bindBuffer(GL_ARRAY_BUFFER, m_boxBuffer);
+        backend.bufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices.data(), GL_STATIC_DRAW);
+    }
+
+    refreshProgram();
+    backend.useProgram(getShaderIdentifier().second);
+
+    const glm::mat4 model = glm::scale(glm::translate(glm::mat4(1.f), min), max - min);
+    backend.setUniform(getActiveUniform("MVP"), camera->getProjectionMatrix() * camera->getViewMatrix() * model);
+
+    bindVertexData(GLOBAL_ATTRIB_INDEX_VERTEXPOSITION, GL_ARRAY_BUFFER, m_boxBuffer, 3, GL_FLOAT, false, 0);
+    backend.drawArrays(GL_TRIANGLES, 0, 36);
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "../../classes/engine/rendering/Shader.h"
+
+namespace Engine
+{
+    /**
+     * @brief Only transforms the vertex positions, used for the depth pre-pass & the overdraw view.
+     *
+     * The positions match standard.vert exactly, so geometry drawn with it can be shaded with GL_EQUAL afterwards.
+     * Skinned geometry needs the skinned variant.
+     */
+    class DepthShader : public Shader
+    {
+        public:
+            DepthShader(const std::shared_ptr<RenderManager>& renderManager, bool skinned);
+            ~DepthShader();
+
+            /**
+             * @brief Draws a world space box, the proxy geometry of occlusion queries.
+             */
+            void renderBox(const glm::vec3& min, const glm::vec3& max, CameraComponent* camera);
+
+        private:
+            GLuint m_boxBuffer;
+    };
+} // namespace Engine
@@ -1,6 +1,8 @@
 
 #include "GridShader.h"
 
+#include "../../classes/engine/rendering/backend/RenderBackend.h"
+
 using namespace Engine;
 
 GridShader::GridShader(const std::shared_ptr<RenderManager>& renderManager)
@@ -13,16 +15,18 @@ GridShader::GridShader(const std::shared_ptr<RenderManager>& renderManager)
 
 void GridShader::renderVertices(std::nullptr_t object, CameraComponent* camera)
 {
-    glUseProgram(getShaderIdentifier().second);
+    refreshProgram();
+    RenderBackend& backend = RenderBackend::get();
+    backend.useProgram(getShaderIdentifier().second);
 
-    glUniform1f(getActiveUniform("mainGridScale"), m_gridScale);
-    glUniform1f(getActiveUniform("secondaryGridScale"), m_gridScale * 0.1f);
+    backend.setUniform(getActiveUniform("mainGridScale"), m_gridScale);
+    backend.setUniform(getActiveUniform("secondaryGridScale"), m_gridScale * 0.1f);
 
-    glUniform1f(getActiveUniform("near"), m_gridNear);
-    glUniform1f(getActiveUniform("far"), m_gridFar);
+    backend.setUniform(getActiveUniform("near"), m_gridNear);
+    backend.setUniform(getActiveUniform("far"), m_gridFar);
 
-    glUniformMatrix4fv(getActiveUniform("projection"), 1, GL_FALSE, &camera->getProjectionMatrix()[0][0]);
-    glUniformMatrix4fv(getActiveUniform("view"), 1, GL_FALSE, &camera->getViewMatrix()[0][0]);
+    backend.setUniform(getActiveUniform("projection"), camera->getProjectionMatrix());
+    backend.setUniform(getActiveUniform("view"), camera->getViewMatrix());
 
-    glDrawArrays(GL_TRIANGLES, 0, 6);
+    backend.drawArrays(GL_TRIANGLES, 0, 6);
 }
\ No newline at end of file
@@ -6,8 +6,12 @@
 
 using namespace Engine;
 
-MandelbrotShader::MandelbrotShader(const std::shared_ptr<RenderManager>& renderManager, std::shared_ptr<MandelbrotUbo> ubo)
+MandelbrotShader::MandelbrotShader(
+        const std::shared_ptr<RenderManager>& renderManager,
+        std::shared_ptr<MandelbrotUbo> ubo,
+        unsigned int features /* = SHADER_FEATURE_NONE */
+)
     : m_mandelbrotUbo(std::move(ubo))
 {
-    registerShader(renderManager, "resources/shader/mandelbrot", "mandelbrot");
+    registerShader(renderManager, "resources/shader/mandelbrot", "mandelbrot", features);
 }
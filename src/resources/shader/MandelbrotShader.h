@@ -7,9 +7,13 @@ class MandelbrotUbo;
 class MandelbrotShader : public Engine::Shader
 {
     public:
+        /**
+         * @param features SHADER_FEATURE_DOUBLE_FLOAT for the emulated double precision kernel
+         */
         explicit MandelbrotShader(
                 const std::shared_ptr<Engine::RenderManager>& renderManager,
-                std::shared_ptr<MandelbrotUbo> ubo
+                std::shared_ptr<MandelbrotUbo> ubo,
+                unsigned int features = Engine::SHADER_FEATURE_NONE
         );
         ~MandelbrotShader() = default;
 
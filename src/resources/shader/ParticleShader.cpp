@@ -0,0 +1,83 @@
+#include "ParticleShader.h"
+
+#include "../../classes/engine/rendering/backend/RenderBackend.h"
+#include "../../classes/nodeComponents/ParticleEmitter.h"
+
+using namespace Engine;
+
+ParticleShader::ParticleShader(const std::shared_ptr<RenderManager>& renderManager)
+    : m_particleBuffer(std::make_unique<StreamingBuffer>(GL_ARRAY_BUFFER, INITIAL_BUFFER_SIZE))
+{
+    registerShader(renderManager, "resources/shader/particle", "particle");
+}
+
+void ParticleShader::renderParticles(ParticleEmitter& emitter, CameraComponent* camera)
+{
+    const size_t count = emitter.getParticleCount();
+    if(count == 0)
+    {
+        return;
+    }
+
+    const glm::mat4 view = camera->getViewMatrix();
+    const glm::vec3 cameraRight = glm::vec3(view[0][0], view[1][0], view[2][0]);
+    const glm::vec3 cameraUp = glm::vec3(view[0][1], view[1][1], view[2][1]);
+
+    if(emitter.isSorted())
+    {
+        const glm::vec3 viewDirection = -glm::vec3(view[0][2], view[1][2], view[2][2]);
+        emitter.sortByDepth(camera->getGlobalPosition(), viewDirection);
+    }
+
+    // Positions & sizes of all particles first, followed by their colors
+    size_t offset = 0;
+    void* data = m_particleBuffer->map(count * (sizeof(glm::vec4) + sizeof(uint32_t)), offset);
+    if(!data)
+    {
+        return;
+    }
+    auto* positionSize = static_cast<glm::vec4*>(data);
+    emitter.writeInstances(positionSize, reinterpret_cast<uint32_t*>(positionSize + count));
+    m_particleBuffer->unmap();
+
+    refreshProgram();
+    RenderBackend& backend = RenderBackend::get();
+    backend.useProgram(getShaderIdentifier().second);
+
+    backend.setUniform(getActiveUniform("VP"), camera->getProjectionMatrix() * view);
+    backend.setUniform(getActiveUniform("cameraRight"), cameraRight);
+    backend.setUniform(getActiveUniform("cameraUp"), cameraUp);
+
+    backend.bindBuffer(GL_ARRAY_BUFFER, m_particleBuffer->getBuffer());
+    backend.enableVertexAttribute(ATTRIB_INDEX_POSITION_SIZE);
+    backend.vertexAttributePointer(ATTRIB_INDEX_POSITION_SIZE, 4, GL_FLOAT, false, 0, offset);
+    backend.vertexAttributeDivisor(ATTRIB_INDEX_POSITION_SIZE, 1);
+    backend.enableVertexAttribute(ATTRIB_INDEX_COLOR);
+    backend.vertexAttributePointer(
+            ATTRIB_INDEX_COLOR,
+            4,
+            GL_UNSIGNED_BYTE,
+            true,
+            0,
+            offset + count * sizeof(glm::vec4)
+    );
+    backend.vertexAttributeDivisor(ATTRIB_INDEX_COLOR, 1);
+
+    // Particles are tested against the scene, but don't occlude each other
+    backend.depthMask(false);
+    if(emitter.getBlendMode() == PARTICLE_BLEND_ADDITIVE)
+    {
+        backend.blendFunc(GL_SRC_ALPHA, GL_ONE);
+    }
+
+    backend.drawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, GLsizei(count));
+
+    backend.blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    backend.depthMask(true);
+
+    // The attribute slots are shared with every other shader, which doesn't expect divisors
+    backend.vertexAttributeDivisor(ATTRIB_INDEX_POSITION_SIZE, 0);
+    backend.vertexAttributeDivisor(ATTRIB_INDEX_COLOR, 0);
+    backend.disableVertexAttribute(ATTRIB_INDEX_POSITION_SIZE);
+    backend.disableVertexAttribute(ATTRIB_INDEX_COLOR);
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "../../classes/engine/rendering/Shader.h"
+#include "../../classes/engine/rendering/StreamingBuffer.h"
+
+namespace Engine
+{
+    class ParticleEmitter;
+
+    /**
+     * @brief Draws the particles of an emitter as camera facing quads, one instance per particle.
+     *
+     * The instance data of all emitters is streamed through one shared buffer, the quads themselves are generated in
+     * the vertex shader.
+     */
+    class ParticleShader : public Shader
+    {
+        public:
+            ParticleShader(const std::shared_ptr<RenderManager>& renderManager);
+            ~ParticleShader() = default;
+
+            /**
+             * @brief Sorts (if needed), uploads & draws the particles of an emitter. Expects blending to be enabled.
+             */
+            void renderParticles(ParticleEmitter& emitter, CameraComponent* camera);
+
+        private:
+            std::unique_ptr<StreamingBuffer> m_particleBuffer;
+
+            static constexpr GLuint ATTRIB_INDEX_POSITION_SIZE = 0;
+            static constexpr GLuint ATTRIB_INDEX_COLOR = 1;
+            static constexpr size_t INITIAL_BUFFER_SIZE = 4 * 1024 * 1024;
+    };
+} // namespace Engine
@@ -0,0 +1,34 @@
+#include "PickingShader.h"
+
+#include "../../classes/engine/rendering/backend/RenderBackend.h"
+
+using namespace Engine;
+
+PickingShader::PickingShader(const std::shared_ptr<RenderManager>& renderManager, bool skinned)
+    : m_nodeIdUniform(-1)
+    , m_uniformProgram(0)
+{
+    registerShader(
+            renderManager,
+            "resources/shader/depth",
+            "depth",
+            SHADER_FEATURE_PICKING | (skinned ? SHADER_FEATURE_SKINNED : SHADER_FEATURE_NONE)
+    );
+}
+
+void PickingShader::renderNode(const std::shared_ptr<GeometryComponent>& node, CameraComponent* camera)
+{
+    refreshProgram();
+    const GLuint program = getShaderIdentifier().second;
+    if(program != m_uniformProgram)
+    {
+        m_uniformProgram = program;
+        m_nodeIdUniform = getActiveUniform("nodeId");
+    }
+
+    RenderBackend& backend = RenderBackend::get();
+    backend.useProgram(program);
+    backend.setUniform(m_nodeIdUniform, node->getNodeId());
+
+    renderVertices(node, camera);
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include "../../classes/engine/rendering/Shader.h"
+
+namespace Engine
+{
+    /**
+     * @brief Writes the id of the drawn node into an unsigned integer target, the ObjectPicker draws with it.
+     *
+     * The PICKING variant of the depth shader, so geometry covers the exact same pixels as in the color pass.
+     * Skinned geometry needs the skinned variant.
+     */
+    class PickingShader : public Shader
+    {
+        public:
+            PickingShader(const std::shared_ptr<RenderManager>& renderManager, bool skinned);
+            ~PickingShader() = default;
+
+            void renderNode(const std::shared_ptr<GeometryComponent>& node, CameraComponent* camera);
+
+        private:
+            GLint m_nodeIdUniform;
+            // The program the uniform was looked up for, a hot reload brings a new one
+            GLuint m_uniformProgram;
+    };
+} // namespace Engine
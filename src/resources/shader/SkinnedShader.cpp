@@ -0,0 +1,16 @@
+#include "SkinnedShader.h"
+
+using namespace Engine;
+
+SkinnedShader::SkinnedShader(const std::shared_ptr<RenderManager>& renderManager)
+{
+    registerShader(
+            renderManager,
+            "resources/shader/standard",
+            "standard",
+            SHADER_FEATURE_TEXTURED | SHADER_FEATURE_LIT | SHADER_FEATURE_ALPHA | SHADER_FEATURE_SKINNED
+    );
+
+    bindUbo(renderManager->getAmbientLightUbo());
+    bindUbo(renderManager->getDiffuseLightUbo());
+}
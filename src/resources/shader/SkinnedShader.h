@@ -0,0 +1,10 @@
+#pragma once
+
+#include "../../classes/engine/rendering/Shader.h"
+
+class SkinnedShader : public Engine::Shader
+{
+    public:
+        explicit SkinnedShader(const std::shared_ptr<Engine::RenderManager>& renderManager);
+        ~SkinnedShader() = default;
+};
@@ -5,10 +5,13 @@ using namespace Engine;
 
 TextureShader::TextureShader(const std::shared_ptr<RenderManager>& renderManager)
 {
-    registerShader(renderManager, "resources/shader/texture", "texture");
+    registerShader(
+            renderManager,
+            "resources/shader/standard",
+            "standard",
+            SHADER_FEATURE_TEXTURED | SHADER_FEATURE_LIT | SHADER_FEATURE_ALPHA
+    );
 
     bindUbo(renderManager->getAmbientLightUbo());
     bindUbo(renderManager->getDiffuseLightUbo());
-
-    setVisualPassStyle(Shader::PASS_TEXTURE);
 }
@@ -0,0 +1,31 @@
+
+#include "UpscaleShader.h"
+
+#include "../../classes/engine/rendering/backend/RenderBackend.h"
+
+using namespace Engine;
+
+UpscaleShader::UpscaleShader(const std::shared_ptr<RenderManager>& renderManager)
+    : m_sourceTexture(0)
+    , m_sourceSize(1, 1)
+    , m_sharpness(0.5f)
+{
+    registerShader(renderManager, "resources/shader/upscale", "upscale");
+}
+
+void UpscaleShader::renderVertices(std::nullptr_t object, CameraComponent* camera)
+{
+    refreshProgram();
+    RenderBackend& backend = RenderBackend::get();
+    backend.useProgram(getShaderIdentifier().second);
+
+    backend.activeTexture(0);
+    backend.bindTexture(GL_TEXTURE_2D, m_sourceTexture);
+    backend.setUniform(getActiveUniform("sceneTexture"), 0);
+
+    backend.setUniform(getActiveUniform("texelSize"), glm::vec2(1.f) / glm::vec2(m_sourceSize));
+    backend.setUniform(getActiveUniform("sharpness"), m_sharpness);
+
+    // Fullscreen triangle, generated in the vertex shader
+    backend.drawArrays(GL_TRIANGLES, 0, 3);
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "../../classes/engine/rendering/Shader.h"
+
+namespace Engine
+{
+    /**
+     * @brief Draws a low resolution scene texture over the whole viewport, sharpening it while upscaling.
+     */
+    class UpscaleShader : public Shader
+    {
+        public:
+            UpscaleShader(const std::shared_ptr<RenderManager>& renderManager);
+            ~UpscaleShader() = default;
+
+            void renderVertices(std::nullptr_t object, CameraComponent* camera) override;
+
+            void setSourceTexture(GLuint texture, const glm::ivec2& size)
+            {
+                m_sourceTexture = texture;
+                m_sourceSize = size;
+            };
+
+            float getSharpness() const { return m_sharpness; };
+
+            void setSharpness(float sharpness) { m_sharpness = sharpness; };
+
+        private:
+            GLuint m_sourceTexture;
+            glm::ivec2 m_sourceSize;
+            float m_sharpness;
+    };
+} // namespace Engine
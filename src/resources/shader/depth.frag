@@ -0,0 +1,22 @@
+#version 410
+#pragma shader_feature PICKING
+
+#ifdef FEATURE_PICKING
+// Id of the node drawn, 0 is left for nothing
+uniform uint nodeId;
+
+out uint id;
+#else
+// Ouput data
+out vec4 color;
+#endif
+
+void main()
+{
+#ifdef FEATURE_PICKING
+    id = nodeId;
+#else
+    // Color writes are masked during the depth pre-pass, in the overdraw view every layer adds this up
+    color = vec4(0.1, 0.04, 0.02, 1.0);
+#endif
+}
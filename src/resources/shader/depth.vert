@@ -0,0 +1,48 @@
+#version 410
+#pragma shader_feature SKINNED
+
+// Only the position of standard.vert, computed the exact same way so the colour pass can test with GL_EQUAL
+layout(location = 0) in vec3 vertexPosition_modelspace;
+#ifdef FEATURE_SKINNED
+layout(location = 8) in uvec4 boneIndices;
+layout(location = 9) in vec4 boneWeights;
+#endif
+
+uniform mat4 MVP;
+#ifdef FEATURE_SKINNED
+// 4 texels per bone, one per matrix column
+uniform samplerBuffer bonePalette;
+#endif
+
+invariant gl_Position;
+
+#ifdef FEATURE_SKINNED
+mat4 getBoneMatrix(uint bone)
+{
+    int texel = int(bone) * 4;
+    return mat4(
+        texelFetch(bonePalette, texel),
+        texelFetch(bonePalette, texel + 1),
+        texelFetch(bonePalette, texel + 2),
+        texelFetch(bonePalette, texel + 3)
+    );
+}
+#endif
+
+void main()
+{
+#ifdef FEATURE_SKINNED
+    // Vertices without weights aren't skinned
+    mat4 skinMatrix = mat4(1.0);
+    if(dot(boneWeights, vec4(1.0)) > 0.0)
+    {
+        skinMatrix = getBoneMatrix(boneIndices.x) * boneWeights.x + getBoneMatrix(boneIndices.y) * boneWeights.y +
+            getBoneMatrix(boneIndices.z) * boneWeights.z + getBoneMatrix(boneIndices.w) * boneWeights.w;
+    }
+    vec4 position_modelspace = skinMatrix * vec4(vertexPosition_modelspace, 1);
+#else
+    vec4 position_modelspace = vec4(vertexPosition_modelspace, 1);
+#endif
+
+    gl_Position = MVP * position_modelspace;
+}
@@ -1,6 +1,8 @@
 #version 410
+#pragma shader_feature DOUBLE_FLOAT
 
 // Usage of doubles not possible on macOS :(
+// The DOUBLE_FLOAT variant emulates them with pairs of floats instead, at a fraction of the speed
 
 // Ouput data
 out vec4 color;
@@ -11,12 +13,95 @@ layout(std140) uniform MandelbrotBlock
     float zoom;
     vec2 screenSize;
     vec2 offset;
+    // The rounding errors of zoom & offset as floats, only read by the DOUBLE_FLOAT variant
+    vec2 offsetLow;
+    float zoomLow;
 };
 
 float n = 0.0;
 float threshold = 100.0;
 
-float mandelbrot(vec2 complexPoint) {
+#ifdef FEATURE_DOUBLE_FLOAT
+// A double-float value is an unevaluated sum hi + lo with |lo| <= ulp(hi) / 2, worth about 48 bits of mantissa.
+// Every step relies on the exact rounding error of a float operation, precise keeps the compiler from
+// reassociating them away.
+
+vec2 quickTwoSum(float a, float b)
+{
+    precise float s = a + b;
+    precise float e = b - (s - a);
+    return vec2(s, e);
+}
+
+vec2 twoSum(float a, float b)
+{
+    precise float s = a + b;
+    precise float v = s - a;
+    precise float e = (a - (s - v)) + (b - v);
+    return vec2(s, e);
+}
+
+vec2 twoProduct(float a, float b)
+{
+    precise float p = a * b;
+    precise float e = fma(a, b, -p);
+    return vec2(p, e);
+}
+
+vec2 dfAdd(vec2 a, vec2 b)
+{
+    vec2 s = twoSum(a.x, b.x);
+    precise float e = s.y + a.y + b.y;
+    return quickTwoSum(s.x, e);
+}
+
+vec2 dfSub(vec2 a, vec2 b) { return dfAdd(a, -b); }
+
+vec2 dfMul(vec2 a, vec2 b)
+{
+    vec2 p = twoProduct(a.x, b.x);
+    precise float e = p.y + (a.x * b.y + a.y * b.x);
+    return quickTwoSum(p.x, e);
+}
+
+vec2 dfDiv(vec2 a, vec2 b)
+{
+    precise float q1 = a.x / b.x;
+    vec2 r = dfSub(a, dfMul(vec2(q1, 0.0), b));
+    precise float q2 = r.x / b.x;
+    return quickTwoSum(q1, q2);
+}
+
+float mandelbrot(vec2 pixel)
+{
+    // Pixel coordinates are whole numbers & exact as floats, only scale & offset need the extra precision
+    vec2 dfZoom = vec2(zoom, zoomLow);
+    vec2 pointX = dfSub(dfDiv(vec2(pixel.x, 0.0), dfZoom), vec2(offset.x, offsetLow.x));
+    vec2 pointY = dfSub(dfDiv(vec2(pixel.y, 0.0), dfZoom), vec2(offset.y, offsetLow.y));
+
+    vec2 valueX = vec2(0.0);
+    vec2 valueY = vec2(0.0);
+
+    for (int i = 0; i < itr; i++) {
+        vec2 squareX = dfMul(valueX, valueX);
+        vec2 squareY = dfMul(valueY, valueY);
+        vec2 product = dfMul(valueX, valueY);
+        valueY = dfAdd(dfAdd(product, product), pointY);
+        valueX = dfAdd(dfSub(squareX, squareY), pointX);
+
+        // The escape test is fine with the high parts
+        if ((valueX.x * valueX.x) + (valueY.x * valueY.x) > threshold) {
+            break;
+        }
+
+        n++;
+    }
+
+    return n / float(itr);
+}
+#else
+float mandelbrot(vec2 pixel) {
+    vec2 complexPoint = (pixel / zoom) - offset;
     vec2 complexValue = vec2(0.0, 0.0);
 
     for (int i = 0; i < itr; i++) {
@@ -34,6 +119,7 @@ float mandelbrot(vec2 complexPoint) {
 
     return n / float(itr);
 }
+#endif
 
 vec4 map_to_color(float t) {
     float r = 9.0 * (1.0 - t) * t * t * t;
@@ -45,6 +131,6 @@ vec4 map_to_color(float t) {
 
 void main() {
     vec2 coord = vec2(gl_FragCoord.xy);
-    float mandelbrotValue = mandelbrot(((coord - screenSize)/zoom) - offset);
+    float mandelbrotValue = mandelbrot(coord - screenSize);
     color = map_to_color(float(mandelbrotValue));
-}
\ No newline at end of file
+}
@@ -6,6 +6,9 @@ layout(location = 0) in vec3 vertexPosition_modelspace;
 // Values that stay constant for the whole mesh.
 uniform mat4 MVP;
 
+// Has to match the depth pre-pass in depth.vert bit for bit, it gets tested with GL_EQUAL
+invariant gl_Position;
+
 void main()
 {
     gl_Position = MVP * vec4(vertexPosition_modelspace, 1);
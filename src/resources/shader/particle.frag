@@ -0,0 +1,20 @@
+#version 410
+
+// Input Data
+in vec4 fragmentColor;
+in vec2 UV;
+
+// Ouput data
+out vec4 color;
+
+void main()
+{
+    // Soft round sprite
+    float distance = length(UV * 2.0 - 1.0);
+    if(distance > 1.0)
+    {
+        discard;
+    }
+
+    color = vec4(fragmentColor.rgb, fragmentColor.a * (1.0 - smoothstep(0.5, 1.0, distance)));
+}
@@ -0,0 +1,27 @@
+#version 410
+
+// Per particle data, one instance per particle
+layout(location = 0) in vec4 particlePositionSize;
+layout(location = 1) in vec4 particleColor;
+
+// Values that stay constant for all particles
+uniform mat4 VP;
+uniform vec3 cameraRight;
+uniform vec3 cameraUp;
+
+// Output data ; will be interpolated for each fragment.
+out vec4 fragmentColor;
+out vec2 UV;
+
+void main()
+{
+    // Quad corners of a triangle strip, generated from the vertex ID
+    vec2 corner = vec2(gl_VertexID & 1, gl_VertexID >> 1);
+    UV = corner;
+
+    vec2 offset = (corner - 0.5) * particlePositionSize.w;
+    vec3 position = particlePositionSize.xyz + cameraRight * offset.x + cameraUp * offset.y;
+
+    gl_Position = VP * vec4(position, 1);
+    fragmentColor = particleColor;
+}
@@ -0,0 +1,59 @@
+#version 410
+#pragma shader_feature TEXTURED VERTEX_COLOR LIT INSTANCED ALPHA
+
+// Input Data
+in vec4 fragmentColor;
+#ifdef FEATURE_LIT
+in vec3 normal;
+#endif
+#ifdef FEATURE_TEXTURED
+in vec2 UV;
+#endif
+// Ouput data
+out vec4 color;
+
+// Values that stay constant for the whole mesh
+#ifdef FEATURE_TEXTURED
+uniform sampler2D textureSampler;
+#endif
+#ifdef FEATURE_LIT
+layout(std140) uniform AmbientLightBlock
+{
+    bool useAmbient;
+    float ambientIntensity;
+    vec3 ambientLightColor;
+};
+layout(std140) uniform DiffuseLightBlock
+{
+    bool useDiffuse;
+    float diffuseIntensity;
+    vec3 diffuseLightDir;
+    vec3 diffuseLightColor;
+};
+#endif
+
+void main()
+{
+    vec4 baseColor = fragmentColor;
+#ifdef FEATURE_TEXTURED
+    baseColor *= vec4(texture(textureSampler, UV).rgb, 1);
+#endif
+
+#ifdef FEATURE_LIT
+    vec3 ambientColor = mix(vec3(0.0, 0.0, 0.0), baseColor.xyz * vec3(ambientLightColor * ambientIntensity), int(useAmbient));
+
+    float diffuse = max(dot(normalize(normal), normalize(diffuseLightDir)), 0.0);
+    vec3 diffuseColor = mix(vec3(0.0, 0.0, 0.0), baseColor.xyz * vec3(diffuseLightColor * diffuse * diffuseIntensity), int(useDiffuse));
+
+    vec3 litColor = ambientColor + diffuseColor;
+#else
+    // Unlit, e.g. lighting is already baked into the vertex colors
+    vec3 litColor = baseColor.xyz;
+#endif
+
+#ifdef FEATURE_ALPHA
+    color = vec4(litColor, baseColor.w);
+#else
+    color = vec4(litColor, 1.0);
+#endif
+}
@@ -0,0 +1,97 @@
+#version 410
+#pragma shader_feature TEXTURED VERTEX_COLOR LIT INSTANCED ALPHA SKINNED
+
+// Input vertex data, different for all executions of this shader
+layout(location = 0) in vec3 vertexPosition_modelspace;
+#ifdef FEATURE_VERTEX_COLOR
+layout(location = 1) in vec4 vertexColor;
+#endif
+#ifdef FEATURE_LIT
+layout(location = 2) in vec3 vertexNormal;
+#endif
+#ifdef FEATURE_TEXTURED
+layout(location = 3) in vec2 vertexUV;
+#endif
+#ifdef FEATURE_INSTANCED
+layout(location = 4) in mat4 instanceModelMatrix;
+#endif
+#ifdef FEATURE_SKINNED
+layout(location = 8) in uvec4 boneIndices;
+layout(location = 9) in vec4 boneWeights;
+#endif
+
+// Values that stay constant for the whole mesh.
+#ifdef FEATURE_INSTANCED
+uniform mat4 VP;
+#else
+uniform mat4 MVP;
+#endif
+uniform vec4 tintColor;
+#ifdef FEATURE_SKINNED
+// 4 texels per bone, one per matrix column
+uniform samplerBuffer bonePalette;
+#endif
+
+// Has to match the depth pre-pass in depth.vert bit for bit, it gets tested with GL_EQUAL
+invariant gl_Position;
+
+// Output data ; will be interpolated for each fragment.
+out vec4 fragmentColor;
+#ifdef FEATURE_LIT
+out vec3 normal;
+#endif
+#ifdef FEATURE_TEXTURED
+out vec2 UV;
+#endif
+
+#ifdef FEATURE_SKINNED
+mat4 getBoneMatrix(uint bone)
+{
+    int texel = int(bone) * 4;
+    return mat4(
+        texelFetch(bonePalette, texel),
+        texelFetch(bonePalette, texel + 1),
+        texelFetch(bonePalette, texel + 2),
+        texelFetch(bonePalette, texel + 3)
+    );
+}
+#endif
+
+void main()
+{
+#ifdef FEATURE_SKINNED
+    // Vertices without weights aren't skinned
+    mat4 skinMatrix = mat4(1.0);
+    if(dot(boneWeights, vec4(1.0)) > 0.0)
+    {
+        skinMatrix = getBoneMatrix(boneIndices.x) * boneWeights.x + getBoneMatrix(boneIndices.y) * boneWeights.y +
+            getBoneMatrix(boneIndices.z) * boneWeights.z + getBoneMatrix(boneIndices.w) * boneWeights.w;
+    }
+    vec4 position_modelspace = skinMatrix * vec4(vertexPosition_modelspace, 1);
+#else
+    vec4 position_modelspace = vec4(vertexPosition_modelspace, 1);
+#endif
+
+#ifdef FEATURE_INSTANCED
+    gl_Position = VP * instanceModelMatrix * position_modelspace;
+#else
+    gl_Position = MVP * position_modelspace;
+#endif
+
+#ifdef FEATURE_VERTEX_COLOR
+    fragmentColor = vertexColor * tintColor;
+#else
+    fragmentColor = tintColor;
+#endif
+
+#ifdef FEATURE_LIT
+#ifdef FEATURE_SKINNED
+    normal = normalize(mat3(skinMatrix) * vertexNormal);
+#else
+    normal = vertexNormal;
+#endif
+#endif
+#ifdef FEATURE_TEXTURED
+    UV = vertexUV;
+#endif
+}
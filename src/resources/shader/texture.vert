@@ -1,23 +0,0 @@
-#version 410
-
-// Input vertex data, different for all executions of this shader
-layout(location = 0) in vec3 vertexPosition_modelspace;
-layout(location = 1) in vec2 vertexUV;
-layout(location = 2) in vec3 vertexNormal;
-
-// Values that stay constant for the whole mesh.
-uniform mat4 MVP;
-
-// Output data ; will be interpolated for each fragment.
-out vec2 UV;
-out vec3 normal;
-
-void main()
-{
-    // Output position of the vertex, in clip space : MVP * position
-    gl_Position = MVP * vec4(vertexPosition_modelspace, 1);
-
-    // UV of the vertex. No special space for this one.
-    UV = vertexUV;
-    normal = vertexNormal;
-}
\ No newline at end of file
@@ -0,0 +1,30 @@
+#version 410
+
+// Input Data
+in vec2 UV;
+// Ouput data
+out vec4 color;
+
+// Values that stay constant for the whole mesh
+uniform sampler2D sceneTexture;
+uniform vec2 texelSize;
+uniform float sharpness;
+
+// Contrast adaptive sharpening: sharpens less where the local contrast is already high, which avoids halos
+void main()
+{
+    vec3 center = texture(sceneTexture, UV).rgb;
+    vec3 north = texture(sceneTexture, UV + vec2(0.0, texelSize.y)).rgb;
+    vec3 south = texture(sceneTexture, UV - vec2(0.0, texelSize.y)).rgb;
+    vec3 east = texture(sceneTexture, UV + vec2(texelSize.x, 0.0)).rgb;
+    vec3 west = texture(sceneTexture, UV - vec2(texelSize.x, 0.0)).rgb;
+
+    vec3 minColor = min(center, min(min(north, south), min(east, west)));
+    vec3 maxColor = max(center, max(max(north, south), max(east, west)));
+
+    vec3 amplitude = sqrt(clamp(min(minColor, 1.0 - maxColor) / max(maxColor, vec3(0.0001)), 0.0, 1.0));
+    vec3 weight = amplitude * (-1.0 / mix(8.0, 5.0, sharpness));
+
+    vec3 result = (center + (north + south + east + west) * weight) / (1.0 + 4.0 * weight);
+    color = vec4(clamp(result, 0.0, 1.0), 1.0);
+}
@@ -0,0 +1,12 @@
+#version 410
+
+// Output data ; will be interpolated for each fragment.
+out vec2 UV;
+
+void main()
+{
+    // One triangle covering the whole screen
+    vec2 position = vec2((gl_VertexID << 1) & 2, gl_VertexID & 2);
+    UV = position;
+    gl_Position = vec4(position * 2.0 - 1.0, 0.0, 1.0);
+}
@@ -0,0 +1,237 @@
+#include <gtest/gtest.h>
+
+#include "../src/classes/engine/vfs/AssetArchive.h"
+#include "../src/classes/engine/vfs/VirtualFileSystem.h"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace Engine;
+
+namespace
+{
+    void writeFile(const std::filesystem::path& filePath, const std::vector<uint8_t>& data)
+    {
+        std::filesystem::create_directories(filePath.parent_path());
+        std::ofstream stream(filePath, std::ios::binary);
+        stream.write(reinterpret_cast<const char*>(data.data()), std::streamsize(data.size()));
+    }
+
+    std::vector<uint8_t> readFile(const std::filesystem::path& filePath)
+    {
+        std::ifstream stream(filePath, std::ios::binary);
+        return std::vector<uint8_t>(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+    }
+
+    std::vector<uint8_t> toBytes(const std::string& text) { return std::vector<uint8_t>(text.begin(), text.end()); }
+
+    std::vector<uint8_t> fileBytes(const AssetFile& file)
+    {
+        return std::vector<uint8_t>(file.data(), file.data() + file.size());
+    }
+
+    /**
+     * @brief Packs a directory of test assets into an archive, the loose files get removed again so every read has to
+     * come from the archive.
+     */
+    class AssetArchiveSuite : public ::testing::Test
+    {
+        protected:
+            void SetUp() override
+            {
+                m_directory = std::filesystem::temp_directory_path() / "assetArchiveTest";
+                std::filesystem::remove_all(m_directory);
+
+                std::string shader;
+                for(int i = 0; i < 200; i++)
+                {
+                    shader += "uniform mat4 MVP;\nvoid main() { gl_Position = MVP * vec4(position, 1.0); }\n";
+                }
+                m_shader = toBytes(shader);
+
+                // Noise doesn't compress, repeating bytes would but a .glb never gets compressed
+                std::mt19937 random(23);
+                m_texture.resize(5000);
+                for(uint8_t& byte : m_texture)
+                {
+                    byte = uint8_t(random());
+                }
+                m_model.assign(4096, 0x2A);
+
+                const std::filesystem::path assets = m_directory / "assets";
+                writeFile(assets / "shader" / "standard.vert", m_shader);
+                writeFile(assets / "textures" / "tile.png", m_texture);
+                writeFile(assets / "models" / "tree.glb", m_model);
+                writeFile(assets / "models" / "tree.cmdl", m_model);
+                writeFile(assets / "empty.txt", {});
+
+                std::vector<AssetArchive::SourceFile> files;
+                ASSERT_TRUE(AssetArchive::collectFiles(assets.generic_string(), files));
+                ASSERT_EQ(4u, files.size());
+
+                m_archivePath = (m_directory / "assets.pak").string();
+                ASSERT_TRUE(AssetArchive::write(m_archivePath, files));
+                std::filesystem::remove_all(assets);
+            }
+
+            void TearDown() override
+            {
+                m_fileSystem.unmountAll();
+                std::filesystem::remove_all(m_directory);
+            }
+
+            std::string getAssetPath(const std::string& name) const
+            {
+                return (m_directory / "assets" / name).generic_string();
+            }
+
+            /**
+             * @brief Writes a modified copy of the archive and tries to mount it.
+             */
+            bool mountModified(const std::vector<uint8_t>& data)
+            {
+                const std::filesystem::path modifiedPath = m_directory / "modified.pak";
+                writeFile(modifiedPath, data);
+                return m_fileSystem.mountArchive(modifiedPath.string());
+            }
+
+            AssetArchiveEntry* findEntry(std::vector<uint8_t>& data, const std::string& name) const
+            {
+                AssetArchiveHeader header;
+                memcpy(&header, data.data(), sizeof(header));
+                auto* entries = reinterpret_cast<AssetArchiveEntry*>(data.data() + header.indexOffset);
+                const uint64_t hash = AssetArchive::hashPath(AssetArchive::normalizePath(getAssetPath(name)));
+                for(uint32_t i = 0; i < header.entryCount; i++)
+                {
+                    if(entries[i].pathHash == hash)
+                    {
+                        return &entries[i];
+                    }
+                }
+                return nullptr;
+            }
+
+            std::filesystem::path m_directory;
+            std::string m_archivePath;
+            std::vector<uint8_t> m_shader;
+            std::vector<uint8_t> m_texture;
+            std::vector<uint8_t> m_model;
+            VirtualFileSystem m_fileSystem;
+    };
+} // namespace
+
+TEST_F(AssetArchiveSuite, PackedFilesReadBack)
+{
+    ASSERT_TRUE(m_fileSystem.mountArchive(m_archivePath));
+
+    AssetArchive archive;
+    ASSERT_TRUE(archive.open(m_archivePath));
+    ASSERT_EQ(4u, archive.getEntryCount());
+    ASSERT_EQ(nullptr, archive.find(getAssetPath("models/tree.cmdl")));
+
+    // Text compresses well & gets decompressed into a buffer of its own
+    const AssetArchiveEntry* shaderEntry = archive.find(getAssetPath("shader/standard.vert"));
+    ASSERT_NE(nullptr, shaderEntry);
+    ASSERT_TRUE(shaderEntry->flags & ASSET_ENTRY_LZ4);
+    ASSERT_LT(shaderEntry->storedSize, shaderEntry->size);
+    AssetFile shader;
+    ASSERT_TRUE(m_fileSystem.openFile(getAssetPath("shader/standard.vert"), shader));
+    ASSERT_FALSE(shader.isMapped());
+    ASSERT_EQ(m_shader, fileBytes(shader));
+
+    // Stored formats are read in place, aligned for zero copy uploads
+    for(const auto& [name, expected] : { std::pair(std::string("textures/tile.png"), m_texture),
+                                         std::pair(std::string("models/tree.glb"), m_model) })
+    {
+        const AssetArchiveEntry* entry = archive.find(getAssetPath(name));
+        ASSERT_NE(nullptr, entry);
+        ASSERT_FALSE(entry->flags & ASSET_ENTRY_LZ4);
+        ASSERT_EQ(0u, entry->offset % ASSET_ARCHIVE_ALIGNMENT);
+
+        AssetFile file;
+        ASSERT_TRUE(m_fileSystem.openFile(getAssetPath(name), file));
+        ASSERT_TRUE(file.isMapped());
+        ASSERT_EQ(expected, fileBytes(file));
+    }
+
+    AssetFile empty;
+    ASSERT_TRUE(m_fileSystem.openFile(getAssetPath("empty.txt"), empty));
+    ASSERT_TRUE(empty.isOpen());
+    ASSERT_EQ(0u, empty.size());
+
+    // Backslashes & a leading "./" resolve to the same entry
+    ASSERT_EQ(shaderEntry, archive.find(getAssetPath("shader\\standard.vert")));
+    ASSERT_EQ(shaderEntry, archive.find("./" + getAssetPath("shader/standard.vert")));
+
+    AssetFile missing;
+    ASSERT_FALSE(m_fileSystem.openFile(getAssetPath("missing.txt"), missing));
+    ASSERT_FALSE(m_fileSystem.exists(getAssetPath("missing.txt")));
+}
+
+TEST_F(AssetArchiveSuite, TruncatedArchivesDontMount)
+{
+    const std::vector<uint8_t> data = readFile(m_archivePath);
+    ASSERT_TRUE(mountModified(data));
+    m_fileSystem.unmountAll();
+
+    // Cut off within the paths, the index & a payload
+    for(const size_t size : { data.size() - 1, data.size() / 2, sizeof(AssetArchiveHeader) + 8, size_t(10) })
+    {
+        ASSERT_FALSE(mountModified(std::vector<uint8_t>(data.begin(), data.begin() + std::ptrdiff_t(size))));
+    }
+    ASSERT_EQ(0u, m_fileSystem.getMountedArchiveCount());
+}
+
+TEST_F(AssetArchiveSuite, CorruptArchivesDontMount)
+{
+    const std::vector<uint8_t> data = readFile(m_archivePath);
+
+    // Offsets that only fit the file once the addition overflows
+    std::vector<uint8_t> corrupt = data;
+    AssetArchiveHeader header;
+    memcpy(&header, corrupt.data(), sizeof(header));
+    header.pathsOffset = UINT64_MAX - header.pathsSize / 2;
+    memcpy(corrupt.data(), &header, sizeof(header));
+    ASSERT_FALSE(mountModified(corrupt));
+
+    corrupt = data;
+    findEntry(corrupt, "textures/tile.png")->offset = UINT64_MAX - 64;
+    ASSERT_FALSE(mountModified(corrupt));
+
+    corrupt = data;
+    findEntry(corrupt, "shader/standard.vert")->pathOffset = UINT32_MAX;
+    ASSERT_FALSE(mountModified(corrupt));
+
+    // A stored entry claiming more bytes than its payload holds
+    corrupt = data;
+    findEntry(corrupt, "models/tree.glb")->size += 1;
+    ASSERT_FALSE(mountModified(corrupt));
+
+    corrupt = data;
+    reinterpret_cast<AssetArchiveHeader*>(corrupt.data())->magic = 0;
+    ASSERT_FALSE(mountModified(corrupt));
+    ASSERT_EQ(0u, m_fileSystem.getMountedArchiveCount());
+}
+
+TEST_F(AssetArchiveSuite, CorruptPayloadsFailToRead)
+{
+    std::vector<uint8_t> corrupt = readFile(m_archivePath);
+    const AssetArchiveEntry* entry = findEntry(corrupt, "shader/standard.vert");
+    ASSERT_NE(nullptr, entry);
+    memset(corrupt.data() + entry->offset, 0xFF, size_t(entry->storedSize));
+
+    // The index is intact, only decompressing the block fails
+    ASSERT_TRUE(mountModified(corrupt));
+    AssetFile shader;
+    ASSERT_FALSE(m_fileSystem.openFile(getAssetPath("shader/standard.vert"), shader));
+    ASSERT_EQ(0u, shader.size());
+
+    AssetFile texture;
+    ASSERT_TRUE(m_fileSystem.openFile(getAssetPath("textures/tile.png"), texture));
+    ASSERT_EQ(m_texture, fileBytes(texture));
+}
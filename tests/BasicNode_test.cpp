@@ -1,10 +1,37 @@
 
 #include <gtest/gtest.h>
 
+#include "../src/classes/engine/EngineManager.h"
+#include "../src/classes/engine/NodeLifecycleQueue.h"
+#include "../src/classes/engine/SceneIndex.h"
+#include "../src/classes/engine/ThreadPool.h"
+#include "../src/classes/engine/rendering/backend/RecordingRenderBackend.h"
 #include "../src/classes/nodeComponents/BasicNode.h"
 
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <unordered_set>
+
 using namespace Engine;
 
+namespace
+{
+    /**
+     * @brief Records the order its instances got started in.
+     */
+    class StartRecorder : public BasicNode
+    {
+        public:
+            explicit StartRecorder(std::vector<StartRecorder*>& started) : m_started(started) {}
+
+            void start() override { m_started.push_back(this); }
+
+        private:
+            std::vector<StartRecorder*>& m_started;
+    };
+} // namespace
+
 TEST(BasicNodeSuite, SetName)
 {
     std::string name = "Donald";
@@ -37,8 +64,312 @@ TEST(BasicNodeSuite, CallOnChildren)
     ASSERT_EQ(name, nodeChild3->getName());
 }
 
+TEST(BasicNodeSuite, NamesAreInterned)
+{
+    std::shared_ptr<BasicNode> node = std::make_shared<BasicNode>();
+    std::shared_ptr<BasicNode> other = std::make_shared<BasicNode>();
+    node->setName("Donald");
+    other->setName(std::string("Don") + "ald");
+
+    ASSERT_EQ(node->getNameId(), other->getNameId());
+    ASSERT_EQ(&node->getName(), &other->getName());
+    ASSERT_EQ(NameTable::EMPTY, std::make_shared<BasicNode>()->getNameId());
+}
+
+TEST(BasicNodeSuite, FindByNameAndId)
+{
+    const auto& sceneIndex = SingletonManager::get<EngineManager>()->getSceneIndex();
+    std::shared_ptr<BasicNode> node = std::make_shared<BasicNode>();
+    std::shared_ptr<BasicNode> child = std::make_shared<BasicNode>();
+    child->setName("Daisy");
+    node->addChild(child);
+
+    ASSERT_EQ(child, sceneIndex->findNode(child->getNodeId()));
+    ASSERT_EQ(child, sceneIndex->findNodeByName("Daisy"));
+
+    // Renaming an indexed node moves it in the index
+    child->setName("Daisy Duck");
+    ASSERT_EQ(nullptr, sceneIndex->findNodeByName("Daisy"));
+    ASSERT_EQ(child, sceneIndex->findNodeByName("Daisy Duck"));
+
+    node->deleteChild(child);
+    ASSERT_EQ(nullptr, sceneIndex->findNode(child->getNodeId()));
+    ASSERT_EQ(nullptr, sceneIndex->findNodeByName("Daisy Duck"));
+}
+
+TEST(BasicNodeSuite, DetachedSubtreesLeaveTheIndex)
+{
+    const auto& sceneIndex = SingletonManager::get<EngineManager>()->getSceneIndex();
+    std::shared_ptr<BasicNode> node = std::make_shared<BasicNode>();
+    std::shared_ptr<BasicNode> child = std::make_shared<BasicNode>();
+    std::shared_ptr<BasicNode> grandChild = std::make_shared<BasicNode>();
+    grandChild->setName("Huey");
+    node->addChild(child);
+    child->addChild(grandChild);
+    ASSERT_EQ(grandChild, sceneIndex->findNodeByName("Huey"));
+
+    node->detatchChild(child);
+    ASSERT_EQ(nullptr, sceneIndex->findNode(child->getNodeId()));
+    ASSERT_EQ(nullptr, sceneIndex->findNode(grandChild->getNodeId()));
+    ASSERT_EQ(nullptr, sceneIndex->findNodeByName("Huey"));
+    ASSERT_FALSE(grandChild->isInScene());
+}
+
+TEST(BasicNodeSuite, DeferredAddsJoinOnFlush)
+{
+    const auto& lifecycleQueue = SingletonManager::get<NodeLifecycleQueue>();
+    const auto& sceneIndex = SingletonManager::get<EngineManager>()->getSceneIndex();
+    std::vector<StartRecorder*> started;
+    std::shared_ptr<BasicNode> root = std::make_shared<BasicNode>();
+    auto child = std::make_shared<StartRecorder>(started);
+
+    // The parent is known right away, everything else waits for the flush
+    root->addChildDeferred(child);
+    ASSERT_EQ(root, child->getParentNode());
+    ASSERT_EQ(1u, lifecycleQueue->getPendingAddCount());
+    ASSERT_TRUE(root->getChildNodes().empty());
+    ASSERT_FALSE(child->isInScene());
+    ASSERT_TRUE(started.empty());
+
+    lifecycleQueue->flush();
+    ASSERT_EQ(0u, lifecycleQueue->getPendingAddCount());
+    ASSERT_EQ(std::vector<std::shared_ptr<BasicNode>>({ child }), root->getChildNodes());
+    ASSERT_EQ(child, sceneIndex->findNode(child->getNodeId()));
+    ASSERT_EQ(std::vector<StartRecorder*>({ child.get() }), started);
+
+    // Adds queued after a flush wait for the next one
+    auto grandChild = std::make_shared<StartRecorder>(started);
+    child->addChildDeferred(grandChild);
+    ASSERT_EQ(child, grandChild->getParentNode());
+    ASSERT_FALSE(grandChild->isInScene());
+
+    lifecycleQueue->flush();
+    ASSERT_TRUE(grandChild->isInScene());
+    ASSERT_EQ(grandChild, child->getChildNode(0));
+    ASSERT_EQ(std::vector<StartRecorder*>({ child.get(), grandChild.get() }), started);
+
+    root->deleteAllChildren();
+}
+
+TEST(BasicNodeSuite, DeferredDestroyOfParentAndChild)
+{
+    const auto& lifecycleQueue = SingletonManager::get<NodeLifecycleQueue>();
+    const auto& sceneIndex = SingletonManager::get<EngineManager>()->getSceneIndex();
+    std::shared_ptr<BasicNode> root = std::make_shared<BasicNode>();
+    std::shared_ptr<BasicNode> parent = std::make_shared<BasicNode>();
+    std::shared_ptr<BasicNode> sibling = std::make_shared<BasicNode>();
+    std::shared_ptr<BasicNode> child = std::make_shared<BasicNode>();
+    std::shared_ptr<BasicNode> grandChild = std::make_shared<BasicNode>();
+    root->addChild(parent);
+    root->addChild(sibling);
+    parent->addChild(child);
+    child->addChild(grandChild);
+
+    // The child first, its parent twice, each node still has to be removed & released only once
+    child->deleteNodeDeferred();
+    parent->deleteNodeDeferred();
+    parent->deleteNodeDeferred();
+    ASSERT_EQ(3u, lifecycleQueue->getPendingDestroyCount());
+    ASSERT_TRUE(child->isInScene());
+
+    lifecycleQueue->flush();
+    ASSERT_EQ(0u, lifecycleQueue->getPendingDestroyCount());
+    ASSERT_EQ(std::vector<std::shared_ptr<BasicNode>>({ sibling }), root->getChildNodes());
+    ASSERT_TRUE(parent->getChildNodes().empty());
+    ASSERT_EQ(nullptr, parent->getParentNode());
+    ASSERT_EQ(nullptr, child->getParentNode());
+    for(const auto& node : { parent, child, grandChild })
+    {
+        ASSERT_FALSE(node->isInScene());
+        ASSERT_EQ(nullptr, sceneIndex->findNode(node->getNodeId()));
+    }
+    ASSERT_TRUE(sibling->isInScene());
+    ASSERT_EQ(2u, lifecycleQueue->getPendingReleaseCount());
+
+    const std::weak_ptr<BasicNode> weakParent = parent;
+    const std::weak_ptr<BasicNode> weakGrandChild = grandChild;
+    parent.reset();
+    child.reset();
+    grandChild.reset();
+    lifecycleQueue->releaseDestroyed();
+    ASSERT_EQ(0u, lifecycleQueue->getPendingReleaseCount());
+    ASSERT_TRUE(weakParent.expired());
+    ASSERT_TRUE(weakGrandChild.expired());
+
+    root->deleteAllChildren();
+}
+
+TEST(BasicNodeSuite, DestroyedNodesReleaseOverFrames)
+{
+    const auto& lifecycleQueue = SingletonManager::get<NodeLifecycleQueue>();
+    const size_t budget = lifecycleQueue->getDestroyBudget();
+    const size_t childCount = 2 * budget + 100;
+    std::shared_ptr<BasicNode> root = std::make_shared<BasicNode>();
+    std::shared_ptr<BasicNode> subtree = std::make_shared<BasicNode>();
+    std::vector<std::weak_ptr<BasicNode>> children;
+    for(size_t i = 0; i < childCount; i++)
+    {
+        auto child = std::make_shared<BasicNode>();
+        subtree->addChildDetached(child);
+        children.push_back(child);
+    }
+    root->addChild(subtree);
+
+    subtree->deleteNodeDeferred();
+    subtree.reset();
+    lifecycleQueue->flush();
+    ASSERT_EQ(1u, lifecycleQueue->getPendingReleaseCount());
+
+    // The subtree root & its children count alike, no frame releases more than the budget
+    size_t frames = 0;
+    size_t pending = childCount + 1;
+    while(lifecycleQueue->getPendingReleaseCount() > 0)
+    {
+        lifecycleQueue->releaseDestroyed();
+        frames++;
+        pending -= std::min(pending, budget);
+        ASSERT_EQ(pending, lifecycleQueue->getPendingReleaseCount());
+
+        const size_t expired = std::count_if(
+                children.begin(),
+                children.end(),
+                [](const std::weak_ptr<BasicNode>& child) { return child.expired(); }
+        );
+        ASSERT_EQ(childCount - pending, expired);
+    }
+    ASSERT_EQ((childCount + budget) / budget, frames);
+}
+
+TEST(BasicNodeSuite, SubtreesBuiltInParallelAttachInBulk)
+{
+    constexpr size_t SUBTREE_COUNT = 16;
+    constexpr int NODES_PER_SUBTREE = 500;
+
+    const auto& sceneIndex = SingletonManager::get<EngineManager>()->getSceneIndex();
+    const size_t indexedBefore = sceneIndex->getCount();
+
+    // Every worker builds its own subtrees without touching the engine
+    std::vector<std::shared_ptr<BasicNode>> subtrees(SUBTREE_COUNT);
+    SingletonManager::get<ThreadPool>()->parallelFor(
+            SUBTREE_COUNT,
+            [&subtrees](size_t begin, size_t end)
+            {
+                for(size_t i = begin; i < end; i++)
+                {
+                    subtrees[i] = std::make_shared<BasicNode>();
+                    subtrees[i]->setName("subtree" + std::to_string(i));
+                    for(int j = 0; j < NODES_PER_SUBTREE; j++)
+                    {
+                        subtrees[i]->addChildDetached(std::make_shared<BasicNode>());
+                    }
+                }
+            },
+            1
+    );
+    ASSERT_EQ(indexedBefore, sceneIndex->getCount());
+
+    std::unordered_set<unsigned int> nodeIds;
+    for(const auto& subtree : subtrees)
+    {
+        subtree->callOnAllChildrenRecursiveAndSelf([&nodeIds](BasicNode* node) { nodeIds.insert(node->getNodeId()); });
+    }
+    ASSERT_EQ(SUBTREE_COUNT * (NODES_PER_SUBTREE + 1), nodeIds.size());
+    ASSERT_FALSE(nodeIds.contains(0u));
+
+    std::shared_ptr<BasicNode> root = std::make_shared<BasicNode>();
+    for(const auto& subtree : subtrees)
+    {
+        root->addChild(subtree);
+    }
+    ASSERT_EQ(indexedBefore + nodeIds.size(), sceneIndex->getCount());
+    ASSERT_TRUE(subtrees.back()->getChildNode(0)->isInScene());
+    ASSERT_EQ(subtrees.front(), sceneIndex->findNodeByName("subtree0"));
+
+    root->deleteAllChildren();
+    ASSERT_EQ(indexedBefore, sceneIndex->getCount());
+}
+
+TEST(BasicNodeSuite, SubtreesStartOnceParentsFirst)
+{
+    std::vector<StartRecorder*> started;
+    std::shared_ptr<BasicNode> root = std::make_shared<BasicNode>();
+    auto parent = std::make_shared<StartRecorder>(started);
+    auto child = std::make_shared<StartRecorder>(started);
+    parent->addChildDetached(child);
+
+    root->addChild(parent);
+    ASSERT_EQ(std::vector<StartRecorder*>({ parent.get(), child.get() }), started);
+
+    // Attaching the subtree again registers it again, but doesn't start it a second time
+    root->detatchChild(parent);
+    ASSERT_FALSE(child->isInScene());
+    root->addChild(parent);
+    ASSERT_TRUE(child->isInScene());
+    ASSERT_EQ(2u, started.size());
+
+    root->deleteAllChildren();
+}
+
+TEST(BasicNodeSuite, Benchmark10kFindByName)
+{
+    constexpr int NODE_COUNT = 10000;
+    constexpr int WALK_COUNT = 100;
+
+    const auto& sceneIndex = SingletonManager::get<EngineManager>()->getSceneIndex();
+    std::shared_ptr<BasicNode> root = std::make_shared<BasicNode>();
+    std::vector<std::string> names;
+    for(int i = 0; i < NODE_COUNT; i++)
+    {
+        names.push_back("node" + std::to_string(i));
+        auto node = std::make_shared<BasicNode>();
+        node->setName(names.back());
+        root->addChildDeferred(node);
+    }
+    SingletonManager::get<NodeLifecycleQueue>()->flush();
+
+    using Clock = std::chrono::steady_clock;
+    auto start = Clock::now();
+    size_t found = 0;
+    for(const std::string& name : names)
+    {
+        found += sceneIndex->findNodeByName(name) != nullptr;
+    }
+    const double indexMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    ASSERT_EQ(size_t(NODE_COUNT), found);
+
+    // Walking the graph is what finding a node took without the index, only a few lookups to keep it quick
+    start = Clock::now();
+    found = 0;
+    for(int i = 0; i < WALK_COUNT; i++)
+    {
+        BasicNode* match = nullptr;
+        const std::string& name = names[i * (NODE_COUNT / WALK_COUNT)];
+        root->callOnAllChildrenRecursive(
+                [&match, &name](BasicNode* node)
+                {
+                    if(!match && node->getName() == name)
+                    {
+                        match = node;
+                    }
+                }
+        );
+        found += match != nullptr;
+    }
+    const double walkMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    ASSERT_EQ(size_t(WALK_COUNT), found);
+
+    std::cout << "[ Find 10k ] index " << indexMs * 1000.0 / NODE_COUNT << " us, graph walk "
+              << walkMs * 1000.0 / WALK_COUNT << " us per lookup" << std::endl;
+
+    root->deleteAllChildren();
+    ASSERT_EQ(nullptr, sceneIndex->findNodeByName(names.front()));
+}
+
 int main(int argc, char** argv)
 {
+    // None of the tests has a GL context, the engine renders into a backend that only records the commands
+    RenderBackend::set(std::make_unique<RecordingRenderBackend>());
+
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
 }
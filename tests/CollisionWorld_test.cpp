@@ -0,0 +1,252 @@
+#include <gtest/gtest.h>
+
+#include "../src/classes/engine/collision/CollisionWorld.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <set>
+#include <utility>
+
+using namespace Engine;
+
+namespace
+{
+    std::set<std::pair<CollisionBodyId, CollisionBodyId>> toSet(const std::vector<CollisionPair>& pairs)
+    {
+        std::set<std::pair<CollisionBodyId, CollisionBodyId>> result;
+        for(const CollisionPair& pair : pairs)
+        {
+            result.emplace(pair.a, pair.b);
+        }
+        return result;
+    }
+
+    std::set<std::pair<CollisionBodyId, CollisionBodyId>> bruteForcePairs(const CollisionWorld& world, const std::vector<CollisionBodyId>& bodies)
+    {
+        std::set<std::pair<CollisionBodyId, CollisionBodyId>> result;
+        for(size_t i = 0; i < bodies.size(); i++)
+        {
+            for(size_t j = i + 1; j < bodies.size(); j++)
+            {
+                const CollisionBodyId a = std::min(bodies[i], bodies[j]);
+                const CollisionBodyId b = std::max(bodies[i], bodies[j]);
+                const glm::vec3 minA = world.getWorldMin(a);
+                const glm::vec3 maxA = world.getWorldMax(a);
+                const glm::vec3 minB = world.getWorldMin(b);
+                const glm::vec3 maxB = world.getWorldMax(b);
+
+                const bool layersMatch = (world.getLayer(a) & world.getMask(b)) && (world.getLayer(b) & world.getMask(a));
+                const bool overlaps = minA.x <= maxB.x && minB.x <= maxA.x && minA.y <= maxB.y && minB.y <= maxA.y &&
+                                      minA.z <= maxB.z && minB.z <= maxA.z;
+                if(layersMatch && overlaps)
+                {
+                    result.emplace(a, b);
+                }
+            }
+        }
+        return result;
+    }
+
+    glm::mat4 translation(const glm::vec3& position)
+    {
+        glm::mat4 matrix(1.f);
+        matrix[3] = glm::vec4(position, 1.f);
+        return matrix;
+    }
+} // namespace
+
+TEST(CollisionWorldSuite, PairsMatchBruteForceWhileMoving)
+{
+    CollisionWorld world;
+    std::mt19937 random(7);
+    std::uniform_real_distribution<float> position(-50.f, 50.f);
+    std::uniform_real_distribution<float> size(0.5f, 4.f);
+    std::uniform_real_distribution<float> step(-1.f, 1.f);
+
+    std::vector<CollisionBodyId> bodies;
+    std::vector<glm::vec3> positions;
+    for(int i = 0; i < 2000; i++)
+    {
+        const glm::vec3 extent(size(random), size(random), size(random));
+        bodies.push_back(world.addBody(-extent, extent, 1u << (i % 3), i % 5 == 0 ? 1u : UINT32_MAX));
+        positions.emplace_back(position(random), position(random), position(random));
+    }
+
+    for(int frame = 0; frame < 10; frame++)
+    {
+        for(size_t i = 0; i < bodies.size(); i++)
+        {
+            positions[i] += glm::vec3(step(random), step(random), step(random));
+            world.setTransform(bodies[i], translation(positions[i]));
+        }
+        world.update();
+
+        ASSERT_EQ(bruteForcePairs(world, bodies), toSet(world.getOverlappingPairs())) << "frame " << frame;
+    }
+}
+
+TEST(CollisionWorldSuite, LayersAndMasks)
+{
+    CollisionWorld world;
+    const CollisionBodyId player = world.addBody(glm::vec3(-1.f), glm::vec3(1.f), 1u, 2u);
+    const CollisionBodyId pickup = world.addBody(glm::vec3(-1.f), glm::vec3(1.f), 2u, 1u);
+    const CollisionBodyId decoration = world.addBody(glm::vec3(-1.f), glm::vec3(1.f), 4u, UINT32_MAX);
+    world.update();
+
+    const auto pairs = toSet(world.getOverlappingPairs());
+    ASSERT_EQ(1u, pairs.size());
+    ASSERT_TRUE(pairs.count({ player, pickup }));
+
+    std::vector<CollisionBodyId> overlaps;
+    world.getOverlaps(decoration, overlaps);
+    ASSERT_TRUE(overlaps.empty());
+}
+
+TEST(CollisionWorldSuite, RotatedBoundsEncloseTheBox)
+{
+    CollisionWorld world;
+    const CollisionBodyId body = world.addBody(glm::vec3(-1.f, -1.f, -1.f), glm::vec3(1.f, 1.f, 1.f));
+
+    // 45 degrees around z, the corners reach out to sqrt(2) on x & y
+    const float c = std::sqrt(0.5f);
+    glm::mat4 rotation(1.f);
+    rotation[0] = glm::vec4(c, c, 0.f, 0.f);
+    rotation[1] = glm::vec4(-c, c, 0.f, 0.f);
+    rotation[3] = glm::vec4(10.f, 0.f, 0.f, 1.f);
+    world.setTransform(body, rotation);
+
+    ASSERT_NEAR(10.f - std::sqrt(2.f), world.getWorldMin(body).x, 1e-5f);
+    ASSERT_NEAR(std::sqrt(2.f), world.getWorldMax(body).y, 1e-5f);
+    ASSERT_NEAR(1.f, world.getWorldMax(body).z, 1e-5f);
+}
+
+TEST(CollisionWorldSuite, RemovedBodiesLeaveThePairs)
+{
+    CollisionWorld world;
+    const CollisionBodyId a = world.addBody(glm::vec3(0.f), glm::vec3(2.f));
+    const CollisionBodyId b = world.addBody(glm::vec3(1.f), glm::vec3(3.f));
+    world.update();
+    ASSERT_EQ(1u, world.getOverlappingPairs().size());
+
+    world.removeBody(b);
+    // Not reused before the next update, the old pair still refers to the removed body
+    ASSERT_NE(b, world.addBody(glm::vec3(10.f), glm::vec3(11.f)));
+    world.update();
+
+    ASSERT_TRUE(world.getOverlappingPairs().empty());
+    ASSERT_EQ(2u, world.getBodyCount());
+    ASSERT_EQ(b, world.addBody(glm::vec3(0.f), glm::vec3(1.f)));
+    ASSERT_TRUE(world.isActive(a));
+}
+
+TEST(CollisionWorldSuite, QueriesMatchBruteForce)
+{
+    CollisionWorld world;
+    std::mt19937 random(3);
+    std::uniform_real_distribution<float> position(-20.f, 20.f);
+    std::uniform_real_distribution<float> size(0.1f, 3.f);
+
+    std::vector<CollisionBodyId> bodies;
+    for(int i = 0; i < 500; i++)
+    {
+        const glm::vec3 center(position(random), position(random), position(random));
+        const glm::vec3 extent(size(random), size(random), size(random));
+        bodies.push_back(world.addBody(center - extent, center + extent, i % 2 ? 1u : 2u));
+    }
+    world.update();
+
+    const glm::vec3 queryMin(-5.f, -2.f, -8.f);
+    const glm::vec3 queryMax(4.f, 6.f, 1.f);
+    std::vector<CollisionBodyId> boxResults;
+    world.queryAabb(queryMin, queryMax, 1u, boxResults);
+
+    const glm::vec3 center(2.f, -3.f, 5.f);
+    const float radius = 6.f;
+    std::vector<CollisionBodyId> sphereResults;
+    world.querySphere(center, radius, UINT32_MAX, sphereResults);
+
+    std::set<CollisionBodyId> expectedBox;
+    std::set<CollisionBodyId> expectedSphere;
+    for(const CollisionBodyId body : bodies)
+    {
+        const glm::vec3 min = world.getWorldMin(body);
+        const glm::vec3 max = world.getWorldMax(body);
+        if(world.getLayer(body) == 1u && min.x <= queryMax.x && queryMin.x <= max.x && min.y <= queryMax.y &&
+           queryMin.y <= max.y && min.z <= queryMax.z && queryMin.z <= max.z)
+        {
+            expectedBox.insert(body);
+        }
+
+        const glm::vec3 offset = glm::clamp(center, min, max) - center;
+        if(glm::dot(offset, offset) <= radius * radius)
+        {
+            expectedSphere.insert(body);
+        }
+    }
+
+    ASSERT_FALSE(expectedBox.empty());
+    ASSERT_EQ(expectedBox, std::set<CollisionBodyId>(boxResults.begin(), boxResults.end()));
+    ASSERT_EQ(expectedSphere, std::set<CollisionBodyId>(sphereResults.begin(), sphereResults.end()));
+}
+
+TEST(CollisionWorldSuite, Benchmark100kMovingBodies)
+{
+    constexpr int BODY_COUNT = 100000;
+    constexpr int FRAME_COUNT = 60;
+
+    CollisionWorld world;
+    std::mt19937 random(11);
+    // Roughly 1 unit boxes spread so every body touches a handful of others
+    std::uniform_real_distribution<float> position(-250.f, 250.f);
+    std::uniform_real_distribution<float> size(0.25f, 1.f);
+    std::uniform_real_distribution<float> velocity(-0.2f, 0.2f);
+
+    std::vector<CollisionBodyId> bodies;
+    std::vector<glm::vec3> positions;
+    std::vector<glm::vec3> velocities;
+    for(int i = 0; i < BODY_COUNT; i++)
+    {
+        const glm::vec3 extent(size(random), size(random), size(random));
+        bodies.push_back(world.addBody(-extent, extent, 1u << (i % 4)));
+        positions.emplace_back(position(random), position(random) * 0.2f, position(random));
+        velocities.emplace_back(velocity(random), velocity(random), velocity(random));
+    }
+
+    using Clock = std::chrono::steady_clock;
+    double firstFrameMs = 0.0;
+    double totalMs = 0.0;
+    size_t totalPairs = 0;
+    int64_t totalSwaps = 0;
+
+    for(int frame = 0; frame <= FRAME_COUNT; frame++)
+    {
+        for(size_t i = 0; i < bodies.size(); i++)
+        {
+            positions[i] += velocities[i];
+            world.setTransform(bodies[i], translation(positions[i]));
+        }
+
+        const auto start = Clock::now();
+        world.update();
+        const double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+        if(frame == 0)
+        {
+            firstFrameMs = ms;
+            continue;
+        }
+        totalMs += ms;
+        totalPairs += world.getOverlappingPairs().size();
+        totalSwaps += std::max<int64_t>(world.getLastSwapCount(), 0);
+        // After the first frame bodies only drift, the insertion sort has to keep up without falling back
+        ASSERT_GE(world.getLastSwapCount(), 0);
+    }
+
+    std::cout << "[ SAP 100k ] first update " << firstFrameMs << " ms, average update " << totalMs / FRAME_COUNT
+              << " ms, " << totalPairs / FRAME_COUNT << " pairs & " << totalSwaps / FRAME_COUNT << " swaps per frame"
+              << std::endl;
+
+    ASSERT_GT(totalPairs, 0u);
+}
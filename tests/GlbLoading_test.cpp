@@ -0,0 +1,305 @@
+#include <gtest/gtest.h>
+
+#include "../src/classes/helper/GlbLoading.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace Engine;
+
+namespace
+{
+    constexpr size_t POSITIONS_SIZE = 3 * 3 * sizeof(float);
+
+    /**
+     * @brief Packs a JSON & binary chunk into a GLB container.
+     */
+    std::vector<uint8_t> buildGlb(std::string json, std::vector<uint8_t> bin)
+    {
+        // Both chunks are 4 byte aligned, JSON with spaces & binary data with zeros
+        json.resize((json.size() + 3) & ~size_t(3), ' ');
+        bin.resize((bin.size() + 3) & ~size_t(3), 0);
+
+        const uint32_t header[5] = {
+            GLB_MAGIC, 2, uint32_t(20 + json.size() + 8 + bin.size()), uint32_t(json.size()), GLB_CHUNK_JSON
+        };
+        const uint32_t binHeader[2] = { uint32_t(bin.size()), GLB_CHUNK_BIN };
+
+        std::vector<uint8_t> glb(sizeof(header));
+        memcpy(glb.data(), header, sizeof(header));
+        glb.insert(glb.end(), json.begin(), json.end());
+        glb.insert(glb.end(), (const uint8_t*)binHeader, (const uint8_t*)binHeader + sizeof(binHeader));
+        glb.insert(glb.end(), bin.begin(), bin.end());
+        return glb;
+    }
+
+    /**
+     * @brief One triangle: three float positions followed by three 16 bit indices.
+     */
+    std::vector<uint8_t> triangleBin()
+    {
+        const float positions[9] = { 0.f, 0.f, 0.f, 1.f, 0.f, 0.f, 0.f, 1.f, 0.f };
+        const uint16_t indices[3] = { 0, 1, 2 };
+        std::vector<uint8_t> bin(POSITIONS_SIZE + sizeof(indices));
+        memcpy(bin.data(), positions, POSITIONS_SIZE);
+        memcpy(bin.data() + POSITIONS_SIZE, indices, sizeof(indices));
+        return bin;
+    }
+
+    /**
+     * @brief The JSON of a single triangle mesh, with the parts the tests vary passed in.
+     */
+    std::string triangleJson(
+            const std::string& positionAccessor = R"("count": 3)",
+            const std::string& positionView = R"("byteOffset": 0, "byteLength": 36)",
+            const std::string& node = R"({ "mesh": 0 })"
+    )
+    {
+        return R"({
+            "asset": { "version": "2.0" },
+            "buffers": [ { "byteLength": 44 } ],
+            "bufferViews": [
+                { "buffer": 0, )" +
+               positionView + R"( },
+                { "buffer": 0, "byteOffset": 36, "byteLength": 6 }
+            ],
+            "accessors": [
+                { "bufferView": 0, "componentType": 5126, "type": "VEC3", )" +
+               positionAccessor + R"( },
+                { "bufferView": 1, "componentType": 5123, "type": "SCALAR", "count": 3 }
+            ],
+            "meshes": [ { "primitives": [ { "attributes": { "POSITION": 0 }, "indices": 1 } ] } ],
+            "nodes": [ )" +
+               node + R"( ]
+        })";
+    }
+
+    /**
+     * @brief Writes the GLB to a temporary file & opens it like the RenderManager does.
+     */
+    class GlbLoadingSuite : public ::testing::Test
+    {
+        protected:
+            void TearDown() override
+            {
+                for(GlbPrimitive& primitive : m_primitives)
+                {
+                    GlbFile::deletePrimitive(primitive);
+                }
+                std::filesystem::remove(getPath());
+            }
+
+            bool open(GlbFile& file, const std::vector<uint8_t>& glb) const
+            {
+                std::ofstream stream(getPath(), std::ios::binary | std::ios::trunc);
+                stream.write((const char*)glb.data(), std::streamsize(glb.size()));
+                stream.close();
+                return file.open(getPath().c_str());
+            }
+
+            GlbLoadResult load(const std::string& json, const std::vector<uint8_t>& bin = triangleBin())
+            {
+                GlbFile file;
+                if(!open(file, buildGlb(json, bin)))
+                {
+                    return GLB_FAILED;
+                }
+
+                const GlbLoadResult result = file.loadPrimitives(m_primitives);
+                if(result == GLB_LOADED)
+                {
+                    return result;
+                }
+                EXPECT_TRUE(m_primitives.empty());
+                return result;
+            }
+
+            static std::string getPath()
+            {
+                return (std::filesystem::temp_directory_path() / "glbLoadingTest.glb").string();
+            }
+
+            std::vector<GlbPrimitive> m_primitives;
+    };
+
+    template<typename T>
+    GlbAccessor createAccessor(const std::vector<T>& data, GLenum type, int components, size_t stride)
+    {
+        GlbAccessor accessor;
+        accessor.data = (const uint8_t*)data.data();
+        accessor.componentType = type;
+        accessor.componentCount = components;
+        accessor.stride = stride;
+        accessor.count = data.size() * sizeof(T) / stride;
+        return accessor;
+    }
+
+    // Bytes after every element, enough to keep the conversions off their SSE2 path
+    constexpr size_t PADDING = 4;
+
+    /**
+     * @brief The same values with PADDING bytes after every element.
+     */
+    template<typename T>
+    std::vector<T> createStrided(const std::vector<T>& values, int components)
+    {
+        std::vector<T> strided;
+        for(size_t i = 0; i < values.size(); i += size_t(components))
+        {
+            const auto element = values.begin() + std::ptrdiff_t(i);
+            strided.insert(strided.end(), element, element + components);
+            strided.insert(strided.end(), PADDING / sizeof(T), T(0x5A));
+        }
+        return strided;
+    }
+} // namespace
+
+TEST_F(GlbLoadingSuite, ValidTriangleLoads)
+{
+    ASSERT_EQ(GLB_LOADED, load(triangleJson()));
+    ASSERT_EQ(1u, m_primitives.size());
+    ASSERT_EQ(3, m_primitives[0].vertexCount);
+    ASSERT_EQ(3, m_primitives[0].indexCount);
+}
+
+TEST_F(GlbLoadingSuite, AccessorsOutsideTheirViewFail)
+{
+    // One element too many, an offset pushing the last element out, & a stride doing the same
+    ASSERT_EQ(GLB_FAILED, load(triangleJson(R"("count": 4)")));
+    ASSERT_EQ(GLB_FAILED, load(triangleJson(R"("count": 3, "byteOffset": 4)")));
+    ASSERT_EQ(GLB_FAILED, load(triangleJson(R"("count": 3)", R"("byteLength": 36, "byteStride": 16)")));
+
+    // Counts & offsets no binary chunk can hold, or too large to be read as size at all
+    ASSERT_EQ(GLB_FAILED, load(triangleJson(R"("count": 9007199254740992)")));
+    ASSERT_EQ(GLB_FAILED, load(triangleJson(R"("count": 1e300)")));
+    ASSERT_EQ(GLB_FAILED, load(triangleJson(R"("count": 3, "byteOffset": 18446744073709551612)")));
+    ASSERT_EQ(GLB_FAILED, load(triangleJson(R"("count": 3, "byteOffset": -4)")));
+
+    // The view itself reaching past the binary chunk
+    ASSERT_EQ(GLB_FAILED, load(triangleJson(R"("count": 3)", R"("byteOffset": 40, "byteLength": 36)")));
+    ASSERT_EQ(GLB_FAILED, load(triangleJson(R"("count": 3)", R"("byteOffset": 1.8e19, "byteLength": 36)")));
+    ASSERT_EQ(GLB_FAILED, load(triangleJson(R"("count": 3)", R"("byteOffset": 0, "byteLength": 4096)")));
+}
+
+TEST_F(GlbLoadingSuite, TransformsAndLargeMeshesLeaveTheFastPath)
+{
+    GlbFile identity;
+    ASSERT_TRUE(open(identity, buildGlb(triangleJson(), triangleBin())));
+    ASSERT_TRUE(identity.isFastPathCompatible());
+
+    for(const char* node : { R"({ "mesh": 0, "translation": [ 1, 0, 0 ] })",
+                             R"({ "mesh": 0, "rotation": [ 0, 0, 0, 1 ] })",
+                             R"({ "mesh": 0, "scale": [ 2, 2, 2 ] })",
+                             R"({ "mesh": 0, "matrix": [ 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1 ] })" })
+    {
+        GlbFile file;
+        ASSERT_TRUE(open(file, buildGlb(triangleJson(R"("count": 3)", R"("byteLength": 36)", node), triangleBin())));
+        ASSERT_FALSE(file.isFastPathCompatible());
+        ASSERT_EQ(GLB_UNSUPPORTED, file.loadPrimitives(m_primitives));
+    }
+
+    // 16 bit indices can't address more vertices, the importer has to split the mesh
+    const std::vector<uint8_t> bin(0x10000 * 12 + 8, 0);
+    GlbFile large;
+    ASSERT_TRUE(open(large, buildGlb(triangleJson(R"("count": 65536)", R"("byteLength": 786432)"), bin)));
+    ASSERT_FALSE(large.isFastPathCompatible());
+    GlbFile largest;
+    ASSERT_TRUE(open(largest, buildGlb(triangleJson(R"("count": 65535)", R"("byteLength": 786432)"), bin)));
+    ASSERT_TRUE(largest.isFastPathCompatible());
+    ASSERT_TRUE(m_primitives.empty());
+}
+
+TEST_F(GlbLoadingSuite, IndexConversionsMatchScalar)
+{
+    // Not a multiple of 4, 8 or 16, so every SSE2 loop leaves a tail for the scalar loop
+    constexpr size_t COUNT = 37;
+    std::mt19937 random(29);
+
+    std::vector<uint32_t> wideIndices(COUNT);
+    for(uint32_t& index : wideIndices)
+    {
+        // Above 0x7FFF as well, those need the bias around the signed pack
+        index = random() % 0x10000;
+    }
+    const std::vector<uint32_t> stridedWide = createStrided(wideIndices, 1);
+
+    const std::vector<uint16_t> packed = convertGlbIndices(createAccessor(wideIndices, GL_UNSIGNED_INT, 1, 4));
+    const std::vector<uint16_t> scalar =
+            convertGlbIndices(createAccessor(stridedWide, GL_UNSIGNED_INT, 1, 4 + PADDING));
+    ASSERT_EQ(std::vector<uint16_t>(wideIndices.begin(), wideIndices.end()), packed);
+    ASSERT_EQ(packed, scalar);
+
+    std::vector<uint8_t> byteIndices(COUNT);
+    for(uint8_t& index : byteIndices)
+    {
+        index = uint8_t(random());
+    }
+    const std::vector<uint8_t> stridedBytes = createStrided(byteIndices, 1);
+    const std::vector<uint16_t> packedBytes = convertGlbIndices(createAccessor(byteIndices, GL_UNSIGNED_BYTE, 1, 1));
+    ASSERT_EQ(std::vector<uint16_t>(byteIndices.begin(), byteIndices.end()), packedBytes);
+    ASSERT_EQ(packedBytes, convertGlbIndices(createAccessor(stridedBytes, GL_UNSIGNED_BYTE, 1, 1 + PADDING)));
+
+    for(size_t count = 1; count <= COUNT; count++)
+    {
+        const uint16_t expected = *std::max_element(packed.begin(), packed.begin() + std::ptrdiff_t(count));
+        ASSERT_EQ(expected, getGlbMaxIndex(packed.data(), count));
+    }
+}
+
+TEST_F(GlbLoadingSuite, AttributeConversionsMatchScalar)
+{
+    // 13 three component elements, 39 components leave a tail after the blocks of eight
+    constexpr int COMPONENTS = 3;
+    constexpr size_t COUNT = 13 * COMPONENTS;
+    std::mt19937 random(31);
+
+    const auto check = [](const auto& values, GLenum type, bool normalized)
+    {
+        using T = typename std::decay_t<decltype(values)>::value_type;
+        const std::vector<T> strided = createStrided(values, COMPONENTS);
+
+        GlbAccessor packed = createAccessor(values, type, COMPONENTS, COMPONENTS * sizeof(T));
+        GlbAccessor padded = createAccessor(strided, type, COMPONENTS, COMPONENTS * sizeof(T) + PADDING);
+        packed.normalized = normalized;
+        padded.normalized = normalized;
+        ASSERT_EQ(packed.count, padded.count);
+
+        const std::vector<float> simd = convertGlbAttribute(packed, COMPONENTS);
+        const std::vector<float> scalar = convertGlbAttribute(padded, COMPONENTS);
+        ASSERT_EQ(values.size(), simd.size());
+        ASSERT_EQ(values.size(), scalar.size());
+        for(size_t i = 0; i < values.size(); i++)
+        {
+            ASSERT_FLOAT_EQ(readGlbComponent((const uint8_t*)&values[i], type, normalized), simd[i]);
+            ASSERT_FLOAT_EQ(scalar[i], simd[i]);
+        }
+    };
+
+    std::vector<uint8_t> unsignedBytes(COUNT);
+    std::vector<int8_t> bytes(COUNT);
+    std::vector<uint16_t> unsignedShorts(COUNT);
+    std::vector<int16_t> shorts(COUNT);
+    for(size_t i = 0; i < COUNT; i++)
+    {
+        unsignedBytes[i] = uint8_t(random());
+        bytes[i] = int8_t(random());
+        unsignedShorts[i] = uint16_t(random());
+        shorts[i] = int16_t(random());
+    }
+    // The extremes, -128 & -32768 clamp to -1 when normalized
+    bytes[0] = -128;
+    shorts[0] = -32768;
+    unsignedShorts[1] = 0xFFFF;
+
+    for(const bool normalized : { false, true })
+    {
+        check(unsignedBytes, GL_UNSIGNED_BYTE, normalized);
+        check(bytes, GL_BYTE, normalized);
+        check(unsignedShorts, GL_UNSIGNED_SHORT, normalized);
+        check(shorts, GL_SHORT, normalized);
+    }
+}
@@ -0,0 +1,146 @@
+#include <gtest/gtest.h>
+
+#include "../src/classes/engine/rendering/MeshOptimizer.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <numeric>
+#include <random>
+
+using namespace Engine;
+
+namespace
+{
+    using TriangleKey = std::array<int, 3>;
+
+    /**
+     * @brief A grid of quads, with triangles & vertices in random order like an exporter without any optimization.
+     * One extra vertex isn't used by any triangle.
+     */
+    CookedMesh createShuffledGrid(int quads, std::mt19937& random)
+    {
+        const int rowLength = quads + 1;
+        std::vector<unsigned short> order(size_t(rowLength) * size_t(rowLength) + 1);
+        std::iota(order.begin(), order.end(), 0);
+        std::shuffle(order.begin(), order.end(), random);
+
+        CookedMesh mesh;
+        mesh.valid = true;
+        mesh.vertexData.resize(order.size());
+        mesh.uvData.resize(order.size());
+        mesh.vertexNormals.resize(order.size());
+        for(size_t i = 0; i < order.size(); i++)
+        {
+            const int x = int(i) % rowLength;
+            const int y = int(i) / rowLength;
+            const float height = std::sin(float(x) * 0.3f) * std::cos(float(y) * 0.2f);
+            mesh.vertexData[order[i]] = glm::vec3(float(x), float(y), height);
+            mesh.uvData[order[i]] = glm::vec2(float(x) / float(quads), float(y) / float(quads));
+            mesh.vertexNormals[order[i]] = glm::vec3(0.f, 0.f, 1.f);
+        }
+
+        const auto vertex = [&order, rowLength](int x, int y) { return order[y * rowLength + x]; };
+        for(int y = 0; y < quads; y++)
+        {
+            for(int x = 0; x < quads; x++)
+            {
+                mesh.triIndexData.emplace_back(vertex(x, y), vertex(x + 1, y), vertex(x + 1, y + 1));
+                mesh.triIndexData.emplace_back(vertex(x, y), vertex(x + 1, y + 1), vertex(x, y + 1));
+            }
+        }
+        std::shuffle(mesh.triIndexData.begin(), mesh.triIndexData.end(), random);
+        return mesh;
+    }
+
+    /**
+     * @brief The triangles by the grid position of their corners instead of vertex indices, rotated so the smallest
+     * comes first. Independent of the vertex & triangle order, but not of the winding.
+     */
+    std::vector<TriangleKey> getTriangleKeys(const CookedMesh& mesh)
+    {
+        const auto position = [&mesh](unsigned short index)
+        {
+            const glm::vec3& pos = mesh.vertexData[index];
+            return int(pos.y) * 1000 + int(pos.x);
+        };
+
+        std::vector<TriangleKey> keys;
+        for(const triData& triangle : mesh.triIndexData)
+        {
+            TriangleKey key = {
+                position(std::get<0>(triangle)), position(std::get<1>(triangle)), position(std::get<2>(triangle))
+            };
+            std::rotate(key.begin(), std::min_element(key.begin(), key.end()), key.end());
+            keys.push_back(key);
+        }
+        std::sort(keys.begin(), keys.end());
+        return keys;
+    }
+} // namespace
+
+TEST(MeshOptimizerSuite, OptimizeKeepsTrianglesAndImprovesCache)
+{
+    constexpr int QUADS = 64;
+
+    std::mt19937 random(17);
+    CookedMesh mesh = createShuffledGrid(QUADS, random);
+    const size_t vertexCount = mesh.vertexData.size();
+    const std::vector<TriangleKey> trianglesBefore = getTriangleKeys(mesh);
+
+    const MeshOptimizationResult result = MeshOptimizer::optimize(mesh);
+
+    // Same triangles with the same winding, only their order & the vertex numbering changed
+    ASSERT_EQ(trianglesBefore, getTriangleKeys(mesh));
+
+    // The remap is a permutation of the used vertices, the unused one got dropped
+    ASSERT_EQ(vertexCount - 1, mesh.vertexData.size());
+    ASSERT_EQ(mesh.vertexData.size(), mesh.uvData.size());
+    ASSERT_EQ(mesh.vertexData.size(), mesh.vertexNormals.size());
+    std::vector<bool> referenced(mesh.vertexData.size(), false);
+    for(const triData& triangle : mesh.triIndexData)
+    {
+        for(const unsigned short index : { std::get<0>(triangle), std::get<1>(triangle), std::get<2>(triangle) })
+        {
+            ASSERT_LT(index, mesh.vertexData.size());
+            referenced[index] = true;
+        }
+    }
+    ASSERT_TRUE(std::all_of(referenced.begin(), referenced.end(), [](bool used) { return used; }));
+
+    // Attributes moved along with their vertex
+    for(size_t i = 0; i < mesh.vertexData.size(); i++)
+    {
+        ASSERT_EQ(mesh.vertexData[i].x / float(QUADS), mesh.uvData[i].x);
+        ASSERT_EQ(mesh.vertexData[i].y / float(QUADS), mesh.uvData[i].y);
+    }
+
+    ASSERT_EQ(mesh.triIndexData.size(), result.before.triangleCount);
+    ASSERT_EQ(result.before.triangleCount, result.after.triangleCount);
+    ASSERT_LT(result.after.getAcmr(), result.before.getAcmr());
+    ASSERT_LT(result.after.getAtvr(), result.before.getAtvr());
+    // A grid this size gets close to the ideal of 0.5
+    ASSERT_LT(result.after.getAcmr(), 0.8f);
+}
+
+TEST(MeshOptimizerSuite, VertexCacheKeepsEveryTriangle)
+{
+    std::mt19937 random(19);
+    CookedMesh mesh = createShuffledGrid(24, random);
+    std::vector<triData> triangles = mesh.triIndexData;
+
+    std::vector<size_t> clusterStarts;
+    MeshOptimizer::optimizeVertexCache(triangles, mesh.vertexData.size(), clusterStarts);
+
+    // Tipsify only reorders, every triangle comes out exactly once with its indices untouched
+    std::vector<triData> expected = mesh.triIndexData;
+    std::sort(expected.begin(), expected.end());
+    std::vector<triData> reordered = triangles;
+    std::sort(reordered.begin(), reordered.end());
+    ASSERT_EQ(expected, reordered);
+
+    ASSERT_FALSE(clusterStarts.empty());
+    ASSERT_EQ(0u, clusterStarts.front());
+    ASSERT_TRUE(std::is_sorted(clusterStarts.begin(), clusterStarts.end()));
+    ASSERT_LT(clusterStarts.back(), triangles.size());
+}
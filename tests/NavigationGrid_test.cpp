@@ -0,0 +1,448 @@
+#include <gtest/gtest.h>
+
+#include "../src/customCode/waveFunctionCollapse/NavigationGrid.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <utility>
+
+namespace
+{
+    constexpr uint32_t STRAIGHT_STEP = 10;
+    constexpr uint32_t DIAGONAL_STEP = 14;
+
+    /**
+     * @brief Walls with the given chance, every other tile costs 1 to 3.
+     */
+    void fillRandom(NavigationGrid& grid, std::mt19937& random, float wallChance)
+    {
+        std::uniform_real_distribution<float> wall(0.f, 1.f);
+        std::uniform_int_distribution<int> cost(1, 3);
+        const glm::ivec2 dimensions = grid.getDimensions();
+        for(int y = 0; y < dimensions.y; y++)
+        {
+            for(int x = 0; x < dimensions.x; x++)
+            {
+                grid.setTileCost(glm::ivec2(x, y), wall(random) < wallChance ? 0 : uint8_t(cost(random)));
+            }
+        }
+    }
+
+    glm::ivec2 randomWalkable(const NavigationGrid& grid, std::mt19937& random)
+    {
+        std::uniform_int_distribution<int> x(0, grid.getDimensions().x - 1);
+        std::uniform_int_distribution<int> y(0, grid.getDimensions().y - 1);
+        glm::ivec2 pos(x(random), y(random));
+        while(!grid.isWalkable(pos))
+        {
+            pos = glm::ivec2(x(random), y(random));
+        }
+        return pos;
+    }
+
+    /**
+     * @brief The cost of a single step by the rules of the grid, UNREACHABLE if it isn't allowed.
+     */
+    uint32_t stepCost(const NavigationGrid& grid, const glm::ivec2& from, const glm::ivec2& to)
+    {
+        const glm::ivec2 offset = to - from;
+        if(std::abs(offset.x) > 1 || std::abs(offset.y) > 1 || offset == glm::ivec2(0) || !grid.isWalkable(from) ||
+           !grid.isWalkable(to))
+        {
+            return NavigationGrid::UNREACHABLE;
+        }
+
+        if(offset.x == 0 || offset.y == 0)
+        {
+            return grid.getTileCost(to) * STRAIGHT_STEP;
+        }
+        if(!grid.isWalkable(glm::ivec2(to.x, from.y)) || !grid.isWalkable(glm::ivec2(from.x, to.y)))
+        {
+            return NavigationGrid::UNREACHABLE;
+        }
+        return grid.getTileCost(to) * DIAGONAL_STEP;
+    }
+
+    /**
+     * @return The cost of walking the path, UNREACHABLE if any step isn't allowed
+     */
+    uint32_t pathCost(const NavigationGrid& grid, const std::vector<glm::ivec2>& path)
+    {
+        uint32_t cost = 0;
+        for(size_t i = 1; i < path.size(); i++)
+        {
+            const uint32_t step = stepCost(grid, path[i - 1], path[i]);
+            if(step == NavigationGrid::UNREACHABLE)
+            {
+                return NavigationGrid::UNREACHABLE;
+            }
+            cost += step;
+        }
+        return cost;
+    }
+
+    /**
+     * @brief Plain A* over the whole grid, the optimal cost HPA* gets compared against.
+     */
+    uint32_t plainAStarCost(const NavigationGrid& grid, const glm::ivec2& start, const glm::ivec2& goal)
+    {
+        if(!grid.isWalkable(start) || !grid.isWalkable(goal))
+        {
+            return NavigationGrid::UNREACHABLE;
+        }
+
+        const glm::ivec2 dimensions = grid.getDimensions();
+        const auto toCell = [&dimensions](const glm::ivec2& pos) { return pos.y * dimensions.x + pos.x; };
+        const auto heuristic = [&goal](const glm::ivec2& pos)
+        {
+            const uint32_t dx = uint32_t(std::abs(pos.x - goal.x));
+            const uint32_t dy = uint32_t(std::abs(pos.y - goal.y));
+            return STRAIGHT_STEP * std::max(dx, dy) + (DIAGONAL_STEP - STRAIGHT_STEP) * std::min(dx, dy);
+        };
+
+        std::vector<uint32_t> costs(size_t(dimensions.x) * size_t(dimensions.y), NavigationGrid::UNREACHABLE);
+        using Entry = std::pair<uint32_t, int>;
+        std::vector<Entry> open;
+        costs[toCell(start)] = 0;
+        open.emplace_back(heuristic(start), toCell(start));
+
+        while(!open.empty())
+        {
+            std::pop_heap(open.begin(), open.end(), std::greater<>());
+            const auto [priority, cell] = open.back();
+            open.pop_back();
+
+            const glm::ivec2 pos(cell % dimensions.x, cell / dimensions.x);
+            if(pos == goal)
+            {
+                return costs[cell];
+            }
+            if(priority > costs[cell] + heuristic(pos))
+            {
+                continue;
+            }
+
+            for(int y = -1; y <= 1; y++)
+            {
+                for(int x = -1; x <= 1; x++)
+                {
+                    const glm::ivec2 next = pos + glm::ivec2(x, y);
+                    const uint32_t step = stepCost(grid, pos, next);
+                    if(step == NavigationGrid::UNREACHABLE || costs[cell] + step >= costs[toCell(next)])
+                    {
+                        continue;
+                    }
+                    costs[toCell(next)] = costs[cell] + step;
+                    open.emplace_back(costs[toCell(next)] + heuristic(next), toCell(next));
+                    std::push_heap(open.begin(), open.end(), std::greater<>());
+                }
+            }
+        }
+        return NavigationGrid::UNREACHABLE;
+    }
+
+    /**
+     * @brief Checks a path found by the grid against plain A*: same reachability, valid steps & a cost close to the
+     * optimum. HPA* only moves through the entrances of the clusters, so its paths may be a bit longer.
+     */
+    void expectNearOptimal(const NavigationGrid& grid, const glm::ivec2& start, const glm::ivec2& goal)
+    {
+        const uint32_t optimal = plainAStarCost(grid, start, goal);
+        const std::vector<glm::ivec2> path = grid.findPath(start, goal);
+        if(optimal == NavigationGrid::UNREACHABLE)
+        {
+            EXPECT_TRUE(path.empty());
+            return;
+        }
+
+        ASSERT_FALSE(path.empty());
+        EXPECT_EQ(start, path.front());
+        EXPECT_EQ(goal, path.back());
+        const uint32_t cost = pathCost(grid, path);
+        ASSERT_NE(NavigationGrid::UNREACHABLE, cost);
+        EXPECT_GE(cost, optimal);
+        EXPECT_LE(cost, optimal * 3 / 2 + STRAIGHT_STEP * 4);
+    }
+} // namespace
+
+TEST(NavigationGridSuite, PathsMatchPlainAStar)
+{
+    std::mt19937 random(3);
+    NavigationGrid grid(glm::ivec2(96, 80), 16);
+    fillRandom(grid, random, 0.2f);
+    grid.build();
+    ASSERT_FALSE(grid.isDirty());
+    ASSERT_GT(grid.getAbstractNodeCount(), 0u);
+
+    // Mostly queries across several clusters, some within one cluster or its neighbors
+    for(int i = 0; i < 300; i++)
+    {
+        const glm::ivec2 start = randomWalkable(grid, random);
+        const glm::ivec2 goal = i % 4 == 0 ? glm::clamp(start + glm::ivec2(i % 7 - 3, i % 5 - 2) * 3, glm::ivec2(0),
+                                                        grid.getDimensions() - 1)
+                                           : randomWalkable(grid, random);
+        if(!grid.isWalkable(goal))
+        {
+            continue;
+        }
+        expectNearOptimal(grid, start, goal);
+    }
+
+    const glm::ivec2 pos = randomWalkable(grid, random);
+    EXPECT_EQ(std::vector<glm::ivec2>({ pos }), grid.findPath(pos, pos));
+}
+
+TEST(NavigationGridSuite, PathsLeaveTheStartClusterAndComeBack)
+{
+    NavigationGrid grid(glm::ivec2(32, 32), 8);
+    for(int y = 0; y < 32; y++)
+    {
+        for(int x = 0; x < 32; x++)
+        {
+            grid.setTileCost(glm::ivec2(x, y), 1);
+        }
+    }
+    // A wall through the cluster from (8, 8) to (15, 15) and two neighbors, the way above is shorter than below
+    for(int y = 4; y < 28; y++)
+    {
+        grid.setTileCost(glm::ivec2(12, y), 0);
+    }
+    grid.build();
+
+    const glm::ivec2 start(10, 12);
+    const glm::ivec2 goal(14, 12);
+    const std::vector<glm::ivec2> path = grid.findPath(start, goal);
+    ASSERT_TRUE(std::any_of(path.begin(), path.end(), [](const glm::ivec2& pos) { return pos.y < 4; }));
+    expectNearOptimal(grid, start, goal);
+
+    // With the way above closed, the detour goes around below
+    for(int y = 0; y < 4; y++)
+    {
+        grid.setTileCost(glm::ivec2(12, y), 0);
+    }
+    grid.update();
+    const std::vector<glm::ivec2> detour = grid.findPath(start, goal);
+    ASSERT_TRUE(std::any_of(detour.begin(), detour.end(), [](const glm::ivec2& pos) { return pos.y >= 28; }));
+    expectNearOptimal(grid, start, goal);
+}
+
+TEST(NavigationGridSuite, WallOnClusterBorderReroutes)
+{
+    NavigationGrid grid(glm::ivec2(48, 48), 16);
+    for(int y = 0; y < 48; y++)
+    {
+        for(int x = 0; x < 48; x++)
+        {
+            grid.setTileCost(glm::ivec2(x, y), 1);
+        }
+    }
+    grid.build();
+
+    const glm::ivec2 start(8, 24);
+    const glm::ivec2 goal(40, 24);
+    expectNearOptimal(grid, start, goal);
+
+    // Both sides of the border between the first & second cluster column, with a single gap at the top
+    for(int y = 1; y < 48; y++)
+    {
+        grid.setTileCost(glm::ivec2(15, y), 0);
+        grid.setTileCost(glm::ivec2(16, y), 0);
+    }
+    ASSERT_TRUE(grid.isDirty());
+    grid.update();
+    ASSERT_FALSE(grid.isDirty());
+
+    const std::vector<glm::ivec2> path = grid.findPath(start, goal);
+    ASSERT_NE(path.end(), std::find(path.begin(), path.end(), glm::ivec2(16, 0)));
+    expectNearOptimal(grid, start, goal);
+
+    // Closing the gap cuts the grid in two
+    grid.setTileCost(glm::ivec2(16, 0), 0);
+    grid.update();
+    ASSERT_TRUE(grid.findPath(start, goal).empty());
+
+    // Opening the wall again brings the direct way back
+    for(int y = 0; y < 48; y++)
+    {
+        grid.setTileCost(glm::ivec2(15, y), 1);
+        grid.setTileCost(glm::ivec2(16, y), 1);
+    }
+    grid.update();
+    const std::vector<glm::ivec2> reopened = grid.findPath(start, goal);
+    ASSERT_EQ(reopened.end(), std::find(reopened.begin(), reopened.end(), glm::ivec2(16, 0)));
+    expectNearOptimal(grid, start, goal);
+}
+
+TEST(NavigationGridSuite, FlowFieldsLeadToTheGoal)
+{
+    std::mt19937 random(5);
+    NavigationGrid grid(glm::ivec2(64, 48), 16);
+    fillRandom(grid, random, 0.2f);
+    grid.build();
+
+    const glm::ivec2 goal = randomWalkable(grid, random);
+    const std::shared_ptr<const FlowField> flowField = grid.getFlowField(goal);
+    ASSERT_NE(nullptr, flowField);
+    ASSERT_EQ(flowField, grid.getFlowField(goal));
+    ASSERT_EQ(glm::ivec2(0), flowField->getDirection(goal));
+
+    const glm::ivec2 dimensions = grid.getDimensions();
+    for(int y = 0; y < dimensions.y; y++)
+    {
+        for(int x = 0; x < dimensions.x; x++)
+        {
+            const glm::ivec2 start(x, y);
+            const uint32_t optimal = plainAStarCost(grid, start, goal);
+            ASSERT_EQ(optimal != NavigationGrid::UNREACHABLE, flowField->isReachable(start));
+            if(optimal == NavigationGrid::UNREACHABLE)
+            {
+                ASSERT_EQ(glm::ivec2(0), flowField->getDirection(start));
+                continue;
+            }
+
+            // Following the directions walks an optimal path
+            uint32_t cost = 0;
+            glm::ivec2 pos = start;
+            for(int steps = 0; pos != goal && steps < dimensions.x * dimensions.y; steps++)
+            {
+                const glm::ivec2 next = pos + flowField->getDirection(pos);
+                const uint32_t step = stepCost(grid, pos, next);
+                ASSERT_NE(NavigationGrid::UNREACHABLE, step);
+                cost += step;
+                pos = next;
+            }
+            ASSERT_EQ(goal, pos);
+            ASSERT_EQ(optimal, cost);
+        }
+    }
+
+    // Changing any tile drops the cached fields, the old one stays valid for whoever still holds it
+    glm::ivec2 blocked = randomWalkable(grid, random);
+    while(blocked == goal)
+    {
+        blocked = randomWalkable(grid, random);
+    }
+    grid.setTileCost(blocked, 0);
+    const std::shared_ptr<const FlowField> changed = grid.getFlowField(goal);
+    ASSERT_NE(flowField, changed);
+    ASSERT_FALSE(changed->isReachable(blocked));
+    for(const glm::ivec2& offset : { glm::ivec2(1, 0), glm::ivec2(-1, 0), glm::ivec2(0, 1), glm::ivec2(0, -1) })
+    {
+        const glm::ivec2 pos = blocked + offset;
+        if(changed->isReachable(pos))
+        {
+            ASSERT_NE(blocked, pos + changed->getDirection(pos));
+        }
+    }
+    ASSERT_EQ(changed, grid.getFlowField(goal));
+    ASSERT_EQ(nullptr, grid.getFlowField(glm::ivec2(-1, 0)));
+}
+
+TEST(NavigationGridSuite, FindPathsMatchesSerial)
+{
+    std::mt19937 random(7);
+    NavigationGrid grid(glm::ivec2(128, 128), 16);
+    fillRandom(grid, random, 0.2f);
+    grid.build();
+
+    std::vector<std::pair<glm::ivec2, glm::ivec2>> queries;
+    for(int i = 0; i < 500; i++)
+    {
+        queries.emplace_back(randomWalkable(grid, random), randomWalkable(grid, random));
+    }
+    // One without an answer
+    queries.emplace_back(glm::ivec2(-1, 0), glm::ivec2(5, 5));
+
+    std::vector<std::vector<glm::ivec2>> paths;
+    grid.findPaths(queries, paths);
+    ASSERT_EQ(queries.size(), paths.size());
+    for(size_t i = 0; i < queries.size(); i++)
+    {
+        ASSERT_EQ(grid.findPath(queries[i].first, queries[i].second), paths[i]);
+    }
+    ASSERT_TRUE(paths.back().empty());
+}
+
+TEST(NavigationGridSuite, Benchmark1024Grid)
+{
+    constexpr int QUERY_COUNT = 500;
+
+    std::mt19937 random(13);
+    NavigationGrid grid(glm::ivec2(1024, 1024), 16);
+    fillRandom(grid, random, 0.15f);
+
+    using Clock = std::chrono::steady_clock;
+    auto start = Clock::now();
+    grid.build();
+    const double buildMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    std::vector<std::pair<glm::ivec2, glm::ivec2>> queries;
+    for(int i = 0; i < QUERY_COUNT; i++)
+    {
+        queries.emplace_back(randomWalkable(grid, random), randomWalkable(grid, random));
+    }
+
+    start = Clock::now();
+    size_t found = 0;
+    for(const auto& [from, to] : queries)
+    {
+        found += !grid.findPath(from, to).empty();
+    }
+    const double serialMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    // Agents mostly walk to somewhere close by
+    std::uniform_int_distribution<int> offset(-32, 32);
+    std::vector<std::pair<glm::ivec2, glm::ivec2>> shortQueries;
+    while(shortQueries.size() < size_t(QUERY_COUNT))
+    {
+        const glm::ivec2 from = randomWalkable(grid, random);
+        const glm::ivec2 to = from + glm::ivec2(offset(random), offset(random));
+        if(grid.isWalkable(to))
+        {
+            shortQueries.emplace_back(from, to);
+        }
+    }
+
+    start = Clock::now();
+    for(const auto& [from, to] : shortQueries)
+    {
+        found += !grid.findPath(from, to).empty();
+    }
+    const double shortMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    std::vector<std::vector<glm::ivec2>> paths;
+    start = Clock::now();
+    grid.findPaths(queries, paths);
+    const double batchMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    // A handful of long plain A* queries as the baseline, they are slow on a grid this size
+    constexpr int BASELINE_COUNT = 20;
+    start = Clock::now();
+    for(int i = 0; i < BASELINE_COUNT; i++)
+    {
+        plainAStarCost(grid, queries[i].first, queries[i].second);
+    }
+    const double baselineMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    start = Clock::now();
+    const std::shared_ptr<const FlowField> flowField = grid.getFlowField(queries.front().second);
+    const double flowFieldMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    grid.setTileCost(glm::ivec2(500, 500), 0);
+    start = Clock::now();
+    grid.update();
+    const double updateMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    std::cout << "[ HPA* 1024 ] build " << buildMs << " ms, short path " << shortMs * 1000.0 / QUERY_COUNT
+              << " us, long path " << serialMs * 1000.0 / QUERY_COUNT << " us serial & "
+              << batchMs * 1000.0 / QUERY_COUNT << " us batched, plain A* "
+              << baselineMs * 1000.0 / BASELINE_COUNT << " us, flow field " << flowFieldMs << " ms, update "
+              << updateMs << " ms" << std::endl;
+
+    ASSERT_GT(found, size_t(QUERY_COUNT));
+    ASSERT_NE(nullptr, flowField);
+}
@@ -0,0 +1,297 @@
+#include <gtest/gtest.h>
+
+#include "../src/classes/engine/EngineManager.h"
+#include "../src/classes/engine/FramePacer.h"
+#include "../src/classes/engine/NodeLifecycleQueue.h"
+#include "../src/classes/engine/rendering/ObjectPicker.h"
+#include "../src/classes/engine/rendering/OcclusionCuller.h"
+#include "../src/classes/engine/rendering/RenderGraph.h"
+#include "../src/classes/engine/rendering/StreamingBuffer.h"
+#include "../src/classes/engine/rendering/backend/RecordingRenderBackend.h"
+#include "../src/classes/nodeComponents/CameraComponent.h"
+#include "../src/classes/nodeComponents/GeometryComponent.h"
+#include "../src/resources/shader/ColorShader.h"
+
+#include <chrono>
+#include <cstring>
+#include <iostream>
+
+using namespace Engine;
+
+namespace
+{
+    RecordingRenderBackend& getRecording()
+    {
+        auto* recording = dynamic_cast<RecordingRenderBackend*>(&RenderBackend::get());
+        EXPECT_NE(nullptr, recording) << "The tests run without a context, main() has to set a recording backend";
+        return *recording;
+    }
+
+    std::shared_ptr<ObjectData> createCube()
+    {
+        std::vector<glm::vec3> vertices;
+        for(int i = 0; i < 8; i++)
+        {
+            vertices.emplace_back(i & 1 ? 1.f : -1.f, i & 2 ? 1.f : -1.f, i & 4 ? 1.f : -1.f);
+        }
+        std::vector<glm::vec3> normals = vertices;
+        std::vector<triData> triangles = { { 0, 1, 3 }, { 0, 3, 2 }, { 4, 6, 7 }, { 4, 7, 5 },
+                                           { 0, 4, 5 }, { 0, 5, 1 }, { 2, 3, 7 }, { 2, 7, 6 },
+                                           { 0, 2, 6 }, { 0, 6, 4 }, { 1, 5, 7 }, { 1, 7, 3 } };
+
+        return std::make_shared<ObjectData>(
+                "cube",
+                RenderManager::createBuffer(vertices),
+                GLuint(-1),
+                RenderManager::createBuffer(normals),
+                RenderManager::createBuffer(triangles),
+                vertices,
+                std::vector<glm::vec2>(),
+                normals,
+                triangles
+        );
+    }
+
+    /**
+     * @brief A scene of opaque cubes sharing one shader, removed from the engine again when it goes out of scope.
+     */
+    class CubeScene
+    {
+        public:
+            explicit CubeScene(int cubeCount)
+            {
+                const auto& engineManager = SingletonManager::get<EngineManager>();
+                m_scene = std::make_shared<BasicNode>();
+                engineManager->setScene(m_scene);
+                engineManager->setGridVisibility(false);
+
+                auto camera = std::make_shared<CameraComponent>();
+                m_scene->addChild(camera);
+                engineManager->setCamera(camera);
+
+                const auto shader = std::make_shared<ColorShader>(engineManager->getRenderManager());
+                const auto cube = createCube();
+                for(int i = 0; i < cubeCount; i++)
+                {
+                    auto geometry = std::make_shared<GeometryComponent>();
+                    geometry->setObjectData(cube);
+                    geometry->setShader(shader);
+                    m_scene->addChild(geometry);
+                }
+            }
+
+            ~CubeScene()
+            {
+                const auto& engineManager = SingletonManager::get<EngineManager>();
+                engineManager->setScene(nullptr);
+                engineManager->setCamera(nullptr);
+                SingletonManager::get<NodeLifecycleQueue>()->flush();
+            }
+
+        private:
+            std::shared_ptr<BasicNode> m_scene;
+    };
+} // namespace
+
+TEST(RenderBackendSuite, RedundantBindsAndStateChanges)
+{
+    RecordingRenderBackend& backend = getRecording();
+    backend.resetStats();
+
+    backend.useProgram(5);
+    backend.useProgram(5);
+    backend.bindBuffer(GL_ARRAY_BUFFER, 3);
+    backend.bindBuffer(GL_ELEMENT_ARRAY_BUFFER, 3);
+    backend.activeTexture(0);
+    backend.bindTexture(GL_TEXTURE_2D, 7);
+    backend.activeTexture(1);
+    backend.bindTexture(GL_TEXTURE_2D, 7);
+    backend.enable(GL_BLEND);
+    backend.enable(GL_BLEND);
+    backend.disable(GL_BLEND);
+
+    const RenderBackendStats& stats = backend.getStats();
+    ASSERT_EQ(2u, stats.programBinds);
+    ASSERT_EQ(2u, stats.bufferBinds);
+    ASSERT_EQ(2u, stats.textureBinds);
+    ASSERT_EQ(1u, stats.redundantBinds);
+    ASSERT_EQ(3u, stats.stateChanges);
+    ASSERT_EQ(1u, stats.redundantStateChanges);
+}
+
+TEST(RenderBackendSuite, MappedBuffersAreWritable)
+{
+    RecordingRenderBackend& backend = getRecording();
+    StreamingBuffer buffer(GL_ARRAY_BUFFER, 1024);
+    backend.resetStats();
+
+    size_t offset = 0;
+    void* data = buffer.map(256, offset);
+    ASSERT_NE(nullptr, data);
+    memset(data, 0xff, 256);
+    buffer.unmap();
+
+    ASSERT_EQ(256u, backend.getStats().bytesUploaded);
+}
+
+TEST(RenderBackendSuite, SceneDrawCallsAndBinds)
+{
+    constexpr int CUBE_COUNT = 100;
+
+    RecordingRenderBackend& backend = getRecording();
+    CubeScene scene(CUBE_COUNT);
+    backend.resetStats();
+
+    SingletonManager::get<EngineManager>()->drawScene(glm::ivec2(1280, 720), 4);
+
+    const RenderBackendStats& stats = backend.getStats();
+    ASSERT_EQ(size_t(CUBE_COUNT), stats.drawCalls);
+    ASSERT_EQ(size_t(CUBE_COUNT) * 36, stats.verticesDrawn);
+    ASSERT_LE(stats.programBinds, size_t(CUBE_COUNT));
+    // A static scene is drawn from the buffers uploaded when it was created
+    ASSERT_EQ(0u, stats.bytesUploaded);
+}
+
+TEST(RenderBackendSuite, DepthPrePassDrawsOpaqueGeometryTwice)
+{
+    constexpr int CUBE_COUNT = 100;
+
+    RecordingRenderBackend& backend = getRecording();
+    const auto& engineManager = SingletonManager::get<EngineManager>();
+    CubeScene scene(CUBE_COUNT);
+    engineManager->setDepthPrePass(true);
+    backend.resetStats();
+
+    engineManager->drawScene(glm::ivec2(1280, 720), 4);
+
+    ASSERT_EQ(size_t(CUBE_COUNT) * 2, backend.getStats().drawCalls);
+    ASSERT_TRUE(engineManager->getRenderGraph()->wasPassExecuted("DepthPrePass"));
+}
+
+TEST(RenderBackendSuite, DepthPrePassIsResetWithTheScene)
+{
+    const auto& engineManager = SingletonManager::get<EngineManager>();
+    engineManager->setDepthPrePass(true);
+
+    CubeScene scene(1);
+    ASSERT_FALSE(engineManager->isDepthPrePassEnabled());
+}
+
+TEST(RenderBackendSuite, OcclusionCullingDrawsHiddenNodesConditionally)
+{
+    constexpr int CUBE_COUNT = 10;
+
+    RecordingRenderBackend& backend = getRecording();
+    const auto& engineManager = SingletonManager::get<EngineManager>();
+    CubeScene scene(CUBE_COUNT);
+    engineManager->getCamera()->setPosition(glm::vec3(0.f, 0.f, 20.f));
+    engineManager->setOcclusionCulling(true);
+    const auto& culler = engineManager->getOcclusionCuller();
+
+    // Every query of the recording backend finishes right away without any samples passing
+    backend.setQueryResult(0);
+    engineManager->drawScene(glm::ivec2(1280, 720), 4);
+    ASSERT_EQ(size_t(CUBE_COUNT), culler->getStats().visibleNodes);
+
+    // All cubes share a grid cell, so the whole cell gets a single box query & its cubes draw on its result
+    backend.resetStats();
+    engineManager->drawScene(glm::ivec2(1280, 720), 4);
+    ASSERT_EQ(size_t(CUBE_COUNT), culler->getStats().occludedNodes);
+    ASSERT_EQ(1u, culler->getStats().occludedGroups);
+    ASSERT_EQ(size_t(CUBE_COUNT), backend.getStats().conditionalDrawCalls);
+    ASSERT_EQ(size_t(CUBE_COUNT) + 1, backend.getStats().drawCalls);
+
+    // Once the box shows up the cubes get drawn & queried on their own again
+    backend.setQueryResult(1);
+    engineManager->drawScene(glm::ivec2(1280, 720), 4);
+    backend.setQueryResult(0);
+    ASSERT_EQ(size_t(CUBE_COUNT), culler->getStats().visibleNodes);
+    ASSERT_EQ(size_t(CUBE_COUNT), culler->getStats().queries);
+}
+
+TEST(RenderBackendSuite, PickingOnlyDrawsIdsWhenRequested)
+{
+    constexpr int CUBE_COUNT = 10;
+    constexpr uint32_t PICKED_ID = 42;
+
+    RecordingRenderBackend& backend = getRecording();
+    const auto& engineManager = SingletonManager::get<EngineManager>();
+    CubeScene scene(CUBE_COUNT);
+    const auto& picker = engineManager->getObjectPicker();
+
+    backend.resetStats();
+    engineManager->drawScene(glm::ivec2(1280, 720), 4);
+    ASSERT_FALSE(engineManager->getRenderGraph()->wasPassExecuted("Picking"));
+    ASSERT_EQ(size_t(CUBE_COUNT), backend.getStats().drawCalls);
+
+    // The id buffer holds the picked id at every pixel, the readback only gets issued with the frame
+    backend.setPixelValue(PICKED_ID);
+    picker->requestPick(glm::ivec2(640, 360));
+    PickResult result;
+    ASSERT_FALSE(picker->pollResult(result));
+
+    backend.resetStats();
+    engineManager->drawScene(glm::ivec2(1280, 720), 4);
+    backend.setPixelValue(0);
+    ASSERT_TRUE(engineManager->getRenderGraph()->wasPassExecuted("Picking"));
+    ASSERT_EQ(size_t(CUBE_COUNT) * 2, backend.getStats().drawCalls);
+    ASSERT_EQ(1u, backend.getStats().pixelReads);
+    ASSERT_FALSE(picker->isPickRequested());
+
+    // Fences of the recording backend signal right away
+    ASSERT_TRUE(picker->pollResult(result));
+    ASSERT_EQ(PICKED_ID, result.nodeId);
+    ASSERT_EQ(glm::ivec2(640, 360), result.pixel);
+    ASSERT_EQ(0u, picker->getPicksInFlight());
+}
+
+TEST(RenderBackendSuite, LatencyIsMeasuredForFramesWithInput)
+{
+    RecordingRenderBackend& backend = getRecording();
+    FramePacer pacer;
+    backend.resetStats();
+
+    // Without input only the poll to GPU latency gets tracked
+    pacer.beginFrame();
+    pacer.endFrame();
+    ASSERT_EQ(1u, pacer.getStats().framesInFlight);
+
+    pacer.beginFrame();
+    pacer.markInput();
+    pacer.endFrame();
+    ASSERT_EQ(0u, pacer.getStats().inputSamples);
+
+    // Fences & queries of the recording backend finish right away, the frame is collected with the next one
+    pacer.beginFrame();
+    ASSERT_EQ(1u, pacer.getStats().inputSamples);
+    ASSERT_EQ(0u, pacer.getStats().framesInFlight);
+    ASSERT_GE(pacer.getStats().inputToSwapMs, 0.0);
+}
+
+TEST(RenderBackendSuite, Benchmark10kDrawsWithoutContext)
+{
+    constexpr int CUBE_COUNT = 10000;
+    constexpr int FRAME_COUNT = 60;
+
+    RecordingRenderBackend& backend = getRecording();
+    CubeScene scene(CUBE_COUNT);
+    const auto& engineManager = SingletonManager::get<EngineManager>();
+
+    using Clock = std::chrono::steady_clock;
+    double totalMs = 0.0;
+    for(int frame = 0; frame < FRAME_COUNT; frame++)
+    {
+        backend.resetStats();
+
+        const auto start = Clock::now();
+        engineManager->drawScene(glm::ivec2(1280, 720), 4);
+        totalMs += std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+
+    const RenderBackendStats& stats = backend.getStats();
+    std::cout << "[ Draw 10k ] average drawScene " << totalMs / FRAME_COUNT << " ms, " << stats.commands
+              << " commands, " << stats.drawCalls << " draws, " << stats.programBinds << " program binds & "
+              << stats.redundantBinds << " redundant binds per frame" << std::endl;
+
+    ASSERT_EQ(size_t(CUBE_COUNT), stats.drawCalls);
+}
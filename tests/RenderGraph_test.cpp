@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+
+#include "../src/classes/engine/rendering/RenderGraph.h"
+#include "../src/classes/engine/rendering/backend/RecordingRenderBackend.h"
+
+#include <string>
+#include <vector>
+
+using namespace Engine;
+
+namespace
+{
+    const glm::ivec2 SIZE(320, 180);
+    const RenderTargetDesc COLOR_DESC = { SIZE, GL_RGBA8, 0 };
+
+    RecordingRenderBackend& getRecording()
+    {
+        auto* recording = dynamic_cast<RecordingRenderBackend*>(&RenderBackend::get());
+        EXPECT_NE(nullptr, recording) << "The tests run without a context, main() has to set a recording backend";
+        return *recording;
+    }
+
+    /**
+     * @brief A chain of fullscreen passes, each reading the target of the previous one, ending in the backbuffer.
+     */
+    void addPostChain(RenderGraph& graph, int length, std::vector<std::string>& executed)
+    {
+        const RenderGraph::Resource backbuffer = graph.importBackbuffer("Backbuffer", SIZE);
+
+        RenderGraph::Resource previous = backbuffer;
+        for(int i = 0; i < length; i++)
+        {
+            const std::string name = "Post" + std::to_string(i);
+            graph.addPass(
+                    name,
+                    [&](RenderGraph::PassBuilder& builder)
+                    {
+                        if(i > 0)
+                        {
+                            builder.read(previous);
+                        }
+                        previous = builder.create(name, COLOR_DESC);
+                    },
+                    [&executed, name](const RenderGraph::PassContext&) { executed.push_back(name); }
+            );
+        }
+
+        graph.addPass(
+                "Present",
+                [&](RenderGraph::PassBuilder& builder)
+                {
+                    builder.read(previous);
+                    builder.write(backbuffer);
+                },
+                [&executed](const RenderGraph::PassContext&) { executed.push_back("Present"); }
+        );
+    }
+} // namespace
+
+TEST(RenderGraphSuite, CullsPassesWithoutReaders)
+{
+    getRecording();
+    RenderGraph graph;
+    std::vector<std::string> executed;
+
+    graph.beginFrame();
+    const RenderGraph::Resource backbuffer = graph.importBackbuffer("Backbuffer", SIZE);
+
+    graph.addPass(
+            "Unused",
+            [](RenderGraph::PassBuilder& builder) { builder.create("UnusedColor", COLOR_DESC); },
+            [&executed](const RenderGraph::PassContext&) { executed.push_back("Unused"); }
+    );
+    graph.addPass(
+            "Scene",
+            [&](RenderGraph::PassBuilder& builder) { builder.write(backbuffer); },
+            [&executed](const RenderGraph::PassContext&) { executed.push_back("Scene"); }
+    );
+    graph.addPass(
+            "Readback",
+            [&](RenderGraph::PassBuilder& builder) { builder.setSideEffect(); },
+            [&executed](const RenderGraph::PassContext&) { executed.push_back("Readback"); }
+    );
+    graph.execute();
+
+    ASSERT_EQ((std::vector<std::string> { "Scene", "Readback" }), executed);
+    ASSERT_FALSE(graph.wasPassExecuted("Unused"));
+    ASSERT_EQ(1u, graph.getStats().culledPasses);
+    // The culled pass was the only user of its target, so it never got allocated
+    ASSERT_EQ(0u, graph.getStats().physicalTargets);
+}
+
+TEST(RenderGraphSuite, AliasesTargetsWithDisjointLifetimes)
+{
+    getRecording();
+    RenderGraph graph;
+    std::vector<std::string> executed;
+
+    graph.beginFrame();
+    addPostChain(graph, 4, executed);
+    graph.execute();
+
+    ASSERT_EQ((std::vector<std::string> { "Post0", "Post1", "Post2", "Post3", "Present" }), executed);
+
+    // Every target is only alive while written & read by the next pass, two of them are enough for the chain
+    const RenderGraphStats& stats = graph.getStats();
+    ASSERT_EQ(4u, stats.transientTargets);
+    ASSERT_EQ(2u, stats.physicalTargets);
+    ASSERT_EQ(stats.transientBytes / 2, stats.physicalBytes);
+}
+
+TEST(RenderGraphSuite, KeepsTargetsBetweenFrames)
+{
+    RecordingRenderBackend& backend = getRecording();
+    RenderGraph graph;
+    std::vector<std::string> executed;
+
+    graph.beginFrame();
+    addPostChain(graph, 3, executed);
+    graph.execute();
+
+    backend.resetStats();
+    graph.beginFrame();
+    addPostChain(graph, 3, executed);
+    graph.execute();
+
+    // Neither the targets nor their framebuffers get recreated for an unchanged frame
+    ASSERT_EQ(0u, backend.getStats().objectsCreated);
+    ASSERT_EQ(2u, graph.getStats().physicalTargets);
+}
@@ -0,0 +1,57 @@
+#include "../src/classes/engine/vfs/AssetArchive.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace Engine;
+
+/**
+ * Packs directories into an asset archive, usage: assetPacker <archive> <directory>...
+ *
+ * Files are stored under the path they are found at, relative to the working directory, e.g. running it next to the
+ * copied resources as "assetPacker resources.pak resources" gives "resources/shader/standard.vert".
+ */
+int main(int argc, char** argv)
+{
+    if(argc < 3)
+    {
+        std::cout << "Usage: assetPacker <archive> <directory>..." << std::endl;
+        return 1;
+    }
+
+    std::vector<AssetArchive::SourceFile> files;
+    for(int i = 2; i < argc; i++)
+    {
+        if(!AssetArchive::collectFiles(argv[i], files))
+        {
+            return 1;
+        }
+    }
+
+    size_t totalSize = 0;
+    for(const AssetArchive::SourceFile& file : files)
+    {
+        totalSize += file.data.size();
+    }
+
+    // Sorted by path, so the payloads of a directory end up next to each other
+    std::sort(
+            files.begin(),
+            files.end(),
+            [](const AssetArchive::SourceFile& a, const AssetArchive::SourceFile& b)
+            { return a.archivePath < b.archivePath; }
+    );
+
+    if(!AssetArchive::write(argv[1], files))
+    {
+        return 1;
+    }
+
+    std::error_code error;
+    std::cout << "Packed " << files.size() << " files, " << totalSize << " bytes into [" << argv[1] << "] with "
+              << std::filesystem::file_size(argv[1], error) << " bytes" << std::endl;
+    return 0;
+}